@@ -81,6 +81,8 @@ inline resynthesis_t<Params> load_resynthesis_params( rapidjson::Document const&
     ps.dynamic_database = rp["dynamic_database"].GetBool();
   if ( rp.HasMember( "fanout_limit" ) && rp["fanout_limit"].IsUint() )
     ps.fanout_limit = rp["fanout_limit"].GetUint();
+  if ( rp.HasMember( "compact" ) && rp["compact"].IsBool() )
+    ps.compact = rp["compact"].GetBool();
 
   return res;
 }
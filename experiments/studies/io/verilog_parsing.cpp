@@ -0,0 +1,140 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/genlib.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <rinox/io/utils/reader.hpp>
+#include <rinox/io/verilog/verilog.hpp>
+#include <rinox/network/network.hpp>
+
+/* Throughput of the VERILOG reader on a synthetic gate-level netlist.
+ *
+ * The netlist is written once as a single module, and once split into
+ * independent modules to measure the scaling of the parallel reader.
+ *
+ * Usage: verilog_parsing [num_gates] [num_runs] [num_modules]
+ */
+
+std::string const library = "GATE   inv1    1 O=!a;            PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                            "GATE   nand2   2 O=!(a*b);        PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                            "GATE   xor2    4 O=a^b;           PIN * UNKNOWN 2 999 1.9 0.5 1.9 0.5\n"
+                            "GATE   zero    0 O=CONST0;\n"
+                            "GATE   one     0 O=CONST1;";
+
+using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+
+/*! \brief Write a module of `num_gates` gates over 64 inputs */
+void write_module( std::ostream& out, std::string const& name, uint32_t num_gates )
+{
+  uint32_t const num_inputs = 64u;
+  auto net = [&]( uint32_t i ) { return i < num_inputs ? fmt::format( "{}_x{}", name, i ) : fmt::format( "{}_{}", name, i ); };
+
+  out << "module " << name << "( ";
+  for ( auto i = 0u; i < num_inputs; ++i )
+    out << net( i ) << " , ";
+  out << name << "_y );\n";
+  out << "  input ";
+  for ( auto i = 0u; i < num_inputs; ++i )
+    out << net( i ) << ( i + 1 < num_inputs ? " , " : " ;\n" );
+  out << "  output " << name << "_y ;\n";
+
+  uint32_t const last = num_inputs + num_gates - 1;
+  for ( auto i = num_inputs; i <= last; ++i )
+  {
+    std::string const out_net = i == last ? name + "_y" : net( i );
+    /* fanins are taken among the preceding 64 nets */
+    uint32_t const a = i - 1 - ( ( i * 7u ) % std::min( i, 64u ) );
+    uint32_t const b = i - 1 - ( ( i * 13u ) % std::min( i, 64u ) );
+    switch ( i % 3 )
+    {
+    case 0:
+      out << fmt::format( "  inv1 g{} ( .a({}), .O({}) );\n", i, net( a ), out_net );
+      break;
+    case 1:
+      out << fmt::format( "  nand2 g{} ( .a({}), .b({}), .O({}) );\n", i, net( a ), net( b ), out_net );
+      break;
+    default:
+      out << fmt::format( "  xor2 g{} ( .a({}), .b({}), .O({}) );\n", i, net( a ), net( b ), out_net );
+      break;
+    }
+  }
+  out << "endmodule\n";
+}
+
+void write_netlist( std::string const& filename, uint32_t num_gates, uint32_t num_modules )
+{
+  std::ofstream out( filename );
+  for ( auto m = 0u; m < num_modules; ++m )
+    write_module( out, fmt::format( "m{}", m ), num_gates / num_modules );
+}
+
+template<typename Fn>
+double measure( std::vector<mockturtle::gate> const& gates, uint32_t num_runs, Fn&& fn )
+{
+  double best = 0;
+  for ( auto r = 0u; r < num_runs; ++r )
+  {
+    bound_network ntk( gates );
+    auto const start = std::chrono::steady_clock::now();
+    if ( fn( ntk ) != lorina::return_code::success )
+    {
+      std::cerr << "[e] failed to read the netlist\n";
+      return 0;
+    }
+    double const time = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    best = ( r == 0 || time < best ) ? time : best;
+  }
+  return best;
+}
+
+int main( int argc, char** argv )
+{
+  uint32_t const num_gates = argc > 1 ? static_cast<uint32_t>( std::stoul( argv[1] ) ) : 1000000u;
+  uint32_t const num_runs = argc > 2 ? static_cast<uint32_t>( std::stoul( argv[2] ) ) : 3u;
+  uint32_t const num_modules = argc > 3 ? static_cast<uint32_t>( std::stoul( argv[3] ) ) : 64u;
+
+  std::vector<mockturtle::gate> gates;
+  std::istringstream in_lib( library );
+  if ( lorina::read_genlib( in_lib, mockturtle::genlib_reader( gates ) ) != lorina::return_code::success )
+    return 1;
+
+  std::string const filename = ( std::filesystem::temp_directory_path() / "rinox_verilog_parsing.v" ).string();
+  write_netlist( filename, num_gates, 1u );
+  double const megabytes = static_cast<double>( std::filesystem::file_size( filename ) ) / ( 1024.0 * 1024.0 );
+
+  double const t_stream = measure( gates, num_runs, [&]( bound_network& ntk ) {
+    std::ifstream in( filename );
+    return rinox::io::verilog::read_verilog( in, rinox::io::reader( ntk ) );
+  } );
+  double const t_mapped = measure( gates, num_runs, [&]( bound_network& ntk ) {
+    return rinox::io::verilog::read_verilog( filename, rinox::io::reader( ntk ) );
+  } );
+
+  fmt::print( "[i] netlist: {} gates, {:.2f} MB\n", num_gates, megabytes );
+  fmt::print( "[i] stream tokenizer : {:8.3f} s  {:8.2f} MB/s\n", t_stream, t_stream > 0 ? megabytes / t_stream : 0.0 );
+  fmt::print( "[i] mapped tokenizer : {:8.3f} s  {:8.2f} MB/s\n", t_mapped, t_mapped > 0 ? megabytes / t_mapped : 0.0 );
+
+  /* independent modules */
+  write_netlist( filename, num_gates, num_modules );
+  double const megabytes_modules = static_cast<double>( std::filesystem::file_size( filename ) ) / ( 1024.0 * 1024.0 );
+  fmt::print( "[i] netlist: {} modules, {:.2f} MB\n", num_modules, megabytes_modules );
+  uint32_t const max_threads = std::max( 1u, std::thread::hardware_concurrency() );
+  for ( auto num_threads = 1u; num_threads <= max_threads; num_threads *= 2u )
+  {
+    double const t_parallel = measure( gates, num_runs, [&]( bound_network& ntk ) {
+      return rinox::io::verilog::read_verilog_parallel( filename, rinox::io::reader( ntk ), num_threads );
+    } );
+    fmt::print( "[i] parallel reader  : {:3} threads {:8.3f} s  {:8.2f} MB/s\n", num_threads, t_parallel, t_parallel > 0 ? megabytes_modules / t_parallel : 0.0 );
+  }
+
+  std::remove( filename.c_str() );
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/genlib.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <rinox/analyzers/trackers/trackers.hpp>
+#include <rinox/network/network.hpp>
+
+/* Comparison of the array-of-structs and struct-of-arrays storage layouts.
+ *
+ * The same random netlist is built with both layouts, and the time of the
+ * construction, of the fanin traversals through `get_children`, and of the
+ * global simulation is measured.
+ *
+ * Usage: storage_layout [num_gates] [num_runs]
+ */
+
+std::string const library = "GATE   inv1    1 O=!a;            PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                            "GATE   nand2   2 O=!(a*b);        PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                            "GATE   xor2    4 O=a^b;           PIN * UNKNOWN 2 999 1.9 0.5 1.9 0.5\n"
+                            "GATE   zero    0 O=CONST0;\n"
+                            "GATE   one     0 O=CONST1;";
+
+using aos_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+using soa_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2, rinox::network::storage_layout_t::STRUCT_OF_ARRAYS>;
+
+/*! \brief Best time over the runs of a function */
+template<typename Fn>
+double measure( uint32_t num_runs, Fn&& fn )
+{
+  double best = 0;
+  for ( auto r = 0u; r < num_runs; ++r )
+  {
+    auto const start = std::chrono::steady_clock::now();
+    fn();
+    double const time = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    best = ( r == 0 || time < best ) ? time : best;
+  }
+  return best;
+}
+
+/*! \brief Random netlist over 64 inputs, whose gates take their fanins among the preceding 64 signals */
+template<typename Ntk>
+void build( Ntk& ntk, uint32_t num_gates )
+{
+  using signal = typename Ntk::signal;
+  std::mt19937 rng( 1 );
+  std::vector<signal> fs;
+  for ( auto i = 0u; i < 64u; ++i )
+    fs.push_back( ntk.create_pi() );
+  for ( auto i = 0u; i < num_gates; ++i )
+  {
+    auto const window = static_cast<uint32_t>( std::min<size_t>( fs.size(), 64u ) );
+    signal const a = fs[fs.size() - 1 - rng() % window];
+    signal const b = fs[fs.size() - 1 - rng() % window];
+    uint32_t const id = rng() % 3u;
+    fs.push_back( id == 0u ? ntk.create_node( { a }, id ) : ntk.create_node( { a, b }, id ) );
+  }
+  for ( auto i = 0u; i < 64u; ++i )
+    ntk.create_po( fs[fs.size() - 1 - i] );
+}
+
+template<typename Ntk>
+void run( std::string const& name, std::vector<mockturtle::gate> const& gates, uint32_t num_gates, uint32_t num_runs )
+{
+  double const t_build = measure( num_runs, [&]() {
+    Ntk ntk( gates );
+    build( ntk, num_gates );
+  } );
+
+  Ntk ntk( gates );
+  build( ntk, num_gates );
+
+  uint64_t checksum = 0u;
+  double const t_children = measure( num_runs, [&]() {
+    ntk.foreach_gate( [&]( auto const& n ) {
+      for ( auto const& f : ntk.get_children( n ) )
+        checksum += f.index;
+    } );
+  } );
+
+  double const t_simulation = measure( num_runs, [&]() {
+    rinox::analyzers::trackers::simulation_tracker_params ps;
+    ps.num_bits = 1024u;
+    rinox::analyzers::trackers::simulation_tracker sim( ntk, ps );
+    checksum += sim.get_bit( ntk.po_at( 0 ), 0u ) ? 1u : 0u;
+  } );
+
+  fmt::print( "[i] {} : build {:8.3f} s  children {:8.3f} s  simulation {:8.3f} s  ( checksum {} )\n", name, t_build, t_children, t_simulation, checksum );
+}
+
+int main( int argc, char** argv )
+{
+  uint32_t const num_gates = argc > 1 ? static_cast<uint32_t>( std::stoul( argv[1] ) ) : 1000000u;
+  uint32_t const num_runs = argc > 2 ? static_cast<uint32_t>( std::stoul( argv[2] ) ) : 3u;
+
+  std::vector<mockturtle::gate> gates;
+  std::istringstream in_lib( library );
+  if ( lorina::read_genlib( in_lib, mockturtle::genlib_reader( gates ) ) != lorina::return_code::success )
+    return 1;
+
+  fmt::print( "[i] netlist: {} gates\n", num_gates );
+  run<aos_network>( "array of structs", gates, num_gates, num_runs );
+  run<soa_network>( "struct of arrays", gates, num_gates, num_runs );
+  return 0;
+}
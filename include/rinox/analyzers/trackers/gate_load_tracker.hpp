@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include "../../network/network_events.hpp"
 #include "../../network/signal_map.hpp"
 #include <limits>
 
@@ -135,6 +136,12 @@ public:
         } );
       } );
     } );
+
+    remap_event_ = ntk_.events().register_remap_event( [&]( auto const& old_to_new ) {
+      (void)old_to_new;
+      loads_.resize();
+      compute_gate_load();
+    } );
   }
 
   ~gate_load_tracker()
@@ -153,6 +160,11 @@ public:
     {
       ntk_.events().release_modified_event( modified_event_ );
     }
+
+    if ( remap_event_ )
+    {
+      ntk_.events().release_remap_event( remap_event_ );
+    }
   }
 
 #pragma region Interface methods
@@ -215,6 +227,7 @@ private:
   std::shared_ptr<typename mockturtle::network_events<Ntk>::add_event_type> add_event_;
   std::shared_ptr<typename mockturtle::network_events<Ntk>::delete_event_type> delete_event_;
   std::shared_ptr<typename mockturtle::network_events<Ntk>::modified_event_type> modified_event_;
+  std::shared_ptr<typename network::network_events<Ntk>::remap_event_type> remap_event_;
 };
 } // namespace trackers
 
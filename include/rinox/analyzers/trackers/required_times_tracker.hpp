@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include "../../network/network_events.hpp"
 #include "../../network/signal_map.hpp"
 #include "topo_sort_tracker.hpp"
 #include <limits>
@@ -157,6 +158,13 @@ public:
       /* update the affected required times from one level up */
       update_required( level );
     } );
+
+    remap_event_ = ntk_.events().register_remap_event( [&]( auto const& old_to_new ) {
+      (void)old_to_new;
+      /* the topological order is updated by its own remap event, registered earlier */
+      times_.resize();
+      compute_required_times();
+    } );
   }
 
   ~required_times_tracker()
@@ -170,6 +178,11 @@ public:
     {
       ntk_.events().release_modified_event( modified_event_ );
     }
+
+    if ( remap_event_ )
+    {
+      ntk_.events().release_remap_event( remap_event_ );
+    }
   }
 
 #pragma region Interface methods
@@ -345,6 +358,7 @@ private:
   /* events */
   std::shared_ptr<typename mockturtle::network_events<Ntk>::add_event_type> add_event_;
   std::shared_ptr<typename mockturtle::network_events<Ntk>::modified_event_type> modified_event_;
+  std::shared_ptr<typename network::network_events<Ntk>::remap_event_type> remap_event_;
 };
 } // namespace trackers
 
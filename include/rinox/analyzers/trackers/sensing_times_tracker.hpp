@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include "../../network/network_events.hpp"
 #include "../../network/signal_map.hpp"
 #include "../../network/tfo_manager.hpp"
 #include <limits>
@@ -130,6 +131,12 @@ public:
         update_sensing_times_tfo( ntk_.get_node( f ) );
       }
     } );
+
+    remap_event_ = ntk_.events().register_remap_event( [&]( auto const& old_to_new ) {
+      (void)old_to_new;
+      times_.resize();
+      compute_sensing_times();
+    } );
   }
 
   ~sensing_times_tracker()
@@ -143,6 +150,11 @@ public:
     {
       ntk_.events().release_modified_event( modified_event_ );
     }
+
+    if ( remap_event_ )
+    {
+      ntk_.events().release_remap_event( remap_event_ );
+    }
   }
 
 #pragma region Interface methods
@@ -293,6 +305,7 @@ private:
   /* events */
   std::shared_ptr<typename mockturtle::network_events<Ntk>::add_event_type> add_event_;
   std::shared_ptr<typename mockturtle::network_events<Ntk>::modified_event_type> modified_event_;
+  std::shared_ptr<typename network::network_events<Ntk>::remap_event_type> remap_event_;
 };
 } // namespace trackers
 
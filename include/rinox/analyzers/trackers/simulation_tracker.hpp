@@ -0,0 +1,664 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+ * \file simulation_tracker.hpp
+ * \brief Bit-parallel simulation of a whole network kept up-to-date
+ *
+ * \author Andrea Costamagna
+ */
+
+#pragma once
+
+#include "../../network/network_events.hpp"
+#include "../../traits.hpp"
+#include <kitty/partial_truth_table.hpp>
+#include <mockturtle/networks/events.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace rinox
+{
+
+namespace analyzers
+{
+
+namespace trackers
+{
+
+struct simulation_tracker_params
+{
+  /*! \brief Number of simulation patterns */
+  uint32_t num_bits = 256u;
+
+  /*! \brief Number of threads simulating the gates of the same level */
+  uint32_t num_threads = 1u;
+
+  /*! \brief Minimum number of gates of the network to simulate it in parallel */
+  uint32_t min_parallel_size = 4096u;
+
+  /*! \brief Seed of the random patterns of the inputs */
+  uint64_t seed = 0xcafeu;
+};
+
+/*! \brief Engine to simulate a network on a set of patterns.
+ *
+ * Every output pin of the network is simulated on the same `num_bits`
+ * patterns. The simulations are stored in a single contiguous buffer of
+ * 64-bit blocks, where the blocks of a signal start at the offset
+ * `signal_to_index( f ) * num_blocks()`. The inputs are assigned random
+ * patterns, which can be modified by the user.
+ *
+ * The complete simulation visits the network level by level. Since the gates
+ * of the same level do not depend on each other, they are split among the
+ * threads, which synchronize before moving to the next level.
+ *
+ * The engine keeps the simulations up-to-date using the network events:
+ * - Node addition: The node is simulated from its fanins.
+ * - Node modification: The transitive fanout (TFO) of the node is
+ *   re-simulated, stopping where the simulations do not change.
+ * - Node deletion: The simulations of the outputs of the node are cleared.
+ * - Node renumbering: The simulations are moved to the new indices.
+ * - Truncation: The removed indices are simulated again when reused.
+ *
+ * \tparam Ntk the network type to be simulated.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      bound_network ntk( gates );
+      auto const a = ntk.create_pi();
+      auto const b = ntk.create_pi();
+      simulation_tracker sim( ntk );
+      auto const f = ntk.create_node( { a, b }, 2 );
+      kitty::partial_truth_table const tt = sim.get( f );
+   \endverbatim
+ */
+template<class Ntk>
+class simulation_tracker
+{
+public:
+  using node_index_t = typename Ntk::node;
+  using signal_t = typename Ntk::signal;
+
+public:
+  simulation_tracker( Ntk& ntk, simulation_tracker_params const& ps = {} )
+      : ntk_( ntk ),
+        ps_( ps ),
+        num_blocks_( ( ps.num_bits + 63u ) >> 6u ),
+        last_mask_( ( ps.num_bits & 63u ) ? ( ( uint64_t( 1 ) << ( ps.num_bits & 63u ) ) - 1u ) : ~uint64_t( 0 ) )
+  {
+    init();
+  }
+
+  simulation_tracker( simulation_tracker const& ) = delete;
+  simulation_tracker& operator=( simulation_tracker const& ) = delete;
+
+  void init()
+  {
+    /* check if the network implements the needed functionalities */
+    static_assert( mockturtle::is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( mockturtle::has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( mockturtle::has_foreach_fanout_v<Ntk>, "Ntk does not implement the foreach_fanout method" );
+    static_assert( mockturtle::has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( mockturtle::has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( mockturtle::has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( rinox::traits::has_foreach_output_v<Ntk>, "Ntk does not implement the foreach_output method" );
+
+    run();
+
+    add_event_ = ntk_.events().register_add_event( [&]( node_index_t const& n ) {
+      (void)n;
+      resize();
+    } );
+
+    modified_event_ = ntk_.events().register_modified_event( [&]( node_index_t const& n, auto const& old_children ) {
+      (void)old_children;
+      resize();
+      if ( !ntk_.is_dead( n ) )
+      {
+        roots_.clear();
+        roots_.push_back( n );
+        propagate( roots_ );
+      }
+    } );
+
+    delete_event_ = ntk_.events().register_delete_event( [&]( node_index_t const& n ) {
+      clear_node( n );
+    } );
+
+    remap_event_ = ntk_.events().register_remap_event( [&]( auto const& old_to_new ) {
+      remap( old_to_new );
+    } );
+
+    truncate_event_ = ntk_.events().register_truncate_event( [&]( node_index_t const& size ) {
+      truncate( size );
+    } );
+  }
+
+  ~simulation_tracker()
+  {
+    if ( add_event_ )
+    {
+      ntk_.events().release_add_event( add_event_ );
+    }
+
+    if ( modified_event_ )
+    {
+      ntk_.events().release_modified_event( modified_event_ );
+    }
+
+    if ( delete_event_ )
+    {
+      ntk_.events().release_delete_event( delete_event_ );
+    }
+
+    if ( remap_event_ )
+    {
+      ntk_.events().release_remap_event( remap_event_ );
+    }
+
+    if ( truncate_event_ )
+    {
+      ntk_.events().release_truncate_event( truncate_event_ );
+    }
+  }
+
+#pragma region Interface methods
+public:
+  /*! \brief Simulate the whole network, keeping the patterns of the inputs.
+   *
+   * The levels are simulated in parallel if the network has at least
+   * `min_parallel_size` gates and more than one thread is requested.
+   */
+  void run()
+  {
+    resize( false );
+    compute_levels();
+    changed_inputs_.clear();
+
+    uint32_t const num_threads = std::max( 1u, ps_.num_threads );
+    if ( ( num_threads == 1u ) || ( order_.size() < ps_.min_parallel_size ) )
+    {
+      for ( auto const& n : order_ )
+        simulate_node( n );
+      return;
+    }
+
+    barrier_count_ = 0u;
+    foreach_thread( num_threads, [&]( uint32_t t ) {
+      for ( auto l = 1u; l + 1u < level_offsets_.size(); ++l )
+      {
+        uint32_t const begin = level_offsets_[l];
+        uint32_t const end = level_offsets_[l + 1u];
+        uint32_t const chunk = ( end - begin + num_threads - 1u ) / num_threads;
+        uint32_t const first = std::min( end, begin + t * chunk );
+        uint32_t const last = std::min( end, first + chunk );
+        for ( auto i = first; i < last; ++i )
+          simulate_node( order_[i] );
+        wait_barrier( num_threads );
+      }
+    } );
+  }
+
+  /*! \brief Propagate the changes of the input patterns to their TFO. */
+  void update()
+  {
+    resize();
+    if ( changed_inputs_.empty() )
+      return;
+    propagate( changed_inputs_ );
+    changed_inputs_.clear();
+  }
+
+  /*! \brief Assign a pattern bit of an input, propagated by the next `update()`. */
+  void set_input_bit( node_index_t const& n, uint32_t bit, bool value )
+  {
+    assert( ntk_.is_pi( n ) );
+    resize();
+    uint64_t& block = data_[offset( ntk_.make_signal( n ) ) + ( bit >> 6u )];
+    uint64_t const mask = uint64_t( 1 ) << ( bit & 63u );
+    if ( ( ( block & mask ) != 0u ) == value )
+      return;
+    block ^= mask;
+    if ( std::find( changed_inputs_.begin(), changed_inputs_.end(), n ) == changed_inputs_.end() )
+      changed_inputs_.push_back( n );
+  }
+
+  /*! \brief Assign the patterns of an input, propagated by the next `update()`. */
+  void set_input( node_index_t const& n, kitty::partial_truth_table const& tt )
+  {
+    assert( ntk_.is_pi( n ) );
+    resize();
+    uint64_t* dst = &data_[offset( ntk_.make_signal( n ) )];
+    for ( auto b = 0u; b < num_blocks_; ++b )
+      dst[b] = b < tt.num_blocks() ? tt._bits[b] : 0u;
+    dst[num_blocks_ - 1u] &= last_mask_;
+    if ( std::find( changed_inputs_.begin(), changed_inputs_.end(), n ) == changed_inputs_.end() )
+      changed_inputs_.push_back( n );
+  }
+
+  [[nodiscard]] uint32_t num_bits() const
+  {
+    return ps_.num_bits;
+  }
+
+  [[nodiscard]] uint32_t num_blocks() const
+  {
+    return num_blocks_;
+  }
+
+  /*! \brief Blocks of the simulation of a signal. */
+  [[nodiscard]] uint64_t const* blocks( signal_t const& f ) const
+  {
+    return &data_[offset( f )];
+  }
+
+  [[nodiscard]] bool get_bit( signal_t const& f, uint32_t bit ) const
+  {
+    return ( blocks( f )[bit >> 6u] >> ( bit & 63u ) ) & 1u;
+  }
+
+  /*! \brief Simulation of a signal as a truth table. */
+  [[nodiscard]] kitty::partial_truth_table get( signal_t const& f ) const
+  {
+    kitty::partial_truth_table tt( ps_.num_bits );
+    std::copy( blocks( f ), blocks( f ) + num_blocks_, tt.begin() );
+    return tt;
+  }
+
+  /*! \brief Copy the first patterns of a signal in a truth table of fixed size. */
+  template<typename TT>
+  void load( TT& tt, signal_t const& f ) const
+  {
+    uint64_t const* src = blocks( f );
+    auto it = tt.begin();
+    for ( auto b = 0u; ( b < num_blocks_ ) && ( it != tt.end() ); ++b, ++it )
+      *it = src[b];
+    tt.mask_bits();
+  }
+#pragma endregion
+
+#pragma region Implementation details
+private:
+  uint64_t offset( signal_t const& f ) const
+  {
+    return ntk_.signal_to_index( f ) * num_blocks_;
+  }
+
+  /*! \brief Allocate the simulations of the new nodes and simulate them.
+   *
+   * The nodes are created after their fanins, hence the new nodes are
+   * simulated in index order. The new inputs get random patterns. A network
+   * smaller than the simulated one has been truncated without notification,
+   * and its reused indices are simulated again.
+   */
+  void resize( bool simulate_gates = true )
+  {
+    if ( num_nodes_ > ntk_.size() )
+      truncate( ntk_.size() );
+    if ( num_nodes_ >= ntk_.size() )
+      return;
+    data_.resize( ntk_.signal_size() * num_blocks_, 0u );
+    for ( node_index_t n = num_nodes_; n < ntk_.size(); ++n )
+    {
+      if ( ntk_.is_dead( n ) )
+        continue;
+      if ( ntk_.is_pi( n ) )
+        randomize_input( n );
+      else if ( simulate_gates || ntk_.is_constant( n ) )
+        simulate_node( n );
+    }
+    num_nodes_ = ntk_.size();
+  }
+
+  /*! \brief Forget the simulations of the nodes from index `size` on. */
+  void truncate( node_index_t const& size )
+  {
+    if ( num_nodes_ <= size )
+      return;
+    num_nodes_ = size;
+    data_.resize( ntk_.signal_size() * num_blocks_ );
+    changed_inputs_.erase( std::remove_if( changed_inputs_.begin(), changed_inputs_.end(), [&]( auto const& n ) { return n >= size; } ),
+                           changed_inputs_.end() );
+  }
+
+  /*! \brief Clear the simulations of a deleted node, whose index is reused only after truncation. */
+  void clear_node( node_index_t const& n )
+  {
+    if ( n >= num_nodes_ )
+      return;
+    ntk_.foreach_output( n, [&]( auto const& fo ) {
+      uint64_t* dst = &data_[offset( fo )];
+      std::fill( dst, dst + num_blocks_, 0u );
+    } );
+  }
+
+  void randomize_input( node_index_t const& n )
+  {
+    std::mt19937_64 rng( ps_.seed + n );
+    uint64_t* dst = &data_[offset( ntk_.make_signal( n ) )];
+    for ( auto b = 0u; b < num_blocks_; ++b )
+      dst[b] = rng();
+    dst[num_blocks_ - 1u] &= last_mask_;
+  }
+
+  void simulate_node( node_index_t const& n )
+  {
+    if ( ntk_.is_constant( n ) )
+    {
+      uint64_t* dst = &data_[offset( ntk_.make_signal( n ) )];
+      std::fill( dst, dst + num_blocks_, ntk_.constant_value( n ) ? ~uint64_t( 0 ) : 0u );
+      dst[num_blocks_ - 1u] &= last_mask_;
+      return;
+    }
+    if ( ntk_.is_pi( n ) )
+      return;
+
+    std::array<uint64_t const*, Ntk::max_fanin_size> fanins;
+    ntk_.foreach_fanin( n, [&]( auto const& fi, auto ii ) {
+      fanins[ii] = &data_[offset( fi )];
+    } );
+    ntk_.foreach_output( n, [&]( auto const& fo ) {
+      uint64_t* dst = &data_[offset( fo )];
+      ntk_.compute( dst, fo, fanins.data(), num_blocks_ );
+      dst[num_blocks_ - 1u] &= last_mask_;
+    } );
+  }
+
+  /*! \brief Re-simulate a node, returning true if any of its outputs changed */
+  bool resimulate_node( node_index_t const& n )
+  {
+    std::array<uint64_t const*, Ntk::max_fanin_size> fanins;
+    ntk_.foreach_fanin( n, [&]( auto const& fi, auto ii ) {
+      fanins[ii] = &data_[offset( fi )];
+    } );
+
+    bool changed = false;
+    temp_.resize( num_blocks_ );
+    ntk_.foreach_output( n, [&]( auto const& fo ) {
+      ntk_.compute( temp_.data(), fo, fanins.data(), num_blocks_ );
+      temp_[num_blocks_ - 1u] &= last_mask_;
+      uint64_t* dst = &data_[offset( fo )];
+      if ( !std::equal( temp_.begin(), temp_.end(), dst ) )
+      {
+        std::copy( temp_.begin(), temp_.end(), dst );
+        changed = true;
+      }
+    } );
+    return changed;
+  }
+
+  void new_mark()
+  {
+    if ( marks_.size() < ntk_.size() )
+    {
+      marks_.resize( ntk_.size(), 0u );
+      tfo_.resize( ntk_.size(), 0u );
+      changed_.resize( ntk_.size(), 0u );
+    }
+    ++mark_;
+  }
+
+  /*! \brief Visit the unmarked nodes in the transitive fanin of `root` in topological order.
+   *
+   * The traversal does not expand the nodes for which `stop` returns true.
+   */
+  template<typename Stop, typename Fn>
+  void foreach_tfi_topological( node_index_t const& root, Stop&& stop, Fn&& fn )
+  {
+    if ( marks_[root] == mark_ )
+      return;
+    stack_.clear();
+    stack_.emplace_back( root, false );
+    while ( !stack_.empty() )
+    {
+      auto const [n, expanded] = stack_.back();
+      if ( expanded )
+      {
+        stack_.pop_back();
+        fn( n );
+        continue;
+      }
+      if ( marks_[n] == mark_ )
+      {
+        stack_.pop_back();
+        continue;
+      }
+      marks_[n] = mark_;
+      stack_.back().second = true;
+      ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+        auto const m = ntk_.get_node( fi );
+        if ( ( marks_[m] != mark_ ) && !stop( m ) )
+          stack_.emplace_back( m, false );
+      } );
+    }
+  }
+
+  /*! \brief Sort the gates by level, the length of the longest path from the inputs */
+  void compute_levels()
+  {
+    new_mark();
+    topo_.clear();
+    ntk_.foreach_node( [&]( auto const& n ) {
+      foreach_tfi_topological(
+          n, []( auto const& ) { return false; }, [&]( auto const& m ) { topo_.push_back( m ); } );
+    } );
+
+    levels_.resize( ntk_.size() );
+    uint32_t max_level = 0u;
+    for ( auto const& n : topo_ )
+    {
+      uint32_t level = 0u;
+      if ( !ntk_.is_pi( n ) && !ntk_.is_constant( n ) )
+      {
+        ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+          level = std::max( level, levels_[ntk_.get_node( fi )] + 1u );
+        } );
+        level = std::max( level, 1u );
+      }
+      levels_[n] = level;
+      max_level = std::max( max_level, level );
+    }
+
+    /* counting sort of the gates, the inputs and the constants have level 0 */
+    level_offsets_.assign( max_level + 2u, 0u );
+    for ( auto const& n : topo_ )
+      level_offsets_[levels_[n] + 1u] += levels_[n] > 0u ? 1u : 0u;
+    for ( auto l = 1u; l < level_offsets_.size(); ++l )
+      level_offsets_[l] += level_offsets_[l - 1u];
+
+    order_.resize( level_offsets_.back() );
+    next_.assign( level_offsets_.begin(), level_offsets_.end() - 1u );
+    for ( auto const& n : topo_ )
+    {
+      if ( levels_[n] > 0u )
+        order_[next_[levels_[n]]++] = n;
+    }
+  }
+
+  /*! \brief Move the simulations to the new indices of the nodes, without simulating them */
+  void remap( std::vector<node_index_t> const& old_to_new )
+  {
+    std::vector<uint64_t> data( ntk_.signal_size() * num_blocks_, 0u );
+    for ( node_index_t n = 0; n < std::min<uint64_t>( old_to_new.size(), num_nodes_ ); ++n )
+    {
+      auto const m = old_to_new[n];
+      if ( m == std::numeric_limits<node_index_t>::max() )
+        continue;
+      for ( auto i = 0u; i < ntk_.num_outputs( m ); ++i )
+        std::copy_n( data_.begin() + offset( signal_t{ n, i } ), num_blocks_, data.begin() + offset( signal_t{ m, i } ) );
+    }
+    data_.swap( data );
+    num_nodes_ = ntk_.size();
+
+    for ( auto& n : changed_inputs_ )
+      n = old_to_new[n];
+    /* the traversal marks refer to the old indices */
+    std::fill( marks_.begin(), marks_.end(), 0u );
+    std::fill( tfo_.begin(), tfo_.end(), 0u );
+    std::fill( changed_.begin(), changed_.end(), 0u );
+  }
+
+  /*! \brief Re-simulate the TFO of the roots, stopping where the simulations do not change */
+  void propagate( std::vector<node_index_t> const& roots )
+  {
+    /* mark the transitive fanout of the roots */
+    new_mark();
+    uint32_t const tfo_mark = mark_;
+    queue_.clear();
+    for ( auto const& r : roots )
+    {
+      if ( tfo_[r] != tfo_mark )
+      {
+        tfo_[r] = tfo_mark;
+        queue_.push_back( r );
+      }
+    }
+    for ( auto i = 0u; i < queue_.size(); ++i )
+    {
+      ntk_.foreach_fanout( queue_[i], [&]( node_index_t const& o ) {
+        if ( ( tfo_[o] != tfo_mark ) && !ntk_.is_dead( o ) )
+        {
+          tfo_[o] = tfo_mark;
+          queue_.push_back( o );
+        }
+      } );
+    }
+
+    /* the index order is not topological after a substitution */
+    topo_.clear();
+    for ( auto const& n : queue_ )
+    {
+      foreach_tfi_topological(
+          n, [&]( auto const& m ) { return tfo_[m] != tfo_mark; }, [&]( auto const& m ) { topo_.push_back( m ); } );
+    }
+
+    for ( auto const& r : roots )
+      changed_[r] = tfo_mark;
+    for ( auto const& n : topo_ )
+    {
+      if ( ntk_.is_pi( n ) || ntk_.is_constant( n ) )
+        continue;
+      bool dirty = changed_[n] == tfo_mark;
+      ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+        dirty |= changed_[ntk_.get_node( fi )] == tfo_mark;
+      } );
+      if ( !dirty )
+        continue;
+      if ( resimulate_node( n ) )
+        changed_[n] = tfo_mark;
+    }
+  }
+
+  /*! \brief Run a job on each thread. */
+  template<typename Fn>
+  void foreach_thread( uint32_t num_threads, Fn&& fn )
+  {
+    std::vector<std::thread> threads;
+    for ( auto t = 1u; t < num_threads; ++t )
+      threads.emplace_back( [&fn, t]() { fn( t ); } );
+    fn( 0u );
+    for ( auto& thread : threads )
+      thread.join();
+  }
+
+  /*! \brief Wait until all the threads have simulated the current level. */
+  void wait_barrier( uint32_t num_threads )
+  {
+    std::unique_lock<std::mutex> lock( mutex_ );
+    uint64_t const generation = barrier_generation_;
+    if ( ++barrier_count_ == num_threads )
+    {
+      barrier_count_ = 0u;
+      ++barrier_generation_;
+      condition_.notify_all();
+      return;
+    }
+    condition_.wait( lock, [&]() { return generation != barrier_generation_; } );
+  }
+#pragma endregion
+
+private:
+  Ntk& ntk_;
+  simulation_tracker_params ps_;
+  uint32_t num_blocks_;
+  /*! \brief Mask of the valid bits of the last block */
+  uint64_t last_mask_;
+  /*! \brief Blocks of the simulations, indexed by signal */
+  std::vector<uint64_t> data_;
+  /*! \brief Nodes with a smaller index are allocated */
+  node_index_t num_nodes_{ 0 };
+  std::vector<node_index_t> changed_inputs_;
+  std::vector<uint64_t> temp_;
+
+  /* topological traversals */
+  std::vector<uint32_t> marks_;
+  std::vector<uint32_t> tfo_;
+  std::vector<uint32_t> changed_;
+  uint32_t mark_{ 0 };
+  std::vector<std::pair<node_index_t, bool>> stack_;
+  std::vector<node_index_t> queue_;
+  std::vector<node_index_t> topo_;
+  std::vector<node_index_t> roots_;
+
+  /* gates sorted by level */
+  std::vector<uint32_t> levels_;
+  std::vector<node_index_t> order_;
+  std::vector<uint32_t> level_offsets_;
+  std::vector<uint32_t> next_;
+
+  /* synchronization of the threads */
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  uint32_t barrier_count_{ 0 };
+  uint64_t barrier_generation_{ 0 };
+
+  /* events */
+  std::shared_ptr<typename mockturtle::network_events<typename Ntk::base_type>::add_event_type> add_event_;
+  std::shared_ptr<typename mockturtle::network_events<typename Ntk::base_type>::modified_event_type> modified_event_;
+  std::shared_ptr<typename mockturtle::network_events<typename Ntk::base_type>::delete_event_type> delete_event_;
+  std::shared_ptr<typename network::network_events<typename Ntk::base_type>::remap_event_type> remap_event_;
+  std::shared_ptr<typename network::network_events<typename Ntk::base_type>::truncate_event_type> truncate_event_;
+};
+
+} // namespace trackers
+
+} // namespace analyzers
+
+} // namespace rinox
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include "../../network/network_events.hpp"
 #include "../../network/tfo_manager.hpp"
 #include <limits>
 #include <mockturtle/utils/node_map.hpp>
@@ -177,6 +178,12 @@ public:
         update_topo_sort_tfo( ntk_.get_node( f ) );
       }
     } );
+
+    remap_event_ = ntk_.events().register_remap_event( [&]( auto const& old_to_new ) {
+      (void)old_to_new;
+      nodes_.resize();
+      compute_topo_sort();
+    } );
   }
 
   ~topo_sort_tracker()
@@ -195,6 +202,11 @@ public:
     {
       ntk_.events().release_modified_event( modified_event_ );
     }
+
+    if ( remap_event_ )
+    {
+      ntk_.events().release_remap_event( remap_event_ );
+    }
   }
 
 #pragma region Iterators
@@ -488,6 +500,7 @@ private:
   std::shared_ptr<typename mockturtle::network_events<Ntk>::add_event_type> add_event_;
   std::shared_ptr<typename mockturtle::network_events<Ntk>::delete_event_type> delete_event_;
   std::shared_ptr<typename mockturtle::network_events<Ntk>::modified_event_type> modified_event_;
+  std::shared_ptr<typename network::network_events<Ntk>::remap_event_type> remap_event_;
 };
 } // namespace trackers
 
@@ -34,4 +34,5 @@
 #include "gate_load_tracker.hpp"
 #include "required_times_tracker.hpp"
 #include "sensing_times_tracker.hpp"
+#include "simulation_tracker.hpp"
 #include "topo_sort_tracker.hpp"
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "p_canonization.hpp"
 #include "permutation.hpp"
 #include "simd.hpp"
 #include "symmetry.hpp"
\ No newline at end of file
@@ -0,0 +1,255 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file p_canonization.hpp
+  \brief Signature-based P-canonization of small truth tables
+
+  \author Andrea Costamagna
+*/
+
+#pragma once
+
+#include "permutation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <kitty/kitty.hpp>
+
+namespace rinox
+{
+
+namespace boolean
+{
+
+/*! \brief P-canonization pruned by permutation-invariant signatures.
+ *
+ * The variables are first sorted by a signature that does not depend on their
+ * order: the number of minterms of the positive cofactor, and the number of
+ * minterms of the positive cofactors with respect to pairs of variables.
+ * Only the permutations compatible with this order are enumerated, and
+ * variables that can be swapped without changing the function are enumerated
+ * once. The representative is the smallest truth table among the enumerated
+ * ones, hence P-equivalent functions share the same representative.
+ *
+ * The representative differs in general from the one of
+ * `kitty::exact_p_canonization`, which minimizes over all permutations. The
+ * permutation follows the same convention: variable `perm[i]` of the function
+ * is variable `i` of the representative.
+ *
+ * For up to `max_table_vars` variables, the result can be read from a table
+ * precomputed once per process.
+ *
+ * \tparam MaxNumVars Number of variables of the truth tables
+ */
+template<uint32_t MaxNumVars>
+class p_canonizer
+{
+public:
+  using truth_table_t = kitty::static_truth_table<MaxNumVars>;
+  using result_t = std::pair<truth_table_t, permutation_t>;
+  static constexpr uint32_t max_table_vars = 4u;
+
+  explicit p_canonizer( bool use_table = true )
+      : use_table_( use_table && ( MaxNumVars <= max_table_vars ) )
+  {
+    if ( use_table_ )
+      table();
+  }
+
+  result_t operator()( truth_table_t const& tt ) const
+  {
+    if constexpr ( MaxNumVars <= max_table_vars )
+    {
+      if ( use_table_ )
+      {
+        uint64_t const entry = table()[*tt.cbegin()];
+        truth_table_t repr;
+        *repr.begin() = entry & table_mask;
+        return { repr, unpack( entry >> 32u ) };
+      }
+    }
+    return canonize( tt );
+  }
+
+  /*! \brief Canonization without the precomputed table */
+  static result_t canonize( truth_table_t const& tt )
+  {
+    std::array<uint8_t, MaxNumVars> order;
+    std::array<uint64_t, MaxNumVars> sign;
+    for ( uint8_t i = 0; i < MaxNumVars; ++i )
+    {
+      order[i] = i;
+      auto const tt1 = kitty::cofactor1( tt, i );
+      uint64_t pairs = 0u;
+      for ( uint8_t j = 0; j < MaxNumVars; ++j )
+      {
+        if ( j != i )
+          pairs += kitty::count_ones( kitty::cofactor1( tt1, j ) );
+      }
+      sign[i] = ( kitty::count_ones( tt1 ) << 32u ) | pairs;
+    }
+    std::stable_sort( order.begin(), order.end(), [&]( auto const& a, auto const& b ) {
+      return sign[a] < sign[b];
+    } );
+
+    /* variables with the same signature that can be swapped without changing the function */
+    std::array<uint8_t, MaxNumVars> twin;
+    for ( uint8_t i = 0; i < MaxNumVars; ++i )
+    {
+      twin[i] = i;
+      for ( uint8_t j = 0; j < i; ++j )
+      {
+        if ( sign[i] == sign[j] && kitty::equal( tt, kitty::swap( tt, i, j ) ) )
+        {
+          twin[i] = twin[j];
+          break;
+        }
+      }
+    }
+
+    state_t state{ tt, sign, twin, order };
+    for ( uint8_t i = 0; i < MaxNumVars; ++i )
+    {
+      state.perm[i] = i;
+      state.where[i] = i;
+    }
+    state.best = tt;
+    state.best_perm = state.perm;
+    state.found = false;
+    enumerate( state, 0u, tt );
+
+    permutation_t perm;
+    perm.num_vars = MaxNumVars;
+    for ( uint8_t i = 0; i < MaxNumVars; ++i )
+      perm.set( i, state.best_perm[i] );
+    return { state.best, perm };
+  }
+
+private:
+  struct state_t
+  {
+    truth_table_t const& tt;
+    std::array<uint64_t, MaxNumVars> const& sign;
+    std::array<uint8_t, MaxNumVars> const& twin;
+    std::array<uint8_t, MaxNumVars> const& order;
+    /* variable of the function at each position, and its inverse */
+    std::array<uint8_t, MaxNumVars> perm;
+    std::array<uint8_t, MaxNumVars> where;
+    std::array<uint8_t, MaxNumVars> best_perm;
+    truth_table_t best;
+    bool found;
+  };
+
+  static void enumerate( state_t& state, uint8_t pos, truth_table_t const& curr )
+  {
+    if ( pos == MaxNumVars )
+    {
+      if ( !state.found || curr < state.best )
+      {
+        state.best = curr;
+        state.best_perm = state.perm;
+        state.found = true;
+      }
+      return;
+    }
+
+    /* candidates are the unplaced variables with the signature required at this position */
+    uint64_t const target = state.sign[state.order[pos]];
+    for ( uint8_t v = 0; v < MaxNumVars; ++v )
+    {
+      if ( state.where[v] < pos || state.sign[v] != target )
+        continue;
+
+      /* interchangeable variables are placed in increasing order */
+      bool skip = false;
+      for ( uint8_t u = 0; u < v; ++u )
+        skip |= ( state.twin[u] == state.twin[v] ) && ( state.where[u] >= pos );
+      if ( skip )
+        continue;
+
+      uint8_t const p = state.where[v];
+      uint8_t const w = state.perm[pos];
+      auto next = curr;
+      if ( p != pos )
+        kitty::swap_inplace( next, pos, p );
+      std::swap( state.perm[pos], state.perm[p] );
+      state.where[v] = pos;
+      state.where[w] = p;
+
+      enumerate( state, pos + 1, next );
+
+      std::swap( state.perm[pos], state.perm[p] );
+      state.where[v] = p;
+      state.where[w] = pos;
+    }
+  }
+
+  static constexpr uint64_t table_mask = ~0ull >> ( 64u - ( 1u << std::min( MaxNumVars, 6u ) ) );
+
+  static permutation_t unpack( uint64_t packed )
+  {
+    permutation_t perm;
+    perm.num_vars = MaxNumVars;
+    for ( uint8_t i = 0; i < MaxNumVars; ++i )
+      perm.set( i, ( packed >> ( 4u * i ) ) & 0xF );
+    return perm;
+  }
+
+  /*! \brief Representative and packed permutation of each function, built on first use */
+  static std::vector<uint64_t> const& table()
+  {
+    static std::vector<uint64_t> const entries = [] {
+      std::vector<uint64_t> res;
+      if constexpr ( MaxNumVars <= max_table_vars )
+      {
+        res.resize( 1ull << ( 1u << MaxNumVars ) );
+        truth_table_t tt;
+        for ( uint64_t f = 0u; f < res.size(); ++f )
+        {
+          *tt.begin() = f;
+          auto const [repr, perm] = canonize( tt );
+          uint64_t packed = 0u;
+          for ( uint8_t i = 0; i < MaxNumVars; ++i )
+            packed |= static_cast<uint64_t>( perm.forward( i ) ) << ( 4u * i );
+          res[f] = ( *repr.cbegin() & table_mask ) | ( packed << 32u );
+        }
+      }
+      return res;
+    }();
+    return entries;
+  }
+
+private:
+  bool use_table_;
+};
+
+} // namespace boolean
+
+} // namespace rinox
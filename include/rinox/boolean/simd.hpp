@@ -27,14 +27,23 @@
   \file simd_operations.hpp
   \brief Implements efficient alternatives of common truth-table operations.
 
+  The vectorized kernels are compiled for several instruction sets ( AVX-512,
+  AVX2, SSE4.2 ) through function-level target attributes, so that no global
+  architecture flag is needed. The best instruction set supported by the host
+  is selected once at startup, and can be lowered through the environment
+  variable `RINOX_SIMD` ( `avx512`, `avx2`, `sse42`, or `scalar` ).
+
   \author Andrea Costamagna
 */
 
 #pragma once
 
 #include <algorithm>
+#include <bitset>
 #include <cassert>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <kitty/detail/mscfix.hpp>
 #include <kitty/kitty.hpp>
@@ -42,22 +51,27 @@
 #include <numeric>
 #include <unordered_map>
 
-/*! Check if the code is compiled on a platform that might support AVX2 */
-#ifndef KITTY_HAS_AVX2
-#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( _MSC_VER )
-#define KITTY_HAS_AVX2 1
+/*! Check if the code is compiled for a platform with x86 vector extensions */
+#ifndef RINOX_HAS_X86_SIMD
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#define RINOX_HAS_X86_SIMD 1
 #else
-#define KITTY_HAS_AVX2 0
+#define RINOX_HAS_X86_SIMD 0
 #endif
 #endif
 
-#if KITTY_HAS_AVX2
+#if RINOX_HAS_X86_SIMD
 #if defined( _MSC_VER )
 #include <intrin.h>
-#else
-#include <cpuid.h>
+#endif
 #include <immintrin.h>
 #endif
+
+/*! Compile a function for a specific instruction set, independently of the global flags */
+#if RINOX_HAS_X86_SIMD && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define RINOX_TARGET( isa ) __attribute__( ( target( isa ) ) )
+#else
+#define RINOX_TARGET( isa )
 #endif
 
 namespace rinox
@@ -79,77 +93,592 @@ enum class Operation : uint32_t
   SIZE
 };
 
-/*! Check if AVX2 is supported on this machine. */
-inline bool has_avx2_cached()
+/*! \brief Instruction sets of the vectorized kernels, from the least to the most powerful. */
+enum class simd_isa : uint32_t
 {
-#if KITTY_HAS_AVX2
-#if defined( _MSC_VER )
-  static const bool cached = [] {
-    int cpuInfo[4];
-    __cpuid( cpuInfo, 0 );
-    if ( cpuInfo[0] < 7 )
-      return false;
-    __cpuidex( cpuInfo, 7, 0 );
-    return ( cpuInfo[1] & ( 1 << 5 ) ) != 0;
-  }();
-  return cached;
+  SCALAR,
+  SSE42,
+  AVX2,
+  AVX512
+};
+
+namespace detail
+{
+
+/*! \brief Instruction sets supported by the host. */
+struct cpu_features
+{
+  bool sse42{ false };
+  bool popcnt{ false };
+  bool avx2{ false };
+  bool avx512{ false };
+  bool avx512_popcnt{ false };
+};
+
+inline cpu_features detect_cpu_features()
+{
+  cpu_features features;
+#if RINOX_HAS_X86_SIMD
+#if defined( _MSC_VER ) && !defined( __clang__ )
+  int info[4];
+  __cpuid( info, 0 );
+  int const max_leaf = info[0];
+  if ( max_leaf < 1 )
+    return features;
+  __cpuid( info, 1 );
+  features.sse42 = ( info[2] & ( 1 << 20 ) ) != 0;
+  features.popcnt = ( info[2] & ( 1 << 23 ) ) != 0;
+  bool const osxsave = ( info[2] & ( 1 << 27 ) ) != 0;
+  if ( max_leaf < 7 || !osxsave )
+    return features;
+  /* the OS must save the YMM ( and ZMM ) registers on context switches */
+  uint64_t const xcr0 = _xgetbv( 0 );
+  bool const os_avx = ( xcr0 & 0x6 ) == 0x6;
+  bool const os_avx512 = ( xcr0 & 0xE6 ) == 0xE6;
+  __cpuidex( info, 7, 0 );
+  features.avx2 = os_avx && ( info[1] & ( 1 << 5 ) ) != 0;
+  features.avx512 = os_avx512 && ( info[1] & ( 1 << 16 ) ) != 0;
+  features.avx512_popcnt = features.avx512 && ( info[2] & ( 1 << 14 ) ) != 0;
 #else
-  static const bool cached = [] {
-    unsigned int eax, ebx, ecx, edx;
-    unsigned int max_leaf = __get_cpuid_max( 0, nullptr );
-    if ( !max_leaf || max_leaf < 7 )
-      return false;
-    __cpuid_count( 7, 0, eax, ebx, ecx, edx );
-    return ( ebx & ( 1 << 5 ) ) != 0;
-  }();
-  return cached;
+  __builtin_cpu_init();
+  features.sse42 = __builtin_cpu_supports( "sse4.2" );
+  features.popcnt = __builtin_cpu_supports( "popcnt" );
+  features.avx2 = __builtin_cpu_supports( "avx2" );
+  features.avx512 = __builtin_cpu_supports( "avx512f" );
+  features.avx512_popcnt = features.avx512 && __builtin_cpu_supports( "avx512vpopcntdq" );
 #endif
-#else
-  return false;
 #endif
+  return features;
 }
 
-/*! Check if AVX2 is supported on this machine. */
-template<Operation Op, typename TT>
-inline bool use_avx2_cached( TT const&, uint32_t );
+inline cpu_features const& host_features()
+{
+  static cpu_features const features = detect_cpu_features();
+  return features;
+}
+
+/*! \brief Most powerful instruction set supported by the host. */
+inline simd_isa host_isa()
+{
+  auto const& features = host_features();
+  if ( features.avx512 )
+    return simd_isa::AVX512;
+  if ( features.avx2 )
+    return simd_isa::AVX2;
+  if ( features.sse42 )
+    return simd_isa::SSE42;
+  return simd_isa::SCALAR;
+}
+
+/*! \brief Instruction set requested through the environment variable `RINOX_SIMD`. */
+inline simd_isa requested_isa()
+{
+  char const* env = std::getenv( "RINOX_SIMD" );
+  if ( env == nullptr )
+    return simd_isa::AVX512;
+  if ( std::strcmp( env, "scalar" ) == 0 )
+    return simd_isa::SCALAR;
+  if ( std::strcmp( env, "sse42" ) == 0 )
+    return simd_isa::SSE42;
+  if ( std::strcmp( env, "avx2" ) == 0 )
+    return simd_isa::AVX2;
+  return simd_isa::AVX512;
+}
 
-/*! Compile-time dispatch of the vector operations. */
-#if KITTY_HAS_AVX2
 template<Operation Op>
-constexpr auto vector_operation()
+inline uint64_t scalar_word( uint64_t a, uint64_t b )
 {
   if constexpr ( Op == Operation::AND )
-    return []( __m256i a, __m256i b ) { return _mm256_and_si256( a, b ); };
+    return a & b;
   else if constexpr ( Op == Operation::OR )
-    return []( __m256i a, __m256i b ) { return _mm256_or_si256( a, b ); };
+    return a | b;
   else if constexpr ( Op == Operation::XOR )
-    return []( __m256i a, __m256i b ) { return _mm256_xor_si256( a, b ); };
-  else if constexpr ( Op == Operation::LT )
-    return []( __m256i a, __m256i b ) { return _mm256_andnot_si256( a, b ); };
+    return a ^ b;
+  else
+    return ~a & b;
+}
+
+#pragma region Scalar kernels
+template<Operation Op>
+inline void binary_scalar( uint64_t* dst, uint64_t const* src, size_t i, size_t size )
+{
+  for ( ; i < size; ++i )
+    dst[i] = scalar_word<Op>( dst[i], src[i] );
 }
+
+inline void not_scalar( uint64_t* dst, size_t i, size_t size )
+{
+  for ( ; i < size; ++i )
+    dst[i] = ~dst[i];
+}
+
+inline void fill_scalar( uint64_t* dst, uint64_t value, size_t i, size_t size )
+{
+  for ( ; i < size; ++i )
+    dst[i] = value;
+}
+
+inline uint64_t count_scalar( uint64_t const* src, size_t i, size_t size )
+{
+  uint64_t res = 0u;
+  for ( ; i < size; ++i )
+    res += std::bitset<64>( src[i] ).count();
+  return res;
+}
+
+template<Operation Op>
+inline void binary_scalar( uint64_t* dst, uint64_t const* src, size_t size )
+{
+  binary_scalar<Op>( dst, src, 0u, size );
+}
+
+inline void not_scalar( uint64_t* dst, size_t size )
+{
+  not_scalar( dst, 0u, size );
+}
+
+inline void fill_scalar( uint64_t* dst, uint64_t value, size_t size )
+{
+  fill_scalar( dst, value, 0u, size );
+}
+
+inline uint64_t count_scalar( uint64_t const* src, size_t size )
+{
+  return count_scalar( src, 0u, size );
+}
+
+/*! \brief Split a mask by a truth table and count the on-set and off-set minterms of each half.
+ *
+ * For each word, the half `mask & ~tt` is stored in `out0` and the half
+ * `mask & tt` in `out1` when `Store` is true ( `out0` can alias `mask` ).
+ * The counts are accumulated in `counts` as { on0, off0, on1, off1 }.
+ */
+template<bool Store>
+inline void split_count_scalar( uint64_t const* mask, uint64_t const* tt, uint64_t const* on, uint64_t const* off, uint64_t* out0, uint64_t* out1, size_t i, size_t size, uint64_t* counts )
+{
+  for ( ; i < size; ++i )
+  {
+    uint64_t const m1 = mask[i] & tt[i];
+    uint64_t const m0 = mask[i] & ~tt[i];
+    if constexpr ( Store )
+    {
+      out0[i] = m0;
+      out1[i] = m1;
+    }
+    counts[0] += std::bitset<64>( m0 & on[i] ).count();
+    counts[1] += std::bitset<64>( m0 & off[i] ).count();
+    counts[2] += std::bitset<64>( m1 & on[i] ).count();
+    counts[3] += std::bitset<64>( m1 & off[i] ).count();
+  }
+}
+
+template<bool Store>
+inline void split_count_scalar( uint64_t const* mask, uint64_t const* tt, uint64_t const* on, uint64_t const* off, uint64_t* out0, uint64_t* out1, size_t size, uint64_t* counts )
+{
+  split_count_scalar<Store>( mask, tt, on, off, out0, out1, 0u, size, counts );
+}
+#pragma endregion
+
+#if RINOX_HAS_X86_SIMD
+#pragma region SSE4.2 kernels
+template<Operation Op>
+RINOX_TARGET( "sse4.2" )
+inline void binary_sse42( uint64_t* dst, uint64_t const* src, size_t size )
+{
+  size_t i = 0;
+  for ( ; i + 1 < size; i += 2 )
+  {
+    __m128i a = _mm_loadu_si128( reinterpret_cast<__m128i const*>( dst + i ) );
+    __m128i const b = _mm_loadu_si128( reinterpret_cast<__m128i const*>( src + i ) );
+    if constexpr ( Op == Operation::AND )
+      a = _mm_and_si128( a, b );
+    else if constexpr ( Op == Operation::OR )
+      a = _mm_or_si128( a, b );
+    else if constexpr ( Op == Operation::XOR )
+      a = _mm_xor_si128( a, b );
+    else
+      a = _mm_andnot_si128( a, b );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i ), a );
+  }
+  binary_scalar<Op>( dst, src, i, size );
+}
+
+RINOX_TARGET( "sse4.2" )
+inline void not_sse42( uint64_t* dst, size_t size )
+{
+  __m128i const ones = _mm_set1_epi64x( -1 );
+  size_t i = 0;
+  for ( ; i + 1 < size; i += 2 )
+  {
+    __m128i const a = _mm_loadu_si128( reinterpret_cast<__m128i const*>( dst + i ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i ), _mm_xor_si128( a, ones ) );
+  }
+  not_scalar( dst, i, size );
+}
+
+RINOX_TARGET( "sse4.2" )
+inline void fill_sse42( uint64_t* dst, uint64_t value, size_t size )
+{
+  __m128i const v = _mm_set1_epi64x( static_cast<int64_t>( value ) );
+  size_t i = 0;
+  for ( ; i + 1 < size; i += 2 )
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( dst + i ), v );
+  fill_scalar( dst, value, i, size );
+}
+
+RINOX_TARGET( "popcnt" )
+inline uint64_t count_popcnt( uint64_t const* src, size_t size )
+{
+  uint64_t res = 0u;
+  for ( size_t i = 0; i < size; ++i )
+    res += static_cast<uint64_t>( _mm_popcnt_u64( src[i] ) );
+  return res;
+}
+
+template<bool Store>
+RINOX_TARGET( "popcnt" )
+inline void split_count_popcnt( uint64_t const* mask, uint64_t const* tt, uint64_t const* on, uint64_t const* off, uint64_t* out0, uint64_t* out1, size_t size, uint64_t* counts )
+{
+  for ( size_t i = 0; i < size; ++i )
+  {
+    uint64_t const m1 = mask[i] & tt[i];
+    uint64_t const m0 = mask[i] & ~tt[i];
+    if constexpr ( Store )
+    {
+      out0[i] = m0;
+      out1[i] = m1;
+    }
+    counts[0] += static_cast<uint64_t>( _mm_popcnt_u64( m0 & on[i] ) );
+    counts[1] += static_cast<uint64_t>( _mm_popcnt_u64( m0 & off[i] ) );
+    counts[2] += static_cast<uint64_t>( _mm_popcnt_u64( m1 & on[i] ) );
+    counts[3] += static_cast<uint64_t>( _mm_popcnt_u64( m1 & off[i] ) );
+  }
+}
+#pragma endregion
+
+#pragma region AVX2 kernels
+template<Operation Op>
+RINOX_TARGET( "avx2" )
+inline void binary_avx2( uint64_t* dst, uint64_t const* src, size_t size )
+{
+  size_t i = 0;
+  for ( ; i + 3 < size; i += 4 )
+  {
+    __m256i a = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( dst + i ) );
+    __m256i const b = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( src + i ) );
+    if constexpr ( Op == Operation::AND )
+      a = _mm256_and_si256( a, b );
+    else if constexpr ( Op == Operation::OR )
+      a = _mm256_or_si256( a, b );
+    else if constexpr ( Op == Operation::XOR )
+      a = _mm256_xor_si256( a, b );
+    else
+      a = _mm256_andnot_si256( a, b );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst + i ), a );
+  }
+  binary_scalar<Op>( dst, src, i, size );
+}
+
+RINOX_TARGET( "avx2" )
+inline void not_avx2( uint64_t* dst, size_t size )
+{
+  __m256i const ones = _mm256_set1_epi64x( -1 );
+  size_t i = 0;
+  for ( ; i + 3 < size; i += 4 )
+  {
+    __m256i const a = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( dst + i ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst + i ), _mm256_xor_si256( a, ones ) );
+  }
+  not_scalar( dst, i, size );
+}
+
+RINOX_TARGET( "avx2" )
+inline void fill_avx2( uint64_t* dst, uint64_t value, size_t size )
+{
+  __m256i const v = _mm256_set1_epi64x( static_cast<int64_t>( value ) );
+  size_t i = 0;
+  for ( ; i + 3 < size; i += 4 )
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( dst + i ), v );
+  fill_scalar( dst, value, i, size );
+}
+
+/*! \brief Population count of the four 64-bit words of a register, through a nibble lookup */
+RINOX_TARGET( "avx2" )
+inline __m256i popcount_avx2( __m256i v )
+{
+  __m256i const lookup = _mm256_setr_epi8( 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 );
+  __m256i const low = _mm256_set1_epi8( 0x0f );
+  __m256i const lo = _mm256_and_si256( v, low );
+  __m256i const hi = _mm256_and_si256( _mm256_srli_epi16( v, 4 ), low );
+  __m256i const bytes = _mm256_add_epi8( _mm256_shuffle_epi8( lookup, lo ), _mm256_shuffle_epi8( lookup, hi ) );
+  return _mm256_sad_epu8( bytes, _mm256_setzero_si256() );
+}
+
+RINOX_TARGET( "avx2" )
+inline uint64_t reduce_add_avx2( __m256i v )
+{
+  uint64_t lanes[4];
+  _mm256_storeu_si256( reinterpret_cast<__m256i*>( lanes ), v );
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+template<bool Store>
+RINOX_TARGET( "avx2" )
+inline void split_count_avx2( uint64_t const* mask, uint64_t const* tt, uint64_t const* on, uint64_t const* off, uint64_t* out0, uint64_t* out1, size_t size, uint64_t* counts )
+{
+  __m256i acc[4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+  size_t i = 0;
+  for ( ; i + 3 < size; i += 4 )
+  {
+    __m256i const m = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( mask + i ) );
+    __m256i const t = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( tt + i ) );
+    __m256i const fon = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( on + i ) );
+    __m256i const foff = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( off + i ) );
+    __m256i const m1 = _mm256_and_si256( m, t );
+    __m256i const m0 = _mm256_andnot_si256( t, m );
+    if constexpr ( Store )
+    {
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>( out0 + i ), m0 );
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>( out1 + i ), m1 );
+    }
+    acc[0] = _mm256_add_epi64( acc[0], popcount_avx2( _mm256_and_si256( m0, fon ) ) );
+    acc[1] = _mm256_add_epi64( acc[1], popcount_avx2( _mm256_and_si256( m0, foff ) ) );
+    acc[2] = _mm256_add_epi64( acc[2], popcount_avx2( _mm256_and_si256( m1, fon ) ) );
+    acc[3] = _mm256_add_epi64( acc[3], popcount_avx2( _mm256_and_si256( m1, foff ) ) );
+  }
+  for ( auto j = 0u; j < 4u; ++j )
+    counts[j] += reduce_add_avx2( acc[j] );
+  split_count_scalar<Store>( mask, tt, on, off, out0, out1, i, size, counts );
+}
+#pragma endregion
+
+#pragma region AVX-512 kernels
+template<Operation Op>
+RINOX_TARGET( "avx512f" )
+inline void binary_avx512( uint64_t* dst, uint64_t const* src, size_t size )
+{
+  size_t i = 0;
+  for ( ; i + 7 < size; i += 8 )
+  {
+    __m512i a = _mm512_loadu_si512( dst + i );
+    __m512i const b = _mm512_loadu_si512( src + i );
+    if constexpr ( Op == Operation::AND )
+      a = _mm512_and_si512( a, b );
+    else if constexpr ( Op == Operation::OR )
+      a = _mm512_or_si512( a, b );
+    else if constexpr ( Op == Operation::XOR )
+      a = _mm512_xor_si512( a, b );
+    else
+      a = _mm512_ternarylogic_epi64( a, b, b, 0x0C ); /* ~a & b */
+    _mm512_storeu_si512( dst + i, a );
+  }
+  binary_scalar<Op>( dst, src, i, size );
+}
+
+RINOX_TARGET( "avx512f" )
+inline void not_avx512( uint64_t* dst, size_t size )
+{
+  __m512i const ones = _mm512_set1_epi64( -1 );
+  size_t i = 0;
+  for ( ; i + 7 < size; i += 8 )
+    _mm512_storeu_si512( dst + i, _mm512_xor_si512( _mm512_loadu_si512( dst + i ), ones ) );
+  not_scalar( dst, i, size );
+}
+
+RINOX_TARGET( "avx512f" )
+inline void fill_avx512( uint64_t* dst, uint64_t value, size_t size )
+{
+  __m512i const v = _mm512_set1_epi64( static_cast<int64_t>( value ) );
+  size_t i = 0;
+  for ( ; i + 7 < size; i += 8 )
+    _mm512_storeu_si512( dst + i, v );
+  fill_scalar( dst, value, i, size );
+}
+
+RINOX_TARGET( "avx512f,avx512vpopcntdq,popcnt" )
+inline uint64_t count_avx512( uint64_t const* src, size_t size )
+{
+  __m512i acc = _mm512_setzero_si512();
+  size_t i = 0;
+  for ( ; i + 7 < size; i += 8 )
+    acc = _mm512_add_epi64( acc, _mm512_popcnt_epi64( _mm512_loadu_si512( src + i ) ) );
+  uint64_t lanes[8];
+  _mm512_storeu_si512( lanes, acc );
+  uint64_t res = std::accumulate( lanes, lanes + 8, uint64_t( 0 ) );
+  for ( ; i < size; ++i )
+    res += static_cast<uint64_t>( _mm_popcnt_u64( src[i] ) );
+  return res;
+}
+
+template<bool Store>
+RINOX_TARGET( "avx512f,avx512vpopcntdq" )
+inline void split_count_avx512( uint64_t const* mask, uint64_t const* tt, uint64_t const* on, uint64_t const* off, uint64_t* out0, uint64_t* out1, size_t size, uint64_t* counts )
+{
+  __m512i acc[4] = { _mm512_setzero_si512(), _mm512_setzero_si512(), _mm512_setzero_si512(), _mm512_setzero_si512() };
+  size_t i = 0;
+  for ( ; i + 7 < size; i += 8 )
+  {
+    __m512i const m = _mm512_loadu_si512( mask + i );
+    __m512i const t = _mm512_loadu_si512( tt + i );
+    __m512i const fon = _mm512_loadu_si512( on + i );
+    __m512i const foff = _mm512_loadu_si512( off + i );
+    __m512i const m1 = _mm512_and_si512( m, t );
+    __m512i const m0 = _mm512_ternarylogic_epi64( t, m, m, 0x0C ); /* ~t & m */
+    if constexpr ( Store )
+    {
+      _mm512_storeu_si512( out0 + i, m0 );
+      _mm512_storeu_si512( out1 + i, m1 );
+    }
+    acc[0] = _mm512_add_epi64( acc[0], _mm512_popcnt_epi64( _mm512_and_si512( m0, fon ) ) );
+    acc[1] = _mm512_add_epi64( acc[1], _mm512_popcnt_epi64( _mm512_and_si512( m0, foff ) ) );
+    acc[2] = _mm512_add_epi64( acc[2], _mm512_popcnt_epi64( _mm512_and_si512( m1, fon ) ) );
+    acc[3] = _mm512_add_epi64( acc[3], _mm512_popcnt_epi64( _mm512_and_si512( m1, foff ) ) );
+  }
+  for ( auto j = 0u; j < 4u; ++j )
+  {
+    uint64_t lanes[8];
+    _mm512_storeu_si512( lanes, acc[j] );
+    counts[j] += std::accumulate( lanes, lanes + 8, uint64_t( 0 ) );
+  }
+  split_count_scalar<Store>( mask, tt, on, off, out0, out1, i, size, counts );
+}
+#pragma endregion
 #endif
 
-/*! Compile-time dispatch of the scalar operations. */
-template<Operation Op, typename T>
-constexpr auto scalar_operation()
+/*! \brief Table of the kernels compiled for one instruction set. */
+struct simd_kernels
 {
-  if constexpr ( Op == Operation::AND )
-    return std::bit_and<T>{};
-  else if constexpr ( Op == Operation::OR )
-    return std::bit_or<T>{};
-  else if constexpr ( Op == Operation::XOR )
-    return std::bit_xor<T>{};
-  else if constexpr ( Op == Operation::LT )
-    return []( T a, T b ) { return ~a & b; };
+  using binary_fn = void ( * )( uint64_t*, uint64_t const*, size_t );
+  using not_fn = void ( * )( uint64_t*, size_t );
+  using fill_fn = void ( * )( uint64_t*, uint64_t, size_t );
+  using count_fn = uint64_t ( * )( uint64_t const*, size_t );
+  using split_count_fn = void ( * )( uint64_t const*, uint64_t const*, uint64_t const*, uint64_t const*, uint64_t*, uint64_t*, size_t, uint64_t* );
+
+  simd_isa isa;
+  /*! \brief In-place binary operations, indexed by `Operation::AND` to `Operation::LT` */
+  binary_fn binary[4];
+  not_fn unary_not;
+  fill_fn fill;
+  count_fn count_ones;
+  /*! \brief Fused split and count, indexed by whether the halves are stored */
+  split_count_fn split_count[2];
+};
+
+/*! \brief Kernels for the given instruction set, or for the best one below it supported by the host. */
+inline simd_kernels make_simd_kernels( simd_isa isa )
+{
+  isa = std::min( isa, host_isa() );
+  simd_kernels k{ simd_isa::SCALAR,
+                  { binary_scalar<Operation::AND>, binary_scalar<Operation::OR>, binary_scalar<Operation::XOR>, binary_scalar<Operation::LT> },
+                  not_scalar,
+                  fill_scalar,
+                  count_scalar,
+                  { split_count_scalar<false>, split_count_scalar<true> } };
+#if RINOX_HAS_X86_SIMD
+  auto const& features = host_features();
+  if ( features.popcnt )
+    k.count_ones = count_popcnt;
+  switch ( isa )
+  {
+  case simd_isa::AVX512:
+    k = { simd_isa::AVX512,
+          { binary_avx512<Operation::AND>, binary_avx512<Operation::OR>, binary_avx512<Operation::XOR>, binary_avx512<Operation::LT> },
+          not_avx512,
+          fill_avx512,
+          k.count_ones,
+          { split_count_scalar<false>, split_count_scalar<true> } };
+    if ( features.avx512_popcnt )
+      k.count_ones = count_avx512;
+    break;
+  case simd_isa::AVX2:
+    k = { simd_isa::AVX2,
+          { binary_avx2<Operation::AND>, binary_avx2<Operation::OR>, binary_avx2<Operation::XOR>, binary_avx2<Operation::LT> },
+          not_avx2,
+          fill_avx2,
+          k.count_ones,
+          { split_count_scalar<false>, split_count_scalar<true> } };
+    break;
+  case simd_isa::SSE42:
+    k = { simd_isa::SSE42,
+          { binary_sse42<Operation::AND>, binary_sse42<Operation::OR>, binary_sse42<Operation::XOR>, binary_sse42<Operation::LT> },
+          not_sse42,
+          fill_sse42,
+          k.count_ones,
+          { split_count_scalar<false>, split_count_scalar<true> } };
+    break;
+  default:
+    break;
+  }
+
+  if ( k.isa == simd_isa::AVX512 && features.avx512_popcnt )
+  {
+    k.split_count[0] = split_count_avx512<false>;
+    k.split_count[1] = split_count_avx512<true>;
+  }
+  else if ( k.isa >= simd_isa::AVX2 )
+  {
+    k.split_count[0] = split_count_avx2<false>;
+    k.split_count[1] = split_count_avx2<true>;
+  }
+  else if ( k.isa == simd_isa::SSE42 && features.popcnt )
+  {
+    k.split_count[0] = split_count_popcnt<false>;
+    k.split_count[1] = split_count_popcnt<true>;
+  }
+#endif
+  return k;
+}
+
+/*! \brief Kernels in use, selected at the first call. */
+inline simd_kernels& active_simd_kernels()
+{
+  static simd_kernels kernels = make_simd_kernels( requested_isa() );
+  return kernels;
+}
+
+} // namespace detail
+
+/*! \brief Instruction set of the kernels in use. */
+inline simd_isa get_simd_isa()
+{
+  return detail::active_simd_kernels().isa;
+}
+
+/*! \brief Select the kernels of an instruction set.
+ *
+ * Instruction sets not supported by the host fall back to the best supported
+ * one below them. Not thread-safe: to be called before running the kernels.
+ *
+ * \return The instruction set actually selected.
+ */
+inline simd_isa set_simd_isa( simd_isa isa )
+{
+  detail::active_simd_kernels() = detail::make_simd_kernels( isa );
+  return get_simd_isa();
+}
+
+/*! Check if vectorized kernels are in use on this machine. */
+inline bool has_simd_cached()
+{
+  return get_simd_isa() != simd_isa::SCALAR;
+}
+
+/*! Check if AVX2 is supported on this machine. */
+inline bool has_avx2_cached()
+{
+  return detail::host_features().avx2;
 }
 
+/*! Check if it is convenient to use the vectorized kernels. */
+template<Operation Op, typename TT>
+inline bool use_avx2_cached( TT const&, uint32_t );
+
 /*! \brief Universal function for vectorized operations between two truth tables.
  *
- * Computes the bitwise operation \f$tt_a Op tt_b\f$ using 256-bit AVX2 registers.
- * Each register processes four 64-bit words in parallel, enabling efficient
- * parallel computation across the truth tables. When the number of bits is not
- * a multiple of four, the function fallsback to the scalar version on the tailing
- * words.
+ * Computes the bitwise operation \f$tt_a Op tt_b\f$ with the kernels of the
+ * instruction set selected at startup. The scalar version is used when the
+ * benchmarking of `use_avx2_cached` found no advantage for this truth table.
  *
  * \tparam Op Binary operation.
  * \tparam TT Truth table type.
@@ -163,30 +692,14 @@ inline TT binary_operation( const TT& tta, const TT& ttb )
   assert( tta.num_blocks() == ttb.num_blocks() );
 
   TT result = tta;
-  auto& datar = result._bits;
-  const auto& data2 = ttb._bits;
-  using T = typename std::decay_t<decltype( datar[0] )>;
+  uint64_t* datar = result._bits.data();
+  uint64_t const* data2 = ttb._bits.data();
+  size_t const size = tta.num_blocks();
 
-  size_t i = 0;
-#if KITTY_HAS_AVX2
-  size_t size = tta.num_blocks();
-  if ( has_avx2_cached() && size >= 4 && ( !UseCache || use_avx2_cached<Op, TT>( tta, tta.num_vars() ) ) )
-  {
-    auto binary_op = vector_operation<Op>();
-    for ( ; i + 3 < size; i += 4 )
-    {
-      __m256i vr = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( &datar[i] ) );
-      __m256i v2 = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( &data2[i] ) );
-      vr = binary_op( vr, v2 );
-      _mm256_storeu_si256( reinterpret_cast<__m256i*>( &datar[i] ), vr );
-    }
-  }
-#endif
-  /* Fallback to the scalar version for the remaining words. */
-  auto scalar_op = scalar_operation<Op, T>();
-  assert( datar.size() == data2.size() );
-  assert( datar.size() >= i );
-  std::transform( datar.cbegin() + i, datar.cend(), data2.cbegin() + i, datar.begin() + i, scalar_op );
+  if ( has_simd_cached() && size >= 2 && ( !UseCache || use_avx2_cached<Op, TT>( tta, tta.num_vars() ) ) )
+    detail::active_simd_kernels().binary[static_cast<uint32_t>( Op )]( datar, data2, size );
+  else
+    detail::binary_scalar<Op>( datar, data2, size );
 
   result.mask_bits();
   return result;
@@ -194,9 +707,8 @@ inline TT binary_operation( const TT& tta, const TT& ttb )
 
 /*! \brief Perform a vectorized bitwise AND between two truth tables.
  *
- * Computes the bitwise AND \f$tt_a \land tt_b\f$ using 256-bit AVX2 registers.
- * Each register processes four 64-bit words in parallel, enabling efficient
- * parallel computation across the truth tables.
+ * Computes the bitwise AND \f$tt_a \land tt_b\f$ with the kernels of the
+ * instruction set selected at startup.
  *
  * \tparam TT Truth table type.
  * \param tta First truth table.
@@ -211,9 +723,8 @@ inline TT binary_and( const TT& tta, const TT& ttb )
 
 /*! \brief Perform a vectorized bitwise OR between two truth tables.
  *
- * Computes the bitwise OR \f$tt_a \lor tt_b\f$ using 256-bit AVX2 registers.
- * Each register processes four 64-bit words in parallel, enabling efficient
- * parallel computation across the truth tables.
+ * Computes the bitwise OR \f$tt_a \lor tt_b\f$ with the kernels of the
+ * instruction set selected at startup.
  *
  * \tparam TT Truth table type.
  * \param tta First truth table.
@@ -228,9 +739,8 @@ inline TT binary_or( const TT& tta, const TT& ttb )
 
 /*! \brief Perform a vectorized bitwise XOR between two truth tables.
  *
- * Computes the bitwise XOR \f$tt_a \lxor tt_b\f$ using 256-bit AVX2 registers.
- * Each register processes four 64-bit words in parallel, enabling efficient
- * parallel computation across the truth tables.
+ * Computes the bitwise XOR \f$tt_a \lxor tt_b\f$ with the kernels of the
+ * instruction set selected at startup.
  *
  * \tparam TT Truth table type.
  * \param tta First truth table.
@@ -245,9 +755,8 @@ inline TT binary_xor( const TT& tta, const TT& ttb )
 
 /*! \brief Perform a vectorized bitwise LT ( Lower Than ) between two truth tables.
  *
- * Computes the bitwise LT \f$ ~tt_a \land tt_b\f$ using 256-bit AVX2 registers.
- * Each register processes four 64-bit words in parallel, enabling efficient
- * parallel computation across the truth tables.
+ * Computes the bitwise LT \f$ ~tt_a \land tt_b\f$ with the kernels of the
+ * instruction set selected at startup.
  *
  * \tparam TT Truth table type.
  * \param tta First truth table.
@@ -262,9 +771,8 @@ inline TT binary_lt( const TT& tta, const TT& ttb )
 
 /*! \brief Perform a vectorized inversion of a truth tables.
  *
- * Computes the inverse \f$ ~tt \f$ using 256-bit AVX2 registers.
- * Each register processes four 64-bit words in parallel, enabling efficient
- * parallel inversion across the truth tables.
+ * Computes the inverse \f$ ~tt \f$ with the kernels of the
+ * instruction set selected at startup.
  *
  * \tparam TT Truth table type.
  * \param tt Truth table.
@@ -274,23 +782,13 @@ template<typename TT, bool UseCache = true>
 inline TT unary_not( const TT& tt )
 {
   TT result = tt;
-  size_t size = tt.num_blocks();
-  auto& data = result._bits;
+  uint64_t* data = result._bits.data();
+  size_t const size = tt.num_blocks();
 
-  size_t i = 0;
-#if KITTY_HAS_AVX2
-  if ( has_avx2_cached() && ( !UseCache || use_avx2_cached<Operation::NOT, TT>( tt, tt.num_vars() ) ) )
-  {
-    const __m256i all_ones = _mm256_set1_epi64x( -1 );
-    for ( ; i + 3 < size; i += 4 )
-    {
-      __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( &data[i] ) );
-      v = _mm256_xor_si256( v, all_ones );
-      _mm256_storeu_si256( reinterpret_cast<__m256i*>( &data[i] ), v );
-    }
-  }
-#endif
-  std::transform( data.cbegin() + i, data.cend(), result.begin() + i, std::bit_not<>() );
+  if ( has_simd_cached() && size >= 2 && ( !UseCache || use_avx2_cached<Operation::NOT, TT>( tt, tt.num_vars() ) ) )
+    detail::active_simd_kernels().unary_not( data, size );
+  else
+    detail::not_scalar( data, size );
 
   result.mask_bits();
   return result;
@@ -298,9 +796,8 @@ inline TT unary_not( const TT& tt )
 
 /*! \brief Vectorized set of a truth-table to a constant value.
  *
- * Assign the bits of a truth table to a constant using 256-bit AVX2 registers.
- * Each register processes four 64-bit words in parallel, enabling efficient
- * parallel assignment across the truth tables.
+ * Assign the bits of a truth table to a constant with the kernels of the
+ * instruction set selected at startup.
  *
  * \tparam TT Truth table type.
  * \tparam Const Constant value to be assigned ( 0 for contradiction, anything for tautology ).
@@ -309,51 +806,76 @@ inline TT unary_not( const TT& tt )
 template<typename TT, Operation Op, bool UseCache = true>
 inline void set_const( TT& tt )
 {
-  size_t size = tt.num_blocks();
-  auto& data = tt._bits;
+  uint64_t* data = tt._bits.data();
+  size_t const size = tt.num_blocks();
+  uint64_t const v = ( Op == Operation::CONST0 ) ? 0u : ~uint64_t( 0 );
 
-  size_t i = 0;
-#if KITTY_HAS_AVX2
+  if ( has_simd_cached() && size >= 2 && ( !UseCache || use_avx2_cached<Op, TT>( tt, tt.num_vars() ) ) )
+    detail::active_simd_kernels().fill( data, v, size );
+  else
+    detail::fill_scalar( data, v, size );
+}
 
-  if ( has_avx2_cached() && ( !UseCache || use_avx2_cached<Op, TT>( tt, tt.num_vars() ) ) )
-  {
-    __m256i v;
-    if constexpr ( Op == Operation::CONST0 )
-    {
-      v = _mm256_setzero_si256();
-    }
-    else
-    {
-      v = _mm256_set1_epi64x( -1 );
-    }
+/*! \brief Vectorized count of the ones of a truth table.
+ *
+ * Uses the AVX-512 population count when the host supports it, and the
+ * scalar POPCNT instruction otherwise.
+ *
+ * \tparam TT Truth table type.
+ * \param tt Truth table.
+ * \return The number of bits set to 1.
+ */
+template<typename TT>
+inline uint64_t count_ones( const TT& tt )
+{
+  return detail::active_simd_kernels().count_ones( tt._bits.data(), tt.num_blocks() );
+}
 
-    for ( ; i + 3 < size; i += 4 )
-    {
-      _mm256_storeu_si256( reinterpret_cast<__m256i*>( &data[i] ), v );
-    }
-  }
-#endif
-  uint64_t v;
+/*! \brief Number of on-set and off-set minterms in the two halves of a split mask. */
+struct split_counts
+{
+  uint64_t on0{ 0 };
+  uint64_t off0{ 0 };
+  uint64_t on1{ 0 };
+  uint64_t off1{ 0 };
+};
 
-  if constexpr ( Op == Operation::CONST0 )
-  {
-    v = 0;
-  }
-  else
-  {
-    v = (uint64_t)( -1 );
-  }
+/*! \brief Split a mask by a truth table, and count the minterms of the halves in one pass.
+ *
+ * The mask is replaced by \f$ mask \land \lnot tt \f$ and `mask1` is assigned
+ * \f$ mask \land tt \f$. The on-set and off-set minterms of each half are
+ * counted while splitting, avoiding separate passes for the AND, the NOT and
+ * the population counts.
+ *
+ * \tparam TT Truth table type.
+ * \param mask Mask to split, overwritten with the negative half.
+ * \param mask1 Positive half of the mask.
+ * \param tt Truth table splitting the mask.
+ * \param onset On-set of the function.
+ * \param offset Off-set of the function.
+ */
+template<typename TT>
+inline split_counts split_and_count( TT& mask, TT& mask1, TT const& tt, TT const& onset, TT const& offset )
+{
+  uint64_t counts[4] = { 0u, 0u, 0u, 0u };
+  uint64_t* data = &*mask.begin();
+  detail::active_simd_kernels().split_count[1]( data, &*tt.cbegin(), &*onset.cbegin(), &*offset.cbegin(), data, &*mask1.begin(), mask.num_blocks(), counts );
+  return { counts[0], counts[1], counts[2], counts[3] };
+}
 
-  // Handle remaining elements
-  if ( tt.num_blocks() > i )
-    std::fill( data.begin() + i, data.end(), v );
+/*! \brief Count the minterms of the halves of a mask split by a truth table, without storing them. */
+template<typename TT>
+inline split_counts count_split( TT const& mask, TT const& tt, TT const& onset, TT const& offset )
+{
+  uint64_t counts[4] = { 0u, 0u, 0u, 0u };
+  detail::active_simd_kernels().split_count[0]( &*mask.cbegin(), &*tt.cbegin(), &*onset.cbegin(), &*offset.cbegin(), nullptr, nullptr, mask.num_blocks(), counts );
+  return { counts[0], counts[1], counts[2], counts[3] };
 }
 
 /*! \brief Reset all the bits of a truth table to 0 through vectorization.
  *
- * Set all the bits of a truth table to 0 using 256-bit AVX2 registers.
- * Each register processes four 64-bit words in parallel, enabling efficiently
- * setting the truth table to the desird value.
+ * Set all the bits of a truth table to 0 with the kernels of the
+ * instruction set selected at startup.
  *
  * \tparam TT Truth table type.
  * \param tt Truth table.
@@ -366,9 +888,8 @@ inline void set_zero( TT& tt )
 
 /*! \brief Reset all the bits of a truth table to 1 through vectorization.
  *
- * Set all the bits of a truth table to 1 using 256-bit AVX2 registers.
- * Each register processes four 64-bit words in parallel, enabling efficiently
- * setting the truth table to the desird value.
+ * Set all the bits of a truth table to 1 with the kernels of the
+ * instruction set selected at startup.
  *
  * \tparam TT truth table type.
  * \param tt Truth table.
@@ -403,13 +924,10 @@ public:
 
       time_diff += ( time_simd - time_sisd ) / time_sisd / static_cast<double>( num_cases );
     }
-#if KITTY_HAS_AVX2
-    bool const has_avx2 = has_avx2_cached();
-    if ( has_avx2 )
+    if ( has_simd_cached() )
     {
       return time_diff < -eps;
     }
-#endif
     return false;
   }
 
@@ -429,13 +947,10 @@ public:
 
       time_diff += ( time_simd - time_sisd ) / time_sisd / static_cast<double>( num_cases );
     }
-#if KITTY_HAS_AVX2
-    bool const has_avx2 = has_avx2_cached();
-    if ( has_avx2 )
+    if ( has_simd_cached() )
     {
       return time_diff < -eps;
     }
-#endif
     return false;
   }
 
@@ -456,13 +971,10 @@ public:
 
       time_diff += ( time_simd - time_sisd ) / time_sisd / static_cast<double>( num_cases );
     }
-#if KITTY_HAS_AVX2
-    bool const has_avx2 = has_avx2_cached();
-    if ( has_avx2 )
+    if ( has_simd_cached() )
     {
       return time_diff < -eps;
     }
-#endif
     return false;
   }
 
@@ -502,12 +1014,17 @@ public:
 template<Operation Op, typename TT, typename FnSisd, typename FnSimd>
 inline bool use_avx2_cached( TT const& tt, FnSisd fn_sisd, FnSimd fn_simd, uint32_t num_vars )
 {
-  static std::unordered_map<int, bool> cache;
+  /* the outcome depends on the kernels in use, which can be changed with `set_simd_isa` */
+  static std::unordered_map<uint64_t, bool> cache;
   static std::mutex mutex;
 
+  if ( !has_simd_cached() )
+    return false;
+  uint64_t const key = ( static_cast<uint64_t>( get_simd_isa() ) << 32u ) | num_vars;
+
   {
     std::lock_guard<std::mutex> lock( mutex );
-    auto it = cache.find( num_vars );
+    auto it = cache.find( key );
     if ( it != cache.end() )
     {
       return it->second;
@@ -542,7 +1059,7 @@ inline bool use_avx2_cached( TT const& tt, FnSisd fn_sisd, FnSimd fn_simd, uint3
 
   {
     std::lock_guard<std::mutex> lock( mutex );
-    cache[num_vars] = result;
+    cache[key] = result;
   }
 
   return result;
@@ -632,10 +1149,10 @@ inline bool use_avx2_cached( TT const& tt, uint32_t num_vars )
 
 /*! \brief Test and caches if it is better to use the scalar or the vector version.
  *
- * Each operation is tested once for the specified truth table type and for the
- * specified number of variables. The benchmarking determines if the vectorized ( AVX2 )
- * implementation should be preferred for this machin, truth table size, and truth table
- * type.
+ * Each operation is tested once for the specified truth table type, number of
+ * variables and instruction set of the kernels in use. The benchmarking
+ * determines if the vectorized implementation should be preferred for this
+ * machine, truth table size, and truth table type.
  *
  * \tparam TT Truth table type.
  * \param tt Reference truth table needed for construction purposes.
@@ -688,6 +1205,13 @@ inline kitty::static_truth_table<NumVars> binary_lt( const kitty::static_truth_t
   return ~tta & ttb;
 }
 
+/*! Fallback to the default count of the ones for small static truth tables. */
+template<uint32_t NumVars>
+inline uint64_t count_ones( const kitty::static_truth_table<NumVars, true>& tt )
+{
+  return kitty::count_ones( tt );
+}
+
 /*! Implementation set to constant 1 for small static truth tables. */
 template<uint32_t NumVars>
 inline void set_ones( kitty::static_truth_table<NumVars, true>& tt )
@@ -91,30 +91,10 @@ public:
       }
       else
       {
-        masks_[num_masks_ + iMask] = boolean::binary_and( masks_[iMask], tt );
-        masks_[iMask] &= boolean::unary_not( tt );
-
-        if ( is_killed( num_masks_ + iMask ) )
-        {
-          kills_[num_masks_ + iMask] = true;
-          num_kills_++;
-        }
-        else
-        {
-          kills_[num_masks_ + iMask] = false;
-          num_edges_ += count_edges( num_masks_ + iMask );
-        }
-
-        if ( is_killed( iMask ) )
-        {
-          kills_[iMask] = true;
-          num_kills_++;
-        }
-        else
-        {
-          kills_[iMask] = false;
-          num_edges_ += count_edges( iMask );
-        }
+        /* split the mask and count the remaining pairs in a single pass */
+        auto const counts = boolean::split_and_count( masks_[iMask], masks_[num_masks_ + iMask], tt, func_[1], func_[0] );
+        assign_counts( num_masks_ + iMask, counts.on1, counts.off1 );
+        assign_counts( iMask, counts.on0, counts.off0 );
       }
     }
     num_masks_ = num_masks_ << 1u;
@@ -124,14 +104,12 @@ public:
   uint32_t evaluate( Tt_t const& tt ) const
   {
     uint32_t res = 0;
-    for ( auto iMask{ 0 }; iMask < num_masks_; ++iMask )
+    for ( auto iMask{ 0u }; iMask < num_masks_; ++iMask )
     {
       if ( !kills_[iMask] )
       {
-        Tt_t const mask1 = boolean::binary_and( masks_[iMask], tt );
-        Tt_t const mask0 = boolean::binary_and( masks_[iMask], boolean::unary_not( tt ) );
-        res += kitty::count_ones( boolean::binary_and( func_[1], mask0 ) ) * kitty::count_ones( boolean::binary_and( func_[0], mask0 ) );
-        res += kitty::count_ones( boolean::binary_and( func_[1], mask1 ) ) * kitty::count_ones( boolean::binary_and( func_[0], mask1 ) );
+        auto const counts = boolean::count_split( masks_[iMask], tt, func_[1], func_[0] );
+        res += static_cast<uint32_t>( counts.on0 * counts.off0 + counts.on1 * counts.off1 );
       }
     }
     return res;
@@ -157,11 +135,10 @@ public:
     return num_masks_;
   }
 
+  /*! \brief True if the mask contains only on-set or only off-set minterms */
   bool is_killed( uint32_t i ) const
   {
-    bool const only_onset = ( kitty::count_ones( boolean::binary_and( masks_[i], func_[1] ) ) == 0 );
-    bool const only_ofset = ( kitty::count_ones( boolean::binary_and( masks_[i], func_[0] ) ) == 0 );
-    return only_onset || only_ofset;
+    return kills_[i];
   }
 
   kitty::ternary_truth_table<Tt_t> get_function( std::vector<uint8_t> indices, std::vector<char> polarities )
@@ -183,6 +160,16 @@ public:
   }
 
 private:
+  void assign_counts( uint32_t i, uint64_t num_onset, uint64_t num_ofset )
+  {
+    bool const is_killed = ( num_onset == 0 ) || ( num_ofset == 0 );
+    kills_[i] = is_killed;
+    if ( is_killed )
+      num_kills_++;
+    else
+      num_edges_ += static_cast<uint32_t>( num_onset * num_ofset );
+  }
+
   uint32_t count_edges( uint32_t i ) const
   {
     Tt_t const onset = boolean::binary_and( masks_[i], func_[1] );
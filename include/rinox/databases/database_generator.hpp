@@ -24,8 +24,8 @@
  */
 
 /*!
-  \file mapped_database.hpp
-  \brief Manager for databases of mapped networks
+  \file database_generator.hpp
+  \brief Generation of databases of mapped networks
 
   \author Andrea Costamagna
 */
@@ -34,13 +34,27 @@
 #include "../boolean/boolean.hpp"
 #include "../evaluation/chains.hpp"
 #include "../network/network.hpp"
+#include "mapped_database.hpp"
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
 #include <mockturtle/algorithms/emap.hpp>
 #include <mockturtle/algorithms/klut_to_graph.hpp>
 #include <mockturtle/algorithms/rewrite.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
 #include <mockturtle/io/genlib_reader.hpp>
 #include <mockturtle/networks/block.hpp>
 #include <mockturtle/views/cell_view.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <fmt/format.h>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
 namespace rinox
 {
 
@@ -55,9 +69,34 @@ struct database_gen_params
   bool verbose = false;
   std::string metric = "area";
   std::string output_file = "";
+
+  /*! \brief AIGER benchmark whose cuts provide the classes with more than 4 variables */
+  std::string cuts_file = "";
+
+  /*! \brief Maximum number of cuts per node when harvesting the classes */
+  uint32_t cut_limit = 12u;
+
+  /*! \brief Number of shards in which the classes are partitioned */
+  uint32_t num_shards = 1u;
+
+  /*! \brief Shard to build, or all the shards if negative */
+  int32_t shard = -1;
+
+  /*! \brief Number of threads building the shards */
+  uint32_t num_threads = 1u;
 };
 
 /*! \brief Engine to initialize the database with simple structures
+ *
+ * The database is built from a representative of each P-class. For up to 4
+ * variables, the classes are enumerated exhaustively. For 5 and 6 variables,
+ * they are harvested from the cuts of a benchmark.
+ *
+ * The classes are sorted and partitioned in shards, and each shard is
+ * preprocessed and mapped independently, possibly in parallel or on different
+ * machines. The shards are then merged in order, pruning the dominated
+ * entries. Since each class is mapped on its own, the database does not
+ * depend on the number of threads or of shards.
  *
  * \tparam DesignType CELL_BASED or ARRAY_BASED.
  * \tparam MaxNumVars Maximum number of input variables. Works best for 6 or lower
@@ -88,15 +127,41 @@ public:
   database_generator( std::vector<mockturtle::gate> const& gates )
       : library_( gates ), gates_( gates ), db_( library_ )
   {
-    init();
   }
 
-  void run( database_gen_params ps )
+  /*! \brief Generate the database for the given parameters
+   *
+   * Returns false if the parameters are invalid or the classes cannot be
+   * loaded, in which case the database is left empty.
+   */
+  bool run( database_gen_params ps )
   {
-    if ( ps.method == "mapp" )
+    if ( ps.method != "mapp" )
+    {
+      std::cerr << "[e] unknown generation method " << ps.method << std::endl;
+      return false;
+    }
+    if ( ps.metric != "area" && ps.metric != "delay" && ps.metric != "power" )
+    {
+      std::cerr << "[e] unknown generation metric " << ps.metric << std::endl;
+      return false;
+    }
+    if ( ps.shard >= 0 && static_cast<uint32_t>( ps.shard ) >= std::max( 1u, ps.num_shards ) )
+    {
+      std::cerr << fmt::format( "[e] shard {} out of {} shards\n", ps.shard, std::max( 1u, ps.num_shards ) );
+      return false;
+    }
+    if ( ps.metric == "area" && ps.num_vars == 4u && ps.num_shards <= 1u && ps.num_threads <= 1u )
     {
       area_oriented_generation( ps.output_file );
+      return true;
     }
+
+    auto const classes = load_classes( ps );
+    if ( !classes )
+      return false;
+    sharded_generation( *classes, ps );
+    return true;
   }
 
   database_t extract_db()
@@ -106,37 +171,146 @@ public:
 
   void area_oriented_generation( std::string const& output_file )
   {
+    if ( aig_.num_pos() == 0u )
+      init();
+
     // Preprocess the AIG
-    aig_preprocessing();
+    aig_preprocessing( aig_ );
 
     // Perform technology mapping
-    auto mapped = map_to_block_network();
+    auto mapped = map_to_block_network( aig_, true );
 
     // Create a database from the mapped network
     create_database_from_mapped( mapped, output_file + ".v" );
   }
 
+  /*! \brief Representatives of the P-classes for the generation parameters
+   *
+   * The classes are sorted, so that the shards do not depend on the machine
+   * on which they are built.
+   */
+  std::optional<std::vector<Tt_t>> load_classes( database_gen_params const& ps ) const
+  {
+    if ( ps.num_vars > MaxNumVars )
+    {
+      std::cerr << fmt::format( "[e] the database supports up to {} variables\n", MaxNumVars );
+      return std::nullopt;
+    }
+
+    if ( !ps.cuts_file.empty() )
+    {
+      mockturtle::aig_network aig;
+      if ( lorina::read_aiger( ps.cuts_file, mockturtle::aiger_reader( aig ) ) != lorina::return_code::success )
+      {
+        std::cerr << "[e] cannot read " << ps.cuts_file << std::endl;
+        return std::nullopt;
+      }
+      return load_classes( aig, ps );
+    }
+    if ( ps.num_vars > 4u )
+    {
+      std::cerr << "[e] the classes with more than 4 variables are harvested from a benchmark" << std::endl;
+      return std::nullopt;
+    }
+    return sort_classes( load_p_representatives( ps.num_vars ) );
+  }
+
+  /*! \brief Representatives of the P-classes of the cut functions of a benchmark, sorted */
+  std::optional<std::vector<Tt_t>> load_classes( mockturtle::aig_network const& aig, database_gen_params const& ps ) const
+  {
+    if ( ps.num_vars > MaxNumVars )
+    {
+      std::cerr << fmt::format( "[e] the database supports up to {} variables\n", MaxNumVars );
+      return std::nullopt;
+    }
+    return sort_classes( harvest_p_representatives( aig, ps.num_vars, ps.cut_limit ) );
+  }
+
+  /*! \brief Build the shards with a pool of threads and merge them in the database
+   *
+   * Shard `s` contains the classes whose index is congruent to `s` modulo the
+   * number of shards. If `ps.shard` is non-negative, only that shard is built.
+   * If an output file is given, each shard is saved as `<output>.shard<s>.rdb`.
+   */
+  void sharded_generation( std::vector<Tt_t> const& classes, database_gen_params const& ps )
+  {
+    uint32_t const num_shards = std::max( 1u, ps.num_shards );
+    std::vector<uint32_t> to_build;
+    for ( auto s = 0u; s < num_shards; ++s )
+    {
+      if ( ps.shard < 0 || static_cast<uint32_t>( ps.shard ) == s )
+        to_build.push_back( s );
+    }
+
+    std::vector<std::optional<database_t>> shards( to_build.size() );
+    std::atomic<uint32_t> next{ 0u };
+    auto const worker = [&]() {
+      for ( auto i = next++; i < to_build.size(); i = next++ )
+      {
+        shards[i].emplace( build_shard( classes, to_build[i], num_shards, ps ) );
+        if ( !ps.output_file.empty() )
+          shards[i]->commit_binary( shard_file( ps.output_file, to_build[i] ) );
+      }
+    };
+
+    std::vector<std::thread> threads;
+    uint32_t const num_workers = std::min<uint32_t>( std::max( 1u, ps.num_threads ), static_cast<uint32_t>( to_build.size() ) );
+    for ( auto t = 1u; t < num_workers; ++t )
+      threads.emplace_back( worker );
+    worker();
+    for ( auto& thread : threads )
+      thread.join();
+
+    for ( auto& shard : shards )
+      db_.merge( *shard );
+  }
+
+  /*! \brief Merge shards saved in binary format, in the given order */
+  bool merge_shards( std::vector<std::string> const& files )
+  {
+    for ( auto const& file : files )
+    {
+      database_t shard( library_ );
+      if ( !shard.load_binary( file ) )
+        return false;
+      db_.merge( shard );
+    }
+    return true;
+  }
+
+  static std::string shard_file( std::string const& output_file, uint32_t shard )
+  {
+    return fmt::format( "{}.shard{}.rdb", output_file, shard );
+  }
+
 private:
   void init()
   {
     // Store a representative for each P class
-    auto const classes = load_p_representatives();
+    auto const classes = load_p_representatives( 4u );
 
     // Collect the classes into a single kLUT network
-    auto const klut = classes_to_klut( classes );
+    auto const klut = classes_to_klut( classes, 4u );
 
     // Transform the kLUT network into an AIG
     aig_ = mockturtle::convert_klut_to_graph<mockturtle::aig_network, mockturtle::klut_network>( klut );
   }
 
+  static std::vector<Tt_t> sort_classes( tt_set const& classes )
+  {
+    std::vector<Tt_t> sorted( classes.begin(), classes.end() );
+    std::sort( sorted.begin(), sorted.end() );
+    return sorted;
+  }
+
   /*! \brief Load the P representatives in a truth-table set
    */
-  tt_set load_p_representatives()
+  static tt_set load_p_representatives( uint32_t num_vars )
   {
     tt_set classes;
-    classes.reserve( 222 );
+    classes.reserve( num_vars == 4u ? 222u : 16u );
 
-    Tt_t tt( 4 );
+    Tt_t tt( num_vars );
     do
     {
       auto const res = kitty::exact_p_canonization( tt );
@@ -147,13 +321,43 @@ private:
     return classes;
   }
 
+  /*! \brief Collect the P representatives of the cut functions of a benchmark
+   *
+   * Only the functions depending on all the `num_vars` variables of the cut
+   * are collected.
+   */
+  static tt_set harvest_p_representatives( mockturtle::aig_network const& aig, uint32_t num_vars, uint32_t cut_limit )
+  {
+    mockturtle::cut_enumeration_params cps;
+    cps.cut_size = num_vars;
+    cps.cut_limit = cut_limit;
+    auto const cuts = mockturtle::cut_enumeration<mockturtle::aig_network, true>( aig, cps );
+
+    tt_set classes;
+    aig.foreach_gate( [&]( auto const& n ) {
+      for ( auto const& cut : cuts.cuts( aig.node_to_index( n ) ) )
+      {
+        if ( cut->size() != num_vars )
+          continue;
+        auto const tt = cuts.truth_table( *cut );
+        bool full_support = true;
+        for ( auto i = 0u; i < num_vars; ++i )
+          full_support &= kitty::has_var( tt, i );
+        if ( full_support )
+          classes.emplace( std::get<0>( kitty::exact_p_canonization( tt ) ) );
+      }
+    } );
+    return classes;
+  }
+
   /*! \brief Convert a truth-table set into a kLUT network where each function is a PO
    */
-  mockturtle::klut_network classes_to_klut( tt_set const& classes )
+  template<typename Classes>
+  static mockturtle::klut_network classes_to_klut( Classes const& classes, uint32_t num_vars )
   {
     mockturtle::klut_network klut;
 
-    std::vector<typename mockturtle::klut_network::signal> pis( 4 );
+    std::vector<typename mockturtle::klut_network::signal> pis( num_vars );
     for ( auto& pi : pis )
       pi = klut.create_pi();
 
@@ -166,9 +370,54 @@ private:
     return klut;
   }
 
+  /*! \brief Preprocess and map the classes of a shard into a database
+   *
+   * Each class is mapped on its own, so that its entries do not depend on the
+   * classes sharing its shard, and hence on the number of shards.
+   */
+  database_t build_shard( std::vector<Tt_t> const& classes, uint32_t shard, uint32_t num_shards, database_gen_params const& ps )
+  {
+    std::vector<Tt_t> selected;
+    for ( auto i = shard; i < classes.size(); i += num_shards )
+      selected.push_back( classes[i] );
+
+    database_t db( library_ );
+    if ( selected.empty() )
+      return db;
+
+    mockturtle::tech_library_params tps;
+    tps.ignore_symmetries = false;
+    mockturtle::tech_library<9> tech_lib( gates_, tps );
+    auto const configurations = mapping_configurations( ps.metric );
+
+    for ( auto const& tt : selected )
+    {
+      auto aig = mockturtle::convert_klut_to_graph<mockturtle::aig_network, mockturtle::klut_network>( classes_to_klut( std::vector<Tt_t>{ tt }, ps.num_vars ) );
+      aig_preprocessing( aig );
+
+      /* the database keeps the entries of the mappings which are not dominated */
+      for ( auto const& mps : configurations )
+      {
+        mockturtle::emap_stats mst;
+        Ntk_t mapped = mockturtle::emap<9>( aig, tech_lib, mps, &mst );
+
+        std::vector<Signal_t> pis( mapped.num_pis() );
+        mapped.foreach_pi( [&]( auto const& n, auto i ) {
+          pis[i] = mapped.make_signal( n );
+        } );
+        mapped.foreach_po( [&]( auto const& f ) {
+          db.add( mapped, pis, f );
+        } );
+      }
+    }
+    if ( ps.verbose )
+      std::cout << fmt::format( "[i] shard {:4d}: {:6d} classes, {:6d} entries\n", shard, selected.size(), db.size() );
+    return db;
+  }
+
   /*! \brief Area-oriented AIG minimization
    */
-  void aig_preprocessing()
+  static void aig_preprocessing( mockturtle::aig_network& aig )
   {
     const mockturtle::xag_npn_resynthesis<mockturtle::aig_network> resyn;
     mockturtle::exact_library_params eps;
@@ -180,33 +429,84 @@ private:
     int iteration = 0;
     while ( iteration++ < 10 )
     {
-      const auto size_before = aig_.num_gates();
-      rewrite( aig_, exact_lib, ps );
-      const auto size_after = aig_.num_gates();
+      const auto size_before = aig.num_gates();
+      rewrite( aig, exact_lib, ps );
+      const auto size_after = aig.num_gates();
       if ( size_before <= size_after )
         break;
     }
   }
 
+  /*! \brief Mapping configurations explored for a metric
+   *
+   * - area: area-oriented mapping.
+   * - delay: delay-oriented mapping without area recovery, so that every
+   *   output is delay-optimal, mappings with increasing relaxations of the
+   *   required time, and the area-oriented mapping.
+   * - power: mappings with switching power recovery, either area-oriented or
+   *   delay-oriented, and the area-oriented mapping.
+   */
+  static std::vector<mockturtle::emap_params> mapping_configurations( std::string const& metric )
+  {
+    mockturtle::emap_params area_ps;
+    area_ps.matching_mode = mockturtle::emap_params::hybrid;
+    area_ps.area_oriented_mapping = true;
+    area_ps.map_multioutput = false;
+    area_ps.relax_required = 0;
+
+    std::vector<mockturtle::emap_params> configurations;
+    if ( metric == "delay" )
+    {
+      mockturtle::emap_params fastest_ps = area_ps;
+      fastest_ps.area_oriented_mapping = false;
+      fastest_ps.area_flow_rounds = 0u;
+      fastest_ps.ela_rounds = 0u;
+      configurations.push_back( fastest_ps );
+      for ( double const relax : { 10.0, 25.0 } )
+      {
+        mockturtle::emap_params delay_ps = area_ps;
+        delay_ps.area_oriented_mapping = false;
+        delay_ps.relax_required = relax;
+        configurations.push_back( delay_ps );
+      }
+      configurations.push_back( area_ps );
+    }
+    else if ( metric == "power" )
+    {
+      for ( bool const area_oriented : { true, false } )
+      {
+        mockturtle::emap_params power_ps = area_ps;
+        power_ps.area_oriented_mapping = area_oriented;
+        power_ps.eswp_rounds = 2u;
+        configurations.push_back( power_ps );
+      }
+      configurations.push_back( area_ps );
+    }
+    else
+    {
+      configurations.push_back( area_ps );
+    }
+    return configurations;
+  }
+
   /*! \brief Area-oriented technology-mapping
    */
-  Ntk_t map_to_block_network()
+  Ntk_t map_to_block_network( mockturtle::aig_network const& aig, bool verbose ) const
+  {
+    return map_to_block_network( aig, verbose, mapping_configurations( "area" ).front() );
+  }
+
+  Ntk_t map_to_block_network( mockturtle::aig_network const& aig, bool verbose, mockturtle::emap_params const& mps ) const
   {
     mockturtle::tech_library_params tps;
     tps.ignore_symmetries = false;
-    tps.verbose = true;
+    tps.verbose = verbose;
 
     mockturtle::tech_library<9> tech_lib( gates_, tps );
 
-    mockturtle::emap_params mps;
-    mps.matching_mode = mockturtle::emap_params::hybrid;
-    mps.area_oriented_mapping = true;
-    mps.map_multioutput = false;
-    mps.relax_required = 0;
-
     mockturtle::emap_stats mst;
 
-    Ntk_t const ntk = mockturtle::emap<9>( aig_, tech_lib, mps, &mst );
+    Ntk_t const ntk = mockturtle::emap<9>( aig, tech_lib, mps, &mst );
     return ntk;
   }
 
@@ -0,0 +1,394 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file database_synthesizer.hpp
+  \brief On-demand synthesis of the functions missing in a mapped database
+
+  \author Andrea Costamagna
+*/
+#pragma once
+
+#include "../boolean/p_canonization.hpp"
+#include "../evaluation/chains.hpp"
+#include <kitty/kitty.hpp>
+#include <mockturtle/algorithms/emap.hpp>
+#include <mockturtle/algorithms/klut_to_graph.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/rewrite.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/block.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/cell_view.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fmt/format.h>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <parallel_hashmap/phmap.h>
+#include <thread>
+#include <vector>
+
+namespace rinox
+{
+
+namespace databases
+{
+
+struct database_synthesizer_params
+{
+  /*! \brief Synthesize the missing functions in a background thread */
+  bool background = false;
+
+  /*! \brief Maximum number of functions waiting for the background thread */
+  uint32_t max_pending = 1024u;
+
+  /*! \brief Maximum number of rewriting rounds on the AIG of a function */
+  uint32_t max_rewrite_rounds = 10u;
+};
+
+struct database_synthesizer_stats
+{
+  /*! \brief Total runtime of the synthesis. */
+  mockturtle::stopwatch<>::duration time_total{ 0 };
+
+  /*! \brief Number of functions missing in the database. */
+  uint64_t num_misses{ 0 };
+
+  /*! \brief Number of misses of functions already synthesized. */
+  uint64_t num_repeated{ 0 };
+
+  /*! \brief Number of functions synthesized. */
+  uint64_t num_synthesized{ 0 };
+
+  /*! \brief Number of functions whose mapping could not be inserted. */
+  uint64_t num_failed{ 0 };
+
+  /*! \brief Number of functions dropped because the queue was full. */
+  uint64_t num_dropped{ 0 };
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] db misses        = {:8d}\n", num_misses );
+    std::cout << fmt::format( "    db repeated      = {:8d}\n", num_repeated );
+    std::cout << fmt::format( "    db synthesized   = {:8d}\n", num_synthesized );
+    std::cout << fmt::format( "    db failed        = {:8d}\n", num_failed );
+    std::cout << fmt::format( "    db dropped       = {:8d}\n", num_dropped );
+    std::cout << fmt::format( "    db time          = {:>8.2f} secs\n", mockturtle::to_seconds( time_total ) );
+  }
+};
+
+/*! \brief Engine growing a mapped database with the functions it misses.
+ *
+ * Each missing function is synthesized with the flow used to generate the
+ * databases: the function is decomposed into an AIG, which is minimized by
+ * exact rewriting and mapped with `emap`. The mapped network is inserted in
+ * the database as a chain. The P-classes of the functions are memoized, so
+ * that each class is synthesized at most once, even if its mapping fails.
+ *
+ * In background mode, the functions are queued to a thread and `flush` inserts
+ * the chains synthesized so far. The database is only modified by the thread
+ * calling `synthesize` or `flush`. The thread counts its work apart, and the
+ * counts are added to the statistics by `flush` and by the destructor, so that
+ * the statistics are only written by the thread owning the synthesizer.
+ *
+ * \tparam Database Mapped database type
+ */
+template<typename Database>
+class database_synthesizer
+{
+public:
+  static constexpr uint32_t max_num_vars = Database::max_num_vars;
+  using truth_table_t = typename Database::truth_table_t;
+  using chain_t = typename Database::chain_t;
+
+private:
+  using mapped_t = mockturtle::cell_view<mockturtle::block_network>;
+  using exact_library_t = mockturtle::exact_library<mockturtle::aig_network>;
+
+public:
+  database_synthesizer( std::vector<mockturtle::gate> const& gates, database_synthesizer_params const& ps = {} )
+      : database_synthesizer( gates, ps, own_st_ )
+  {}
+
+  database_synthesizer( std::vector<mockturtle::gate> const& gates, database_synthesizer_params const& ps, database_synthesizer_stats& st )
+      : ps_( ps ),
+        st_( st ),
+        tech_lib_( gates, make_tech_library_params() ),
+        exact_lib_( resyn_, make_exact_library_params() )
+  {
+    if ( ps_.background )
+      worker_ = std::thread( [this]() { work(); } );
+  }
+
+  database_synthesizer( database_synthesizer const& ) = delete;
+  database_synthesizer& operator=( database_synthesizer const& ) = delete;
+
+  ~database_synthesizer()
+  {
+    if ( worker_.joinable() )
+    {
+      {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        stop_ = true;
+      }
+      cv_.notify_one();
+      worker_.join();
+      merge_background_stats();
+    }
+  }
+
+  /*! \brief Handle a function missing in the database.
+   *
+   * In foreground mode, the function is synthesized and inserted in the
+   * database. Returns true if the database has been modified. In background
+   * mode, the function is queued and the method returns false.
+   */
+  bool synthesize( truth_table_t const& func, Database& db )
+  {
+    return synthesize( func, std::vector<Database*>{ &db } );
+  }
+
+  /*! \brief Handle a function missing in several copies of a database.
+   *
+   * The same chain is inserted in each copy, so that the copies stay equal.
+   */
+  bool synthesize( truth_table_t const& func, std::vector<Database*> const& dbs )
+  {
+    ++st_.num_misses;
+    auto const repr = canonizer_( func ).first;
+    if ( !visited_.insert( repr ).second )
+    {
+      ++st_.num_repeated;
+      return false;
+    }
+
+    if ( ps_.background )
+    {
+      {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        if ( requests_.size() >= ps_.max_pending )
+        {
+          ++st_.num_dropped;
+          visited_.erase( repr );
+          return false;
+        }
+        requests_.push_back( repr );
+      }
+      cv_.notify_one();
+      return false;
+    }
+
+    mockturtle::stopwatch<> t( st_.time_total );
+    auto chain = synthesize_chain( repr );
+    if ( !chain )
+    {
+      ++st_.num_failed;
+      return false;
+    }
+    ++st_.num_synthesized;
+    bool modified = false;
+    for ( auto* db : dbs )
+      modified |= db->add( *chain );
+    return modified;
+  }
+
+  /*! \brief Insert the chains synthesized in background. Returns true if the database has been modified. */
+  bool flush( Database& db )
+  {
+    return insert_ready( [&]( auto const& chain ) {
+      return db.add( chain );
+    } );
+  }
+
+  /*! \brief Insert the chains synthesized in background in several copies of a database. */
+  bool flush( std::vector<Database*> const& dbs )
+  {
+    return insert_ready( [&]( auto const& chain ) {
+      bool modified = false;
+      for ( auto* db : dbs )
+        modified |= db->add( chain );
+      return modified;
+    } );
+  }
+
+  /*! \brief Statistics, including the work of the background thread up to the last `flush` */
+  database_synthesizer_stats const& get_stats() const
+  {
+    return st_;
+  }
+
+private:
+  /*! \brief Pass the chains synthesized in background to `add`, without locking when not in background */
+  template<typename Fn>
+  bool insert_ready( Fn&& add )
+  {
+    if ( !ps_.background )
+      return false;
+
+    {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      merge_background_stats();
+      if ( results_.empty() )
+        return false;
+      ready_.swap( results_ );
+    }
+    bool modified = false;
+    for ( auto& chain : ready_ )
+      modified |= add( chain );
+    ready_.clear();
+    return modified;
+  }
+
+  /*! \brief Move the counts of the background thread to the statistics, with the mutex held or the thread joined */
+  void merge_background_stats()
+  {
+    st_.time_total += background_st_.time_total;
+    st_.num_synthesized += background_st_.num_synthesized;
+    st_.num_failed += background_st_.num_failed;
+    background_st_ = {};
+  }
+
+  static mockturtle::tech_library_params make_tech_library_params()
+  {
+    mockturtle::tech_library_params tps;
+    tps.ignore_symmetries = false;
+    tps.verbose = false;
+    return tps;
+  }
+
+  static mockturtle::exact_library_params make_exact_library_params()
+  {
+    mockturtle::exact_library_params eps;
+    eps.np_classification = false;
+    return eps;
+  }
+
+  /*! \brief Map a function and extract the mapped network as a chain */
+  std::optional<chain_t> synthesize_chain( truth_table_t const& func ) const
+  {
+    kitty::dynamic_truth_table tt( max_num_vars );
+    std::copy( func.cbegin(), func.cend(), tt.begin() );
+
+    mockturtle::klut_network klut;
+    std::vector<mockturtle::klut_network::signal> klut_pis( max_num_vars );
+    for ( auto& pi : klut_pis )
+      pi = klut.create_pi();
+    klut.create_po( klut.create_node( klut_pis, tt ) );
+
+    auto aig = mockturtle::convert_klut_to_graph<mockturtle::aig_network, mockturtle::klut_network>( klut );
+    mockturtle::rewrite_params rps;
+    rps.preserve_depth = true;
+    for ( auto i = 0u; i < ps_.max_rewrite_rounds; ++i )
+    {
+      auto const size_before = aig.num_gates();
+      mockturtle::rewrite( aig, exact_lib_, rps );
+      if ( size_before <= aig.num_gates() )
+        break;
+    }
+
+    mockturtle::emap_params mps;
+    mps.matching_mode = mockturtle::emap_params::hybrid;
+    mps.area_oriented_mapping = true;
+    mps.map_multioutput = false;
+    mps.relax_required = 0;
+    mapped_t mapped = mockturtle::emap<9>( aig, tech_lib_, mps );
+    if ( mapped.num_pis() != max_num_vars || mapped.num_pos() != 1u )
+      return std::nullopt;
+
+    std::vector<typename mapped_t::signal> pis( max_num_vars );
+    mapped.foreach_pi( [&]( auto const& n, auto i ) {
+      pis[i] = mapped.make_signal( n );
+    } );
+    chain_t chain( max_num_vars );
+    evaluation::chains::extract( chain, mapped, pis, mapped.po_at( 0 ) );
+    if ( chain.num_gates() == 0u )
+      return std::nullopt;
+    return chain;
+  }
+
+  void work()
+  {
+    std::unique_lock<std::mutex> lock( mutex_ );
+    while ( true )
+    {
+      cv_.wait( lock, [&]() { return stop_ || !requests_.empty(); } );
+      if ( stop_ )
+        return;
+      truth_table_t const func = requests_.front();
+      requests_.pop_front();
+      lock.unlock();
+
+      auto const start = std::chrono::high_resolution_clock::now();
+      auto chain = synthesize_chain( func );
+      auto const elapsed = std::chrono::high_resolution_clock::now() - start;
+
+      lock.lock();
+      background_st_.time_total += elapsed;
+      if ( chain )
+      {
+        ++background_st_.num_synthesized;
+        results_.push_back( std::move( *chain ) );
+      }
+      else
+      {
+        ++background_st_.num_failed;
+      }
+    }
+  }
+
+private:
+  database_synthesizer_params ps_;
+  database_synthesizer_stats own_st_;
+  database_synthesizer_stats& st_;
+
+  mockturtle::tech_library<9> tech_lib_;
+  mockturtle::xag_npn_resynthesis<mockturtle::aig_network> resyn_;
+  exact_library_t exact_lib_;
+  boolean::p_canonizer<max_num_vars> canonizer_;
+
+  /*! \brief Representatives of the P-classes already handled */
+  phmap::flat_hash_set<truth_table_t, kitty::hash<truth_table_t>> visited_;
+
+  /*! \brief Background synthesis */
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<truth_table_t> requests_;
+  std::vector<chain_t> results_;
+  std::vector<chain_t> ready_;
+  /*! \brief Counts of the background thread, guarded by the mutex */
+  database_synthesizer_stats background_st_;
+  bool stop_ = false;
+};
+
+} // namespace databases
+
+} // namespace rinox
@@ -32,17 +32,75 @@
 #pragma once
 
 #include "../boolean/boolean.hpp"
+#include "../boolean/p_canonization.hpp"
 #include "../evaluation/evaluation.hpp"
+#include "../io/utils/mapped_file.hpp"
 #include "../io/verilog/write_verilog.hpp"
 #include "../network/utils.hpp"
 #include <kitty/kitty.hpp>
 
+#include <array>
+#include <cstring>
+#include <fmt/format.h>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
 namespace rinox
 {
 
 namespace databases
 {
 
+struct mapped_database_params
+{
+  /*! \brief Number of functions whose match is cached ( rounded up to a power of two ). */
+  uint32_t cache_size{ 1u << 16 };
+
+  /*! \brief Read the P-canonization from a precomputed table for up to 4 variables. */
+  bool use_canonization_table{ true };
+
+  /*! \brief Number of incompletely specified functions whose matches are cached. */
+  uint32_t dc_cache_size{ 1u << 14 };
+};
+
+struct mapped_database_stats
+{
+  /*! \brief Number of functions looked up. */
+  uint64_t num_lookups{ 0 };
+
+  /*! \brief Number of lookups answered by the cache. */
+  uint64_t num_hits{ 0 };
+
+  /*! \brief Number of P-canonizations computed. */
+  uint64_t num_canonizations{ 0 };
+
+  /*! \brief Number of incompletely specified functions looked up. */
+  uint64_t num_dc_lookups{ 0 };
+
+  /*! \brief Number of lookups of incompletely specified functions answered by the cache. */
+  uint64_t num_dc_hits{ 0 };
+
+  /*! \brief Number of completions found in the database. */
+  uint64_t num_dc_matches{ 0 };
+
+  double hit_rate() const
+  {
+    return num_lookups == 0 ? 0.0 : static_cast<double>( num_hits ) / static_cast<double>( num_lookups );
+  }
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] num lookups      = {:8d}\n", num_lookups );
+    std::cout << fmt::format( "    num hits         = {:8d}\n", num_hits );
+    std::cout << fmt::format( "    hit rate         = {:>8.2f} %\n", 100.0 * hit_rate() );
+    std::cout << fmt::format( "    canonizations    = {:8d}\n", num_canonizations );
+    std::cout << fmt::format( "    num dc lookups   = {:8d}\n", num_dc_lookups );
+    std::cout << fmt::format( "    num dc hits      = {:8d}\n", num_dc_hits );
+    std::cout << fmt::format( "    num dc matches   = {:8d}\n", num_dc_matches );
+  }
+};
+
 /*! \brief Database of mapped networks
  *
  * \tparam NtkDb Network type of the stored database
@@ -63,12 +121,11 @@ public:
 private:
   struct database_entry_t
   {
+    /*! \brief Pareto dominance: no worse in any objective and better in one */
     bool operator<( database_entry_t const& other ) const
     {
-      bool dominates = true;
-      dominates &= area < other.area;
-      dominates &= switches < other.switches;
-      bool one_strict = false;
+      bool dominates = area <= other.area && switches <= other.switches;
+      bool one_strict = area < other.area || switches < other.switches;
       for ( int i = 0; i < delays.size(); ++i )
       {
         one_strict |= delays[i] < other.delays[i];
@@ -77,6 +134,7 @@ private:
       return dominates & one_strict;
     }
 
+    /*! \brief Weak dominance by the other entry: no better in any objective */
     bool operator>=( database_entry_t const& other ) const
     {
       bool dominated = true;
@@ -138,12 +196,132 @@ private:
     uint64_t row;
   };
 
+  /*! \brief Slot of the direct-mapped cache of matches */
+  struct cache_slot_t
+  {
+    truth_table_t func;
+    match_t match;
+    bool valid = false;
+  };
+
+  /*! \brief Function of the P-class of a row, obtained by permuting its representative */
+  struct orbit_entry_t
+  {
+    truth_table_t func;
+    /*! \brief Forward map of the permutation from the function to the representative */
+    uint64_t fmap;
+    uint32_t row;
+    /*! \brief Bit i is set if the function depends on variable i */
+    uint32_t support;
+  };
+
+  /*! \brief Incompletely specified function looked up in the database */
+  struct dc_key_t
+  {
+    bool operator==( dc_key_t const& other ) const
+    {
+      return num_vars == other.num_vars && kitty::equal( bits, other.bits ) && kitty::equal( care, other.care );
+    }
+
+    truth_table_t bits;
+    truth_table_t care;
+    uint32_t num_vars;
+  };
+
+  struct dc_key_hash_t
+  {
+    uint64_t operator()( dc_key_t const& key ) const
+    {
+      kitty::hash<truth_table_t> hash;
+      uint64_t seed = hash( key.bits );
+      seed ^= hash( key.care ) + 0x9e3779b97f4a7c15ull + ( seed << 6 ) + ( seed >> 2 );
+      return seed ^ key.num_vars;
+    }
+  };
+
+  /*! \brief Header of the binary format.
+   *
+   * The header is followed by the sections listed below, each padded to a
+   * multiple of 8 bytes:
+   * - representatives: `num_rows * num_blocks` words
+   * - symmetries: `num_rows` words
+   * - row offsets: `num_rows + 1` entries indices
+   * - areas, delays ( `num_vars` per entry ), switches, root of each entry
+   * - node offsets: `num_nodes + 1` indices in the codes
+   * - codes: for each node the number of binding ids, the ids and the fanins
+   * - primary outputs
+   *
+   * Nodes are listed in topological order. Signals are encoded as
+   * `ref * max_num_outputs + output`, where refs 0 and 1 are the constants,
+   * the next `num_vars` refs are the PIs and the others are the nodes.
+   */
+  struct binary_header_t
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_vars;
+    uint32_t design;
+    uint32_t num_blocks;
+    uint64_t library;
+    uint64_t num_rows;
+    uint64_t num_entries;
+    uint64_t num_nodes;
+    uint64_t num_codes;
+    uint64_t num_pos;
+  };
+
+  /*! \brief Bounds-checked cursor over the sections of a binary database */
+  /*! \brief Reader of the sections of the binary format.
+   *
+   * The sections are copied into vectors, as the buffer is not required to be
+   * aligned for their element types.
+   */
+  struct binary_reader_t
+  {
+    template<typename T>
+    std::vector<T> take( uint64_t count )
+    {
+      std::vector<T> section;
+      if ( truncated || offset > size || count > ( size - offset ) / sizeof( T ) )
+      {
+        truncated = true;
+        return section;
+      }
+      section.resize( count );
+      if ( count > 0u )
+        std::memcpy( section.data(), data + offset, count * sizeof( T ) );
+      offset += count * sizeof( T );
+      align();
+      return section;
+    }
+
+    void align()
+    {
+      offset += ( 8u - offset % 8u ) % 8u;
+    }
+
+    char const* data;
+    size_t size;
+    size_t offset;
+    bool truncated = false;
+  };
+
+  static constexpr char binary_magic[8] = { 'R', 'N', 'X', 'D', 'B', '\0', '\0', '\0' };
+  static constexpr uint32_t binary_version = 2u;
+
 public:
-  mapped_database( library_t& lib )
+  mapped_database( library_t& lib, mapped_database_params const& ps = {} )
       : lib_( lib ),
         ntk_( lib ),
-        simulator_( lib )
+        simulator_( lib ),
+        canonizer_( ps.use_canonization_table ),
+        dc_cache_size_( ps.dc_cache_size )
   {
+    uint32_t cache_size = 1u;
+    while ( cache_size < ps.cache_size )
+      cache_size <<= 1u;
+    cache_.resize( cache_size );
+
     for ( auto i = 0u; i < MaxNumVars; ++i )
       pis_.push_back( ntk_.create_pi() );
 
@@ -170,6 +348,26 @@ public:
     return lib_;
   }
 
+  /*! \brief Deep copy of the database.
+   *
+   * The copy constructor shares the storage of the database network. This
+   * method returns a database whose network can be modified independently,
+   * as required when several threads query the database concurrently. The
+   * statistics of the copy start from zero.
+   */
+  mapped_database clone() const
+  {
+    mapped_database other( *this );
+    other.ntk_ = ntk_.clone();
+    other.st_ = {};
+    other.sims_ptrs_.clear();
+    for ( auto i = 0u; i < MaxNumVars; ++i )
+    {
+      other.sims_ptrs_.push_back( &other.proj_funcs_[i] );
+    }
+    return other;
+  }
+
 #pragma region Saving
 
   void commit( std::string const& file )
@@ -182,6 +380,292 @@ public:
     io::verilog::write_verilog( ntk_, os );
   }
 
+  /*! \brief Save the database in binary format.
+   *
+   * Contrary to the Verilog dump, the binary format stores the rows, the
+   * canonical representatives and the costs of the entries, so that loading
+   * it does not require any simulation or canonization. The file is tied to
+   * the library used to build the database.
+   */
+  bool commit_binary( std::string const& file ) const
+  {
+    std::ofstream os( file, std::ios::binary );
+    if ( !os.is_open() )
+    {
+      std::cerr << "[e] cannot open " << file << " for writing" << std::endl;
+      return false;
+    }
+    commit_binary( os );
+    return os.good();
+  }
+
+  void commit_binary( std::ostream& os ) const
+  {
+    static constexpr uint32_t num_blocks = sizeof( truth_table_t ) / sizeof( uint64_t );
+    static constexpr uint32_t num_consts = 2u;
+    static constexpr uint32_t num_outs = NtkDb::max_num_outputs;
+
+    /* number the nodes reachable from the outputs in topological order */
+    phmap::flat_hash_map<node_index_t, uint32_t> refs;
+    refs[ntk_.get_node( ntk_.get_constant( false ) )] = 0u;
+    refs[ntk_.get_node( ntk_.get_constant( true ) )] = 1u;
+    for ( auto i = 0u; i < MaxNumVars; ++i )
+      refs[ntk_.get_node( pis_[i] )] = num_consts + i;
+
+    std::vector<uint32_t> node_offsets{ 0u };
+    std::vector<uint32_t> codes;
+    auto const encode = [&]( signal_t const& f ) {
+      return static_cast<uint32_t>( refs.at( f.index ) * num_outs + f.output );
+    };
+    std::function<void( node_index_t const& )> number;
+    number = [&]( node_index_t const& n ) {
+      if ( refs.find( n ) != refs.end() )
+        return;
+      ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+        number( ntk_.get_node( fi ) );
+      } );
+      auto const ids = ntk_.get_binding_ids( n );
+      codes.push_back( static_cast<uint32_t>( ids.size() ) );
+      codes.insert( codes.end(), ids.begin(), ids.end() );
+      ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+        codes.push_back( encode( fi ) );
+      } );
+      refs[n] = num_consts + MaxNumVars + static_cast<uint32_t>( node_offsets.size() - 1 );
+      node_offsets.push_back( static_cast<uint32_t>( codes.size() ) );
+    };
+
+    std::vector<uint32_t> pos;
+    ntk_.foreach_po( [&]( auto const& f ) {
+      number( ntk_.get_node( f ) );
+      pos.push_back( encode( f ) );
+    } );
+
+    std::vector<uint64_t> reprs, symms, row_offsets{ 0u };
+    std::vector<double> areas, delays;
+    std::vector<uint32_t> switches, roots;
+    for ( database_row_t const& row : database_ )
+    {
+      reprs.insert( reprs.end(), row.repr.cbegin(), row.repr.cend() );
+      symms.push_back( row.symm.data );
+      for ( database_entry_t const& entry : row.entries )
+      {
+        areas.push_back( entry.area );
+        for ( auto i = 0u; i < MaxNumVars; ++i )
+          delays.push_back( i < entry.delays.size() ? entry.delays[i] : 0.0 );
+        switches.push_back( entry.switches );
+        number( entry.index );
+        roots.push_back( refs.at( entry.index ) );
+      }
+      row_offsets.push_back( areas.size() );
+    }
+
+    binary_header_t header;
+    std::memcpy( header.magic, binary_magic, sizeof( binary_magic ) );
+    header.version = binary_version;
+    header.num_vars = MaxNumVars;
+    header.design = static_cast<uint32_t>( design_t );
+    header.num_blocks = num_blocks;
+    header.library = lib_.fingerprint();
+    header.num_rows = database_.size();
+    header.num_entries = areas.size();
+    header.num_nodes = node_offsets.size() - 1;
+    header.num_codes = codes.size();
+    header.num_pos = pos.size();
+
+    auto const write_section = [&]( void const* data, size_t size ) {
+      static constexpr char padding[8] = {};
+      os.write( static_cast<char const*>( data ), size );
+      os.write( padding, ( 8u - size % 8u ) % 8u );
+    };
+    write_section( &header, sizeof( header ) );
+    write_section( reprs.data(), reprs.size() * sizeof( uint64_t ) );
+    write_section( symms.data(), symms.size() * sizeof( uint64_t ) );
+    write_section( row_offsets.data(), row_offsets.size() * sizeof( uint64_t ) );
+    write_section( areas.data(), areas.size() * sizeof( double ) );
+    write_section( delays.data(), delays.size() * sizeof( double ) );
+    write_section( switches.data(), switches.size() * sizeof( uint32_t ) );
+    write_section( roots.data(), roots.size() * sizeof( uint32_t ) );
+    write_section( node_offsets.data(), node_offsets.size() * sizeof( uint32_t ) );
+    write_section( codes.data(), codes.size() * sizeof( uint32_t ) );
+    write_section( pos.data(), pos.size() * sizeof( uint32_t ) );
+  }
+
+#pragma endregion
+
+#pragma region Loading
+
+  /*! \brief Load a database saved with `commit_binary`.
+   *
+   * The file is mapped in memory and the database is rebuilt from the stored
+   * rows and nodes. Files saved with a different version, number of variables
+   * or library are rejected, leaving the database unchanged.
+   */
+  bool load_binary( std::string const& file )
+  {
+    io::mapped_file mapped( file );
+    if ( !mapped.is_open() )
+    {
+      std::cerr << "[e] cannot open " << file << std::endl;
+      return false;
+    }
+    return load_binary( mapped.data(), mapped.size() );
+  }
+
+  bool load_binary( char const* data, size_t size )
+  {
+    static constexpr uint32_t num_blocks = sizeof( truth_table_t ) / sizeof( uint64_t );
+    static constexpr uint32_t num_consts = 2u;
+    static constexpr uint32_t num_outs = NtkDb::max_num_outputs;
+
+    binary_header_t header;
+    if ( size < sizeof( header ) )
+    {
+      std::cerr << "[e] binary database is truncated" << std::endl;
+      return false;
+    }
+    std::memcpy( &header, data, sizeof( header ) );
+    if ( std::memcmp( header.magic, binary_magic, sizeof( binary_magic ) ) != 0 || header.version != binary_version )
+    {
+      std::cerr << "[e] unsupported binary database format" << std::endl;
+      return false;
+    }
+    if ( header.num_vars != MaxNumVars || header.num_blocks != num_blocks || header.design != static_cast<uint32_t>( design_t ) )
+    {
+      std::cerr << "[e] binary database built for a different database type" << std::endl;
+      return false;
+    }
+    if ( header.library != lib_.fingerprint() )
+    {
+      std::cerr << "[e] binary database built for a different library" << std::endl;
+      return false;
+    }
+
+    /* each element takes at least 4 bytes, hence the counts of a valid file are
+     * below its size, and the section sizes computed below do not overflow */
+    if ( header.num_rows >= size || header.num_entries >= size || header.num_nodes >= size ||
+         header.num_codes >= size || header.num_pos >= size )
+    {
+      std::cerr << "[e] binary database is truncated" << std::endl;
+      return false;
+    }
+
+    /* sections are 8-byte aligned offsets from the beginning of the buffer */
+    binary_reader_t reader{ data, size, sizeof( header ) };
+    reader.align();
+    auto const reprs = reader.template take<uint64_t>( header.num_rows * num_blocks );
+    auto const symms = reader.template take<uint64_t>( header.num_rows );
+    auto const row_offsets = reader.template take<uint64_t>( header.num_rows + 1 );
+    auto const areas = reader.template take<double>( header.num_entries );
+    auto const delays = reader.template take<double>( header.num_entries * MaxNumVars );
+    auto const switches = reader.template take<uint32_t>( header.num_entries );
+    auto const roots = reader.template take<uint32_t>( header.num_entries );
+    auto const node_offsets = reader.template take<uint32_t>( header.num_nodes + 1 );
+    auto const codes = reader.template take<uint32_t>( header.num_codes );
+    auto const pos = reader.template take<uint32_t>( header.num_pos );
+    if ( reader.truncated )
+    {
+      std::cerr << "[e] binary database is truncated" << std::endl;
+      return false;
+    }
+
+    /* rebuild the network of the database */
+    NtkDb ntk( lib_ );
+    std::vector<signal_t> pis;
+    std::vector<node_index_t> nodes;
+    nodes.reserve( num_consts + MaxNumVars + header.num_nodes );
+    nodes.push_back( ntk.get_node( ntk.get_constant( false ) ) );
+    nodes.push_back( ntk.get_node( ntk.get_constant( true ) ) );
+    for ( auto i = 0u; i < MaxNumVars; ++i )
+    {
+      pis.push_back( ntk.create_pi() );
+      nodes.push_back( ntk.get_node( pis.back() ) );
+    }
+
+    uint64_t const num_gates = lib_.get_aug_gates().size();
+    auto const decode = [&]( uint32_t code, signal_t& f ) {
+      if ( code / num_outs >= nodes.size() )
+        return false;
+      f = signal_t{ nodes[code / num_outs], code % num_outs };
+      return true;
+    };
+
+    std::vector<signal_t> children;
+    std::vector<uint32_t> ids;
+    for ( auto k = 0u; k < header.num_nodes; ++k )
+    {
+      uint32_t const begin = node_offsets[k];
+      uint32_t const end = node_offsets[k + 1];
+      if ( begin >= end || end > header.num_codes || codes[begin] > end - begin - 1 )
+      {
+        std::cerr << "[e] binary database is corrupted" << std::endl;
+        return false;
+      }
+      ids.assign( codes.begin() + begin + 1, codes.begin() + begin + 1 + codes[begin] );
+      children.resize( end - begin - 1 - codes[begin] );
+      bool valid = !ids.empty() && ids.size() <= num_outs;
+      for ( auto const id : ids )
+        valid &= id < num_gates;
+      for ( auto i = 0u; i < children.size(); ++i )
+        valid &= decode( codes[begin + 1 + ids.size() + i], children[i] );
+      if ( !valid )
+      {
+        std::cerr << "[e] binary database is corrupted" << std::endl;
+        return false;
+      }
+      nodes.push_back( ntk.get_node( ntk.template create_node<false>( children, ids ) ) );
+    }
+
+    for ( auto i = 0u; i < header.num_pos; ++i )
+    {
+      signal_t f;
+      if ( !decode( pos[i], f ) )
+      {
+        std::cerr << "[e] binary database is corrupted" << std::endl;
+        return false;
+      }
+      ntk.create_po( f );
+    }
+
+    /* rebuild the rows */
+    std::vector<database_row_t> database( header.num_rows );
+    phmap::flat_hash_map<truth_table_t, uint64_t, kitty::hash<truth_table_t>> repr_to_row;
+    repr_to_row.reserve( header.num_rows );
+    for ( auto r = 0u; r < header.num_rows; ++r )
+    {
+      database_row_t& row = database[r];
+      std::copy( reprs.begin() + r * num_blocks, reprs.begin() + ( r + 1 ) * num_blocks, row.repr.begin() );
+      row.symm.data = symms[r];
+      if ( row_offsets[r] > row_offsets[r + 1] || row_offsets[r + 1] > header.num_entries )
+      {
+        std::cerr << "[e] binary database is corrupted" << std::endl;
+        return false;
+      }
+      row.entries.resize( row_offsets[r + 1] - row_offsets[r] );
+      for ( auto e = row_offsets[r]; e < row_offsets[r + 1]; ++e )
+      {
+        database_entry_t& entry = row.entries[e - row_offsets[r]];
+        if ( roots[e] >= nodes.size() )
+        {
+          std::cerr << "[e] binary database is corrupted" << std::endl;
+          return false;
+        }
+        entry.area = areas[e];
+        entry.switches = switches[e];
+        entry.delays.assign( delays.begin() + e * MaxNumVars, delays.begin() + ( e + 1 ) * MaxNumVars );
+        entry.index = nodes[roots[e]];
+      }
+      repr_to_row[row.repr] = r;
+    }
+
+    ntk_ = ntk;
+    pis_ = pis;
+    database_ = std::move( database );
+    repr_to_row_ = std::move( repr_to_row );
+    clear_cache();
+    clear_dc_index();
+    return true;
+  }
+
 #pragma endregion
 
 #pragma region Getters
@@ -194,40 +678,23 @@ public:
   /*! \brief Get the number of sub-networks stored */
   uint64_t size() const
   {
-    return ntk_.num_pos();
+    uint64_t num_entries = 0u;
+    for ( database_row_t const& row : database_ )
+      num_entries += row.size();
+    return num_entries;
+  }
+
+  /*! \brief Get the statistics of the lookups */
+  mapped_database_stats const& get_stats() const
+  {
+    return st_;
   }
 #pragma endregion
 
 #pragma region Insert in Database
   uint64_t memoize_func( truth_table_t const& tt )
   {
-    uint64_t row_index;
-    const auto it0 = func_to_match_.find( tt );
-    if ( it0 != func_to_match_.end() )
-    {
-      row_index = ( it0->second ).row;
-    }
-    else
-    {
-      auto [repr, _, perm] = kitty::exact_p_canonization( tt );
-      const auto it1 = repr_to_row_.find( repr );
-      /* insert in the database */
-      if ( it1 != repr_to_row_.end() )
-      {
-        row_index = it1->second;
-      }
-      else // the representative doesn't have any implementation yet
-      {
-        row_index = database_.size();
-        database_.emplace_back();
-        database_.back().symm = boolean::symmetries_t( repr );
-        database_.back().repr = repr;
-        repr_to_row_[repr] = row_index;
-      }
-
-      func_to_match_[tt] = match_t{ boolean::permutation_t( perm ), row_index };
-    }
-    return row_index;
+    return memoize_match( tt ).row;
   }
 
   /*! \brief Insert a mapped chain into the database
@@ -242,9 +709,10 @@ public:
     simulator_( chain, sims_ptrs_ );
     truth_table_t const tt = simulator_.get_simulation( chain, sims_ptrs_, chain.po_at( 0 ) );
     /* perform P-canonization on the chain */
-    uint64_t row = memoize_func( tt );
+    match_t const match = memoize_match( tt );
+    uint64_t const row = match.row;
 
-    rinox::evaluation::chains::perm_canonize( chain, func_to_match_[tt].perm );
+    rinox::evaluation::chains::perm_canonize( chain, match.perm );
     rinox::evaluation::chains::time_canonize( chain, lib_, database_[row].symm );
 
     bool is_inserted = add( chain, row );
@@ -270,7 +738,65 @@ public:
     return add( chain );
   }
 
+  /*! \brief Insert the entries of another database
+   *
+   * The entries are inserted row by row, in the order of the other database,
+   * and the dominated entries are pruned as in `add`. Hence, merging the same
+   * databases in the same order gives the same result. Returns the number of
+   * entries inserted.
+   */
+  uint64_t merge( mapped_database& other )
+  {
+    uint64_t num_inserted = 0u;
+    for ( database_row_t const& row : other.database_ )
+    {
+      for ( database_entry_t const& entry : row.entries )
+      {
+        evaluation::chains::bound_chain<design_t> chain( MaxNumVars );
+        rinox::evaluation::chains::extract( chain, other.ntk_, other.pis_, other.ntk_.make_signal( entry.index ) );
+        num_inserted += add( chain ) ? 1u : 0u;
+      }
+    }
+    return num_inserted;
+  }
+
 private:
+  /*! \brief Match of a function, creating its row if the class is not in the database yet */
+  match_t memoize_match( truth_table_t const& tt )
+  {
+    ++st_.num_lookups;
+    if ( auto const match = get_cached_match( tt ) )
+      return *match;
+
+    ++st_.num_canonizations;
+    auto const [repr, perm] = canonizer_( tt );
+    auto const it = repr_to_row_.find( repr );
+    uint64_t row_index;
+    if ( it != repr_to_row_.end() )
+    {
+      row_index = it->second;
+    }
+    else
+    {
+      row_index = database_.size();
+      database_.emplace_back();
+      database_.back().symm = boolean::symmetries_t( repr );
+      database_.back().repr = repr;
+      repr_to_row_[repr] = row_index;
+    }
+
+    match_t const match{ perm, row_index };
+    cache( tt, match );
+    return match;
+  }
+
+  /*! \brief Insert a chain in a row, keeping the Pareto front of the row
+   *
+   * The chain is rejected if an entry of the row is at least as good in area,
+   * switches, and every pin delay. Otherwise, all the entries dominated by the
+   * chain, i.e. no better in any of these objectives, are removed, and their
+   * outputs are redirected to the chain.
+   */
   bool add( evaluation::chains::bound_chain<design_t>& chain, uint64_t row )
   {
     database_entry_t entry;
@@ -278,28 +804,44 @@ private:
     entry.switches = simulator_.get_switches( chain );
     entry.delays = get_longest_paths( chain, lib_ );
 
-    for ( auto i = 0u; i < database_[row].size(); ++i )
+    auto& entries = database_[row].entries;
+    for ( database_entry_t const& other : entries )
     {
-      if ( entry >= database_[row][i] )
-      {
+      if ( entry >= other )
         return false;
+    }
+
+    // TODO: add capacity
+    auto const f = insert( ntk_, pis_, chain );
+    entry.index = ntk_.get_node( f );
+
+    /* the first dominated entry is replaced, the others are erased */
+    bool is_replaced = false;
+    for ( auto i = 0u; i < entries.size(); )
+    {
+      if ( !( entries[i] >= entry ) )
+      {
+        ++i;
+        continue;
       }
-      else if ( entry < database_[row][i] )
+      ntk_.substitute_node( entries[i].index, f );
+      if ( is_replaced )
       {
-        auto const f = insert( ntk_, pis_, chain );
-        ntk_.substitute_node( database_[row][i].index, f );
-        entry.index = ntk_.get_node( f );
-        database_[row][i] = entry;
-        return true;
+        entries.erase( entries.begin() + i );
+      }
+      else
+      {
+        entries[i++] = entry;
+        is_replaced = true;
       }
     }
-    // TODO: add capacity
-    auto const f = insert( ntk_, pis_, chain );
+    if ( is_replaced )
+      return true;
+
     if ( ntk_.is_po( f ) )
       return false; // do not re-insert POs in the database
     ntk_.create_po( f );
-    entry.index = ntk_.get_node( f );
-    database_[row].push_back( entry );
+    entries.push_back( entry );
     return true;
   }
 #pragma endregion
@@ -340,20 +882,85 @@ public:
     auto match = get_match( func );
     if ( match )
     {
-      auto const row_index = ( *match ).row;
-      database_row_t const& row = database_[row_index];
-      auto const perm = ( *match ).perm;
-      auto const symm = row.symm;
+      match_inputs( ( *match ).row, ( *match ).perm, times, others... );
+      return ( *match ).row;
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief Boolean matching of an incompletely specified function.
+   *
+   * Calls `fn( row, perm )` for each completion of the function whose P-class
+   * is stored in the database, without enumerating the completions. The
+   * completions only depend on the first `num_vars` variables. The inputs are
+   * then arranged for the row with `match_inputs`.
+   *
+   * The P-classes of the rows are expanded once in an index, where the rows
+   * are grouped by number of minterms, which is invariant under permutation.
+   * Hence, only the rows whose number of minterms lies between the ones of the
+   * smallest and of the largest completion are checked. The matches are cached,
+   * so that looking up again the same function costs as many steps as matches.
+   *
+   * The index stores up to `MaxNumVars!` functions per row, and the number of
+   * rows checked grows with the number of don't cares. Hence, the lookup suits
+   * the functions with few don't cares, whose completions are few as well.
+   */
+  template<typename Fn>
+  void foreach_compatible_row( kitty::ternary_truth_table<truth_table_t> const& func, uint32_t num_vars, Fn&& fn )
+  {
+    truth_table_t const care = func._care;
+    truth_table_t const bits = func._bits & care;
+
+    /* completely specified functions go through the cache of the matches */
+    if ( kitty::is_const0( ~care ) )
+    {
+      if ( auto const match = get_match( bits ) )
+        fn( match->row, match->perm );
+      return;
+    }
 
-      // Apply permutation to all vectors simultaneously
-      boolean::forward_permute_inplace( perm, times, others... );
+    ++st_.num_dc_lookups;
+    update_dc_index();
 
-      // Apply time-based symmetric sorting to all vectors simultaneously
-      boolean::sort_symmetric( symm, [&]( auto const& a, auto const& b ) { return a < b; }, times, others... );
+    dc_key_t const key{ bits, care, num_vars };
+    auto it = dc_cache_.find( key );
+    if ( it != dc_cache_.end() )
+    {
+      ++st_.num_dc_hits;
+    }
+    else
+    {
+      if ( dc_cache_.size() >= dc_cache_size_ )
+        dc_cache_.clear();
+      it = dc_cache_.emplace( key, compatible_functions( bits, care, num_vars ) ).first;
+    }
 
-      return row_index;
+    for ( uint32_t const index : it->second )
+    {
+      orbit_entry_t const& entry = orbits_[index];
+      if ( database_[entry.row].size() == 0 )
+        continue;
+      ++st_.num_dc_matches;
+      fn( static_cast<uint64_t>( entry.row ), unpack_permutation( entry.fmap ) );
     }
-    return std::nullopt;
+  }
+
+  /*! \brief Arrange the inputs of a function for the row it matches.
+   *
+   * The vectors are permuted to follow the variables of the representative,
+   * and the symmetric variables are sorted by increasing time.
+   */
+  template<typename Time, typename... Vecs>
+  void match_inputs( uint64_t row_index, boolean::permutation_t const& perm, std::vector<Time>& times, Vecs&... others )
+  {
+    times.resize( MaxNumVars, std::numeric_limits<double>::max() );
+    ( ( (void)others.resize( MaxNumVars ) ), ... );
+
+    // Apply permutation to all vectors simultaneously
+    boolean::forward_permute_inplace( perm, times, others... );
+
+    // Apply time-based symmetric sorting to all vectors simultaneously
+    boolean::sort_symmetric( database_[row_index].symm, [&]( auto const& a, auto const& b ) { return a < b; }, times, others... );
   }
 
   template<typename Fn>
@@ -407,28 +1014,234 @@ public:
     return insert( index );
   }
 
+  /*! \brief Area added to a network by writing an entry with structural hashing.
+   *
+   * The gates of the entry are looked up in `ntk` bottom-up, as done when the
+   * entry is committed with `create_node<true>`. A gate whose fanins and binding
+   * IDs match a live node `n` of `ntk` does not contribute to the area if
+   * `is_shared( n )` holds. The network is not modified.
+   */
+  template<typename Ntk, typename Fn>
+  double get_area_after_sharing( database_entry_t const& entry, Ntk const& ntk, std::vector<signal_t> const& leaves, Fn&& is_shared )
+  {
+    ntk_.incr_trav_id();
+
+    /* the value of a gate is its index in `ntk` plus one, or zero if the gate is not in `ntk`.
+     * The inputs are always in `ntk`, and their children are read from the leaves.
+     * The gates are visited in post-order, once their fanins have a value */
+    double area = 0.0;
+    sharing_stack_.assign( 1u, { entry.index, false } );
+    while ( !sharing_stack_.empty() )
+    {
+      auto const [n, expanded] = sharing_stack_.back();
+      if ( ntk_.visited( n ) == ntk_.trav_id() )
+      {
+        sharing_stack_.pop_back();
+        continue;
+      }
+      if ( ntk_.is_pi( n ) )
+      {
+        sharing_stack_.pop_back();
+        ntk_.set_visited( n, ntk_.trav_id() );
+        ntk_.set_value( n, 1u );
+        continue;
+      }
+      if ( !expanded )
+      {
+        sharing_stack_.back().second = true;
+        ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+          auto const ni = ntk_.get_node( fi );
+          if ( ntk_.visited( ni ) != ntk_.trav_id() )
+            sharing_stack_.emplace_back( ni, false );
+        } );
+        continue;
+      }
+      sharing_stack_.pop_back();
+      ntk_.set_visited( n, ntk_.trav_id() );
+
+      bool in_ntk = true;
+      sharing_children_.resize( ntk_.fanin_size( n ) );
+      ntk_.foreach_fanin( n, [&]( auto const& fi, auto i ) {
+        auto const ni = ntk_.get_node( fi );
+        auto const value = ntk_.value( ni );
+        in_ntk &= value > 0u;
+        if ( ntk_.is_pi( ni ) )
+          sharing_children_[i] = leaves[ntk_.pi_index( ni )];
+        else if ( value > 0u )
+          sharing_children_[i] = signal_t{ value - 1u, fi.output };
+      } );
+
+      std::optional<typename Ntk::node> nold;
+      if ( in_ntk )
+        nold = ntk.find_node( sharing_children_, ntk_.get_binding_ids( n ) );
+      if ( !nold )
+      {
+        area += ntk_.get_area( n );
+        ntk_.set_value( n, 0u );
+        continue;
+      }
+      if ( !is_shared( *nold ) )
+        area += ntk_.get_area( n );
+      ntk_.set_value( n, *nold + 1u );
+    }
+    return area;
+  }
+
 private:
+  std::optional<match_t> get_cached_match( truth_table_t const& tt )
+  {
+    if ( cache_.empty() )
+      return std::nullopt;
+    cache_slot_t const& slot = cache_[hash_( tt ) & ( cache_.size() - 1 )];
+    if ( !slot.valid || !kitty::equal( slot.func, tt ) )
+      return std::nullopt;
+    ++st_.num_hits;
+    return slot.match;
+  }
+
   std::optional<match_t> get_match( truth_table_t const& tt )
   {
-    const auto it0 = func_to_match_.find( tt );
-    if ( it0 != func_to_match_.end() )
+    ++st_.num_lookups;
+    if ( auto const match = get_cached_match( tt ) )
+      return match;
+
+    ++st_.num_canonizations;
+    auto const [repr, perm] = canonizer_( tt );
+    const auto it = repr_to_row_.find( repr );
+    if ( it != repr_to_row_.end() )
     {
-      return ( it0->second );
+      match_t const match{ perm, it->second };
+      cache( tt, match );
+      return match;
     }
-    else
+    /* functions without a row are not cached, as the row can be created later */
+    return std::nullopt;
+  }
+
+  void cache( truth_table_t const& tt, match_t const& match )
+  {
+    if ( cache_.empty() )
+      return;
+    cache_slot_t& slot = cache_[hash_( tt ) & ( cache_.size() - 1 )];
+    slot.func = tt;
+    slot.match = match;
+    slot.valid = true;
+  }
+
+  void clear_cache()
+  {
+    for ( cache_slot_t& slot : cache_ )
+      slot.valid = false;
+  }
+
+  /*! \brief Indices in the orbits of the functions compatible with an on-set and a care-set */
+  std::vector<uint32_t> compatible_functions( truth_table_t const& bits, truth_table_t const& care, uint32_t num_vars ) const
+  {
+    uint32_t const outside_support = ~( ( 1u << num_vars ) - 1u );
+    uint64_t const min_ones = kitty::count_ones( bits );
+    uint64_t const max_ones = kitty::count_ones( bits | ~care );
+
+    std::vector<uint32_t> res;
+    for ( uint64_t ones = min_ones; ones <= max_ones; ++ones )
     {
-      auto [repr, _, perm] = kitty::exact_p_canonization( tt );
-      const auto it1 = repr_to_row_.find( repr );
-      /* insert in the database */
-      if ( it1 != repr_to_row_.end() )
+      for ( uint32_t const row : rows_by_ones_[ones] )
       {
-        uint64_t const row = it1->second;
-        auto const match = match_t{ boolean::permutation_t( perm ), row };
-        func_to_match_[tt] = match;
-        return match;
+        for ( uint32_t i = orbit_offsets_[row]; i < orbit_offsets_[row + 1]; ++i )
+        {
+          orbit_entry_t const& entry = orbits_[i];
+          if ( ( entry.support & outside_support ) == 0u && kitty::is_const0( ( entry.func ^ bits ) & care ) )
+            res.push_back( i );
+        }
       }
     }
-    return std::nullopt;
+    return res;
+  }
+
+  /*! \brief Add the P-classes of the rows created since the last lookup to the index */
+  void update_dc_index()
+  {
+    if ( rows_by_ones_.empty() )
+    {
+      rows_by_ones_.resize( ( 1u << MaxNumVars ) + 1u );
+      orbit_offsets_.assign( 1u, 0u );
+    }
+    if ( orbit_offsets_.size() == database_.size() + 1 )
+      return;
+
+    /* the cached matches do not include the new rows */
+    dc_cache_.clear();
+    phmap::flat_hash_set<truth_table_t, kitty::hash<truth_table_t>> visited;
+    for ( auto row = orbit_offsets_.size() - 1; row < database_.size(); ++row )
+    {
+      add_orbit( static_cast<uint32_t>( row ), visited );
+      rows_by_ones_[kitty::count_ones( database_[row].repr )].push_back( static_cast<uint32_t>( row ) );
+      orbit_offsets_.push_back( static_cast<uint32_t>( orbits_.size() ) );
+    }
+  }
+
+  /*! \brief Enumerate the distinct functions obtained by permuting the representative of a row
+   *
+   * The permutations are generated with Heap's algorithm, so that each one is
+   * obtained from the previous one by swapping two variables.
+   */
+  void add_orbit( uint32_t row, phmap::flat_hash_set<truth_table_t, kitty::hash<truth_table_t>>& visited )
+  {
+    truth_table_t func = database_[row].repr;
+    /* variable of the representative at each position of the function */
+    std::array<uint8_t, MaxNumVars> at;
+    std::array<uint8_t, MaxNumVars> counters{};
+    for ( uint8_t i = 0; i < MaxNumVars; ++i )
+      at[i] = i;
+
+    visited.clear();
+    auto const visit = [&]() {
+      if ( !visited.insert( func ).second )
+        return;
+      orbit_entry_t entry{ func, 0u, row, 0u };
+      for ( uint8_t i = 0; i < MaxNumVars; ++i )
+      {
+        entry.fmap |= static_cast<uint64_t>( i ) << ( 4u * at[i] );
+        entry.support |= kitty::has_var( func, i ) ? ( 1u << i ) : 0u;
+      }
+      orbits_.push_back( entry );
+    };
+
+    visit();
+    uint32_t i = 1u;
+    while ( i < MaxNumVars )
+    {
+      if ( counters[i] < i )
+      {
+        uint32_t const j = ( i % 2u == 0u ) ? 0u : counters[i];
+        kitty::swap_inplace( func, j, i );
+        std::swap( at[j], at[i] );
+        visit();
+        ++counters[i];
+        i = 1u;
+      }
+      else
+      {
+        counters[i] = 0u;
+        ++i;
+      }
+    }
+  }
+
+  static boolean::permutation_t unpack_permutation( uint64_t fmap )
+  {
+    boolean::permutation_t perm;
+    perm.num_vars = MaxNumVars;
+    for ( uint8_t i = 0; i < MaxNumVars; ++i )
+      perm.set( i, ( fmap >> ( 4u * i ) ) & 0xF );
+    return perm;
+  }
+
+  void clear_dc_index()
+  {
+    orbits_.clear();
+    orbit_offsets_.clear();
+    rows_by_ones_.clear();
+    dc_cache_.clear();
   }
 
   template<typename E, typename T>
@@ -459,8 +1272,7 @@ private:
   /*! \brief Map a truth table to a storage of nodes and input permutations */
   std::vector<database_row_t> database_;
 
-  /*! \brief Map a completely specified truth table to a database row */
-  phmap::flat_hash_map<truth_table_t, match_t, kitty::hash<truth_table_t>> func_to_match_;
+  /*! \brief Map a representative to a database row */
   phmap::flat_hash_map<truth_table_t, uint64_t, kitty::hash<truth_table_t>> repr_to_row_;
 
   /*! \brief Database represented as a network */
@@ -476,6 +1288,26 @@ private:
   /*! \brief Vector of simulationpatterns */
   std::array<truth_table_t, MaxNumVars> proj_funcs_;
   std::vector<truth_table_t const*> sims_ptrs_;
+
+  /*! \brief Bounded cache mapping a completely specified truth table to its match */
+  std::vector<cache_slot_t> cache_;
+  kitty::hash<truth_table_t> hash_;
+  boolean::p_canonizer<MaxNumVars> canonizer_;
+
+  /*! \brief Functions of the P-classes of the rows, stored row by row */
+  std::vector<orbit_entry_t> orbits_;
+  std::vector<uint32_t> orbit_offsets_;
+  /*! \brief Rows grouped by the number of minterms of their representative */
+  std::vector<std::vector<uint32_t>> rows_by_ones_;
+  /*! \brief Cache mapping an incompletely specified function to its matches in the orbits */
+  phmap::flat_hash_map<dc_key_t, std::vector<uint32_t>, dc_key_hash_t> dc_cache_;
+  uint32_t dc_cache_size_{ 1u << 14 };
+
+  /*! \brief Buffers of the traversal of `get_area_after_sharing` */
+  std::vector<std::pair<node_index_t, bool>> sharing_stack_;
+  std::vector<signal_t> sharing_children_;
+
+  mapped_database_stats st_;
 };
 
 } /* namespace databases */
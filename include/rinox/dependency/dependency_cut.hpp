@@ -35,6 +35,13 @@
 #include "../boolean/simd.hpp"
 #include <kitty/kitty.hpp>
 
+#include <array>
+#include <cstdint>
+#include <fmt/format.h>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
 namespace rinox
 {
 
@@ -109,6 +116,8 @@ public:
   node_index_t root;
   std::vector<functionality_t> func;
   std::vector<signal_t> leaves;
+  /*! \brief Bit i is set if leaf i is connected through an inverter ( rewiring only ) */
+  uint32_t inverted{ 0 };
 };
 
 template<uint32_t NumVars>
@@ -156,6 +165,48 @@ kitty::ternary_truth_table<kitty::static_truth_table<NumVars>> extract_function(
   return tt;
 }
 
+struct function_enumerator_params
+{
+  /*! \brief Maximum number of don't cares assigned in all possible ways.
+   *
+   * The don't cares exceeding the limit keep the value zero, so that at most
+   * `2^max_dont_cares` completions are enumerated.
+   */
+  uint32_t max_dont_cares{ 10u };
+};
+
+struct function_enumerator_stats
+{
+  /*! \brief Number of incompletely specified functions enumerated. */
+  uint64_t num_functions{ 0 };
+
+  /*! \brief Number of completions passed to the callers. */
+  uint64_t num_completions{ 0 };
+
+  /*! \brief Number of functions with more don't cares than the limit. */
+  uint64_t num_capped{ 0 };
+
+  /*! \brief Number of enumerations stopped by the caller. */
+  uint64_t num_cutoffs{ 0 };
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] dc functions     = {:8d}\n", num_functions );
+    std::cout << fmt::format( "    dc completions   = {:8d}\n", num_completions );
+    std::cout << fmt::format( "    dc capped        = {:8d}\n", num_capped );
+    std::cout << fmt::format( "    dc cutoffs       = {:8d}\n", num_cutoffs );
+  }
+};
+
+/*! \brief Enumeration of the completions of incompletely specified functions.
+ *
+ * The completions are visited in Gray-code order: each one is obtained from
+ * the previous one by flipping a single don't care minterm, that is a XOR with
+ * the precomputed mask of the minterm. The callback can stop the enumeration
+ * by returning `false`.
+ *
+ * \tparam NumVars Number of variables of the truth tables
+ */
 template<uint32_t NumVars>
 class function_enumerator
 {
@@ -163,83 +214,115 @@ public:
   using truth_table_t = kitty::static_truth_table<NumVars>;
   using functionality_t = kitty::ternary_truth_table<truth_table_t>;
 
-  function_enumerator()
+  function_enumerator( function_enumerator_params const& ps = {} )
+      : function_enumerator( ps, own_st_ )
+  {}
+
+  function_enumerator( function_enumerator_params const& ps, function_enumerator_stats& st )
+      : ps_( ps ),
+        st_( st )
   {
+    std::array<truth_table_t, NumVars> proj_funcs;
     for ( auto i = 0u; i < NumVars; ++i )
-      kitty::create_nth_var( proj_funcs_[i], i );
+      kitty::create_nth_var( proj_funcs[i], i );
+
+    /* minterms of the first k variables, for each k */
+    minterms_[0].emplace_back();
+    boolean::set_ones( minterms_[0].back() );
+    for ( auto k = 1u; k <= NumVars; ++k )
+    {
+      for ( uint64_t m = 0u; m < ( uint64_t( 1 ) << k ); ++m )
+      {
+        truth_table_t const& lit = ( ( m >> ( k - 1 ) ) & 0x1 ) > 0 ? proj_funcs[k - 1] : ~proj_funcs[k - 1];
+        minterms_[k].push_back( boolean::binary_and( minterms_[k - 1][m & ~( uint64_t( 1 ) << ( k - 1 ) )], lit ) );
+      }
+    }
   }
 
-  template<typename Fn>
-  void foreach_dont_care_assignment( functionality_t const& func, uint32_t num_vars, Fn&& fn )
+  function_enumerator( function_enumerator const& ) = delete;
+  function_enumerator& operator=( function_enumerator const& ) = delete;
+
+  /*! \brief Number of don't cares of a function of the first `num_vars` variables. */
+  uint32_t num_dont_cares( functionality_t const& func, uint32_t num_vars )
   {
-    uint32_t const num_minterms = 1u << num_vars;
+    collect_dont_cares( func, num_vars );
+    return static_cast<uint32_t>( dont_cares_.size() );
+  }
 
-    enumerate_dont_cares( func, num_vars );
+  /*! \brief Call `fn` on the completions of a function of the first `num_vars` variables.
+   *
+   * Returns the number of completions visited.
+   */
+  template<typename Fn>
+  uint64_t foreach_dont_care_assignment( functionality_t const& func, uint32_t num_vars, Fn&& fn )
+  {
+    ++st_.num_functions;
+    collect_dont_cares( func, num_vars );
 
-    truth_table_t const care = func._care;
-    truth_table_t const bits = boolean::binary_and( care, func._bits );
-    truth_table_t tmp;
+    uint32_t num_free = static_cast<uint32_t>( dont_cares_.size() );
+    if ( num_free > ps_.max_dont_cares )
+    {
+      num_free = ps_.max_dont_cares;
+      ++st_.num_capped;
+    }
 
-    uint64_t num_funcs = 1u << dont_cares_[0].size();
-    for ( uint64_t f = 0u; f < num_funcs; ++f )
+    truth_table_t tt = boolean::binary_and( func._care, func._bits );
+    uint64_t const num_funcs = uint64_t( 1 ) << num_free;
+    for ( uint64_t f = 1u;; ++f )
     {
-      truth_table_t tt = bits;
-      for ( auto i = 0u; i < dont_cares_[0].size(); ++i )
+      ++st_.num_completions;
+      if constexpr ( std::is_same_v<std::invoke_result_t<Fn, truth_table_t const&>, bool> )
       {
-        if ( ( ( f >> i ) & 0x1 ) > 0 )
+        if ( !fn( static_cast<truth_table_t const&>( tt ) ) )
         {
-          auto const m = dont_cares_[0][i];
-          boolean::set_ones( tmp );
-          for ( auto v = 0u; v < num_vars; ++v )
-          {
-            if ( ( ( m >> v ) & 0x1 ) > 0 )
-              tmp = boolean::binary_and( tmp, proj_funcs_[v] );
-            else
-              tmp = boolean::binary_and( tmp, boolean::unary_not( proj_funcs_[v] ) );
-          }
-          tt = boolean::binary_or( tt, tmp );
+          ++st_.num_cutoffs;
+          return f;
         }
       }
-      fn( tt );
+      else
+      {
+        fn( static_cast<truth_table_t const&>( tt ) );
+      }
+      if ( f == num_funcs )
+        return num_funcs;
+
+      /* the Gray codes of f - 1 and f differ in the lowest set bit of f */
+      uint32_t bit = 0u;
+      while ( ( ( f >> bit ) & 0x1 ) == 0 )
+        ++bit;
+      tt = boolean::binary_xor( tt, *dont_cares_[bit] );
     }
   }
 
   template<typename Ntk, typename Fn>
-  void foreach_dont_care_assignment( dependency_cut_t<Ntk, NumVars> const& cut, Fn&& fn )
+  uint64_t foreach_dont_care_assignment( dependency_cut_t<Ntk, NumVars> const& cut, Fn&& fn )
+  {
+    return foreach_dont_care_assignment( cut.func[0], cut.leaves.size(), std::forward<Fn>( fn ) );
+  }
+
+  function_enumerator_stats const& get_stats() const
   {
-    foreach_dont_care_assignment( cut.func[0], cut.inputs.size(), [&]( auto const& tt ) {
-      fn( tt );
-    } );
+    return st_;
   }
 
 private:
-  void enumerate_dont_cares( functionality_t const& tt, uint32_t num_vars )
+  void collect_dont_cares( functionality_t const& tt, uint32_t num_vars )
   {
-    uint64_t const num_minterms = 1u << num_vars;
     dont_cares_.clear();
-    truth_table_t tmp;
+    for ( auto const& minterm : minterms_[num_vars] )
     {
-
-      dont_cares_.emplace_back();
-      for ( uint64_t m = 0; m < num_minterms; ++m )
-      {
-        boolean::set_ones( tmp );
-        for ( auto i = 0u; i < num_vars; ++i )
-        {
-          if ( ( ( m >> i ) & 0x1 ) > 0 )
-            tmp = boolean::binary_and( tmp, proj_funcs_[i] );
-          else
-            tmp = boolean::binary_and( tmp, boolean::unary_not( proj_funcs_[i] ) );
-        }
-        if ( kitty::count_ones( boolean::binary_and( tmp, tt._care ) ) <= 0 )
-          dont_cares_.back().push_back( m );
-      }
+      if ( kitty::is_const0( boolean::binary_and( minterm, tt._care ) ) )
+        dont_cares_.push_back( &minterm );
     }
   }
 
 private:
-  std::array<truth_table_t, NumVars> proj_funcs_;
-  std::vector<std::vector<uint32_t>> dont_cares_;
+  function_enumerator_params ps_;
+  function_enumerator_stats own_st_;
+  function_enumerator_stats& st_;
+  /*! \brief Masks of the minterms of the first k variables, for each k */
+  std::array<std::vector<truth_table_t>, NumVars + 1> minterms_;
+  std::vector<truth_table_t const*> dont_cares_;
 };
 
 } // namespace dependency
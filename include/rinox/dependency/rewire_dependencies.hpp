@@ -34,6 +34,14 @@
 
 #include "dependency_cut.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <parallel_hashmap/phmap.h>
+
 namespace rinox
 {
 
@@ -45,6 +53,20 @@ struct default_rewire_params
   static constexpr uint32_t max_cuts_size = 6u;
 };
 
+/*! \brief Rewiring of the fanins of a pivot to equivalent divisors.
+ *
+ * A fanin of the pivot can be replaced by a divisor that has the same value
+ * on all the patterns where the fanin is observable. When the library has an
+ * inverter, a divisor with the complemented value is also accepted, and the
+ * leaf is marked in the `inverted` mask of the cut.
+ *
+ * The divisors are grouped in classes of divisors with the same signature on
+ * the observability careset of the window, and the classes are hashed on it
+ * once per window. The careset of each fanin is contained in the observability
+ * careset, hence a class matching the fanin, or its complement, on the latter
+ * is a valid rewiring, and it is found with one probe of the index. Divisors
+ * agreeing with the fanin only on the fanin careset are not considered.
+ */
 template<class Ntk, typename StaticParams = default_rewire_params>
 class rewire_dependencies
 {
@@ -58,7 +80,8 @@ public:
 
 public:
   rewire_dependencies( Ntk& ntk )
-      : ntk_( ntk )
+      : ntk_( ntk ),
+        inverter_id_( ntk.get_augmented_library().get_inverter_id() )
   {
   }
 
@@ -87,6 +110,8 @@ public:
     } );
 
     signature_t obs_care = simulator.get_careset();
+    index_divisors( window, simulator, obs_care );
+
     ntk_.foreach_fanin( n, [&]( auto fi, auto ii ) {
       signature_t flipped = ~simulator.get( fi );
       sim_ptrs[ii] = &flipped;
@@ -97,20 +122,24 @@ public:
         dont_care |= ~( tts_flip[i] ^ tts_curr[i] );
       }
       auto const care = ~dont_care;
-      std::vector<signal_t> leaves = leaves_curr;
-      window.foreach_divisor( [&]( auto const& f, auto i ) {
-        if ( f != fi )
+      auto const& sim_curr = simulator.get( fi );
+
+      match_divisors( window, simulator, sim_curr, obs_care );
+      if ( !matches_.empty() )
+      {
+        auto const func = extract_function<signature_t, max_cuts_size>( sim_ptrs, sim_curr, care );
+        std::vector<signal_t> leaves = leaves_curr;
+        for ( auto const& [index, inverted] : matches_ )
         {
-          auto const& sim_curr = simulator.get( fi );
-          auto const& sim_cand = simulator.get( f );
-          if ( kitty::equal( sim_curr & care, sim_cand & care ) )
-          {
-            leaves[ii] = f;
-            auto func = extract_function<signature_t, max_cuts_size>( sim_ptrs, sim_curr, care );
-            cuts.emplace_back( dependency_t::REWIRE_DEP, n, leaves, func );
-          }
+          auto const& f = window.get_divisor( index );
+          if ( f == fi )
+            continue;
+          leaves[ii] = f;
+          cuts.emplace_back( dependency_t::REWIRE_DEP, n, leaves, func );
+          if ( inverted )
+            cuts.back().inverted = 1u << ii;
         }
-      } );
+      }
 
       sim_ptrs[ii] = &simulator.get( fi );
     } );
@@ -125,11 +154,122 @@ public:
     }
   }
 
+  /*! \brief Binding id of the inverter used by complemented rewirings, if any. */
+  std::optional<unsigned int> get_inverter_id() const
+  {
+    return inverter_id_;
+  }
+
+private:
+  static constexpr uint32_t no_class = std::numeric_limits<uint32_t>::max();
+
+  /*! \brief Hash of the signature, complemented if `complement` is all ones, on the careset */
+  template<typename Signature>
+  static uint64_t masked_hash( Signature const& sign, Signature const& care, uint64_t complement = 0u )
+  {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for ( auto b = 0u; b < sign.num_blocks(); ++b )
+    {
+      h ^= ( *( sign.cbegin() + b ) ^ complement ) & *( care.cbegin() + b );
+      h *= 0x100000001b3ull;
+      h ^= h >> 29u;
+    }
+    return h;
+  }
+
+  /*! \brief True if the signatures are equal on the careset, starting from block `first` */
+  template<typename Signature>
+  static bool equal_on( Signature const& sign, Signature const& other, Signature const& care, uint64_t complement, uint32_t first )
+  {
+    for ( auto b = first; b < sign.num_blocks(); ++b )
+    {
+      if ( ( ( *( sign.cbegin() + b ) ^ *( other.cbegin() + b ) ^ complement ) & *( care.cbegin() + b ) ) != 0u )
+        return false;
+    }
+    return true;
+  }
+
+  /*! \brief Group the divisors with the same signature on the observability careset.
+   *
+   * The classes are hashed on the careset, and the classes whose hashes
+   * collide are chained in the same bucket.
+   */
+  template<typename WinMng, typename WinSim>
+  void index_divisors( WinMng const& window, WinSim const& simulator, typename WinSim::signature_t const& obs_care )
+  {
+    classes_.clear();
+    members_.clear();
+    next_in_bucket_.clear();
+    bucket_of_hash_.clear();
+    first_care_ = 0u;
+    while ( ( first_care_ < obs_care.num_blocks() ) && ( *( obs_care.cbegin() + first_care_ ) == 0u ) )
+      ++first_care_;
+
+    window.foreach_divisor( [&]( auto const& f, auto i ) {
+      auto const& sign = simulator.get( f );
+      auto const [it, inserted] = bucket_of_hash_.try_emplace( masked_hash( sign, obs_care ), no_class );
+      for ( auto c = it->second; c != no_class; c = next_in_bucket_[c] )
+      {
+        if ( equal_on( simulator.get( window.get_divisor( classes_[c] ) ), sign, obs_care, 0u, first_care_ ) )
+        {
+          members_[c].push_back( i );
+          return;
+        }
+      }
+      next_in_bucket_.push_back( it->second );
+      it->second = static_cast<uint32_t>( classes_.size() );
+      classes_.push_back( i );
+      members_.emplace_back( 1u, i );
+    } );
+  }
+
+  /*! \brief Collect the divisors equal to the fanin, or to its complement, on the careset.
+   *
+   * The careset is the observability careset used to index the divisors.
+   */
+  template<typename WinMng, typename WinSim, typename Signature>
+  void match_divisors( WinMng const& window, WinSim const& simulator, Signature const& sign, Signature const& care )
+  {
+    matches_.clear();
+
+    auto const match_bucket = [&]( uint64_t complement ) {
+      auto const it = bucket_of_hash_.find( masked_hash( sign, care, complement ) );
+      if ( it == bucket_of_hash_.end() )
+        return;
+      /* the classes in the bucket may differ on the careset after a hash collision */
+      for ( auto c = it->second; c != no_class; c = next_in_bucket_[c] )
+      {
+        if ( !equal_on( simulator.get( window.get_divisor( classes_[c] ) ), sign, care, complement, first_care_ ) )
+          continue;
+        for ( auto const& index : members_[c] )
+          matches_.emplace_back( index, complement != 0u );
+        return;
+      }
+    };
+    match_bucket( 0u );
+    /* with an empty careset, every divisor already matches without inverter */
+    if ( inverter_id_ && first_care_ < care.num_blocks() )
+      match_bucket( ~uint64_t( 0 ) );
+
+    /* candidates in the order of the divisors */
+    std::sort( matches_.begin(), matches_.end() );
+  }
+
 private:
   Ntk& ntk_;
   std::vector<cut_t> cuts;
+  std::optional<unsigned int> inverter_id_;
+  /*! \brief Representative divisor of each class, and divisors in the class */
+  std::vector<uint32_t> classes_;
+  std::vector<std::vector<uint32_t>> members_;
+  /*! \brief First class of each bucket on the observability careset, and next class in the same bucket */
+  phmap::flat_hash_map<uint64_t, uint32_t> bucket_of_hash_;
+  std::vector<uint32_t> next_in_bucket_;
+  /*! \brief First block of the observability careset that is not empty */
+  uint32_t first_care_ = 0u;
+  std::vector<std::pair<uint32_t, bool>> matches_;
 };
 
 } // namespace dependency
 
-} // namespace rinox
\ No newline at end of file
+} // namespace rinox
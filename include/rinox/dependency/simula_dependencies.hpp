@@ -0,0 +1,708 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file simula_dependencies.hpp
+  \brief Simulation-guided dependencies validated with SAT.
+
+  \author Andrea Costamagna
+*/
+
+#pragma once
+
+#include "../analyzers/trackers/simulation_tracker.hpp"
+#include "../boolean/spfd.hpp"
+#include "dependency_cut.hpp"
+
+#include <bill/sat/solver.hpp>
+#include <fmt/format.h>
+#include <kitty/isop.hpp>
+#include <parallel_hashmap/phmap.h>
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace rinox
+{
+
+namespace dependency
+{
+
+struct default_simula_params
+{
+  /*! \brief Cube size of the global simulation patterns */
+  static constexpr uint32_t num_vars_sign = 6u;
+  static constexpr uint32_t max_cuts_size = 6u;
+  /*! \brief Maximum number of divisors collected in the transitive fanin of the pivot */
+  static constexpr uint32_t max_num_divisors = 64u;
+  /*! \brief Number of divisors used as first leaf of the candidate cuts */
+  static constexpr uint32_t max_num_seeds = 8u;
+  /*! \brief Maximum number of nodes encoded in the validation miter */
+  static constexpr uint32_t max_cone_size = 2000u;
+  /*! \brief Conflict limit of each SAT call ( 0 means no limit ) */
+  static constexpr uint32_t conflict_limit = 1000u;
+  /*! \brief Seed of the random simulation patterns */
+  static constexpr uint64_t seed = 0xcafeu;
+};
+
+struct simula_dependencies_stats
+{
+  /*! \brief Number of cuts proposed by simulation. */
+  uint64_t num_proposed{ 0 };
+
+  /*! \brief Number of cuts proved valid. */
+  uint64_t num_validated{ 0 };
+
+  /*! \brief Number of counter-examples added to the simulation patterns. */
+  uint64_t num_counterexamples{ 0 };
+
+  /*! \brief Number of SAT calls reaching the conflict limit. */
+  uint64_t num_unknown{ 0 };
+
+  /*! \brief Number of pivots whose cone exceeds the size limit. */
+  uint64_t num_skipped{ 0 };
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] simula proposed  = {:8d}\n", num_proposed );
+    std::cout << fmt::format( "    simula validated = {:8d}\n", num_validated );
+    std::cout << fmt::format( "    simula cex       = {:8d}\n", num_counterexamples );
+    std::cout << fmt::format( "    simula unknown   = {:8d}\n", num_unknown );
+    std::cout << fmt::format( "    simula skipped   = {:8d}\n", num_skipped );
+  }
+};
+
+/*! \brief Non-structural dependencies guided by global simulation.
+ *
+ * Each node of the network is simulated on the same set of random patterns,
+ * hence the divisors are not limited to the leaves of a window. The cuts are
+ * proposed greedily among the nodes in the transitive fanin of the pivot and
+ * the divisors of its window, by covering the SPFD of the pivot on the
+ * patterns. A cut is only reported if a SAT miter proves that the pivot is a
+ * function of its leaves. The assignments disproving a cut, as well as the
+ * ones reaching minterms of the leaves never simulated, are added to the
+ * simulation patterns, which are re-simulated before the next pivot.
+ *
+ * The global simulations are kept up-to-date by a simulation tracker, which
+ * re-simulates the transitive fanout of the modified nodes and of the inputs
+ * receiving a counter-example.
+ */
+template<class Ntk, typename StaticParams = default_simula_params>
+class simula_dependencies
+{
+public:
+  static constexpr uint32_t num_vars_sign = StaticParams::num_vars_sign;
+  static constexpr uint32_t max_cuts_size = StaticParams::max_cuts_size;
+  static constexpr uint32_t num_bits = 1u << num_vars_sign;
+  using signal_t = typename Ntk::signal;
+  using node_index_t = typename Ntk::node;
+  using signature_t = kitty::static_truth_table<num_vars_sign>;
+  using cut_t = dependency_cut_t<Ntk, max_cuts_size>;
+  using solver_t = bill::solver<bill::solvers::bsat2>;
+  using pattern_t = std::vector<std::pair<node_index_t, bool>>;
+
+public:
+  simula_dependencies( Ntk& ntk )
+      : simula_dependencies( ntk, own_st_ )
+  {}
+
+  simula_dependencies( Ntk& ntk, simula_dependencies_stats& st )
+      : ntk_( ntk ),
+        st_( st ),
+        sim_( ntk, simulation_params() )
+  {
+    boolean::set_ones( care_ );
+  }
+
+  simula_dependencies( simula_dependencies const& ) = delete;
+  simula_dependencies& operator=( simula_dependencies const& ) = delete;
+
+  template<typename WinMng, typename WinSim>
+  void run( WinMng& window, WinSim& simulator )
+  {
+    (void)simulator;
+    cuts_.clear();
+    window.mark_contained();
+
+    auto const n = window.get_pivot();
+    collect_divisors( window, n );
+    if ( divs_.empty() )
+      return;
+
+    propose_candidates( n );
+    if ( candidates_.empty() )
+      return;
+
+    st_.num_proposed += candidates_.size();
+    validate_candidates( n );
+    if ( !defer_patterns_ )
+      add_patterns();
+  }
+
+  /*! \brief Keep the counter-examples until `take_patterns` instead of simulating them after each pivot.
+   *
+   * Copies of the engine on copies of the network reach the same patterns if
+   * they receive the same counter-examples, in the same order, through
+   * `add_patterns`, independently of the pivots each one has analyzed.
+   */
+  void defer_patterns( bool value )
+  {
+    defer_patterns_ = value;
+  }
+
+  /*! \brief Move out the counter-examples not yet simulated */
+  std::vector<pattern_t> take_patterns()
+  {
+    std::vector<pattern_t> patterns;
+    patterns.swap( patterns_ );
+    return patterns;
+  }
+
+  /*! \brief Simulate a sequence of counter-examples */
+  void add_patterns( std::vector<pattern_t> const& patterns )
+  {
+    if ( patterns.empty() )
+      return;
+    for ( auto const& pattern : patterns )
+    {
+      for ( auto const& [n, value] : pattern )
+        sim_.set_input_bit( n, next_bit_, value );
+      next_bit_ = ( next_bit_ + 1u ) % num_bits;
+    }
+    sim_.update();
+  }
+
+  template<typename Fn>
+  void foreach_cut( Fn&& fn )
+  {
+    for ( auto i = 0u; i < cuts_.size(); ++i )
+    {
+      fn( cuts_[i], i );
+    }
+  }
+
+  /*! \brief Global simulation of a signal on the current patterns */
+  signature_t get( signal_t const& f ) const
+  {
+    signature_t sim;
+    sim_.load( sim, f );
+    return sim;
+  }
+
+  simula_dependencies_stats const& get_stats() const
+  {
+    return st_;
+  }
+
+#pragma region Global Simulation
+private:
+  static analyzers::trackers::simulation_tracker_params simulation_params()
+  {
+    analyzers::trackers::simulation_tracker_params ps;
+    ps.num_bits = num_bits;
+    ps.seed = StaticParams::seed;
+    return ps;
+  }
+
+  void new_mark()
+  {
+    if ( marks_.size() < ntk_.size() )
+      marks_.resize( ntk_.size(), 0u );
+    ++mark_;
+  }
+
+  /*! \brief Visit the unmarked nodes in the transitive fanin of `root` in topological order */
+  template<typename Fn>
+  void foreach_tfi_topological( node_index_t const& root, Fn&& fn )
+  {
+    if ( marks_[root] == mark_ )
+      return;
+    stack_.clear();
+    stack_.emplace_back( root, false );
+    while ( !stack_.empty() )
+    {
+      auto const [n, expanded] = stack_.back();
+      if ( expanded )
+      {
+        stack_.pop_back();
+        fn( n );
+        continue;
+      }
+      if ( marks_[n] == mark_ )
+      {
+        stack_.pop_back();
+        continue;
+      }
+      marks_[n] = mark_;
+      stack_.back().second = true;
+      ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+        if ( marks_[ntk_.get_node( fi )] != mark_ )
+          stack_.emplace_back( ntk_.get_node( fi ), false );
+      } );
+    }
+  }
+
+  /*! \brief Store the assignments collected during validation in the patterns */
+  void add_patterns()
+  {
+    add_patterns( patterns_ );
+    patterns_.clear();
+  }
+#pragma endregion
+
+#pragma region Candidates Identification
+  template<typename WinMng>
+  void collect_divisors( WinMng const& window, node_index_t const& n )
+  {
+    divs_.clear();
+    new_mark();
+    marks_[n] = mark_;
+
+    auto const add_node = [&]( node_index_t const& d ) {
+      if ( ( marks_[d] == mark_ ) || ntk_.is_constant( d ) || ( divs_.size() >= StaticParams::max_num_divisors ) )
+        return;
+      marks_[d] = mark_;
+      ntk_.foreach_output( d, [&]( auto const& f ) {
+        divs_.push_back( f );
+      } );
+    };
+
+    /* the divisors of the window are not in the transitive fanout of the pivot */
+    window.foreach_divisor( [&]( auto const& f, auto i ) {
+      add_node( ntk_.get_node( f ) );
+    } );
+
+    /* breadth-first traversal of the transitive fanin, beyond the window inputs */
+    if ( queued_.size() < ntk_.size() )
+      queued_.resize( ntk_.size(), 0u );
+    queue_.clear();
+    auto const enqueue = [&]( auto const& fi ) {
+      auto const d = ntk_.get_node( fi );
+      if ( queued_[d] != mark_ )
+      {
+        queued_[d] = mark_;
+        queue_.push_back( d );
+      }
+    };
+    ntk_.foreach_fanin( n, enqueue );
+    for ( auto i = 0u; ( i < queue_.size() ) && ( divs_.size() < StaticParams::max_num_divisors ); ++i )
+    {
+      add_node( queue_[i] );
+      ntk_.foreach_fanin( queue_[i], enqueue );
+    }
+
+    div_sims_.resize( divs_.size() );
+    for ( auto i = 0u; i < divs_.size(); ++i )
+      sim_.load( div_sims_[i], divs_[i] );
+    out_sims_.clear();
+    ntk_.foreach_output( n, [&]( auto const& f ) {
+      out_sims_.push_back( get( f ) );
+    } );
+  }
+
+  /*! \brief Greedy SPFD covering of the pivot, starting from the most informative divisors */
+  void propose_candidates( node_index_t const& n )
+  {
+    candidates_.clear();
+
+    std::vector<signature_t const*> funcs_ptrs;
+    for ( auto const& sim : out_sims_ )
+      funcs_ptrs.push_back( &sim );
+    spfds_.init( funcs_ptrs, care_ );
+
+    std::vector<std::pair<uint32_t, uint32_t>> scores( divs_.size() );
+    for ( auto i = 0u; i < divs_.size(); ++i )
+      scores[i] = { spfds_.evaluate( div_sims_[i] ), i };
+    std::stable_sort( scores.begin(), scores.end() );
+
+    uint32_t const num_seeds = std::min<uint32_t>( StaticParams::max_num_seeds, static_cast<uint32_t>( scores.size() ) );
+    for ( auto s = 0u; s < num_seeds; ++s )
+    {
+      std::vector<uint32_t> leaves{ scores[s].second };
+      spfds_.reset();
+      spfds_.update( div_sims_[leaves[0]] );
+      uint32_t best_num_edges = spfds_.get_num_edges();
+      while ( !spfds_.is_covered() && !spfds_.is_saturated() && ( leaves.size() < max_cuts_size ) )
+      {
+        std::optional<uint32_t> best_div;
+        for ( auto i = 0u; i < divs_.size(); ++i )
+        {
+          auto const num_edges = spfds_.evaluate( div_sims_[i] );
+          if ( num_edges < best_num_edges )
+          {
+            best_div = std::make_optional( i );
+            best_num_edges = num_edges;
+          }
+        }
+        if ( !best_div )
+          break;
+        leaves.push_back( *best_div );
+        spfds_.update( div_sims_[*best_div] );
+      }
+      if ( !spfds_.is_covered() )
+        continue;
+
+      std::sort( leaves.begin(), leaves.end() );
+      if ( std::find( candidates_.begin(), candidates_.end(), leaves ) == candidates_.end() )
+        candidates_.push_back( leaves );
+    }
+  }
+#pragma endregion
+
+#pragma region SAT Validation
+  /*! \brief Build a miter of two copies of the cone of the pivot and of the divisors.
+   *
+   * The copies have independent inputs. Divisor `i` is equal in both copies
+   * when the literal `eqs_[i]` is assumed, and at least one output of the
+   * pivot differs when the literal `act_` is assumed. Hence, the pivot is a
+   * function of a set of divisors if the miter is unsatisfiable under the
+   * assumptions of the corresponding equalities.
+   */
+  bool build_miter( node_index_t const& n )
+  {
+    std::vector<uint8_t> used( divs_.size(), 0u );
+    for ( auto const& cand : candidates_ )
+    {
+      for ( auto const i : cand )
+        used[i] = 1u;
+    }
+
+    cone_.clear();
+    new_mark();
+    auto const add_cone = [&]( node_index_t const& root ) {
+      foreach_tfi_topological( root, [&]( auto const& m ) {
+        cone_.push_back( m );
+      } );
+    };
+    add_cone( n );
+    for ( auto i = 0u; i < divs_.size(); ++i )
+    {
+      if ( used[i] )
+        add_cone( ntk_.get_node( divs_[i] ) );
+    }
+    if ( cone_.size() > StaticParams::max_cone_size )
+      return false;
+
+    if ( vars_.size() < ntk_.size() )
+      vars_.resize( ntk_.size() );
+    num_vars_ = 0u;
+    for ( auto const& m : cone_ )
+    {
+      vars_[m] = num_vars_;
+      num_vars_ += ntk_.num_outputs( m );
+    }
+
+    solver_.restart();
+    solver_.add_variables( 2u * num_vars_ );
+    for ( uint32_t copy = 0u; copy < 2u; ++copy )
+    {
+      for ( auto const& m : cone_ )
+        add_node_clauses( m, copy );
+    }
+
+    /* activation of the output difference */
+    act_ = bill::lit_type( solver_.add_variable(), bill::lit_type::polarities::positive );
+    std::vector<bill::lit_type> diff{ ~act_ };
+    ntk_.foreach_output( n, [&]( auto const& f ) {
+      auto const d = bill::lit_type( solver_.add_variable(), bill::lit_type::polarities::positive );
+      solver_.add_clause( { ~d, literal( f, 0u ), literal( f, 1u ) } );
+      solver_.add_clause( { ~d, ~literal( f, 0u ), ~literal( f, 1u ) } );
+      diff.push_back( d );
+    } );
+    solver_.add_clause( diff );
+
+    /* conditional equality of the divisors */
+    eqs_.assign( divs_.size(), act_ );
+    for ( auto i = 0u; i < divs_.size(); ++i )
+    {
+      if ( !used[i] )
+        continue;
+      auto const e = bill::lit_type( solver_.add_variable(), bill::lit_type::polarities::positive );
+      solver_.add_clause( { ~e, ~literal( divs_[i], 0u ), literal( divs_[i], 1u ) } );
+      solver_.add_clause( { ~e, literal( divs_[i], 0u ), ~literal( divs_[i], 1u ) } );
+      eqs_[i] = e;
+    }
+    return true;
+  }
+
+  bill::lit_type literal( signal_t const& f, uint32_t copy ) const
+  {
+    return bill::lit_type( vars_[ntk_.get_node( f )] + f.output + copy * num_vars_, bill::lit_type::polarities::positive );
+  }
+
+  void add_node_clauses( node_index_t const& n, uint32_t copy )
+  {
+    if ( ntk_.is_constant( n ) )
+    {
+      auto const f = literal( ntk_.make_signal( n ), copy );
+      solver_.add_clause( std::vector<bill::lit_type>{ ntk_.constant_value( n ) ? f : ~f } );
+      return;
+    }
+    if ( ntk_.is_pi( n ) )
+      return;
+
+    fanins_.clear();
+    ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+      fanins_.push_back( literal( fi, copy ) );
+    } );
+    ntk_.foreach_output( n, [&]( auto const& fo ) {
+      auto const& [onset, offset] = get_cubes( fo );
+      auto const f = literal( fo, copy );
+      add_cubes_clauses( onset, f );
+      add_cubes_clauses( offset, ~f );
+    } );
+  }
+
+  /*! \brief Each cube of the cover implies the output literal */
+  void add_cubes_clauses( std::vector<kitty::cube> const& cubes, bill::lit_type const& f )
+  {
+    std::vector<bill::lit_type> clause;
+    for ( auto const& cube : cubes )
+    {
+      clause.clear();
+      for ( auto i = 0u; i < fanins_.size(); ++i )
+      {
+        if ( cube.get_mask( i ) )
+          clause.push_back( cube.get_bit( i ) ? ~fanins_[i] : fanins_[i] );
+      }
+      clause.push_back( f );
+      solver_.add_clause( clause );
+    }
+  }
+
+  /*! \brief Irredundant covers of the on-set and off-set of a gate, computed once per binding */
+  std::pair<std::vector<kitty::cube>, std::vector<kitty::cube>> const& get_cubes( signal_t const& f )
+  {
+    auto const id = ntk_.get_binding_index( f );
+    auto it = cubes_.find( id );
+    if ( it == cubes_.end() )
+    {
+      auto const tt = ntk_.signal_function( f );
+      it = cubes_.emplace( id, std::make_pair( kitty::isop( tt ), kitty::isop( ~tt ) ) ).first;
+    }
+    return it->second;
+  }
+
+  pattern_t extract_pattern( std::vector<bill::lbool_type> const& model, uint32_t copy ) const
+  {
+    pattern_t pattern;
+    for ( auto const& m : cone_ )
+    {
+      if ( ntk_.is_pi( m ) )
+        pattern.emplace_back( m, model[vars_[m] + copy * num_vars_] == bill::lbool_type::true_ );
+    }
+    return pattern;
+  }
+
+  /*! \brief Store the counter-example of one copy of the miter, with the values of the cone */
+  void add_counterexample( std::vector<bill::lbool_type> const& model, uint32_t copy )
+  {
+    patterns_.push_back( extract_pattern( model, copy ) );
+    for ( auto v = 0u; v < num_vars_; ++v )
+      model_values_.push_back( model[v + copy * num_vars_] == bill::lbool_type::true_ );
+    st_.num_counterexamples++;
+  }
+
+  void validate_candidates( node_index_t const& n )
+  {
+    if ( !build_miter( n ) )
+    {
+      st_.num_skipped++;
+      return;
+    }
+    model_values_.clear();
+
+    for ( auto const& cand : candidates_ )
+    {
+      std::vector<bill::lit_type> assumptions{ act_ };
+      for ( auto const i : cand )
+        assumptions.push_back( eqs_[i] );
+
+      auto const res = solver_.solve( assumptions, StaticParams::conflict_limit );
+      if ( res == bill::result::states::satisfiable )
+      {
+        /* both assignments distinguish the pivot while the divisors are equal */
+        auto const result = solver_.get_model();
+        add_counterexample( result.model(), 0u );
+        add_counterexample( result.model(), 1u );
+        continue;
+      }
+      if ( res != bill::result::states::unsatisfiable )
+      {
+        st_.num_unknown++;
+        continue;
+      }
+
+      std::vector<signal_t> leaves;
+      for ( auto const i : cand )
+        leaves.push_back( divs_[i] );
+      cut_t cut( dependency_t::SIMULA_DEP, n, leaves );
+      if ( compute_functions( cut, cand ) )
+      {
+        st_.num_validated++;
+        cuts_.push_back( cut );
+      }
+    }
+  }
+
+  /*! \brief Functions of the pivot outputs in terms of validated leaves.
+   *
+   * The minterms of the leaves not observed in the patterns are either
+   * unreachable, hence don't cares, or reached by an assignment found with
+   * SAT, which also determines the value of the outputs. The counter-examples
+   * found for the current pivot are checked first, and SAT is called only on
+   * the minterms they do not reach. When a SAT call is inconclusive, the cut
+   * is rejected together with the counter-examples it produced.
+   */
+  bool compute_functions( cut_t& cut, std::vector<uint32_t> const& cand )
+  {
+    using func_t = typename cut_t::functionality_t;
+    std::vector<signature_t const*> in_ptrs;
+    for ( auto const i : cand )
+      in_ptrs.push_back( &div_sims_[i] );
+
+    std::vector<signal_t> outputs;
+    std::vector<func_t> funcs;
+    ntk_.foreach_output( cut.root, [&]( auto const& f ) {
+      funcs.push_back( extract_function<signature_t, max_cuts_size>( in_ptrs, out_sims_[outputs.size()], care_ ) );
+      outputs.push_back( f );
+    } );
+
+    uint32_t const num_minterms = 1u << cut.size();
+    auto const specify = [&]( uint32_t m, auto const& value_of ) {
+      for ( auto i = 0u; i < outputs.size(); ++i )
+      {
+        kitty::set_bit( funcs[i]._care, m );
+        if ( value_of( outputs[i] ) )
+          kitty::set_bit( funcs[i]._bits, m );
+      }
+    };
+
+    /* minterms reached by the counter-examples of the previous candidates */
+    uint32_t const num_models = num_vars_ == 0u ? 0u : static_cast<uint32_t>( model_values_.size() / num_vars_ );
+    for ( auto k = 0u; k < num_models; ++k )
+    {
+      auto const value_of = [&]( signal_t const& f ) -> bool {
+        return model_values_[k * num_vars_ + vars_[ntk_.get_node( f )] + f.output];
+      };
+      uint32_t m = 0u;
+      for ( auto v = 0u; v < cut.size(); ++v )
+        m |= value_of( cut.leaves[v] ) ? ( 1u << v ) : 0u;
+      if ( !kitty::get_bit( funcs[0]._care, m ) )
+        specify( m, value_of );
+    }
+
+    uint32_t num_unspecified = 0u;
+    for ( auto m = 0u; m < num_minterms; ++m )
+      num_unspecified += kitty::get_bit( funcs[0]._care, m ) ? 0u : 1u;
+
+    auto const num_patterns = patterns_.size();
+    auto const num_values = model_values_.size();
+    std::vector<bill::lit_type> assumptions( cut.size() );
+    for ( auto m = 0u; m < num_minterms && num_unspecified > 0u; ++m )
+    {
+      if ( kitty::get_bit( funcs[0]._care, m ) )
+        continue;
+      --num_unspecified;
+
+      for ( auto v = 0u; v < cut.size(); ++v )
+      {
+        auto const f = literal( cut.leaves[v], 0u );
+        assumptions[v] = ( ( m >> v ) & 1u ) ? f : ~f;
+      }
+      auto const res = solver_.solve( assumptions, StaticParams::conflict_limit );
+      if ( res == bill::result::states::unsatisfiable )
+        continue;
+      if ( res != bill::result::states::satisfiable )
+      {
+        st_.num_unknown++;
+        st_.num_counterexamples -= patterns_.size() - num_patterns;
+        patterns_.resize( num_patterns );
+        model_values_.resize( num_values );
+        return false;
+      }
+
+      auto const result = solver_.get_model();
+      auto const& model = result.model();
+      specify( m, [&]( signal_t const& f ) {
+        return model[literal( f, 0u ).variable()] == bill::lbool_type::true_;
+      } );
+      add_counterexample( model, 0u );
+    }
+
+    for ( auto const& func : funcs )
+      cut.add_func( func );
+    return true;
+  }
+#pragma endregion
+
+private:
+  Ntk& ntk_;
+  simula_dependencies_stats own_st_;
+  simula_dependencies_stats& st_;
+  std::vector<cut_t> cuts_;
+
+  /*! \brief Global simulations on the current patterns */
+  analyzers::trackers::simulation_tracker<Ntk> sim_;
+  signature_t care_;
+  /*! \brief Bit of the patterns replaced by the next counter-example */
+  uint32_t next_bit_{ 0 };
+  std::vector<pattern_t> patterns_;
+  bool defer_patterns_{ false };
+  /*! \brief Values of the cone variables in the counter-examples of the current pivot */
+  std::vector<bool> model_values_;
+
+  std::vector<uint32_t> marks_;
+  uint32_t mark_{ 0 };
+  std::vector<std::pair<node_index_t, bool>> stack_;
+  /*! \brief Nodes visited by the traversal of the transitive fanin */
+  std::vector<uint32_t> queued_;
+  std::vector<node_index_t> queue_;
+
+  std::vector<signal_t> divs_;
+  std::vector<signature_t> div_sims_;
+  std::vector<signature_t> out_sims_;
+  std::vector<std::vector<uint32_t>> candidates_;
+  boolean::spfd_manager<signature_t, ( 1u << max_cuts_size )> spfds_;
+
+  solver_t solver_;
+  std::vector<node_index_t> cone_;
+  /*! \brief First variable of the outputs of each node of the cone, in the first copy */
+  std::vector<uint32_t> vars_;
+  uint32_t num_vars_{ 0 };
+  std::vector<bill::lit_type> fanins_;
+  std::vector<bill::lit_type> eqs_;
+  bill::lit_type act_;
+  phmap::flat_hash_map<uint32_t, std::pair<std::vector<kitty::cube>, std::vector<kitty::cube>>> cubes_;
+};
+
+} // namespace dependency
+
+} // namespace rinox
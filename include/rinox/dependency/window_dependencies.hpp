@@ -36,6 +36,10 @@
 #include "../math/math.hpp"
 #include "dependency_cut.hpp"
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 namespace rinox
 {
 
@@ -185,20 +189,31 @@ private:
 #pragma endregion
 
 #pragma region Candidates Identification
+  /*! \brief Candidate cut, as sorted indices of divisors */
+  struct candidate_t
+  {
+    std::array<uint32_t, max_cuts_size> leaves;
+    uint32_t size;
+    /*! \brief Bit `i % 64` is set if the cut contains a divisor of index `i` */
+    uint64_t sign;
+  };
 
-  void update_information( information_t const& remove, std::vector<information_t>& todos )
+  static uint64_t leaf_sign( uint32_t index )
   {
-    for ( auto& todo : todos )
-    {
-      todo = boolean::binary_and( todo, boolean::unary_not( remove ) );
-    }
+    return uint64_t( 1u ) << ( index & 63u );
   }
 
-  bool is_done( std::vector<information_t>& todos )
+  information_t* todos_at( uint32_t depth )
   {
-    for ( auto const& todo : todos )
+    return todos_.data() + depth * root_info_.size();
+  }
+
+  bool is_done( uint32_t depth )
+  {
+    information_t const* todos = todos_at( depth );
+    for ( auto i = 0u; i < root_info_.size(); ++i )
     {
-      if ( !kitty::is_const0( todo ) )
+      if ( !kitty::is_const0( todos[i] ) )
       {
         return false;
       }
@@ -206,15 +221,16 @@ private:
     return true;
   }
 
-  bool is_possible_from( uint32_t index, std::vector<information_t> const& todos )
+  bool is_possible_from( uint32_t index, uint32_t depth )
   {
     if ( certain_from_[index] )
     {
       return true;
     }
-    for ( auto const& todo : todos )
+    information_t const* todos = todos_at( depth );
+    for ( auto i = 0u; i < root_info_.size(); ++i )
     {
-      if ( !kitty::equal( boolean::binary_and( info_from_[index], todo ), todo ) )
+      if ( !kitty::is_const0( boolean::binary_lt( info_from_[index], todos[i] ) ) )
       {
         return false;
       }
@@ -222,101 +238,100 @@ private:
     return true;
   }
 
-  bool contains( std::vector<uint32_t> const& cut1, std::vector<uint32_t> const& cut2 )
+  /*! \brief True if all the leaves of `cut2` are in `cut1` */
+  static bool contains( candidate_t const& cut1, candidate_t const& cut2 )
   {
-    if ( cut2.size() > cut1.size() )
+    if ( ( cut2.size > cut1.size ) || ( ( cut2.sign & ~cut1.sign ) != 0u ) )
       return false;
-    bool contains = true;
-    auto i = 0;
-    auto j = 0;
-    while ( contains && ( i < cut1.size() ) && ( j < cut2.size() ) )
-    {
-      if ( cut1[i] < cut2[j] )
-        i++;
-      else if ( cut1[i] == cut2[j] )
-      {
-        i++;
-        j++;
-      }
-      else if ( cut1[i] > cut2[j] )
-        contains = false;
-    }
-    if ( contains && ( j == cut2.size() ) )
-      return true;
-    return false;
+    return std::includes( cut1.leaves.begin(), cut1.leaves.begin() + cut1.size,
+                          cut2.leaves.begin(), cut2.leaves.begin() + cut2.size );
   }
 
-  bool contains_previous( std::vector<uint32_t> const& cut, std::vector<std::vector<uint32_t>> const& cuts )
+  bool contains_previous( candidate_t const& cut )
   {
-    for ( auto const& other : cuts )
-    {
-      if ( contains( cut, other ) )
-        return true;
-    }
-    return false;
+    return std::any_of( candidates_.begin(), candidates_.end(), [&]( auto const& other ) {
+      return contains( cut, other );
+    } );
   }
 
-  void add_to_cuts( std::vector<uint32_t> const& cut, std::vector<std::vector<uint32_t>>& cuts )
+  void add_to_cuts( candidate_t const& cut )
   {
-    std::vector<uint32_t> erase;
-    for ( auto i = 0u; i < cuts.size(); ++i )
-    {
-      auto const other = cuts[i];
-      if ( contains( other, cut ) )
-        erase.push_back( i );
-    }
-    for ( auto it = erase.rbegin(); it < erase.rend(); ++it )
-    {
-      cuts.erase( cuts.begin() + *it );
-    }
-    cuts.push_back( cut );
+    candidates_.erase( std::remove_if( candidates_.begin(), candidates_.end(), [&]( auto const& other ) {
+                         return contains( other, cut );
+                       } ),
+                       candidates_.end() );
+    candidates_.push_back( cut );
   }
 
-  void identify_candidates_recursive( std::vector<std::vector<uint32_t>>& cuts,
-                                      std::vector<uint32_t> cut,
-                                      uint32_t begin,
-                                      std::vector<information_t> todos )
+  /*! \brief Branch and bound over the divisors.
+   *
+   * The information still to be covered by a cut of `depth` leaves is stored
+   * in the buffers of that depth, hence no information is copied between the
+   * branches. Skipping a divisor keeps the cut and the information unchanged,
+   * so the chain of skipped divisors is unrolled into a loop, and the
+   * recursion is bounded by the maximum cut size.
+   *
+   * The cuts are explored in the same order as in a search branching on
+   * skipping the divisor first and on adding it after.
+   */
+  void identify_candidates_recursive( uint32_t begin )
   {
-    if ( contains_previous( cut, cuts ) )
+    uint32_t const depth = cut_.size;
+    if ( contains_previous( cut_ ) )
       return;
-    if ( is_done( todos ) )
+    if ( is_done( depth ) )
     {
-      add_to_cuts( cut, cuts );
+      add_to_cuts( cut_ );
       return;
     }
     if ( ( begin >= divs_info_.size() ) )
       return;
-    if ( cut.size() >= max_cuts_size )
+    if ( depth >= max_cuts_size )
       return;
 
-    if ( ( begin < ( divs_info_.size() - 1 ) ) && is_possible_from( begin + 1, todos ) )
-      identify_candidates_recursive( cuts, cut, begin + 1, todos );
+    /* last divisor reached by skipping */
+    uint32_t last = begin;
+    while ( ( last < ( divs_info_.size() - 1 ) ) && is_possible_from( last + 1, depth ) )
+      ++last;
 
-    if ( is_possible_from( begin, todos ) )
+    information_t const* todos = todos_at( depth );
+    information_t* next_todos = todos_at( depth + 1 );
+    for ( uint32_t index = last + 1; index-- > begin; )
     {
-      cut.push_back( begin );
-      update_information( divs_info_[begin], todos );
-      identify_candidates_recursive( cuts, cut, begin + 1, todos );
+      /* the skipped divisors are possible by construction of the chain */
+      if ( ( index == begin ) && !is_possible_from( begin, depth ) )
+        continue;
+
+      for ( auto i = 0u; i < root_info_.size(); ++i )
+        next_todos[i] = boolean::binary_lt( divs_info_[index], todos[i] );
+
+      candidate_t const previous = cut_;
+      cut_.leaves[depth] = index;
+      cut_.size++;
+      cut_.sign |= leaf_sign( index );
+      identify_candidates_recursive( index + 1 );
+      cut_ = previous;
     }
   }
 
   template<typename WinMng, typename WinSim>
   void identify_candidates( WinMng const& window, WinSim& simulator )
   {
-    auto todos = root_info_;
-    uint32_t const begin = 0;
-    std::vector<uint32_t> cut;
-    std::vector<std::vector<uint32_t>> cuts;
-    identify_candidates_recursive( cuts, cut, begin, todos );
+    todos_.resize( ( max_cuts_size + 1 ) * root_info_.size() );
+    std::copy( root_info_.begin(), root_info_.end(), todos_.begin() );
+    candidates_.clear();
+    cut_.size = 0u;
+    cut_.sign = 0u;
+    identify_candidates_recursive( 0u );
 
     auto const n = window.get_pivot();
     cuts_.clear();
-    for ( auto const& cut : cuts )
+    for ( auto const& cut : candidates_ )
     {
       std::vector<signal_t> leaves;
-      for ( auto const& index : cut )
+      for ( auto i = 0u; i < cut.size; ++i )
       {
-        leaves.push_back( window.get_divisor( index ) );
+        leaves.push_back( window.get_divisor( cut.leaves[i] ) );
       }
       cuts_.emplace_back( dependency_t::WINDOW_DEP, n, leaves );
     }
@@ -413,6 +428,10 @@ private:
   std::vector<information_t> info_from_;
   std::vector<bool> certain_from_;
   std::vector<information_t> root_info_;
+  /*! \brief Information to be covered, for each depth of the search and each output */
+  std::vector<information_t> todos_;
+  std::vector<candidate_t> candidates_;
+  candidate_t cut_;
   boolean::spfd_manager<signature_t, ( 1u << max_cuts_size )> spfds_;
 };
 
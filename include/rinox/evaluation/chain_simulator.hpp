@@ -256,8 +256,7 @@ public:
    * \return A tuple containing a pointer to the simulation pattern and a flag for complementation.
    */
   chain_simulator( library_t& library )
-      : library( library ),
-        inner_simulator()
+      : library( library )
   {
     /* The value 20 allows us to store practical chains */
     sims.resize( 20u );
@@ -280,8 +279,6 @@ public:
 
     /* traverse the chain in topological order and simulate each node */
     size_t i = 0;
-    using iterate_type = typename std::vector<element_type>::iterator;
-    std::vector<TT const*> sims_ptrs;
     outer_chain.foreach_gate( [&]( auto const& children, element_type const& id, auto j ) {
       sims_ptrs.clear();
 
@@ -299,14 +296,8 @@ public:
           sims_ptrs.push_back( &sims[index] );
         }
       }
-      inner_chain_t const& inner_chain = library.get_chain( id );
-      inner_simulator( inner_chain, sims_ptrs );
       /* each gate has a single outout, multiple-output are represented as two gates. */
-      auto const lit = inner_chain.po_at( 0 );
-      inner_simulator.get_simulation_inline( sims[i++],
-                                             inner_chain,
-                                             sims_ptrs,
-                                             lit );
+      library.get_kernel( id )( sims[i++], sims_ptrs.data() );
     } );
   }
 
@@ -370,10 +361,10 @@ public:
 private:
   /*! \brief Simulation patterns of the chain's nodes */
   std::vector<TT> sims;
+  /*! \brief Pointers to the simulations of the fanins of a gate */
+  std::vector<TT const*> sims_ptrs;
   /*! \brief Augmented library */
   library_t& library;
-  /*! \brief Simulator engine for the individual nodes */
-  chain_simulator<inner_chain_t, TT> inner_simulator;
 };
 
 } /* namespace evaluation*/
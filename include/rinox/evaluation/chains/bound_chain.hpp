@@ -34,8 +34,10 @@
 
 #include "../../boolean/boolean.hpp"
 #include "../../network/utils.hpp"
+#include <algorithm>
 #include <cassert>
 #include <mockturtle/networks/block.hpp>
+#include <utility>
 #include <vector>
 
 namespace rinox
@@ -51,6 +53,11 @@ namespace chains
  *
  * The inputs are associated with the literals 0, ..., num_inputs - 1.
  * The subsequent literals identify the nodes in the chain.
+ *
+ * The fanins of all the nodes are stored contiguously in a shared pool, and
+ * each node refers to its slice of the pool. Hence, adding a gate does not
+ * allocate memory once the chain has reached its maximum size, and a chain
+ * which is cleared and rebuilt reuses its memory.
  */
 template<network::design_type_t DesignType>
 class bound_chain
@@ -58,32 +65,52 @@ class bound_chain
 public:
   using element_type = uint32_t;
 
-private:
-  /*! \brief Node of a mapped index chain */
-  struct node_t
+  /*! \brief Read-only view of the fanins of a node. */
+  class fanin_view
   {
-    node_t() = default;
-    node_t( const node_t& ) = default;
-    node_t( node_t&& ) noexcept = default;
-    node_t& operator=( const node_t& ) = default;
-    node_t& operator=( node_t&& ) noexcept = default;
-
-    node_t( std::vector<element_type> const& fanins, uint32_t id )
-        : fanins( fanins ), id( id )
+  public:
+    fanin_view( element_type const* begin, element_type const* end )
+        : begin_( begin ), end_( end )
     {}
 
-    bool operator==( node_t const& other ) const
+    element_type const* begin() const
+    {
+      return begin_;
+    }
+
+    element_type const* end() const
+    {
+      return end_;
+    }
+
+    size_t size() const
+    {
+      return static_cast<size_t>( end_ - begin_ );
+    }
+
+    bool empty() const
     {
-      return fanins == other.fanins && id == other.id;
+      return begin_ == end_;
     }
 
-    bool operator!=( node_t const& other ) const
+    element_type const& operator[]( size_t i ) const
     {
-      return fanins != other.fanins || id == other.id;
+      assert( i < size() );
+      return begin_[i];
     }
 
-    std::vector<element_type> fanins; /**< literals of fanins */
-    uint32_t id;                      /**< binding id */
+  private:
+    element_type const* begin_;
+    element_type const* end_;
+  };
+
+private:
+  /*! \brief Node of a mapped index chain */
+  struct node_t
+  {
+    uint32_t offset; /**< position of the fanins in the pool */
+    uint32_t size;   /**< number of fanins */
+    uint32_t id;     /**< binding id */
   };
 
 public:
@@ -93,6 +120,7 @@ public:
       : num_inputs( num_inputs )
   {
     nodes.reserve( reserve_size );
+    fanins.reserve( 2 * reserve_size );
   }
 
   explicit bound_chain( uint32_t num_inputs )
@@ -112,9 +140,21 @@ public:
   void clear()
   {
     nodes.clear();
+    fanins.clear();
     outputs.clear();
   }
 
+  /*! \brief Remove the nodes and the outputs, and set the number of inputs.
+   *
+   * The memory of the chain is preserved, so that it can be rebuilt without
+   * allocating.
+   */
+  void reset( uint32_t num_inputs )
+  {
+    clear();
+    this->num_inputs = num_inputs;
+  }
+
 #pragma endregion
 
 #pragma region Equality
@@ -126,7 +166,9 @@ public:
 
     for ( size_t i = 0; i < nodes.size(); ++i )
     {
-      if ( nodes[i] != other.nodes[i] )
+      auto const lhs = get_fanins( i );
+      auto const rhs = other.get_fanins( i );
+      if ( nodes[i].id != other.nodes[i].id || !std::equal( lhs.begin(), lhs.end(), rhs.begin(), rhs.end() ) )
         return false;
     }
     return true;
@@ -164,18 +206,19 @@ public:
   }
 
   /*! \brief Create a node in the chain. The returned literal uniquely identifies it. */
-  element_type add_gate( std::vector<element_type> const& fanins, uint32_t id )
+  element_type add_gate( std::vector<element_type> const& children, uint32_t id )
   {
     const element_type f = static_cast<element_type>( nodes.size() + num_inputs );
-    nodes.emplace_back( fanins, id );
+    nodes.push_back( { static_cast<uint32_t>( fanins.size() ), static_cast<uint32_t>( children.size() ), id } );
+    fanins.insert( fanins.end(), children.begin(), children.end() );
     return f;
   }
 
   /*! \brief Replace in node */
   void replace_in_node( uint32_t node, uint32_t fanin, element_type other )
   {
-    auto& n = nodes[node];
-    n.fanins[fanin] = other;
+    assert( fanin < nodes[node].size );
+    fanins[nodes[node].offset + fanin] = other;
   }
 
   /*! \brief Replace in node */
@@ -201,8 +244,8 @@ public:
   {
     for ( size_t i = 0; i < nodes.size(); ++i )
     {
-      auto const& n = nodes[i];
-      fn( n.fanins, n.id, i );
+      auto const children = get_fanins( i );
+      fn( children, nodes[i].id, i );
     }
   }
 
@@ -211,8 +254,8 @@ public:
   {
     for ( int i = static_cast<int>( nodes.size() ) - 1; i >= 0; --i )
     {
-      auto const& n = nodes[i];
-      fn( n.fanins, n.id, i );
+      auto const children = get_fanins( i );
+      fn( children, nodes[i].id, i );
     }
   }
 
@@ -263,9 +306,11 @@ public:
     return area;
   }
 
-  [[nodiscard]] std::vector<node_t> get_nodes() const
+  /*! \brief Fanins of the i-th gate. The view is invalidated when a gate is added. */
+  [[nodiscard]] fanin_view get_fanins( size_t i ) const
   {
-    return nodes;
+    element_type const* begin = fanins.data() + nodes[i].offset;
+    return fanin_view( begin, begin + nodes[i].size );
   }
 
   [[nodiscard]] std::vector<element_type> get_outputs() const
@@ -292,6 +337,8 @@ public:
 
 private:
   std::vector<node_t> nodes;
+  /*! \brief Fanins of all the nodes, indexed by the offsets of the nodes */
+  std::vector<element_type> fanins;
   std::vector<element_type> outputs;
   element_type num_inputs = 0;
 };
@@ -414,12 +461,14 @@ typename Ntk::signal_t insert( Ntk& ntk,
                                bound_chain<DesignType> const& chain )
 {
   std::vector<typename Ntk::signal_t> fs;
+  fs.reserve( chain.size() );
 
   for ( auto i = 0; i < chain.num_pis(); ++i )
     fs.emplace_back( inputs[i] );
 
+  std::vector<typename Ntk::signal_t> children;
   chain.foreach_gate( [&]( auto const& fanin, auto id, auto i ) {
-    std::vector<typename Ntk::signal_t> children( fanin.size() );
+    children.resize( fanin.size() );
     for ( auto i = 0u; i < fanin.size(); ++i )
     {
       children[i] = fs[fanin[i]];
@@ -445,63 +494,88 @@ void extract( bound_chain<DesignType>& chain,
     return;
   }
 
-  std::unordered_map<uint64_t, value_type> sig_to_lit;
+  /* the logic cones are small, hence the literals are searched linearly. The
+   * buffers are reused across the calls, so that extraction does not allocate */
+  static thread_local std::vector<std::pair<uint64_t, value_type>> sig_to_lit;
+  static thread_local std::vector<std::pair<signal, bool>> stack;
+  static thread_local std::vector<value_type> children;
+  sig_to_lit.clear();
+  stack.clear();
 
-  // Recursive construction
-  std::function<void( signal )> construct_rec = [&]( signal f ) {
-    node n = ntk.get_node( f );
+  auto const lit_of = [&]( signal const& f ) -> value_type {
+    for ( auto it = sig_to_lit.rbegin(); it != sig_to_lit.rend(); ++it )
+    {
+      if ( it->first == static_cast<uint64_t>( f ) )
+        return it->second;
+    }
+    return 0u;
+  };
 
-    if ( ntk.visited( n ) == ntk.trav_id() )
-      return;
+  // Assign values to input nodes
+  ntk.incr_trav_id();
+  for ( std::size_t i = 0; i < inputs.size(); ++i )
+  {
+    if ( inputs[i].data > std::numeric_limits<uint32_t>::max() )
+      continue;
+    auto const n = ntk.get_node( inputs[i] );
+    ntk.set_visited( n, ntk.trav_id() );
+    sig_to_lit.emplace_back( static_cast<uint64_t>( inputs[i] ), static_cast<value_type>( i ) ); // assign PI index
+  }
 
-    if ( ntk.is_pi( n ) )
+  // Construction in depth-first order
+  stack.emplace_back( output, false );
+  while ( !stack.empty() )
+  {
+    auto const [f, expanded] = stack.back();
+    node const n = ntk.get_node( f );
+    if ( ntk.visited( n ) == ntk.trav_id() )
     {
-      std::cerr << "[e] unexpected unmarked PI in logic cone\n";
-      return;
+      stack.pop_back();
+      continue;
     }
 
-    std::vector<value_type> children;
+    if ( !expanded )
+    {
+      if ( ntk.is_pi( n ) )
+      {
+        std::cerr << "[e] unexpected unmarked PI in logic cone\n";
+        stack.pop_back();
+        continue;
+      }
+      /* push the fanins in reverse order to construct them in order */
+      stack.back().second = true;
+      auto const first = stack.size();
+      ntk.foreach_fanin( n, [&]( auto const& fi ) {
+        stack.emplace_back( fi, false );
+      } );
+      std::reverse( stack.begin() + first, stack.end() );
+      continue;
+    }
+    stack.pop_back();
 
-    ntk.foreach_fanin( n, [&]( auto const& fi, auto ) {
-      construct_rec( fi );
-      children.emplace_back( sig_to_lit[fi] );
+    children.clear();
+    ntk.foreach_fanin( n, [&]( auto const& fi ) {
+      children.push_back( lit_of( fi ) );
     } );
 
-    value_type v;
     if constexpr ( mockturtle::has_has_cell_v<Ntk> )
     {
       auto cell = ntk.get_cell( n );
       assert( cell.gates.size() <= 1 && "[e] multiple output support not available" );
       auto const id = cell.gates[0].id;
-      v = chain.add_gate( children, id );
-      sig_to_lit[f] = v;
+      sig_to_lit.emplace_back( static_cast<uint64_t>( f ), chain.add_gate( children, id ) );
     }
     else
     {
-      auto const ids = ntk.get_binding_ids( n );
-      for ( auto i = 0u; i < ids.size(); ++i )
-      {
-        v = chain.add_gate( children, ids[i] );
-        sig_to_lit[signal( { n, i } )] = v;
-      }
+      ntk.foreach_output_pin( n, [&]( auto const& pin, auto i ) {
+        sig_to_lit.emplace_back( static_cast<uint64_t>( signal( { n, i } ) ), chain.add_gate( children, pin.id ) );
+      } );
     }
 
     ntk.set_visited( n, ntk.trav_id() );
-  };
-
-  // Assign values to input nodes
-  ntk.incr_trav_id();
-  for ( std::size_t i = 0; i < inputs.size(); ++i )
-  {
-    if ( inputs[i].data > std::numeric_limits<uint32_t>::max() )
-      continue;
-    auto const n = ntk.get_node( inputs[i] );
-    ntk.set_visited( n, ntk.trav_id() );
-    sig_to_lit[inputs[i]] = static_cast<value_type>( i ); // assign PI index
   }
 
-  construct_rec( output );
-  chain.add_output( sig_to_lit[output] );
+  chain.add_output( lit_of( output ) );
 }
 
 } // namespace chains
@@ -33,7 +33,6 @@
 #pragma once
 #include <fmt/format.h>
 #include <optional>
-#include <queue>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -146,37 +145,9 @@ private:
     return std::get<std::string>( b.v ); // "0","1","x","z"
   }
 
-  bool parse_module( std::string const& name )
+  /*! \brief Declare the module and its ports to the reader */
+  bool emit_header_( std::string const& name, std::vector<rinox::io::json::port_instance_t> const& ports )
   {
-    if ( !jstream_.set_module( name ) )
-    {
-      rinox::diagnostics::REPORT_DIAG( diag_, lorina::diagnostic_level::fatal,
-                   "module `{}` not found in JSON", name.c_str() );
-      return false;
-    }
-
-    std::vector<rinox::io::json::port_instance_t> ports;
-    std::queue<rinox::io::json::instance_t> pending; // cells/netnames buffered
-
-    rinox::io::json::instance_t inst;
-    for ( ;; )
-    {
-      auto rc = jstream_.get_instance( inst );
-      if ( rc == rinox::io::json::instance_return_code::invalid )
-      {
-        rinox::diagnostics::REPORT_DIAG( diag_, lorina::diagnostic_level::fatal,
-                     "failed to parse a new instance" );
-        return false;
-      }
-      if ( rc == rinox::io::json::instance_return_code::end )
-        break;
-
-      if ( std::holds_alternative<rinox::io::json::port_instance_t>( inst ) )
-        ports.push_back( std::get<rinox::io::json::port_instance_t>( inst ) );
-      else
-        pending.push( std::move( inst ) );
-    }
-
     std::vector<std::string> inouts;
     inouts.reserve( ports.size() );
     for ( auto const& p : ports )
@@ -185,7 +156,6 @@ private:
 
     for ( auto const& p : ports )
     {
-      const auto sz = size_from_bits_( p.bits.size() );
       if ( p.direction == "input" )
       {
         std::vector<std::string> name_ids;
@@ -227,78 +197,138 @@ private:
         return false;
       }
     }
+    return true;
+  }
+
+  /*! \brief Forward a cell to the reader once its fanins are known */
+  void process_cell_( rinox::io::json::cell_instance_t const& cell )
+  {
+    std::vector<std::pair<std::string, std::string>> inmap, outmap;
+    std::vector<std::string> dep_inputs, dep_outputs;
 
-    while ( !pending.empty() )
+    auto is_output_pin = [&]( std::string const& pin ) -> bool {
+      auto it = cell.port_dirs.find( pin );
+      if ( it != cell.port_dirs.end() )
+        return it->second == "output";
+      return reader_.is_output_pin( cell.type, pin );
+    };
+
+    for ( auto const& kv : cell.connections )
     {
-      auto cur = std::move( pending.front() );
-      pending.pop();
+      const auto& pin = kv.first;
+      const auto& bits = kv.second;
+      if ( bits.empty() )
+        continue;
+
+      const std::string net = bit_token_( bits.front() );
 
-      if ( std::holds_alternative<rinox::io::json::cell_instance_t>( cur ) )
+      if ( is_output_pin( pin ) )
       {
-        const auto& cell = std::get<rinox::io::json::cell_instance_t>( cur );
+        outmap.emplace_back( pin, net );
+        dep_outputs.push_back( net );
+      }
+      else
+      {
+        inmap.emplace_back( pin, net );
+        dep_inputs.push_back( net );
+      }
+    }
 
-        std::vector<std::pair<std::string, std::string>> inmap, outmap;
-        std::vector<std::string> dep_inputs, dep_outputs;
+    if ( modules_.count( cell.type ) )
+    {
+      std::vector<std::pair<std::string, std::string>> args;
+      args.reserve( inmap.size() + outmap.size() );
+      for ( auto& kv : inmap )
+        args.emplace_back( "." + kv.first, kv.second );
+      for ( auto& kv : outmap )
+        args.emplace_back( "." + kv.first, kv.second );
+
+      std::vector<std::string> params;
+
+      on_action_.call_deferred<MODULE_INST_FN>(
+          /* deps in  */ dep_inputs,
+          /* deps out */ dep_outputs,
+          /* params   */ std::make_tuple( cell.type, params, cell.name, args ) );
+    }
+    else
+    {
+      // Primitive / tech cell
+      std::vector<unsigned int> ids;
+      for ( auto dep : outmap )
+        ids.push_back( reader_.get_pin_id( cell.type, dep.first ) );
+
+      on_action_.call_deferred<CELL_FN>(
+          /* deps in  */ dep_inputs,
+          /* deps out */ dep_outputs,
+          /* params   */ std::make_tuple( inmap, outmap, ids ) );
+    }
+  }
 
-        auto is_output_pin = [&]( std::string const& pin ) -> bool {
-          auto it = cell.port_dirs.find( pin );
-          if ( it != cell.port_dirs.end() )
-            return it->second == "output";
-          return reader_.is_output_pin( cell.type, pin );
-        };
+  /*! \brief Parse a module while streaming its instances.
+   *
+   * The header is emitted as soon as the ports section has been read, and the
+   * cells following it are forwarded to the reader without being stored. Only
+   * the cells appearing before the ports, if any, are buffered. The net names
+   * are not needed to build the network and are dropped.
+   */
+  bool parse_module( std::string const& name )
+  {
+    if ( !jstream_.set_module( name ) )
+    {
+      rinox::diagnostics::REPORT_DIAG( diag_, lorina::diagnostic_level::fatal,
+                   "module `{}` not found in JSON", name.c_str() );
+      return false;
+    }
 
-        for ( auto const& kv : cell.connections )
-        {
-          const auto& pin = kv.first;
-          const auto& bits = kv.second;
-          if ( bits.empty() )
-            continue;
+    std::vector<rinox::io::json::port_instance_t> ports;
+    std::vector<rinox::io::json::cell_instance_t> pending; // cells preceding the ports
+    bool header_done = false;
 
-          const std::string net = bit_token_( bits.front() );
+    auto flush_header = [&]() {
+      if ( !emit_header_( name, ports ) )
+        return false;
+      header_done = true;
+      for ( auto const& cell : pending )
+        process_cell_( cell );
+      pending.clear();
+      return true;
+    };
 
-          if ( is_output_pin( pin ) )
-          {
-            outmap.emplace_back( pin, net );
-            dep_outputs.push_back( net );
-          }
-          else
-          {
-            inmap.emplace_back( pin, net );
-            dep_inputs.push_back( net );
-          }
-        }
+    rinox::io::json::instance_t inst;
+    for ( ;; )
+    {
+      auto rc = jstream_.get_instance( inst );
+      if ( rc == rinox::io::json::instance_return_code::invalid )
+      {
+        rinox::diagnostics::REPORT_DIAG( diag_, lorina::diagnostic_level::fatal,
+                     "failed to parse a new instance" );
+        return false;
+      }
+      if ( rc == rinox::io::json::instance_return_code::end )
+        break;
 
-        if ( modules_.count( cell.type ) )
-        {
-          std::vector<std::pair<std::string, std::string>> args;
-          args.reserve( inmap.size() + outmap.size() );
-          for ( auto& kv : inmap )
-            args.emplace_back( "." + kv.first, kv.second );
-          for ( auto& kv : outmap )
-            args.emplace_back( "." + kv.first, kv.second );
-
-          std::vector<std::string> params;
-
-          on_action_.call_deferred<MODULE_INST_FN>(
-              /* deps in  */ dep_inputs,
-              /* deps out */ dep_outputs,
-              /* params   */ std::make_tuple( cell.type, params, cell.name, args ) );
-        }
+      if ( std::holds_alternative<rinox::io::json::port_instance_t>( inst ) )
+      {
+        ports.push_back( std::move( std::get<rinox::io::json::port_instance_t>( inst ) ) );
+        continue;
+      }
+
+      /* the ports section is over */
+      if ( !header_done && !ports.empty() && !flush_header() )
+        return false;
+
+      if ( std::holds_alternative<rinox::io::json::cell_instance_t>( inst ) )
+      {
+        if ( header_done )
+          process_cell_( std::get<rinox::io::json::cell_instance_t>( inst ) );
         else
-        {
-          // Primitive / tech cell
-          std::vector<unsigned int> ids;
-          for ( auto dep : outmap )
-            ids.push_back( reader_.get_pin_id( cell.type, dep.first ) );
-
-          on_action_.call_deferred<CELL_FN>(
-              /* deps in  */ dep_inputs,
-              /* deps out */ dep_outputs,
-              /* params   */ std::make_tuple( inmap, outmap, ids ) );
-        }
+          pending.push_back( std::move( std::get<rinox::io::json::cell_instance_t>( inst ) ) );
       }
     }
 
+    if ( !header_done && !flush_header() )
+      return false;
+
     bool ok = true;
     const auto& deps = on_action_.unresolved_dependencies();
     if ( !deps.empty() )
@@ -32,8 +32,8 @@
 
 #pragma once
 #include <rinox/diagnostics.hpp>
-#include <rapidjson/document.h>
 #include <rapidjson/istreamwrapper.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
@@ -104,75 +104,81 @@ enum class instance_return_code
   end
 };
 
+/*! \brief Pull parser of the instances of a Yosys JSON netlist.
+ *
+ * The file is tokenized incrementally with the iterative interface of the
+ * rapidjson `Reader`, and each call to `get_instance` consumes only the tokens
+ * of the next port, cell or net name of the current module. Hence, the memory
+ * does not depend on the size of the file, and the first instances are
+ * available as soon as they are read. The instances are returned in the order
+ * in which they appear in the file, while the sections which are not needed
+ * ( e.g., memories ) are skipped without being stored.
+ *
+ * The names of the modules are collected by a preliminary pass over the file,
+ * and selecting a module rewinds the stream, which is required to be seekable.
+ */
 class json_stream
 {
 public:
   explicit json_stream( std::istream& in, lorina::diagnostic_engine* diag = nullptr )
-      : diag_( diag )
+      : in_( in ), start_( in.tellg() ), diag_( diag ), buffer_( buffer_size )
   {
-    rapidjson::IStreamWrapper isw( in );
-    doc_.ParseStream( isw );
-    if ( doc_.HasParseError() || !doc_.IsObject() )
+    if ( !rewind_() || !scan_module_names_() || module_names_.empty() )
     {
       parse_ok_ = false;
       return;
     }
-    if ( !doc_.HasMember( "modules" ) || !doc_["modules"].IsObject() )
-    {
-      parse_ok_ = false;
-      return;
-    }
-
-    std::vector<std::string> mnames = module_names();
-    assert( ( mnames.size() == 1 ) && "only stable for one module" );
-    module_name_ = mnames[0];
-    set_module( module_name_ );
+    set_module( module_names_[0] );
   }
 
   std::vector<std::string> module_names() const
   {
-    std::vector<std::string> names;
-    if ( !doc_.IsObject() || !doc_.HasMember( "modules" ) || !doc_["modules"].IsObject() )
-      return names;
-    const auto& mods = doc_["modules"];
-    for ( auto it = mods.MemberBegin(); it != mods.MemberEnd(); ++it )
-      names.push_back( it->name.GetString() );
-    return names;
+    return module_names_;
   }
 
   bool set_module( std::string_view name )
   {
-    if ( !doc_.IsObject() || !doc_.HasMember( "modules" ) || !doc_["modules"].IsObject() )
+    if ( !parse_ok_ && module_names_.empty() )
       return false;
-    const auto& mods = doc_["modules"];
-    for ( auto it = mods.MemberBegin(); it != mods.MemberEnd(); ++it )
+
+    /* the stream is already at the beginning of the module */
+    if ( at_module_start_ && name == module_name_ )
+      return true;
+
+    parse_ok_ = false;
+    at_module_start_ = false;
+    section_ = section_t::none;
+    if ( !rewind_() || !next_() || tok_.type != token_t::start_object )
+      return false;
+
+    while ( next_() && tok_.type == token_t::key )
     {
-      if ( name == it->name.GetString() )
+      bool const is_modules = tok_.str == "modules";
+      if ( !next_() )
+        return false;
+      if ( !is_modules || tok_.type != token_t::start_object )
       {
-        module_ = &it->value;
-        module_name_ = it->name.GetString();
+        if ( !skip_value_() )
+          return false;
+        continue;
+      }
 
-        ports_ = cells_ = nets_ = nullptr;
-        if ( module_->HasMember( "ports" ) && ( *module_ )["ports"].IsObject() )
-        {
-          ports_ = &( *module_ )["ports"];
-          p_it_ = ports_->MemberBegin();
-          p_end_ = ports_->MemberEnd();
-        }
-        if ( module_->HasMember( "cells" ) && ( *module_ )["cells"].IsObject() )
-        {
-          cells_ = &( *module_ )["cells"];
-          c_it_ = cells_->MemberBegin();
-          c_end_ = cells_->MemberEnd();
-        }
-        if ( module_->HasMember( "netnames" ) && ( *module_ )["netnames"].IsObject() )
+      while ( next_() && tok_.type == token_t::key )
+      {
+        bool const found = tok_.str == name;
+        if ( !next_() )
+          return false;
+        if ( found && tok_.type == token_t::start_object )
         {
-          nets_ = &( *module_ )["netnames"];
-          n_it_ = nets_->MemberBegin();
-          n_end_ = nets_->MemberEnd();
+          module_name_ = std::string( name );
+          parse_ok_ = true;
+          at_module_start_ = true;
+          return true;
         }
-        return true;
+        if ( !skip_value_() )
+          return false;
       }
+      return false;
     }
     return false;
   }
@@ -181,207 +187,533 @@ public:
   {
     if ( !parse_ok_ )
       return instance_return_code::invalid;
+    if ( module_done_ )
+      return instance_return_code::end;
+    at_module_start_ = false;
 
-    try
+    while ( section_ == section_t::none )
     {
-      if ( ports_ && p_it_ != p_end_ )
-        return read_port_( out );
-      if ( cells_ && c_it_ != c_end_ )
-        return read_cell_( out );
-      if ( nets_ && n_it_ != n_end_ )
-        return read_net_( out );
-      return instance_return_code::end;
+      if ( !next_() )
+        return fail_();
+      if ( tok_.type == token_t::end_object )
+      {
+        module_done_ = true;
+        return instance_return_code::end;
+      }
+      if ( tok_.type != token_t::key )
+        return fail_();
+
+      section_t const section = tok_.str == "ports" ? section_t::ports : tok_.str == "cells" ? section_t::cells
+                                                                     : tok_.str == "netnames" ? section_t::netnames
+                                                                                              : section_t::none;
+      if ( !next_() )
+        return fail_();
+      if ( section == section_t::none || tok_.type != token_t::start_object )
+      {
+        if ( !skip_value_() )
+          return fail_();
+        continue;
+      }
+      section_ = section;
     }
-    catch ( ... )
+
+    if ( !next_() )
+      return fail_();
+    if ( tok_.type == token_t::end_object )
     {
-      return instance_return_code::invalid;
+      section_ = section_t::none;
+      return get_instance( out );
+    }
+    if ( tok_.type != token_t::key )
+      return fail_();
+
+    std::string name = tok_.str;
+    if ( !next_() )
+      return fail_();
+    if ( tok_.type != token_t::start_object )
+      return skip_value_() ? instance_return_code::invalid : fail_();
+
+    bool ok = false;
+    switch ( section_ )
+    {
+    case section_t::ports:
+      ok = read_port_( std::move( name ), out );
+      break;
+    case section_t::cells:
+      ok = read_cell_( std::move( name ), out );
+      break;
+    default:
+      ok = read_net_( std::move( name ), out );
+      break;
     }
+    return ok ? instance_return_code::valid : fail_();
   }
 
   const std::string& module_name() const { return module_name_; }
   int file_line = 0;
 
 private:
-  static bool is_number_( const rapidjson::Value& v )
+  static constexpr size_t buffer_size = 1u << 16;
+
+  enum class section_t
+  {
+    none,
+    ports,
+    cells,
+    netnames
+  };
+
+  enum class token_t
+  {
+    none,
+    null_value,
+    boolean,
+    int64,
+    uint64,
+    real,
+    string,
+    key,
+    start_object,
+    end_object,
+    start_array,
+    end_array
+  };
+
+  /*! \brief Handler storing the last token read by the parser */
+  struct token_handler_t
+  {
+    token_t type = token_t::none;
+    bool boolean = false;
+    int64_t int64 = 0;
+    uint64_t uint64 = 0;
+    double real = 0;
+    std::string str;
+
+    bool Null()
+    {
+      type = token_t::null_value;
+      return true;
+    }
+    bool Bool( bool b )
+    {
+      type = token_t::boolean;
+      boolean = b;
+      return true;
+    }
+    bool Int( int i )
+    {
+      return Int64( i );
+    }
+    bool Uint( unsigned u )
+    {
+      return Uint64( u );
+    }
+    bool Int64( int64_t i )
+    {
+      type = token_t::int64;
+      int64 = i;
+      return true;
+    }
+    bool Uint64( uint64_t u )
+    {
+      type = token_t::uint64;
+      uint64 = u;
+      int64 = static_cast<int64_t>( u );
+      return true;
+    }
+    bool Double( double d )
+    {
+      type = token_t::real;
+      real = d;
+      return true;
+    }
+    bool RawNumber( const char* str, rapidjson::SizeType length, bool copy )
+    {
+      return String( str, length, copy );
+    }
+    bool String( const char* s, rapidjson::SizeType length, bool )
+    {
+      type = token_t::string;
+      str.assign( s, length );
+      return true;
+    }
+    bool Key( const char* s, rapidjson::SizeType length, bool )
+    {
+      type = token_t::key;
+      str.assign( s, length );
+      return true;
+    }
+    bool StartObject()
+    {
+      type = token_t::start_object;
+      return true;
+    }
+    bool EndObject( rapidjson::SizeType )
+    {
+      type = token_t::end_object;
+      return true;
+    }
+    bool StartArray()
+    {
+      type = token_t::start_array;
+      return true;
+    }
+    bool EndArray( rapidjson::SizeType )
+    {
+      type = token_t::end_array;
+      return true;
+    }
+  };
+
+  /*! \brief Restart the tokenizer from the beginning of the stream */
+  bool rewind_()
+  {
+    in_.clear();
+    if ( start_ == std::streampos( -1 ) || !in_.seekg( start_ ) )
+      return false;
+    isw_.emplace( in_, buffer_.data(), buffer_.size() );
+    reader_.IterativeParseInit();
+    module_done_ = false;
+    return true;
+  }
+
+  /*! \brief Read the next token. Returns false at the end of the file or on errors */
+  bool next_()
   {
-    return v.IsInt64() || v.IsUint64() || v.IsInt() || v.IsUint();
+    tok_.type = token_t::none;
+    if ( reader_.IterativeParseComplete() )
+      return false;
+    if ( !reader_.IterativeParseNext<rapidjson::kParseDefaultFlags>( *isw_, tok_ ) )
+    {
+      rinox::diagnostics::REPORT_DIAG( diag_, lorina::diagnostic_level::fatal,
+                                       "JSON parse error at offset {}", reader_.GetErrorOffset() );
+      return false;
+    }
+    return tok_.type != token_t::none;
   }
-  static int64_t to_int64_( const rapidjson::Value& v )
+
+  /*! \brief Skip the value starting with the current token */
+  bool skip_value_()
   {
-    if ( v.IsInt64() )
-      return v.GetInt64();
-    if ( v.IsUint64() )
-      return static_cast<int64_t>( v.GetUint64() );
-    if ( v.IsInt() )
-      return v.GetInt();
-    if ( v.IsUint() )
-      return static_cast<int64_t>( v.GetUint() );
-    return 0;
+    if ( tok_.type != token_t::start_object && tok_.type != token_t::start_array )
+      return true;
+    uint32_t depth = 1u;
+    while ( depth > 0u )
+    {
+      if ( !next_() )
+        return false;
+      if ( tok_.type == token_t::start_object || tok_.type == token_t::start_array )
+        ++depth;
+      else if ( tok_.type == token_t::end_object || tok_.type == token_t::end_array )
+        --depth;
+    }
+    return true;
   }
 
-  static std::vector<json_bit_t> read_bits_( const rapidjson::Value& v )
+  instance_return_code fail_()
   {
-    std::vector<json_bit_t> out;
-    if ( !v.IsArray() )
-      return out;
-    for ( auto it = v.Begin(); it != v.End(); ++it )
+    parse_ok_ = false;
+    return instance_return_code::invalid;
+  }
+
+  /*! \brief Collect the names of the modules, skipping their content */
+  bool scan_module_names_()
+  {
+    if ( !next_() || tok_.type != token_t::start_object )
+      return false;
+    while ( next_() && tok_.type == token_t::key )
     {
-      if ( is_number_( *it ) )
-      {
-        out.push_back( json_bit_t{ to_int64_( *it ) } );
-      }
-      else if ( it->IsString() )
+      bool const is_modules = tok_.str == "modules";
+      if ( !next_() )
+        return false;
+      if ( is_modules && tok_.type == token_t::start_object )
       {
-        out.push_back( json_bit_t{ std::string( it->GetString(), it->GetStringLength() ) } );
+        while ( next_() && tok_.type == token_t::key )
+        {
+          module_names_.push_back( tok_.str );
+          if ( !next_() || !skip_value_() )
+            return false;
+        }
+        if ( tok_.type != token_t::end_object )
+          return false;
       }
+      else if ( !skip_value_() )
+        return false;
     }
-    return out;
+    return tok_.type == token_t::end_object;
   }
 
-  static std::string raw_to_string_( const rapidjson::Value& v )
+  bool is_number_() const
   {
-    rapidjson::StringBuffer sb;
-    rapidjson::Writer<rapidjson::StringBuffer> w( sb );
-    v.Accept( w );
-    return std::string( sb.GetString(), sb.GetSize() );
+    return tok_.type == token_t::int64 || tok_.type == token_t::uint64;
+  }
+
+  /*! \brief Read a boolean given either as a boolean or as a number */
+  bool read_flag_( bool& flag )
+  {
+    if ( !next_() )
+      return false;
+    if ( tok_.type == token_t::boolean )
+      flag = tok_.boolean;
+    else
+      flag = is_number_() && tok_.int64 != 0;
+    return skip_value_();
   }
 
-  instance_return_code read_port_( instance_t& out )
+  bool read_bits_( std::vector<json_bit_t>& out )
   {
-    const auto& mem = *p_it_;
-    const std::string name = mem.name.GetString();
-    const auto& pobj = mem.value;
-    if ( !pobj.IsObject() )
+    out.clear();
+    if ( !next_() )
+      return false;
+    if ( tok_.type != token_t::start_array )
+      return skip_value_();
+    while ( next_() && tok_.type != token_t::end_array )
     {
-      ++p_it_;
-      return instance_return_code::invalid;
+      if ( is_number_() )
+        out.push_back( json_bit_t{ tok_.int64 } );
+      else if ( tok_.type == token_t::string )
+        out.push_back( json_bit_t{ tok_.str } );
+      else if ( !skip_value_() )
+        return false;
     }
+    return tok_.type == token_t::end_array;
+  }
 
-    port_instance_t port;
-    port.name = name;
-
-    if ( pobj.HasMember( "direction" ) && pobj["direction"].IsString() )
-      port.direction = pobj["direction"].GetString();
-    if ( pobj.HasMember( "bits" ) )
-      port.bits = read_bits_( pobj["bits"] );
-
-    if ( pobj.HasMember( "offset" ) && is_number_( pobj["offset"] ) )
-      port.offset = to_int64_( pobj["offset"] );
-    if ( pobj.HasMember( "upto" ) )
-      port.upto = pobj["upto"].IsBool() ? pobj["upto"].GetBool() : ( is_number_( pobj["upto"] ) && to_int64_( pobj["upto"] ) != 0 );
-    if ( pobj.HasMember( "signed" ) )
-      port.is_signed = pobj["signed"].IsBool() ? pobj["signed"].GetBool() : ( is_number_( pobj["signed"] ) && to_int64_( pobj["signed"] ) != 0 );
-    if ( pobj.HasMember( "hide_name" ) && is_number_( pobj["hide_name"] ) )
-      port.hide_name = static_cast<int>( to_int64_( pobj["hide_name"] ) );
-    if ( pobj.HasMember( "attributes" ) && pobj["attributes"].IsObject() )
+  /*! \brief Serialize the value starting with the next token */
+  bool read_raw_( std::string& out )
+  {
+    rapidjson::StringBuffer sb;
+    rapidjson::Writer<rapidjson::StringBuffer> w( sb );
+    uint32_t depth = 0u;
+    do
     {
-      for ( auto it = pobj["attributes"].MemberBegin(); it != pobj["attributes"].MemberEnd(); ++it )
+      if ( !next_() )
+        return false;
+      switch ( tok_.type )
       {
-        port.attributes.emplace_back( it->name.GetString(), raw_to_string_( it->value ) );
+      case token_t::null_value:
+        w.Null();
+        break;
+      case token_t::boolean:
+        w.Bool( tok_.boolean );
+        break;
+      case token_t::int64:
+        w.Int64( tok_.int64 );
+        break;
+      case token_t::uint64:
+        w.Uint64( tok_.uint64 );
+        break;
+      case token_t::real:
+        w.Double( tok_.real );
+        break;
+      case token_t::string:
+        w.String( tok_.str.data(), static_cast<rapidjson::SizeType>( tok_.str.size() ) );
+        break;
+      case token_t::key:
+        w.Key( tok_.str.data(), static_cast<rapidjson::SizeType>( tok_.str.size() ) );
+        break;
+      case token_t::start_object:
+        w.StartObject();
+        ++depth;
+        break;
+      case token_t::end_object:
+        w.EndObject();
+        --depth;
+        break;
+      case token_t::start_array:
+        w.StartArray();
+        ++depth;
+        break;
+      case token_t::end_array:
+        w.EndArray();
+        --depth;
+        break;
+      default:
+        return false;
       }
-    }
-
-    ++p_it_;
-    out = std::move( port );
-    return instance_return_code::valid;
+    } while ( depth > 0u );
+    out.assign( sb.GetString(), sb.GetSize() );
+    return true;
   }
 
-  instance_return_code read_cell_( instance_t& out )
+  /*! \brief Read an object of raw values as a list of key-value pairs */
+  bool read_raw_pairs_( std::vector<std::pair<std::string, std::string>>& out )
   {
-    const auto& mem = *c_it_;
-    const std::string name = mem.name.GetString();
-    const auto& cobj = mem.value;
-    if ( !cobj.IsObject() )
+    if ( !next_() )
+      return false;
+    if ( tok_.type != token_t::start_object )
+      return skip_value_();
+    while ( next_() && tok_.type == token_t::key )
     {
-      ++c_it_;
-      return instance_return_code::invalid;
+      std::string key = tok_.str;
+      std::string value;
+      if ( !read_raw_( value ) )
+        return false;
+      out.emplace_back( std::move( key ), std::move( value ) );
     }
+    return tok_.type == token_t::end_object;
+  }
 
-    cell_instance_t cell;
-    cell.name = name;
-    if ( cobj.HasMember( "type" ) && cobj["type"].IsString() )
-      cell.type = cobj["type"].GetString();
-
-    if ( cobj.HasMember( "model" ) && cobj["model"].IsString() )
-      cell.model = cobj["model"].GetString();
+  bool read_port_( std::string name, instance_t& out )
+  {
+    port_instance_t port;
+    port.name = std::move( name );
 
-    if ( cobj.HasMember( "port_directions" ) && cobj["port_directions"].IsObject() )
+    while ( next_() && tok_.type == token_t::key )
     {
-      const auto& pd = cobj["port_directions"];
-      for ( auto it = pd.MemberBegin(); it != pd.MemberEnd(); ++it )
+      bool ok = true;
+      if ( tok_.str == "direction" )
       {
-        if ( it->value.IsString() )
-          cell.port_dirs.emplace( it->name.GetString(), it->value.GetString() );
+        ok = next_();
+        if ( ok && tok_.type == token_t::string )
+          port.direction = tok_.str;
+        else if ( ok )
+          ok = skip_value_();
       }
-    }
-
-    if ( cobj.HasMember( "parameters" ) && cobj["parameters"].IsObject() )
-    {
-      const auto& pv = cobj["parameters"];
-      for ( auto it = pv.MemberBegin(); it != pv.MemberEnd(); ++it )
+      else if ( tok_.str == "bits" )
+        ok = read_bits_( port.bits );
+      else if ( tok_.str == "offset" )
       {
-        cell.parameters.emplace_back( it->name.GetString(), raw_to_string_( it->value ) );
+        ok = next_();
+        if ( ok && is_number_() )
+          port.offset = tok_.int64;
+        else if ( ok )
+          ok = skip_value_();
       }
-    }
-    if ( cobj.HasMember( "attributes" ) && cobj["attributes"].IsObject() )
-    {
-      const auto& av = cobj["attributes"];
-      for ( auto it = av.MemberBegin(); it != av.MemberEnd(); ++it )
+      else if ( tok_.str == "upto" )
+        ok = read_flag_( port.upto );
+      else if ( tok_.str == "signed" )
+        ok = read_flag_( port.is_signed );
+      else if ( tok_.str == "hide_name" )
       {
-        cell.attributes.emplace_back( it->name.GetString(), raw_to_string_( it->value ) );
+        ok = next_();
+        if ( ok && is_number_() )
+          port.hide_name = static_cast<int>( tok_.int64 );
+        else if ( ok )
+          ok = skip_value_();
       }
+      else if ( tok_.str == "attributes" )
+        ok = read_raw_pairs_( port.attributes );
+      else
+        ok = next_() && skip_value_();
+      if ( !ok )
+        return false;
     }
+    if ( tok_.type != token_t::end_object )
+      return false;
+
+    out = std::move( port );
+    return true;
+  }
+
+  bool read_cell_( std::string name, instance_t& out )
+  {
+    cell_instance_t cell;
+    cell.name = std::move( name );
 
-    if ( cobj.HasMember( "connections" ) && cobj["connections"].IsObject() )
+    while ( next_() && tok_.type == token_t::key )
     {
-      const auto& conn = cobj["connections"];
-      for ( auto it = conn.MemberBegin(); it != conn.MemberEnd(); ++it )
+      bool ok = true;
+      if ( tok_.str == "type" || tok_.str == "model" )
       {
-        cell.connections.emplace( it->name.GetString(), read_bits_( it->value ) );
+        std::string& field = tok_.str == "type" ? cell.type : cell.model;
+        ok = next_();
+        if ( ok && tok_.type == token_t::string )
+          field = tok_.str;
+        else if ( ok )
+          ok = skip_value_();
       }
+      else if ( tok_.str == "port_directions" )
+      {
+        ok = next_();
+        if ( ok && tok_.type == token_t::start_object )
+        {
+          while ( ( ok = next_() ) && tok_.type == token_t::key )
+          {
+            std::string pin = tok_.str;
+            if ( !( ok = next_() ) )
+              break;
+            if ( tok_.type == token_t::string )
+              cell.port_dirs.emplace( std::move( pin ), tok_.str );
+            else if ( !( ok = skip_value_() ) )
+              break;
+          }
+          ok = ok && tok_.type == token_t::end_object;
+        }
+        else if ( ok )
+          ok = skip_value_();
+      }
+      else if ( tok_.str == "parameters" )
+        ok = read_raw_pairs_( cell.parameters );
+      else if ( tok_.str == "attributes" )
+        ok = read_raw_pairs_( cell.attributes );
+      else if ( tok_.str == "connections" )
+      {
+        ok = next_();
+        if ( ok && tok_.type == token_t::start_object )
+        {
+          while ( ( ok = next_() ) && tok_.type == token_t::key )
+          {
+            std::string pin = tok_.str;
+            std::vector<json_bit_t> bits;
+            if ( !( ok = read_bits_( bits ) ) )
+              break;
+            cell.connections.emplace( std::move( pin ), std::move( bits ) );
+          }
+          ok = ok && tok_.type == token_t::end_object;
+        }
+        else if ( ok )
+          ok = skip_value_();
+      }
+      else
+        ok = next_() && skip_value_();
+      if ( !ok )
+        return false;
     }
+    if ( tok_.type != token_t::end_object )
+      return false;
 
-    ++c_it_;
     out = std::move( cell );
-    return instance_return_code::valid;
+    return true;
   }
 
-  instance_return_code read_net_( instance_t& out )
+  bool read_net_( std::string name, instance_t& out )
   {
-    const auto& mem = *n_it_;
-    const std::string name = mem.name.GetString();
-    const auto& nobj = mem.value;
-    if ( !nobj.IsObject() )
+    net_name_instance_t net;
+    net.name = std::move( name );
+
+    while ( next_() && tok_.type == token_t::key )
     {
-      ++n_it_;
-      return instance_return_code::invalid;
+      bool const ok = ( tok_.str == "bits" ) ? read_bits_( net.bits ) : ( next_() && skip_value_() );
+      if ( !ok )
+        return false;
     }
+    if ( tok_.type != token_t::end_object )
+      return false;
 
-    net_name_instance_t net;
-    net.name = name;
-    if ( nobj.HasMember( "bits" ) )
-      net.bits = read_bits_( nobj["bits"] );
-
-    ++n_it_;
     out = std::move( net );
-    return instance_return_code::valid;
+    return true;
   }
 
 private:
   bool parse_ok_ = true;
   std::string module_name_;
+  std::vector<std::string> module_names_;
 
-  rapidjson::Document doc_;
-  const rapidjson::Value* module_ = nullptr;
-
-  const rapidjson::Value* ports_ = nullptr;
-  const rapidjson::Value* cells_ = nullptr;
-  const rapidjson::Value* nets_ = nullptr;
+  std::istream& in_;
+  std::streampos start_;
   lorina::diagnostic_engine* diag_;
 
-  rapidjson::Value::ConstMemberIterator p_it_{}, p_end_{};
-  rapidjson::Value::ConstMemberIterator c_it_{}, c_end_{};
-  rapidjson::Value::ConstMemberIterator n_it_{}, n_end_{};
+  /* incremental tokenizer */
+  std::vector<char> buffer_;
+  std::optional<rapidjson::IStreamWrapper> isw_;
+  rapidjson::Reader reader_;
+  token_handler_t tok_;
+
+  /* position in the current module */
+  section_t section_ = section_t::none;
+  bool at_module_start_ = false;
+  bool module_done_ = false;
 };
 
 } // namespace json
@@ -51,10 +51,10 @@ namespace json
 
 using json = nlohmann::json;
 
-template<network::design_type_t DesignStyle, uint32_t MaxNumOutputs>
-void write_json( network::bound_network<DesignStyle, MaxNumOutputs> const& ntk, std::ostream& os )
+template<network::design_type_t DesignStyle, uint32_t MaxNumOutputs, network::storage_layout_t Layout>
+void write_json( network::bound_network<DesignStyle, MaxNumOutputs, Layout> const& ntk, std::ostream& os )
 {
-  using Ntk = network::bound_network<DesignStyle, MaxNumOutputs>;
+  using Ntk = network::bound_network<DesignStyle, MaxNumOutputs, Layout>;
   mockturtle::topo_view topo_ntk{ ntk };
   auto const& gates = ntk.get_library();
 
@@ -195,11 +195,11 @@ void write_json( network::bound_network<DesignStyle, MaxNumOutputs> const& ntk,
   os << j.dump( 2 );
 }
 
-template<network::design_type_t DesignStyle, uint32_t MaxNumOutputs>
-void write_json( network::bound_network<DesignStyle, MaxNumOutputs> const& ntk, std::string const& filename )
+template<network::design_type_t DesignStyle, uint32_t MaxNumOutputs, network::storage_layout_t Layout>
+void write_json( network::bound_network<DesignStyle, MaxNumOutputs, Layout> const& ntk, std::string const& filename )
 {
   std::ofstream os( filename.c_str(), std::ofstream::out );
-  write_json<DesignStyle, MaxNumOutputs>( ntk, os );
+  write_json<DesignStyle, MaxNumOutputs, Layout>( ntk, os );
   os.close();
 }
 
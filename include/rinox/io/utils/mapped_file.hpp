@@ -0,0 +1,168 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file mapped_file.hpp
+  \brief Read-only memory mapping of a file
+
+  \author Andrea Costamagna
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rinox
+{
+
+namespace io
+{
+
+/*! \brief Read-only view of a file mapped in memory.
+ *
+ * The mapping is released when the object is destroyed. Empty files are
+ * valid and result in an empty view.
+ */
+class mapped_file
+{
+public:
+  mapped_file() = default;
+
+  explicit mapped_file( std::string const& filename )
+  {
+    open( filename );
+  }
+
+  mapped_file( mapped_file const& ) = delete;
+  mapped_file& operator=( mapped_file const& ) = delete;
+
+  mapped_file( mapped_file&& other ) noexcept
+      : data_( other.data_ ), size_( other.size_ ), is_open_( other.is_open_ )
+  {
+    other.data_ = nullptr;
+    other.size_ = 0u;
+    other.is_open_ = false;
+  }
+
+  mapped_file& operator=( mapped_file&& other ) noexcept
+  {
+    if ( this != &other )
+    {
+      close();
+      data_ = other.data_;
+      size_ = other.size_;
+      is_open_ = other.is_open_;
+      other.data_ = nullptr;
+      other.size_ = 0u;
+      other.is_open_ = false;
+    }
+    return *this;
+  }
+
+  ~mapped_file()
+  {
+    close();
+  }
+
+  /*! \brief Map the file in memory, returns false if it cannot be read */
+  bool open( std::string const& filename )
+  {
+    close();
+    int const fd = ::open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+      return false;
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0 )
+    {
+      ::close( fd );
+      return false;
+    }
+
+    size_ = static_cast<size_t>( st.st_size );
+    if ( size_ > 0u )
+    {
+      void* ptr = ::mmap( nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if ( ptr == MAP_FAILED )
+      {
+        ::close( fd );
+        size_ = 0u;
+        return false;
+      }
+      ::madvise( ptr, size_, MADV_SEQUENTIAL );
+      data_ = static_cast<char const*>( ptr );
+    }
+    /* the mapping stays valid after closing the descriptor */
+    ::close( fd );
+    is_open_ = true;
+    return true;
+  }
+
+  void close()
+  {
+    if ( data_ != nullptr )
+      ::munmap( const_cast<char*>( data_ ), size_ );
+    data_ = nullptr;
+    size_ = 0u;
+    is_open_ = false;
+  }
+
+  bool is_open() const
+  {
+    return is_open_;
+  }
+
+  char const* data() const
+  {
+    return data_;
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  std::string_view view() const
+  {
+    return std::string_view( data_, size_ );
+  }
+
+private:
+  char const* data_ = nullptr;
+  size_t size_ = 0u;
+  bool is_open_ = false;
+};
+
+} // namespace io
+
+} // namespace rinox
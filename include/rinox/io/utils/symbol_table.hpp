@@ -0,0 +1,138 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file symbol_table.hpp
+  \brief Interning of the names read by the parsers
+
+  \author Andrea Costamagna
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rinox
+{
+
+namespace io
+{
+
+/*! \brief Table assigning a dense identifier to each distinct name.
+ *
+ * Each name is copied once in a chunked arena, so that the views returned by
+ * `name` stay valid for the lifetime of the table, independently of the buffer
+ * the name was read from. Interning the same name again only costs a lookup.
+ */
+class symbol_table
+{
+public:
+  using symbol_t = uint32_t;
+
+private:
+  static constexpr size_t chunk_size = 1u << 16;
+
+public:
+  /*! \brief Returns the identifier of a name, adding it if needed */
+  symbol_t intern( std::string_view name )
+  {
+    if ( auto const it = ids_.find( name ); it != ids_.end() )
+      return it->second;
+
+    std::string_view const stored = store( name );
+    symbol_t const id = static_cast<symbol_t>( names_.size() );
+    names_.push_back( stored );
+    ids_.emplace( stored, id );
+    return id;
+  }
+
+  /*! \brief Returns the identifier of a name, if it has been interned */
+  std::optional<symbol_t> find( std::string_view name ) const
+  {
+    if ( auto const it = ids_.find( name ); it != ids_.end() )
+      return it->second;
+    return std::nullopt;
+  }
+
+  std::string_view name( symbol_t id ) const
+  {
+    return names_[id];
+  }
+
+  size_t size() const
+  {
+    return names_.size();
+  }
+
+  void clear()
+  {
+    ids_.clear();
+    names_.clear();
+    chunks_.clear();
+    used_ = chunk_size;
+  }
+
+private:
+  std::string_view store( std::string_view name )
+  {
+    if ( name.empty() )
+      return std::string_view{};
+
+    /* names longer than a chunk get their own allocation */
+    if ( name.size() > chunk_size )
+    {
+      chunks_.emplace_back( new char[name.size()] );
+      std::memcpy( chunks_.back().get(), name.data(), name.size() );
+      used_ = chunk_size;
+      return std::string_view( chunks_.back().get(), name.size() );
+    }
+
+    if ( used_ + name.size() > chunk_size )
+    {
+      chunks_.emplace_back( new char[chunk_size] );
+      used_ = 0u;
+    }
+    char* dst = chunks_.back().get() + used_;
+    std::memcpy( dst, name.data(), name.size() );
+    used_ += name.size();
+    return std::string_view( dst, name.size() );
+  }
+
+private:
+  std::unordered_map<std::string_view, symbol_t> ids_;
+  std::vector<std::string_view> names_;
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  size_t used_ = chunk_size;
+};
+
+} // namespace io
+
+} // namespace rinox
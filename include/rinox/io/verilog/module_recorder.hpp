@@ -0,0 +1,307 @@
+/* rinox: C++ parsing library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file module_recorder.hpp
+  \brief Parsing of the modules of a VERILOG file in separate threads
+
+  \author Andrea Costamagna
+*/
+
+#pragma once
+
+#include "../utils/reader.hpp"
+
+#include <cctype>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace rinox
+{
+
+namespace io
+{
+
+namespace verilog
+{
+
+namespace detail
+{
+
+inline bool is_identifier_char( char c )
+{
+  return std::isalnum( static_cast<unsigned char>( c ) ) || c == '_' || c == '$' || c == '\'';
+}
+
+/*! \brief Split a VERILOG buffer in the text of its modules.
+ *
+ * Each view starts at the keyword `module` and ends after the matching
+ * `endmodule`. The keywords are only matched as whole words, outside of line
+ * comments, strings and escaped identifiers. The text between the modules is
+ * dropped.
+ */
+inline std::vector<std::string_view> split_modules( std::string_view buffer )
+{
+  std::vector<std::string_view> modules;
+  size_t begin = std::string_view::npos;
+  size_t i = 0u;
+  while ( i < buffer.size() )
+  {
+    char const c = buffer[i];
+    if ( c == '/' && i + 1 < buffer.size() && buffer[i + 1] == '/' )
+    {
+      while ( i < buffer.size() && buffer[i] != '\n' )
+        ++i;
+    }
+    else if ( c == '"' )
+    {
+      ++i;
+      while ( i < buffer.size() && buffer[i] != '"' )
+        ++i;
+      ++i;
+    }
+    else if ( c == '\\' )
+    {
+      while ( i < buffer.size() && !std::isspace( static_cast<unsigned char>( buffer[i] ) ) )
+        ++i;
+    }
+    else if ( is_identifier_char( c ) )
+    {
+      size_t const start = i;
+      while ( i < buffer.size() && is_identifier_char( buffer[i] ) )
+        ++i;
+      std::string_view const word = buffer.substr( start, i - start );
+      if ( begin == std::string_view::npos && word == "module" )
+      {
+        begin = start;
+      }
+      else if ( begin != std::string_view::npos && word == "endmodule" )
+      {
+        modules.push_back( buffer.substr( begin, i - begin ) );
+        begin = std::string_view::npos;
+      }
+    }
+    else
+    {
+      ++i;
+    }
+  }
+  return modules;
+}
+
+} // namespace detail
+
+/*! \brief Reader recording the callbacks of a module.
+ *
+ * The recorder is passed to `verilog_parser` in place of the reader building
+ * the network. The queries on the library of gates are forwarded to the target
+ * reader, which is not modified, while the callbacks are stored together with
+ * their arguments. Hence, several modules can be parsed concurrently, each one
+ * with its own recorder, and the network is built by replaying the recorders
+ * in the order of the modules.
+ */
+template<typename Ntk>
+class module_recorder
+{
+public:
+  using pin_t = std::pair<std::string, bool>;
+  using pin_map_t = std::vector<std::pair<std::string, std::string>>;
+
+  explicit module_recorder( reader<Ntk> const& target )
+      : target_( target )
+  {}
+
+#pragma region Queries
+  bool has_gate( std::string const& name ) const
+  {
+    return target_.has_gate( name );
+  }
+
+  bool is_input_pin( std::string const& gate_name, std::string const& pin_name ) const
+  {
+    return target_.is_input_pin( gate_name, pin_name );
+  }
+
+  bool is_output_pin( std::string const& gate_name, std::string const& pin_name ) const
+  {
+    return target_.is_output_pin( gate_name, pin_name );
+  }
+
+  unsigned int get_pin_id( std::string const& gate_name, std::string const& pin_name ) const
+  {
+    return target_.get_pin_id( gate_name, pin_name );
+  }
+#pragma endregion
+
+#pragma region Callbacks
+  void on_module_header( std::string const& module_name, std::vector<std::string> const& inouts ) const
+  {
+    record( [&t = target_, module_name, inouts]() { t.on_module_header( module_name, inouts ); } );
+  }
+
+  void on_inputs( std::vector<std::string> const& names, std::string const& size = "" ) const
+  {
+    record( [&t = target_, names, size]() { t.on_inputs( names, size ); } );
+  }
+
+  void on_outputs( std::vector<std::string> const& names, std::string const& size = "" ) const
+  {
+    record( [&t = target_, names, size]() { t.on_outputs( names, size ); } );
+  }
+
+  void on_wires( std::vector<std::string> const& names, std::string const& size = "" ) const
+  {
+    record( [&t = target_, names, size]() { t.on_wires( names, size ); } );
+  }
+
+  void on_parameter( std::string const& name, std::string const& value ) const
+  {
+    record( [&t = target_, name, value]() { t.on_parameter( name, value ); } );
+  }
+
+  void on_assign( std::string const& lhs, pin_t const& rhs ) const
+  {
+    record( [&t = target_, lhs, rhs]() { t.on_assign( lhs, rhs ); } );
+  }
+
+  void on_and( std::string const& lhs, pin_t const& a, pin_t const& b ) const
+  {
+    record( [&t = target_, lhs, a, b]() { t.on_and( lhs, a, b ); } );
+  }
+
+  void on_nand( std::string const& lhs, pin_t const& a, pin_t const& b ) const
+  {
+    record( [&t = target_, lhs, a, b]() { t.on_nand( lhs, a, b ); } );
+  }
+
+  void on_or( std::string const& lhs, pin_t const& a, pin_t const& b ) const
+  {
+    record( [&t = target_, lhs, a, b]() { t.on_or( lhs, a, b ); } );
+  }
+
+  void on_nor( std::string const& lhs, pin_t const& a, pin_t const& b ) const
+  {
+    record( [&t = target_, lhs, a, b]() { t.on_nor( lhs, a, b ); } );
+  }
+
+  void on_xor( std::string const& lhs, pin_t const& a, pin_t const& b ) const
+  {
+    record( [&t = target_, lhs, a, b]() { t.on_xor( lhs, a, b ); } );
+  }
+
+  void on_xnor( std::string const& lhs, pin_t const& a, pin_t const& b ) const
+  {
+    record( [&t = target_, lhs, a, b]() { t.on_xnor( lhs, a, b ); } );
+  }
+
+  void on_and3( std::string const& lhs, pin_t const& a, pin_t const& b, pin_t const& c ) const
+  {
+    record( [&t = target_, lhs, a, b, c]() { t.on_and3( lhs, a, b, c ); } );
+  }
+
+  void on_or3( std::string const& lhs, pin_t const& a, pin_t const& b, pin_t const& c ) const
+  {
+    record( [&t = target_, lhs, a, b, c]() { t.on_or3( lhs, a, b, c ); } );
+  }
+
+  void on_xor3( std::string const& lhs, pin_t const& a, pin_t const& b, pin_t const& c ) const
+  {
+    record( [&t = target_, lhs, a, b, c]() { t.on_xor3( lhs, a, b, c ); } );
+  }
+
+  void on_maj3( std::string const& lhs, pin_t const& a, pin_t const& b, pin_t const& c ) const
+  {
+    record( [&t = target_, lhs, a, b, c]() { t.on_maj3( lhs, a, b, c ); } );
+  }
+
+  void on_mux21( std::string const& lhs, pin_t const& a, pin_t const& b, pin_t const& c ) const
+  {
+    record( [&t = target_, lhs, a, b, c]() { t.on_mux21( lhs, a, b, c ); } );
+  }
+
+  void on_cell( pin_map_t const& input_assign, pin_map_t const& output_assign, std::vector<unsigned int> const& ids ) const
+  {
+    record( [&t = target_, input_assign, output_assign, ids]() { t.on_cell( input_assign, output_assign, ids ); } );
+  }
+
+  void on_module_instantiation( std::string const& module_name, std::vector<std::string> const& params, std::string const& inst_name,
+                                pin_map_t const& args ) const
+  {
+    record( [&t = target_, module_name, params, inst_name, args]() { t.on_module_instantiation( module_name, params, inst_name, args ); } );
+  }
+
+  void on_comment( std::string const& comment ) const
+  {
+    record( [&t = target_, comment]() { t.on_comment( comment ); } );
+  }
+
+  void sanitize_input_names() const
+  {
+    record( [&t = target_]() { t.sanitize_input_names(); } );
+  }
+
+  void sanitize_output_names() const
+  {
+    record( [&t = target_]() { t.sanitize_output_names(); } );
+  }
+
+  void on_endmodule() const
+  {
+    record( [&t = target_]() { t.on_endmodule(); } );
+  }
+#pragma endregion
+
+  /*! \brief Invoke the recorded callbacks on the target reader */
+  void replay() const
+  {
+    for ( auto const& event : events_ )
+      event();
+  }
+
+  size_t num_events() const
+  {
+    return events_.size();
+  }
+
+private:
+  template<typename Fn>
+  void record( Fn&& fn ) const
+  {
+    events_.emplace_back( std::forward<Fn>( fn ) );
+  }
+
+private:
+  reader<Ntk> const& target_;
+  mutable std::vector<std::function<void()>> events_;
+};
+
+} // namespace verilog
+
+} // namespace io
+
+} // namespace rinox
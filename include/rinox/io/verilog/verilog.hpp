@@ -37,10 +37,20 @@
 #pragma once
 
 #include <rinox/diagnostics.hpp>
+#include "../utils/mapped_file.hpp"
 #include "../utils/reader.hpp"
+#include "module_recorder.hpp"
 #include "verilog_parser.hpp"
 #include "write_verilog.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 namespace rinox
 {
 
@@ -83,10 +93,146 @@ template<typename Ntk>
   }
 }
 
+/*! \brief Reader function for VERILOG format.
+ *
+ * Reads a simplistic VERILOG format from a buffer in memory and invokes a
+ * callback method for each parsed primitive and each detected parse error.
+ * The tokens are views of the buffer, which must outlive the parsing.
+ *
+ * \param buffer Content of the VERILOG file
+ * \param reader A VERILOG reader with callback methods invoked for parsed primitives
+ * \param diag An optional diagnostic engine with callback methods for parse errors
+ * \return Success if parsing has been successful, or parse error if parsing has failed
+ */
+template<typename Ntk>
+[[nodiscard]] inline lorina::return_code read_verilog_buffer( std::string_view buffer, const reader<Ntk>& reader, lorina::diagnostic_engine* diag = nullptr )
+{
+  verilog_parser<rinox::io::reader<Ntk>, mapped_tokenizer> parser( buffer, reader, diag );
+  auto result = parser.parse_modules();
+  if ( !result )
+  {
+    return lorina::return_code::parse_error;
+  }
+  else
+  {
+    return lorina::return_code::success;
+  }
+}
+
+/*! \brief Reader function for VERILOG format parsing the modules in parallel.
+ *
+ * The boundaries of the modules are found by a first scan of the buffer.
+ * Then, `num_threads` threads parse the interfaces of the modules, i.e., their
+ * headers and declarations, and the bodies of the modules, each module into a
+ * `module_recorder`. A module can instantiate the modules defined before it,
+ * whose interfaces are declared to its parser. The network is built by
+ * replaying the recorded callbacks in the order of the modules, which resolves
+ * the instantiations in the same order as `read_verilog_buffer`, giving the
+ * same result.
+ *
+ * If the parsing of a module fails, the whole buffer is parsed sequentially,
+ * which also reports the errors.
+ *
+ * \param buffer Content of the VERILOG file
+ * \param reader A VERILOG reader with callback methods invoked for parsed primitives
+ * \param num_threads Number of threads, where 0 uses the available cores
+ * \param diag An optional diagnostic engine with callback methods for parse errors
+ * \return Success if parsing has been successful, or parse error if parsing has failed
+ */
+template<typename Ntk>
+[[nodiscard]] inline lorina::return_code read_verilog_buffer_parallel( std::string_view buffer, const reader<Ntk>& reader, uint32_t num_threads = 0u, lorina::diagnostic_engine* diag = nullptr )
+{
+  if ( num_threads == 0u )
+    num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+  std::vector<std::string_view> const chunks = detail::split_modules( buffer );
+  if ( num_threads == 1u || chunks.size() < 2u )
+    return read_verilog_buffer( buffer, reader, diag );
+
+  using parser_t = verilog_parser<module_recorder<Ntk>, mapped_tokenizer>;
+  uint32_t const num_workers = std::min<uint32_t>( num_threads, static_cast<uint32_t>( chunks.size() ) );
+  auto const foreach_chunk = [&]( auto&& fn ) {
+    std::atomic<uint32_t> next{ 0u };
+    auto const worker = [&]() {
+      for ( auto i = next++; i < chunks.size(); i = next++ )
+        fn( i );
+    };
+
+    std::vector<std::thread> threads;
+    for ( auto t = 1u; t < num_workers; ++t )
+      threads.emplace_back( worker );
+    worker();
+    for ( auto& thread : threads )
+      thread.join();
+  };
+
+  /* the diagnostic engine is not shared by the threads: errors are reported by the sequential parsing */
+  std::vector<std::optional<std::pair<std::string, typename parser_t::module_info>>> interfaces( chunks.size() );
+  foreach_chunk( [&]( uint32_t i ) {
+    module_recorder<Ntk> discarded( reader );
+    parser_t parser( chunks[i], discarded );
+    interfaces[i] = parser.parse_module_interface();
+  } );
+
+  typename parser_t::declared_modules_t declared;
+  for ( auto i = 0u; i < chunks.size(); ++i )
+  {
+    /* the redefinitions of a module are resolved by the sequential parsing */
+    if ( !interfaces[i] || !declared.emplace( interfaces[i]->first, std::make_pair( i, std::move( interfaces[i]->second ) ) ).second )
+      return read_verilog_buffer( buffer, reader, diag );
+  }
+
+  std::vector<module_recorder<Ntk>> recorders;
+  recorders.reserve( chunks.size() );
+  for ( auto i = 0u; i < chunks.size(); ++i )
+    recorders.emplace_back( reader );
+  std::vector<uint8_t> parsed( chunks.size(), 0u );
+  foreach_chunk( [&]( uint32_t i ) {
+    parser_t parser( chunks[i], recorders[i] );
+    parser.declare_modules( &declared, i );
+    parsed[i] = parser.parse_modules() ? 1u : 0u;
+  } );
+
+  if ( std::find( parsed.begin(), parsed.end(), 0u ) != parsed.end() )
+    return read_verilog_buffer( buffer, reader, diag );
+
+  /* serial stitch */
+  for ( auto const& recorder : recorders )
+    recorder.replay();
+  return lorina::return_code::success;
+}
+
+/*! \brief Reader function for VERILOG format parsing the modules in parallel.
+ *
+ * Maps the file in memory and reads it with `read_verilog_buffer_parallel`.
+ *
+ * \param filename Name of the file
+ * \param reader A VERILOG reader with callback methods invoked for parsed primitives
+ * \param num_threads Number of threads, where 0 uses the available cores
+ * \param diag An optional diagnostic engine with callback methods for parse errors
+ * \return Success if parsing has been successful, or parse error if parsing has failed
+ */
+template<typename Ntk>
+[[nodiscard]] inline lorina::return_code read_verilog_parallel( const std::string& filename, const reader<Ntk>& reader, uint32_t num_threads = 0u, lorina::diagnostic_engine* diag = nullptr )
+{
+  mapped_file file;
+  if ( !file.open( lorina::detail::word_exp_filename( filename ) ) )
+  {
+    rinox::diagnostics::REPORT_DIAG( diag, lorina::diagnostic_level::fatal, "failed to open file `{}`", filename.c_str() );
+    return lorina::return_code::parse_error;
+  }
+
+  auto const ret = read_verilog_buffer_parallel( file.view(), reader, num_threads, diag );
+  if ( ret != lorina::return_code::success )
+    rinox::diagnostics::REPORT_DIAG( diag, lorina::diagnostic_level::fatal, "failed to read the verilog file `{}`", filename.c_str() );
+  return ret;
+}
+
 /*! \brief Reader function for VERILOG format.
  *
  * Reads a simplistic VERILOG format from a file and invokes a callback
- * method for each parsed primitive and each detected parse error.
+ * method for each parsed primitive and each detected parse error. The
+ * file is mapped in memory and tokenized without copying it.
  *
  * \param filename Name of the file
  * \param reader A VERILOG reader with callback methods invoked for parsed primitives
@@ -96,16 +242,15 @@ template<typename Ntk>
 template<typename Ntk>
 [[nodiscard]] inline lorina::return_code read_verilog( const std::string& filename, const reader<Ntk>& reader, lorina::diagnostic_engine* diag = nullptr )
 {
-  std::ifstream in( lorina::detail::word_exp_filename( filename ), std::ifstream::in );
-  if ( !in.is_open() )
+  mapped_file file;
+  if ( !file.open( lorina::detail::word_exp_filename( filename ) ) )
   {
     rinox::diagnostics::REPORT_DIAG( diag, lorina::diagnostic_level::fatal, "failed to open file `{}`", filename.c_str() );
     return lorina::return_code::parse_error;
   }
   else
   {
-    auto const ret = read_verilog( in, reader, diag );
-    in.close();
+    auto const ret = read_verilog_buffer( file.view(), reader, diag );
     if ( ret != lorina::return_code::success )
       rinox::diagnostics::REPORT_DIAG( diag, lorina::diagnostic_level::fatal, "failed to read the verilog file `{}`", filename.c_str() );
 
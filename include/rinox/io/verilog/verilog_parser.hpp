@@ -34,6 +34,7 @@
 
 #include <rinox/diagnostics.hpp>
 #include "../utils/reader.hpp"
+#include "../utils/symbol_table.hpp"
 #include <algorithm>
 #include <cctype>
 #include <ctype.h>
@@ -43,8 +44,12 @@
 #include <lorina/detail/utils.hpp>
 #include <lorina/diagnostics.hpp>
 #include <lorina/verilog_regex.hpp>
+#include <optional>
 #include <queue>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 namespace rinox
 {
@@ -58,6 +63,9 @@ namespace verilog
 class augmented_tokenizer : public lorina::detail::tokenizer
 {
 public:
+  using input_t = std::istream&;
+  static constexpr bool zero_copy = false;
+
   explicit augmented_tokenizer( std::istream& in )
       : lorina::detail::tokenizer( in )
   {}
@@ -155,12 +163,188 @@ public:
   int file_line = 0;
 };
 
+/*! \brief Tokenizer reading from a contiguous buffer, e.g., a mapped file.
+ *
+ * Splits the buffer into the same tokens as `augmented_tokenizer`, but returns
+ * them as views of the buffer instead of building a string character by
+ * character. A token is copied in an internal buffer only when it is not
+ * contiguous in the input, which happens when the spaces inside a name are
+ * skipped. The views are valid until the next call.
+ */
+class mapped_tokenizer
+{
+public:
+  using input_t = std::string_view;
+  static constexpr bool zero_copy = true;
+
+  explicit mapped_tokenizer( std::string_view buffer )
+      : buffer_( buffer )
+  {}
+
+  lorina::detail::tokenizer_return_code get_token_view( std::string_view& token, bool use_spaces = false )
+  {
+    if ( done_ )
+    {
+      return lorina::detail::tokenizer_return_code::invalid;
+    }
+    begin_ = end_ = pos_;
+    split_ = false;
+
+    while ( pos_ < buffer_.size() )
+    {
+      char const c = buffer_[pos_++];
+      if ( c == '\n' )
+        file_line++;
+
+      if ( is_keyword( current() ) )
+      {
+        token = current();
+        return lorina::detail::tokenizer_return_code::valid;
+      }
+
+      if ( c == '\n' && comment_mode_ )
+      {
+        comment_mode_ = false;
+        token = current();
+        return lorina::detail::tokenizer_return_code::comment;
+      }
+      else if ( !comment_mode_ )
+      {
+        // Escaped identifier support: starts with '\'
+        if ( c == '\\' && !quote_mode_ )
+        {
+          append( pos_ - 1 );
+          while ( pos_ < buffer_.size() )
+          {
+            char const d = buffer_[pos_];
+            // Stop if we hit a delimiter, which is left for the next token
+            if ( d == '\n' || d == '\t' ||
+                 d == '=' || d == '+' || d == '-' || d == ',' || d == ';' || d == ')' || d == '(' || d == '{' || d == '}' || ( use_spaces && d == ' ' ) )
+              break;
+            append( pos_++ );
+          }
+          token = current();
+          return lorina::detail::tokenizer_return_code::valid;
+        }
+
+        if ( ( !use_spaces && c == ' ' ) && !quote_mode_ )
+        {
+          continue; // skip whitespace
+        }
+
+        if ( ( ( use_spaces && c == ' ' ) || ( c == '\n' ) ) && !quote_mode_ )
+        {
+          if ( !empty() )
+          {
+            token = current();
+            return lorina::detail::tokenizer_return_code::valid;
+          }
+          continue; // skip leading whitespace
+        }
+
+        if ( ( c == '(' || c == ')' || c == '{' || c == '}' ||
+               c == ';' || c == ':' || c == ',' || c == '~' ||
+               c == '&' || c == '|' || c == '^' || c == '#' ||
+               c == '[' || c == ']' || c == '=' || c == '+' || c == '-' ) &&
+             !quote_mode_ )
+        {
+          if ( empty() )
+            append( pos_ - 1 );
+          else
+            --pos_;
+          token = current();
+          return lorina::detail::tokenizer_return_code::valid;
+        }
+
+        if ( c == '"' )
+        {
+          quote_mode_ = !quote_mode_;
+        }
+      }
+
+      append( pos_ - 1 );
+    }
+
+    done_ = true;
+    token = current();
+    return lorina::detail::tokenizer_return_code::valid;
+  }
+
+  void set_comment_mode( bool value = true )
+  {
+    comment_mode_ = value;
+  }
+
+  bool get_comment_mode() const
+  {
+    return comment_mode_;
+  }
+
+private:
+  static bool is_keyword( std::string_view token )
+  {
+    return token == "module" || token == "assign" || token == "input" || token == "wire" || token == "output";
+  }
+
+  bool empty() const
+  {
+    return !split_ && begin_ == end_;
+  }
+
+  std::string_view current() const
+  {
+    return split_ ? std::string_view( split_token_ ) : buffer_.substr( begin_, end_ - begin_ );
+  }
+
+  /*! \brief Add the character at position `i` to the current token */
+  void append( size_t i )
+  {
+    if ( split_ )
+    {
+      split_token_ += buffer_[i];
+    }
+    else if ( begin_ == end_ )
+    {
+      begin_ = i;
+      end_ = i + 1;
+    }
+    else if ( end_ == i )
+    {
+      ++end_;
+    }
+    else
+    {
+      /* the token is not contiguous in the buffer */
+      split_token_.assign( buffer_.substr( begin_, end_ - begin_ ) );
+      split_token_ += buffer_[i];
+      split_ = true;
+    }
+  }
+
+public:
+  int file_line = 0;
+
+private:
+  std::string_view buffer_;
+  size_t pos_ = 0u;
+  size_t begin_ = 0u;
+  size_t end_ = 0u;
+  bool split_ = false;
+  std::string split_token_;
+
+  bool done_ = false;
+  bool comment_mode_ = false;
+  bool quote_mode_ = false;
+};
+
 /*! \brief Simple parser for VERILOG format.
  *
  * Simplistic grammar-oriented parser for a structural VERILOG format.
  *
+ * The tokens are read from a stream with `augmented_tokenizer`, or from a
+ * buffer in memory with `mapped_tokenizer`.
  */
-template<typename verilog_reader>
+template<typename verilog_reader, typename Tokenizer = augmented_tokenizer>
 class verilog_parser
 {
 public:
@@ -170,14 +354,31 @@ public:
     std::vector<std::string> outputs;
   };
 
+  /*! \brief Interfaces of the modules of a buffer, with the position of their definition */
+  using declared_modules_t = std::unordered_map<std::string, std::pair<uint32_t, module_info>>;
+
+private:
+  /* direction and binding ID of a pin of a gate */
+  struct pin_info
+  {
+    enum : int8_t
+    {
+      unknown,
+      input,
+      output
+    };
+    int8_t direction = unknown;
+    unsigned int id = 0u;
+  };
+
 public:
   /*! \brief Construct a VERILOG parser
    *
-   * \param in Input stream
+   * \param in Input stream, or buffer for `mapped_tokenizer`
    * \param reader A verilog reader
    * \param diag A diagnostic engine
    */
-  verilog_parser( std::istream& in,
+  verilog_parser( typename Tokenizer::input_t in,
                   const verilog_reader& reader,
                   lorina::diagnostic_engine* diag = nullptr )
       : tok( in ), reader( reader ), diag( diag ), on_action( PackedFns( GateFn( [&]( const std::vector<std::pair<std::string, bool>>& inputs,
@@ -294,14 +495,23 @@ public:
     {
       if ( tokens.empty() )
       {
-        result = tok.get_token_internal( token, use_spaces );
-        lorina::detail::trim( token );
-
-        token.erase( remove( token.begin(), token.end(), ' ' ), token.end() );
-        // Normalize escaped identifiers: strip leading backslash
-        if ( !token.empty() && token[0] == '\\' )
+        if constexpr ( Tokenizer::zero_copy )
         {
-          token = token.substr( 1 );
+          std::string_view view;
+          result = tok.get_token_view( view, use_spaces );
+          normalize_token( token, view );
+        }
+        else
+        {
+          result = tok.get_token_internal( token, use_spaces );
+          lorina::detail::trim( token );
+
+          token.erase( remove( token.begin(), token.end(), ' ' ), token.end() );
+          // Normalize escaped identifiers: strip leading backslash
+          if ( !token.empty() && token[0] == '\\' )
+          {
+            token = token.substr( 1 );
+          }
         }
       }
       else
@@ -334,6 +544,57 @@ public:
     return ( result == lorina::detail::tokenizer_return_code::valid );
   }
 
+  /*! \brief Trim a token, remove its spaces and its leading backslash, and store it in `out` */
+  static void normalize_token( std::string& out, std::string_view view )
+  {
+    while ( !view.empty() && std::isspace( static_cast<unsigned char>( view.front() ) ) )
+      view.remove_prefix( 1 );
+    while ( !view.empty() && std::isspace( static_cast<unsigned char>( view.back() ) ) )
+      view.remove_suffix( 1 );
+
+    /* copy in the reused buffer of the current token */
+    out.assign( view.data(), view.size() );
+    if ( view.find( ' ' ) != std::string_view::npos )
+      out.erase( remove( out.begin(), out.end(), ' ' ), out.end() );
+    // Normalize escaped identifiers: strip leading backslash
+    if ( !out.empty() && out[0] == '\\' )
+      out.erase( 0, 1 );
+  }
+
+  /*! \brief Check if a name is a gate of the library, querying the reader once per name */
+  bool is_library_gate( std::string const& name )
+  {
+    symbol_table::symbol_t const sym = symbols.intern( name );
+    if ( sym >= is_gate.size() )
+      is_gate.resize( sym + 1, -1 );
+    if ( is_gate[sym] < 0 )
+      is_gate[sym] = reader.has_gate( name ) ? 1 : 0;
+    return is_gate[sym] == 1;
+  }
+
+  /*! \brief Direction and binding ID of a pin, querying the reader once per gate and pin */
+  pin_info const& resolve_pin( std::string const& gate_name, std::string_view pin_name )
+  {
+    uint64_t const key = ( uint64_t( symbols.intern( gate_name ) ) << 32 ) | symbols.intern( pin_name );
+    auto it = pins.find( key );
+    if ( it == pins.end() )
+    {
+      std::string const pin( pin_name );
+      pin_info info;
+      if ( reader.is_input_pin( gate_name, pin ) )
+      {
+        info.direction = pin_info::input;
+      }
+      else if ( reader.is_output_pin( gate_name, pin ) )
+      {
+        info.direction = pin_info::output;
+        info.id = reader.get_pin_id( gate_name, pin );
+      }
+      it = pins.emplace( key, info ).first;
+    }
+    return it->second;
+  }
+
   void push_token( std::string const& token )
   {
     tokens.push( token );
@@ -394,6 +655,49 @@ public:
     return true;
   }
 
+  /*! \brief Make the modules defined before `position` in another buffer instantiable.
+   *
+   * The interfaces are looked up when a module is instantiated, as if the
+   * modules had been parsed before the ones of this buffer.
+   */
+  void declare_modules( declared_modules_t const* declared, uint32_t position )
+  {
+    declared_modules = declared;
+    declared_position = position;
+  }
+
+  /*! \brief Parse the header and the declarations of the next module, without its body.
+   *
+   * \return The name and the interface of the module, or nothing if the parsing fails
+   */
+  std::optional<std::pair<std::string, module_info>> parse_module_interface()
+  {
+    if ( !get_token( token, true ) || token != "module" || !parse_module_header() )
+      return std::nullopt;
+
+    bool success = true;
+    do
+    {
+      valid = get_token( token, true );
+      if ( !valid )
+        return std::nullopt;
+      if ( token == "input" )
+        success = parse_inputs();
+      else if ( token == "output" )
+        success = parse_outputs();
+      else if ( token == "wire" )
+        success = parse_wires();
+      else if ( token == "parameter" )
+        success = parse_parameter();
+      else
+        break;
+      if ( !success )
+        return std::nullopt;
+    } while ( token != "assign" && token != "endmodule" );
+
+    return std::make_pair( module_name, modules[module_name] );
+  }
+
   bool parse_module()
   {
     bool success = parse_module_header();
@@ -482,7 +786,7 @@ public:
           return false;
         }
       }
-      else if ( reader.has_gate( token ) )
+      else if ( is_library_gate( token ) )
       {
         std::string const gate_name = token;
         success = parse_bound_gate();
@@ -928,7 +1232,7 @@ public:
 
   bool parse_bound_gate()
   {
-    if ( reader.has_gate( token ) == false )
+    if ( is_library_gate( token ) == false )
     {
       rinox::diagnostics::REPORT_DIAG( diag, lorina::diagnostic_level::fatal,
                    "the loaded library does not contain the gate `{}`", token.c_str() );
@@ -986,17 +1290,18 @@ public:
       /* only signal names and pin names here */
       if ( token[0] == '.' )
       {
-        std::string pin_name = token.substr( 1 );
-        if ( reader.is_input_pin( gate_name, pin_name ) )
+        std::string_view const pin_name = std::string_view( token ).substr( 1 );
+        pin_info const& pin = resolve_pin( gate_name, pin_name );
+        if ( pin.direction == pin_info::input )
         {
           state = pin_state::INPUT_PIN;
           input_assigns.emplace_back( pin_name, "" );
         }
-        else if ( reader.is_output_pin( gate_name, pin_name ) )
+        else if ( pin.direction == pin_info::output )
         {
           state = pin_state::OUTPUT_PIN;
           output_assigns.emplace_back( pin_name, "" );
-          ids.emplace_back( reader.get_pin_id( gate_name, pin_name ) );
+          ids.emplace_back( pin.id );
         }
         else
         {
@@ -1054,7 +1359,13 @@ public:
     bool success = true;
     std::string const module_name{ token }; // name of module
 
-    auto const it = modules.find( module_name );
+    auto it = modules.find( module_name );
+    if ( it == std::end( modules ) && declared_modules )
+    {
+      auto const decl = declared_modules->find( module_name );
+      if ( decl != declared_modules->end() && decl->second.first < declared_position )
+        it = modules.emplace( module_name, decl->second.second ).first;
+    }
     if ( it == std::end( modules ) )
     {
       if ( diag )
@@ -1645,7 +1956,7 @@ private:
   using PackedFns = lorina::detail::FuncPackN<GateFn, ModuleInstFn, CellFn>;
 
 private:
-  augmented_tokenizer tok;
+  Tokenizer tok;
   const verilog_reader& reader;
   lorina::diagnostic_engine* diag;
 
@@ -1657,6 +1968,15 @@ private:
 
   lorina::detail::call_in_topological_order<PackedFns, ParamMaps> on_action;
   std::unordered_map<std::string, module_info> modules;
+
+  /* interfaces of the modules defined in other buffers */
+  declared_modules_t const* declared_modules = nullptr;
+  uint32_t declared_position = 0u;
+
+  /* interned gate and pin names, with the resolution of the pins */
+  symbol_table symbols;
+  std::vector<int8_t> is_gate;
+  std::unordered_map<uint64_t, pin_info> pins;
 }; /* verilog_parser */
 
 } // namespace verilog
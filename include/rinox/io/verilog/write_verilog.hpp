@@ -278,10 +278,10 @@ inline std::vector<bus_info_t> infer_buses( const std::vector<std::string>& nets
  * \param os Output stream
  * \param ps Verilog parameters
  */
-template<network::design_type_t DesignStyle, uint32_t MaxNumOutputs>
-void write_verilog( network::bound_network<DesignStyle, MaxNumOutputs> const& ntk, std::ostream& os, mockturtle::write_verilog_params const& ps = {} )
+template<network::design_type_t DesignStyle, uint32_t MaxNumOutputs, network::storage_layout_t Layout>
+void write_verilog( network::bound_network<DesignStyle, MaxNumOutputs, Layout> const& ntk, std::ostream& os, mockturtle::write_verilog_params const& ps = {} )
 {
-  using Ntk = network::bound_network<DesignStyle, MaxNumOutputs>;
+  using Ntk = network::bound_network<DesignStyle, MaxNumOutputs, Layout>;
   static_assert( mockturtle::is_network_type_v<Ntk>, "Ntk is not a network type" );
   static_assert( mockturtle::has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
   static_assert( mockturtle::has_num_pos_v<Ntk>, "Ntk does not implement the num_pos method" );
@@ -549,11 +549,11 @@ void write_verilog( network::bound_network<DesignStyle, MaxNumOutputs> const& nt
  * \param ntk Network
  * \param filename Filename
  */
-template<network::design_type_t DesignStyle, uint32_t MaxNumOutputs>
-void write_verilog( network::bound_network<DesignStyle, MaxNumOutputs> const& ntk, std::string const& filename, mockturtle::write_verilog_params const& ps = {} )
+template<network::design_type_t DesignStyle, uint32_t MaxNumOutputs, network::storage_layout_t Layout>
+void write_verilog( network::bound_network<DesignStyle, MaxNumOutputs, Layout> const& ntk, std::string const& filename, mockturtle::write_verilog_params const& ps = {} )
 {
   std::ofstream os( filename.c_str(), std::ofstream::out );
-  write_verilog<DesignStyle, MaxNumOutputs>( ntk, os, ps );
+  write_verilog<DesignStyle, MaxNumOutputs, Layout>( ntk, os, ps );
   os.close();
 }
 
@@ -43,9 +43,12 @@
 #pragma once
 
 #include <set>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #include "../synthesis/xaig_decompose.hpp"
+#include "gate_kernel.hpp"
 
 #include <kitty/print.hpp>
 #include <mockturtle/io/genlib_reader.hpp>
@@ -57,6 +60,47 @@ namespace rinox
 namespace libraries
 {
 
+namespace detail
+{
+
+/*! \brief FNV-1a hash used to fingerprint the content of a library */
+struct fingerprint_hasher
+{
+  void operator()( void const* data, size_t size )
+  {
+    auto const* bytes = static_cast<uint8_t const*>( data );
+    for ( auto i = 0u; i < size; ++i )
+    {
+      value ^= bytes[i];
+      value *= 0x100000001b3ull;
+    }
+  }
+
+  template<typename T>
+  void operator()( T const& value )
+  {
+    static_assert( std::is_trivially_copyable_v<T>, "[e] only trivially copyable types can be hashed" );
+    ( *this )( &value, sizeof( T ) );
+  }
+
+  void operator()( std::string const& str )
+  {
+    ( *this )( str.size() );
+    ( *this )( str.data(), str.size() );
+  }
+
+  void operator()( kitty::dynamic_truth_table const& tt )
+  {
+    ( *this )( tt.num_vars() );
+    for ( auto it = tt.cbegin(); it != tt.cend(); ++it )
+      ( *this )( *it );
+  }
+
+  uint64_t value = 0xcbf29ce484222325ull;
+};
+
+} // namespace detail
+
 template<network::design_type_t DesignType>
 class augmented_library;
 
@@ -78,6 +122,7 @@ public:
   struct gate_t : gate
   {
     chain_t aig_chain;
+    gate_kernel kernel;
     std::vector<double> max_pin_time;
     std::vector<double> min_pin_time;
     double avg_pin_delay;
@@ -85,6 +130,7 @@ public:
     gate_t( const gate& g, chain_t const& chain )
         : gate( g ),
           aig_chain( chain ),
+          kernel( chain ),
           max_pin_time( g.num_vars, std::numeric_limits<double>::min() ),
           min_pin_time( g.num_vars, std::numeric_limits<double>::max() )
     {
@@ -158,6 +204,12 @@ public:
     return gates_[id].aig_chain;
   }
 
+  /*! \brief Getter of the compiled simulation kernel of the gate. */
+  gate_kernel const& get_kernel( uint32_t id ) const
+  {
+    return gates_[id].kernel;
+  }
+
   /*! \brief Getter of the gate's name. */
   std::string const& get_name( uint32_t id ) const
   {
@@ -234,6 +286,14 @@ public:
     return std::nullopt;
   }
 
+  /*! \brief Binding id of a single-input inverter, if the library has one. */
+  std::optional<unsigned int> get_inverter_id() const
+  {
+    kitty::dynamic_truth_table tt( 1u );
+    kitty::create_nth_var( tt, 0, true );
+    return get_id( tt );
+  }
+
   uint32_t get_fanin_number( unsigned int id, std::string const& pin_name ) const
   {
     auto const& g = gates_[id];
@@ -248,6 +308,37 @@ public:
     return std::numeric_limits<uint32_t>::max();
   }
 
+  /*! \brief Hash of the content of the library.
+   *
+   * Two libraries have the same fingerprint if their gates have the same
+   * names, functions, areas and pin parameters, in the same order. It is used
+   * to reject data computed for a different library, such as binary databases.
+   */
+  uint64_t fingerprint() const
+  {
+    detail::fingerprint_hasher hasher;
+    hasher( raw_gates_.size() );
+    for ( gate const& g : raw_gates_ )
+    {
+      hasher( g.name );
+      hasher( g.output_name );
+      hasher( g.area );
+      hasher( g.function );
+      for ( auto const& pin : g.pins )
+      {
+        hasher( pin.name );
+        hasher( static_cast<uint32_t>( pin.phase ) );
+        hasher( pin.input_load );
+        hasher( pin.max_load );
+        hasher( pin.rise_block_delay );
+        hasher( pin.rise_fanout_delay );
+        hasher( pin.fall_block_delay );
+        hasher( pin.fall_fanout_delay );
+      }
+    }
+    return hasher.value;
+  }
+
   /*! \brief Check if the gate is a multiple output gate from its name */
   bool is_multioutput( std::string const& name ) const
   {
@@ -331,10 +422,11 @@ public:
   struct gate_t : gate
   {
     gate_t( kitty::dynamic_truth_table const& function, chain_t const& chain )
-        : gate( function ), aig_chain( chain )
+        : gate( function ), aig_chain( chain ), kernel( chain )
     {}
 
     chain_t aig_chain;
+    gate_kernel kernel;
   };
 
   /*! \brief Construction via specification of the simpler library.
@@ -389,6 +481,12 @@ public:
     return gates_[id].aig_chain;
   }
 
+  /*! \brief Getter of the compiled simulation kernel of the gate. */
+  gate_kernel const& get_kernel( uint32_t id ) const
+  {
+    return gates_[id].kernel;
+  }
+
   /*! \brief Getter of the gate's name. */
   std::string const get_name( uint32_t id ) const
   {
@@ -444,6 +542,24 @@ public:
     return std::nullopt;
   }
 
+  /*! \brief Binding id of a single-input inverter, if the library has one. */
+  std::optional<unsigned int> get_inverter_id() const
+  {
+    kitty::dynamic_truth_table tt( 1u );
+    kitty::create_nth_var( tt, 0, true );
+    return get_id( tt );
+  }
+
+  /*! \brief Hash of the functions in the library, in insertion order. */
+  uint64_t fingerprint() const
+  {
+    detail::fingerprint_hasher hasher;
+    hasher( gates_.size() );
+    for ( gate_t const& g : gates_ )
+      hasher( g.function );
+    return hasher.value;
+  }
+
   /*! \brief Check if the gate is a multiple output gate from its name */
   bool is_multioutput( std::string const& name ) const
   {
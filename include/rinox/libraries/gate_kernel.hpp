@@ -0,0 +1,205 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file gate_kernel.hpp
+  \brief Straight-line simulation kernels for the gates of a library
+
+  \author Andrea Costamagna
+*/
+
+#pragma once
+
+#include "../evaluation/chains/xag_chain.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace rinox
+{
+
+namespace libraries
+{
+
+/*! \brief Compiled simulation kernel of a gate.
+ *
+ * The XAG index chain decomposing the gate is compiled once into a sequence
+ * of operations on 64-bit blocks, where the complementations of the operands
+ * are folded into the AND/XOR operations. Gates whose output is a constant or
+ * a ( possibly complemented ) input do not execute any operation.
+ *
+ * The kernel reads the simulations of the fanins from an array of pointers
+ * with one entry per input, and writes the result in place. Truth tables and
+ * raw blocks of 64 bits are both supported. The intermediate values are stored
+ * in a per-thread scratch memory, hence simulation does not allocate memory
+ * once the scratch memory has reached its maximum size.
+ */
+class gate_kernel
+{
+public:
+  /* literal of the operands: index 0 is the constant 0, then inputs, then operations */
+  using literal_t = uint32_t;
+  static constexpr uint32_t max_num_inputs = 32u;
+
+  struct operation_t
+  {
+    literal_t lhs;
+    literal_t rhs;
+    bool is_and;
+  };
+
+  gate_kernel() = default;
+
+  explicit gate_kernel( evaluation::chains::large_xag_chain const& chain )
+      : num_inputs_( static_cast<uint32_t>( chain.num_pis() ) )
+  {
+    chain.foreach_gate( [&]( auto const& lhs, auto const& rhs ) {
+      ops_.push_back( { lhs, rhs, chain.is_and( lhs, rhs ) } );
+    } );
+    output_ = chain.num_pos() > 0 ? chain.po_at( 0 ) : 0u;
+  }
+
+  uint32_t num_inputs() const
+  {
+    return num_inputs_;
+  }
+
+  uint32_t num_operations() const
+  {
+    return static_cast<uint32_t>( ops_.size() );
+  }
+
+  /*! \brief Simulate the gate.
+   *
+   * \param res Truth table where to store the result.
+   * \param inputs Array of `num_inputs()` pointers to the input simulations.
+   */
+  template<typename TT>
+  void operator()( TT& res, TT const* const* inputs ) const
+  {
+    if ( num_inputs_ > 0 && res.num_blocks() != inputs[0]->num_blocks() )
+      res = inputs[0]->construct();
+
+    assert( num_inputs_ <= max_num_inputs );
+    std::array<uint64_t const*, max_num_inputs> blocks;
+    for ( auto i = 0u; i < num_inputs_; ++i )
+      blocks[i] = &*inputs[i]->cbegin();
+
+    ( *this )( &*res.begin(), blocks.data(), res.num_blocks() );
+    res.mask_bits();
+  }
+
+  /*! \brief Simulate the gate on contiguous blocks of 64 bits.
+   *
+   * The unused bits of the last block are not masked.
+   *
+   * \param res Blocks where to store the result.
+   * \param inputs Array of `num_inputs()` pointers to the input blocks.
+   * \param num_blocks Number of blocks of each simulation.
+   */
+  void operator()( uint64_t* res, uint64_t const* const* inputs, uint64_t num_blocks ) const
+  {
+    uint32_t const out_index = output_ >> 1;
+    uint64_t const out_mask = ( output_ & 1u ) ? ~uint64_t( 0 ) : 0u;
+
+    /* constant or wire */
+    if ( out_index <= num_inputs_ )
+    {
+      if ( out_index == 0 )
+      {
+        for ( auto b = 0u; b < num_blocks; ++b )
+          res[b] = out_mask;
+      }
+      else
+      {
+        uint64_t const* src = inputs[out_index - 1];
+        for ( auto b = 0u; b < num_blocks; ++b )
+          res[b] = src[b] ^ out_mask;
+      }
+      return;
+    }
+
+    std::vector<uint64_t>& temps = scratch();
+    if ( temps.size() < ops_.size() * num_blocks )
+      temps.resize( ops_.size() * num_blocks );
+
+    for ( auto k = 0u; k < ops_.size(); ++k )
+    {
+      operation_t const& op = ops_[k];
+      /* the operation producing the output writes directly in the result */
+      bool const is_output = ( num_inputs_ + 1 + k ) == out_index;
+      uint64_t* dst = is_output ? res : temps.data() + k * num_blocks;
+
+      uint64_t const* lhs = operand( op.lhs, inputs, temps, num_blocks );
+      uint64_t const* rhs = operand( op.rhs, inputs, temps, num_blocks );
+      uint64_t const lhs_mask = ( op.lhs & 1u ) ? ~uint64_t( 0 ) : 0u;
+      uint64_t const rhs_mask = ( op.rhs & 1u ) ? ~uint64_t( 0 ) : 0u;
+      uint64_t const dst_mask = is_output ? out_mask : 0u;
+
+      if ( op.is_and )
+      {
+        for ( auto b = 0u; b < num_blocks; ++b )
+          dst[b] = ( ( ( lhs ? lhs[b] : 0u ) ^ lhs_mask ) & ( ( rhs ? rhs[b] : 0u ) ^ rhs_mask ) ) ^ dst_mask;
+      }
+      else
+      {
+        for ( auto b = 0u; b < num_blocks; ++b )
+          dst[b] = ( ( lhs ? lhs[b] : 0u ) ^ ( rhs ? rhs[b] : 0u ) ^ lhs_mask ^ rhs_mask ) ^ dst_mask;
+      }
+
+      if ( is_output )
+        return;
+    }
+  }
+
+private:
+  /*! \brief Blocks of an operand, or nullptr for the constant 0 */
+  uint64_t const* operand( literal_t lit, uint64_t const* const* inputs, std::vector<uint64_t> const& temps, uint64_t num_blocks ) const
+  {
+    uint32_t const index = lit >> 1;
+    if ( index == 0 )
+      return nullptr;
+    if ( index <= num_inputs_ )
+      return inputs[index - 1];
+    return temps.data() + ( index - num_inputs_ - 1 ) * num_blocks;
+  }
+
+  static std::vector<uint64_t>& scratch()
+  {
+    static thread_local std::vector<uint64_t> temps;
+    return temps;
+  }
+
+private:
+  uint32_t num_inputs_ = 0u;
+  literal_t output_ = 0u;
+  std::vector<operation_t> ops_;
+};
+
+} // namespace libraries
+
+} // namespace rinox
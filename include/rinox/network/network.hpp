@@ -41,7 +41,9 @@
 
 #include "../evaluation/evaluation.hpp"
 #include "../libraries/libraries.hpp"
+#include "network_events.hpp"
 #include "signal_map.hpp"
+#include "soa_storage_network.hpp"
 #include "storage_network.hpp"
 #include "storage_node.hpp"
 #include "storage_signal.hpp"
@@ -57,7 +59,12 @@
 #include <kitty/dynamic_truth_table.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace rinox
 {
@@ -68,8 +75,10 @@ namespace network
 /*! \brief Network of gates from a technology library.
  *
  * \tparam MaxNumOutputs Maximum number of outputs of the cells in the library.
+ * \tparam Layout Memory layout of the storage. The struct-of-arrays layout
+ * avoids per-node allocations and improves locality on large netlists.
  */
-template<design_type_t DesignType = design_type_t::CELL_BASED, uint32_t MaxNumOutputs = 2u>
+template<design_type_t DesignType = design_type_t::CELL_BASED, uint32_t MaxNumOutputs = 2u, storage_layout_t Layout = storage_layout_t::ARRAY_OF_STRUCTS>
 class bound_network
 {
 public:
@@ -77,12 +86,16 @@ public:
 
   static constexpr auto NumBitsOutputs = bits_required<MaxNumOutputs>();
   static constexpr design_type_t design_t = DesignType;
+  static constexpr storage_layout_t layout = Layout;
   static constexpr bool is_bound_network_type = true;
 
   /* aliases used in this class */
-  using storage_t = std::shared_ptr<storage_network<DesignType, NumBitsOutputs>>;
+  using storage_type = std::conditional_t<Layout == storage_layout_t::ARRAY_OF_STRUCTS,
+                                          storage_network<DesignType, NumBitsOutputs>,
+                                          soa_storage_network<DesignType, NumBitsOutputs>>;
+  using storage_t = std::shared_ptr<storage_type>;
   using list_t = evaluation::chains::large_xag_chain;
-  using node_t = storage_node<NumBitsOutputs>;
+  using node_t = typename storage_type::node_t;
   using signal_t = storage_signal<NumBitsOutputs>;
   using hash_t = signal_hash<NumBitsOutputs>;
   using node_index_t = uint64_t;
@@ -91,7 +104,8 @@ public:
   static constexpr auto min_fanin_size = 1;
   static constexpr auto max_fanin_size = 32;
   static constexpr auto max_num_outputs = 1u << NumBitsOutputs;
-  using base_type = bound_network<DesignType, MaxNumOutputs>;
+  static constexpr node_index_t null_node = std::numeric_limits<node_index_t>::max();
+  using base_type = bound_network<DesignType, MaxNumOutputs, Layout>;
   using storage = storage_t;
   using signal = signal_t;
   using node = node_index_t;
@@ -104,7 +118,7 @@ public:
       design_type_t D = DesignType,
       std::enable_if_t<D == design_type_t::CELL_BASED, int> = 0>
   bound_network( libraries::augmented_library<DesignType> library )
-      : _storage( std::make_shared<storage_network<DesignType, NumBitsOutputs>>( library ) ),
+      : _storage( std::make_shared<storage_type>( library ) ),
         _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
@@ -117,7 +131,7 @@ public:
       design_type_t D = DesignType,
       std::enable_if_t<D == design_type_t::CELL_BASED, int> = 0>
   bound_network( std::vector<mockturtle::gate> gates )
-      : _storage( std::make_shared<storage_network<DesignType, NumBitsOutputs>>( gates ) ),
+      : _storage( std::make_shared<storage_type>( gates ) ),
         _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
@@ -130,7 +144,7 @@ public:
       design_type_t D = DesignType,
       std::enable_if_t<D == design_type_t::ARRAY_BASED, int> = 0>
   bound_network()
-      : _storage( std::make_shared<storage_network<DesignType, NumBitsOutputs>>() ),
+      : _storage( std::make_shared<storage_type>() ),
         _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
@@ -143,7 +157,7 @@ public:
    *
    * \param storage The storage object containing the network data.
    */
-  bound_network( std::shared_ptr<storage_network<DesignType, NumBitsOutputs>> storage )
+  bound_network( std::shared_ptr<storage_type> storage )
       : _storage( storage ),
         _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
@@ -157,9 +171,9 @@ public:
    *
    * \return A new bound_network instance with cloned storage.
    */
-  bound_network<DesignType, MaxNumOutputs> clone() const
+  bound_network<DesignType, MaxNumOutputs, Layout> clone() const
   {
-    return { std::make_shared<storage_network<DesignType, NumBitsOutputs>>( *_storage ) };
+    return { std::make_shared<storage_type>( *_storage ) };
   }
 
 #pragma endregion
@@ -338,12 +352,10 @@ public:
   signal_t create_node( std::vector<signal_t> const& children,
                         std::vector<uint32_t> const& ids )
   {
-    node_t const& n = _storage->create_storage_node( children, ids );
-
-    /* structural hashing */
+    /* structural hashing, looking up the fanins and IDs before building the node */
     if constexpr ( DoStrash )
     {
-      const auto it = _storage->find( n );
+      const auto it = _storage->find( children, ids );
       if ( it )
       {
         if ( !is_dead( *it ) )
@@ -353,6 +365,7 @@ public:
       }
     }
 
+    node_t const& n = _storage->create_storage_node( children, ids );
     signal_t const f = _storage->create_node( children, n );
 
     /* initialize the application specific value to 0 */
@@ -427,6 +440,21 @@ public:
     return create_node<DoStrash>( children, std::vector<uint32_t>{ id } );
   }
 
+  /*! \brief Find the node that `create_node<true>` would return, without building it.
+   *
+   * \param children The children signals of the node.
+   * \param ids The binding IDs for the outputs of the node.
+   * \return The index of the live node with the given fanins and binding IDs, if any.
+   */
+  std::optional<node_index_t> find_node( std::vector<signal_t> const& children,
+                                         std::vector<uint32_t> const& ids ) const
+  {
+    auto const it = _storage->find( children, ids );
+    if ( it && !is_dead( *it ) )
+      return it;
+    return std::nullopt;
+  }
+
   /*! \brief Clone a node from another bound network.
    *
    * This method creates a new node in the current network by cloning an existing
@@ -546,7 +574,7 @@ public:
     if ( !_storage->in_fanin( root, old_node ) )
       return;
 
-    auto const old_children = _storage->get_children( root );
+    std::vector<signal_t> const old_children = _storage->get_children( root );
 
     _storage->update_nets( root, old_signal, new_signal );
 
@@ -597,7 +625,7 @@ public:
     if ( is_constant( n ) || is_ci( n ) || is_dead( n ) )
       return;
 
-    auto children = _storage->get_children( n );
+    std::vector<signal_t> children = _storage->get_children( n );
 
     /* NOTE: the node's information is not cleared-up yet, so we can
      * access the node's outputs or the node's fanins. Not its old fanouts.
@@ -623,6 +651,96 @@ public:
     }
   }
 
+  /*! \brief Remove the dead nodes stored after a given index.
+   *
+   * This method restores the size of the storage after a sequence of tentative
+   * insertions, all of which must have been taken out. It allows keeping the
+   * node indices aligned with the ones of a copy of the network. The truncate
+   * event notifies the new size, since the removed indices are reused.
+   *
+   * \param size The size of the network to be restored.
+   */
+  void truncate( node_index_t const& size )
+  {
+    if ( size >= this->size() )
+      return;
+
+    _storage->truncate( size );
+    for ( auto const& fn : _events->on_truncate )
+    {
+      ( *fn )( size );
+    }
+  }
+
+  /*! \brief Renumber the nodes in topological order and drop the dead ones.
+   *
+   * The storage is rebuilt with the constants first, followed by the primary
+   * inputs in their original order, and by the gates in the order in which a
+   * depth-first traversal from the primary outputs reaches them. The live gates
+   * not reachable from the outputs are appended at the end. The remap event
+   * notifies the new index of each old node.
+   *
+   * \return The new index of each old node, `null_node` for the dropped ones.
+   */
+  std::vector<node_index_t> compact()
+  {
+    std::vector<node_index_t> order;
+    order.reserve( size() );
+    foreach_pi( [&]( auto const& n ) {
+      order.push_back( n );
+    } );
+
+    std::vector<uint8_t> visited( size(), 0u );
+    std::vector<std::pair<node_index_t, bool>> stack;
+    auto const visit = [&]( node_index_t const& root ) {
+      if ( visited[root] )
+        return;
+      stack.emplace_back( root, false );
+      while ( !stack.empty() )
+      {
+        auto const [n, expanded] = stack.back();
+        if ( expanded )
+        {
+          stack.pop_back();
+          order.push_back( n );
+          continue;
+        }
+        if ( visited[n] )
+        {
+          stack.pop_back();
+          continue;
+        }
+        visited[n] = 1u;
+        stack.back().second = true;
+        /* push the fanins in reverse order to visit them in order */
+        auto const& children = _storage->get_children( n );
+        for ( auto it = children.rbegin(); it != children.rend(); ++it )
+        {
+          if ( !visited[it->index] )
+            stack.emplace_back( it->index, false );
+        }
+      }
+    };
+
+    visited[0] = visited[1] = 1u;
+    foreach_pi( [&]( auto const& n ) {
+      visited[n] = 1u;
+    } );
+    foreach_po( [&]( auto const& f ) {
+      visit( f.index );
+    } );
+    foreach_gate( [&]( auto const& n ) {
+      visit( n );
+    } );
+
+    auto const old_to_new = _storage->compact( order );
+    for ( auto const& fn : _events->on_remap )
+    {
+      ( *fn )( old_to_new );
+    }
+    return old_to_new;
+  }
+
 #pragma endregion
 
 #pragma region Structural properties
@@ -927,13 +1045,14 @@ public:
   /*! \brief Get the cached simulator for AIG index lists.
    *
    * Caching an unique simulator avoids reallocations of different simulation
-   * engines, ensuring memory efficiency.
+   * engines, ensuring memory efficiency. The cache is per-thread, so that
+   * networks simulated concurrently do not share the simulator's state.
    */
   template<typename TT>
   std::shared_ptr<evaluation::chain_simulator<list_t, TT>> get_simulator() const
   {
     using simulator_t = evaluation::chain_simulator<list_t, TT>;
-    static const std::shared_ptr<simulator_t> sim = std::make_shared<simulator_t>();
+    static thread_local const std::shared_ptr<simulator_t> sim = std::make_shared<simulator_t>();
     return sim;
   }
 
@@ -944,7 +1063,7 @@ public:
    * \return A vector of truth-tables, one for each output pin of the node.
    */
   template<typename TT>
-  std::vector<TT> compute( node_index_t const& n, std::vector<TT const*> sim_ptrs ) const
+  std::vector<TT> compute( node_index_t const& n, std::vector<TT const*> const& sim_ptrs ) const
   {
     std::vector<TT> res;
     compute( res, n, sim_ptrs );
@@ -952,7 +1071,7 @@ public:
   }
 
   template<typename TT>
-  TT compute( signal_t const& f, std::vector<TT const*> sim_ptrs ) const
+  TT compute( signal_t const& f, std::vector<TT const*> const& sim_ptrs ) const
   {
     TT res;
     compute( res, f, sim_ptrs );
@@ -965,19 +1084,12 @@ public:
    * \param sim_ptrs vector of pointers to the simulation of the fanins.
    */
   template<typename TT>
-  void compute( std::vector<TT>& res, node_index_t const& n, std::vector<TT const*> sim_ptrs ) const
+  void compute( std::vector<TT>& res, node_index_t const& n, std::vector<TT const*> const& sim_ptrs ) const
   {
-    auto simulator_ptr = get_simulator<TT>();
+    assert( sim_ptrs.size() == fanin_size( n ) );
     res.resize( num_outputs( n ) );
-    const auto nfanin = fanin_size( n );
-    assert( nfanin > 0 );
-    assert( sim_ptrs.size() == nfanin );
-
     _storage->foreach_output_pin( n, [&]( auto const& pin, auto i ) {
-      auto id = pin.id;
-      auto const& list = _storage->get_chain( id );
-      ( *simulator_ptr )( list, sim_ptrs );
-      simulator_ptr->get_simulation_inline( res[i], list, sim_ptrs, list.po_at( 0 ) );
+      _storage->get_kernel( pin.id )( res[i], sim_ptrs.data() );
     } );
   }
 
@@ -987,16 +1099,42 @@ public:
    * \param sim_ptrs vector of pointers to the simulation of the fanins.
    */
   template<typename TT>
-  void compute( TT& res, signal_t const& f, std::vector<TT const*> sim_ptrs ) const
+  void compute( TT& res, signal_t const& f, std::vector<TT const*> const& sim_ptrs ) const
+  {
+    assert( sim_ptrs.size() == fanin_size( get_node( f ) ) );
+    compute( res, f, sim_ptrs.data() );
+  }
+
+  /*! \brief Allocation-free simulation of an output pin.
+   *
+   * The simulations of the fanins are read from an array with one pointer per
+   * fanin, so that callers can keep it on the stack.
+   *
+   * \param res Truth table where to store the result.
+   * \param f Output pin to simulate.
+   * \param sim_ptrs Pointers to the simulation of the fanins.
+   */
+  template<typename TT>
+  void compute( TT& res, signal_t const& f, TT const* const* sim_ptrs ) const
   {
-    auto simulator_ptr = get_simulator<TT>();
-    const auto nfanin = fanin_size( get_node( f ) );
-    assert( nfanin > 0 );
-    assert( sim_ptrs.size() == nfanin );
+    assert( fanin_size( get_node( f ) ) > 0 );
     auto const& g = get_binding( f );
-    auto const& list = _storage->get_chain( g.id );
-    ( *simulator_ptr )( list, sim_ptrs );
-    simulator_ptr->get_simulation_inline( res, list, sim_ptrs, list.po_at( 0 ) );
+    _storage->get_kernel( g.id )( res, sim_ptrs );
+  }
+
+  /*! \brief Simulation of an output pin on contiguous blocks of 64 bits.
+   *
+   * The unused bits of the last block are not masked.
+   *
+   * \param res Blocks where to store the result.
+   * \param f Output pin to simulate.
+   * \param blocks Pointers to the blocks of the fanins.
+   * \param num_blocks Number of blocks of each simulation.
+   */
+  void compute( uint64_t* res, signal_t const& f, uint64_t const* const* blocks, uint64_t num_blocks ) const
+  {
+    auto const& g = get_binding( f );
+    _storage->get_kernel( g.id )( res, blocks, num_blocks );
   }
 #pragma endregion
 
@@ -1040,7 +1178,7 @@ public:
 
   void set_visited( node_index_t const& n, uint32_t v ) const
   {
-    _storage->nodes[n].traversal_id = v;
+    _storage->set_visited( n, v );
   }
 
   uint32_t trav_id() const
@@ -1110,17 +1248,17 @@ public:
 #pragma endregion
 
 #pragma region Getters
-  std::vector<signal_t> const& get_children( node_index_t const& n ) const
+  decltype( auto ) get_children( node_index_t const& n ) const
   {
     return _storage->get_children( n );
   }
 
-  std::vector<signal_t> const& get_children( signal_t const& f ) const
+  decltype( auto ) get_children( signal_t const& f ) const
   {
     return get_children( get_node( f ) );
   }
 
-  std::vector<node_index_t> const& get_fanins( node_index_t const& n ) const
+  decltype( auto ) get_fanins( node_index_t const& n ) const
   {
     return _storage->get_fanins( n );
   }
@@ -1150,6 +1288,11 @@ public:
     return _storage->get_library();
   }
 
+  auto const& get_augmented_library() const
+  {
+    return _storage->get_augmented_library();
+  }
+
   std::vector<kitty::dynamic_truth_table> const get_functions( node_index_t const& n ) const
   {
     return _storage->get_functions( n );
@@ -1226,8 +1369,8 @@ public:
 #pragma endregion
 
 public:
-  std::shared_ptr<storage_network<DesignType, NumBitsOutputs>> _storage;
-  std::shared_ptr<mockturtle::network_events<base_type>> _events;
+  std::shared_ptr<storage_type> _storage;
+  std::shared_ptr<network_events<base_type>> _events;
 };
 
 } // namespace network
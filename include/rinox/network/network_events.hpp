@@ -0,0 +1,110 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file network_events.hpp
+  \brief Events of the bound network
+
+  \author Andrea Costamagna
+*/
+
+#pragma once
+
+#include <mockturtle/networks/events.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace rinox
+{
+
+namespace network
+{
+
+/*! \brief Network events extended with the renumbering of the nodes.
+ *
+ * In addition to the addition, modification and deletion events, the bound
+ * network notifies when its nodes are renumbered. The remap event receives
+ * the new index of each old node, where the nodes that have been dropped are
+ * mapped to `std::numeric_limits<node>::max()`. The truncate event receives
+ * the new size of the network after its trailing dead nodes are removed, so
+ * that the indices reused by the next insertions can be invalidated.
+ */
+template<class Ntk>
+class network_events : public mockturtle::network_events<Ntk>
+{
+public:
+  using remap_event_type = std::function<void( std::vector<typename Ntk::node> const& old_to_new )>;
+  using truncate_event_type = std::function<void( typename Ntk::node const& size )>;
+
+public:
+  std::shared_ptr<remap_event_type> register_remap_event( remap_event_type const& fn )
+  {
+    auto pfn = std::make_shared<remap_event_type>( fn );
+    on_remap.emplace_back( pfn );
+    return pfn;
+  }
+
+  void release_remap_event( std::shared_ptr<remap_event_type>& fn )
+  {
+    /* first decrement the reference counter of the event */
+    auto fn_ptr = fn.get();
+    fn = nullptr;
+
+    /* erase the event if the only instance remains in the vector */
+    on_remap.erase( std::remove_if( std::begin( on_remap ), std::end( on_remap ),
+                                    [&]( auto&& event ) { return event.get() == fn_ptr && event.use_count() <= 1u; } ),
+                    std::end( on_remap ) );
+  }
+
+  std::shared_ptr<truncate_event_type> register_truncate_event( truncate_event_type const& fn )
+  {
+    auto pfn = std::make_shared<truncate_event_type>( fn );
+    on_truncate.emplace_back( pfn );
+    return pfn;
+  }
+
+  void release_truncate_event( std::shared_ptr<truncate_event_type>& fn )
+  {
+    /* first decrement the reference counter of the event */
+    auto fn_ptr = fn.get();
+    fn = nullptr;
+
+    /* erase the event if the only instance remains in the vector */
+    on_truncate.erase( std::remove_if( std::begin( on_truncate ), std::end( on_truncate ),
+                                       [&]( auto&& event ) { return event.get() == fn_ptr && event.use_count() <= 1u; } ),
+                       std::end( on_truncate ) );
+  }
+
+public:
+  std::vector<std::shared_ptr<remap_event_type>> on_remap;
+  std::vector<std::shared_ptr<truncate_event_type>> on_truncate;
+};
+
+} // namespace network
+
+} // namespace rinox
@@ -0,0 +1,1471 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file soa_storage_network.hpp
+  \brief Struct-of-arrays storage for the bound network
+
+  This file defines an alternative storage for the bound network, exposing the
+  same interface of `storage_network`. Instead of storing one object per node,
+  each owning the vectors of its children and of its output pins, the data is
+  stored in flat arrays:
+  - the fanins of all the nodes are stored contiguously ( CSR-like layout );
+  - the output pins of all the nodes are stored contiguously;
+  - the fanouts of all the pins are stored in a shared pool, in which each pin
+    owns a slice with some slack to support in-place insertions;
+  - traversal identifiers, user data, and fanout counts are parallel arrays.
+
+  Creating a node does not perform any heap allocation other than the
+  amortized growth of the arrays.
+
+  \ingroup network_storage
+  \see rinox::network::storage_network
+
+  \author Andrea Costamagna
+*/
+
+#pragma once
+
+#include "../evaluation/chains.hpp"
+#include "../libraries/augmented_library.hpp"
+#include "storage_signal.hpp"
+#include "strash_table.hpp"
+#include "utils.hpp"
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/detail/foreach.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace rinox
+{
+
+namespace network
+{
+
+/*! \brief Struct-of-arrays storage for nodes in the bound network.
+ *
+ * \tparam NumBitsOutputs Number of bits used to represent the output pin specifier.
+ */
+template<design_type_t DesignType, uint32_t NumBitsOutputs>
+class soa_storage_network
+{
+#pragma region Types and constructors
+
+public:
+  using augmented_library_t = libraries::augmented_library<DesignType>;
+  using gate = typename augmented_library_t::gate;
+  using gate_t = typename augmented_library_t::gate_t;
+  using list_t = evaluation::chains::large_xag_chain;
+  using signal_t = storage_signal<NumBitsOutputs>;
+  using offset_t = uint32_t;
+  using strash_table_t = strash_table<node_index_t>;
+
+  /*! \brief Non-owning description of a node to be created.
+   *
+   * The node refers to the vectors used for its creation, which must outlive it.
+   */
+  struct node_t
+  {
+    std::vector<signal_t> const* children;
+    std::vector<uint32_t> const* ids;
+  };
+
+  /*! \brief Read-only view of an output pin. */
+  struct pin_t
+  {
+    /*! \brief Identifier of the pin's function in the library */
+    uint32_t id;
+    /*! \brief Logical type of the pin */
+    pin_type_t type;
+    /*! \brief Position of the pin in the pin arrays */
+    offset_t index;
+  };
+
+  /*! \brief Read-only view of the children of a node.
+   *
+   * The view is invalidated when a node is created or the fanins are updated.
+   * Callers modifying the network while reading the children take a copy.
+   */
+  class children_view
+  {
+  public:
+    using value_type = signal_t;
+    using const_iterator = signal_t const*;
+    using const_reverse_iterator = std::reverse_iterator<signal_t const*>;
+
+    children_view( signal_t const* begin, signal_t const* end )
+        : begin_( begin ), end_( end )
+    {}
+
+    signal_t const* begin() const
+    {
+      return begin_;
+    }
+
+    signal_t const* end() const
+    {
+      return end_;
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+      return const_reverse_iterator( end_ );
+    }
+
+    const_reverse_iterator rend() const
+    {
+      return const_reverse_iterator( begin_ );
+    }
+
+    size_t size() const
+    {
+      return static_cast<size_t>( end_ - begin_ );
+    }
+
+    bool empty() const
+    {
+      return begin_ == end_;
+    }
+
+    signal_t const& operator[]( size_t i ) const
+    {
+      assert( i < size() );
+      return begin_[i];
+    }
+
+    operator std::vector<signal_t>() const
+    {
+      return std::vector<signal_t>( begin_, end_ );
+    }
+
+    friend bool operator==( children_view const& view, std::vector<signal_t> const& children )
+    {
+      return std::equal( view.begin(), view.end(), children.begin(), children.end() );
+    }
+
+    friend bool operator!=( children_view const& view, std::vector<signal_t> const& children )
+    {
+      return !( view == children );
+    }
+
+  private:
+    signal_t const* begin_;
+    signal_t const* end_;
+  };
+
+  /*! \brief Read-only view of the indices of the fanin nodes of a node.
+   *
+   * The indices are read from the children, hence the view has the same
+   * lifetime as `children_view`.
+   */
+  class fanins_view
+  {
+  public:
+    class iterator
+    {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = node_index_t;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = node_index_t;
+
+      explicit iterator( signal_t const* it )
+          : it_( it )
+      {}
+
+      node_index_t operator*() const
+      {
+        return it_->index;
+      }
+
+      iterator& operator++()
+      {
+        ++it_;
+        return *this;
+      }
+
+      iterator operator++( int )
+      {
+        iterator const tmp = *this;
+        ++it_;
+        return tmp;
+      }
+
+      bool operator==( iterator const& other ) const
+      {
+        return it_ == other.it_;
+      }
+
+      bool operator!=( iterator const& other ) const
+      {
+        return it_ != other.it_;
+      }
+
+    private:
+      signal_t const* it_;
+    };
+
+    fanins_view( signal_t const* begin, signal_t const* end )
+        : begin_( begin ), end_( end )
+    {}
+
+    iterator begin() const
+    {
+      return iterator( begin_ );
+    }
+
+    iterator end() const
+    {
+      return iterator( end_ );
+    }
+
+    size_t size() const
+    {
+      return static_cast<size_t>( end_ - begin_ );
+    }
+
+    bool empty() const
+    {
+      return begin_ == end_;
+    }
+
+    node_index_t operator[]( size_t i ) const
+    {
+      assert( i < size() );
+      return begin_[i].index;
+    }
+
+    operator std::vector<node_index_t>() const
+    {
+      return std::vector<node_index_t>( begin(), end() );
+    }
+
+  private:
+    signal_t const* begin_;
+    signal_t const* end_;
+  };
+
+  static constexpr node_index_t null_node = std::numeric_limits<node_index_t>::max();
+
+  template<
+      network::design_type_t D = DesignType,
+      std::enable_if_t<D == network::design_type_t::CELL_BASED, int> = 0>
+  soa_storage_network( augmented_library_t library )
+      : library( library )
+  {
+    init();
+  }
+
+  template<
+      network::design_type_t D = DesignType,
+      std::enable_if_t<D == network::design_type_t::CELL_BASED, int> = 0>
+  soa_storage_network( std::vector<gate> gates )
+      : library( gates )
+  {
+    init();
+  }
+
+  soa_storage_network()
+  {
+    init();
+  }
+
+private:
+  void init()
+  {
+    reserve( 10000u ); // reserve to avoid frequent reallocations
+
+    /* we reserve the first two nodes for constants */
+    add_node( 1u, pin_type_t::CONSTANT ); // 0
+    add_node( 1u, pin_type_t::CONSTANT ); // 1
+  }
+
+public:
+  /*! \brief Reserve memory for a number of nodes. */
+  void reserve( size_t num_nodes )
+  {
+    fanin_offset.reserve( num_nodes + 1 );
+    fanin_count.reserve( num_nodes );
+    pin_offset.reserve( num_nodes + 1 );
+    traversal_ids.reserve( num_nodes );
+    user_data.reserve( num_nodes );
+    fanout_counts.reserve( num_nodes );
+    hash.reserve( num_nodes );
+    fanins.reserve( 2 * num_nodes );
+    pin_ids.reserve( num_nodes );
+    pin_types.reserve( num_nodes );
+    pin_fanout_counts.reserve( num_nodes );
+    pin_fanout_offset.reserve( num_nodes );
+    pin_fanout_size.reserve( num_nodes );
+    pin_fanout_capacity.reserve( num_nodes );
+    fanout_pool.reserve( 2 * num_nodes );
+  }
+
+#pragma endregion
+
+#pragma region Primary I / O and constants
+
+  signal_t get_constant( bool value ) const
+  {
+    return value ? signal_t{ 1, 0 } : signal_t{ 0, 0 };
+  }
+
+  /*! \brief Creates a primary input signal.
+   *
+   * A PI stores its index in the only fanin it has.
+   */
+  signal_t create_pi()
+  {
+    auto const index = add_node( 1u, pin_type_t::PI );
+    fanins.emplace_back( static_cast<uint64_t>( inputs.size() ) );
+    fanin_count[index] = 1u;
+    fanin_offset.back() = static_cast<offset_t>( fanins.size() );
+    inputs.emplace_back( index );
+    return signal_t{ index, 0 };
+  }
+
+  uint32_t create_po( signal_t const& f )
+  {
+    /* increase ref-count to children */
+    fanout_counts[f.index]++;
+    pin_types[pin( f )] |= pin_type_t::PO;
+    auto const po_index = static_cast<uint32_t>( outputs.size() );
+    outputs.emplace_back( f.index, f.output );
+    return po_index;
+  }
+
+  bool is_constant( node_index_t const& n ) const
+  {
+    return has_intersection( pin_types[pin_offset[n]], pin_type_t::CONSTANT );
+  }
+
+  bool is_ci( node_index_t const& n ) const
+  {
+    auto const type = pin_types[pin_offset[n]];
+    return has_intersection( type, pin_type_t::PI ) ||
+           has_intersection( type, pin_type_t::CI );
+  }
+
+  bool is_pi( node_index_t const& n ) const
+  {
+    return is_ci( n );
+  }
+
+  bool is_po( node_index_t const& n, uint32_t output = 0 ) const
+  {
+    return has_intersection( pin_types[pin_offset[n] + output], pin_type_t::PO );
+  }
+
+  bool is_po( signal_t f ) const
+  {
+    return is_po( f.index, f.output );
+  }
+
+  bool constant_value( node_index_t const& n ) const
+  {
+    return n != 0;
+  }
+
+#pragma endregion
+
+#pragma region Create special functions
+  template<bool DoStrash>
+  signal_t create_not( signal_t const& a )
+  {
+    static uint64_t _not = 0x1;
+    kitty::dynamic_truth_table tt_not( 1 );
+    kitty::create_from_words( tt_not, &_not, &_not + 1 );
+    return create_node<DoStrash>( std::vector<signal_t>{ a }, tt_not );
+  }
+
+  template<bool DoStrash>
+  signal_t create_and( signal_t const& a, signal_t const& b )
+  {
+    static uint64_t _and = 0x8;
+    kitty::dynamic_truth_table tt_and( 2 );
+    kitty::create_from_words( tt_and, &_and, &_and + 1 );
+    return create_node<DoStrash>( std::vector<signal_t>{ a, b }, tt_and );
+  }
+
+  template<bool DoStrash>
+  signal_t create_nand( signal_t const& a, signal_t const& b )
+  {
+    static uint64_t _nand = 0xE;
+    kitty::dynamic_truth_table tt_nand( 2 );
+    kitty::create_from_words( tt_nand, &_nand, &_nand + 1 );
+    return create_node<DoStrash>( std::vector<signal_t>{ a, b }, tt_nand );
+  }
+
+  template<bool DoStrash>
+  signal_t create_or( signal_t const& a, signal_t const& b )
+  {
+    static uint64_t _or = 0xe;
+    kitty::dynamic_truth_table tt_or( 2 );
+    kitty::create_from_words( tt_or, &_or, &_or + 1 );
+    return create_node<DoStrash>( std::vector<signal_t>{ a, b }, tt_or );
+  }
+
+  template<bool DoStrash>
+  signal_t create_xor( signal_t const& a, signal_t const& b )
+  {
+    static uint64_t _xor = 0x6;
+    kitty::dynamic_truth_table tt_xor( 2 );
+    kitty::create_from_words( tt_xor, &_xor, &_xor + 1 );
+    return create_node<DoStrash>( std::vector<signal_t>{ a, b }, tt_xor );
+  }
+
+  template<bool DoStrash>
+  signal_t create_maj( signal_t const& a, signal_t const& b, signal_t const& c )
+  {
+    static uint64_t _maj = 0xe8;
+    kitty::dynamic_truth_table tt_maj( 3 );
+    kitty::create_from_words( tt_maj, &_maj, &_maj + 1 );
+    return create_node<DoStrash>( std::vector<signal_t>{ a, b, c }, tt_maj );
+  }
+
+  template<bool DoStrash>
+  signal_t create_ite( signal_t const& a, signal_t const& b, signal_t const& c )
+  {
+    static uint64_t _ite = 0xd8;
+    kitty::dynamic_truth_table tt_ite( 3 );
+    kitty::create_from_words( tt_ite, &_ite, &_ite + 1 );
+    return create_node<DoStrash>( std::vector<signal_t>{ a, b, c }, tt_ite );
+  }
+
+  template<bool DoStrash>
+  signal_t create_xor3( signal_t const& a, signal_t const& b, signal_t const& c )
+  {
+    static uint64_t _xor3 = 0x96;
+    kitty::dynamic_truth_table tt_xor3( 3 );
+    kitty::create_from_words( tt_xor3, &_xor3, &_xor3 + 1 );
+    return create_node<DoStrash>( std::vector<signal_t>{ a, b, c }, tt_xor3 );
+  }
+
+  template<bool DoStrash = false>
+  signal_t create_node( std::vector<signal_t> const& children, kitty::dynamic_truth_table const& tt )
+  {
+    auto id = library.get_id( tt );
+    if ( !id )
+    {
+      std::cerr << "[e] No binding found in the library.\n";
+    }
+    std::vector<uint32_t> const ids{ *id };
+    node_t n = create_storage_node( children, ids );
+    return create_node( children, n );
+  }
+#pragma endregion
+
+#pragma region Create arbitrary functions
+
+  /*! \brief Create a description of the node to be stored.
+   *
+   * \param children input signals.
+   * \param ids binding identifier of the output pins.
+   */
+  node_t create_storage_node( std::vector<signal_t> const& children, std::vector<uint32_t> const& ids ) const
+  {
+    if constexpr ( DesignType == design_type_t::CELL_BASED )
+    {
+      for ( auto i = 1u; i < ids.size(); ++i )
+      {
+        assert( library.get_name( ids[i] ) == library.get_name( ids[0] ) &&
+                "Multiple-output nodes are expected to have the same name" );
+      }
+    }
+    return node_t{ &children, &ids };
+  }
+
+  /*! \brief Create a new node with multiple outputs.
+   *
+   * \param children The child signals that this node will depend on.
+   * \param n The description of the node.
+   * \return A signal representing the newly created node.
+   */
+  signal_t create_node( std::vector<signal_t> const& children, node_t const& n )
+  {
+    auto const& ids = *n.ids;
+    auto const index = add_node( static_cast<uint32_t>( ids.size() ), pin_type_t::INTERNAL );
+    for ( auto i = 0u; i < ids.size(); ++i )
+      pin_ids[pin_offset[index] + i] = ids[i];
+
+    fanins.insert( fanins.end(), children.begin(), children.end() );
+    fanin_count[index] = static_cast<uint32_t>( children.size() );
+    fanin_offset.back() = static_cast<offset_t>( fanins.size() );
+
+    /* increase ref-count to children */
+    for ( auto const& c : children )
+    {
+      fanout_counts[c.index]++;
+      pin_fanout_counts[pin( c )]++;
+      push_fanout( pin( c ), index );
+    }
+
+    hash_insert( index );
+    return { index, 0 };
+  }
+
+  template<
+      network::design_type_t D = DesignType,
+      std::enable_if_t<D == network::design_type_t::ARRAY_BASED, int> = 0>
+  uint32_t insert( kitty::dynamic_truth_table const& function )
+  {
+    return library.add_gate( function );
+  }
+
+  template<
+      network::design_type_t D = DesignType,
+      std::enable_if_t<D == network::design_type_t::ARRAY_BASED, int> = 0>
+  std::vector<uint32_t> insert( std::vector<kitty::dynamic_truth_table> const& functions )
+  {
+    return library.add_gates( functions );
+  }
+
+#pragma endregion
+
+#pragma region Restructuring
+
+  void replace_in_outputs( node_index_t const& old_node,
+                           std::vector<signal_t> const& new_signals )
+  {
+    for ( auto i = 0u; i < num_outputs( old_node ); ++i )
+    {
+      signal_t const old_signal = signal_t{ old_node, i };
+      if ( is_po( old_signal ) )
+      {
+        /* replace the output signals with the new signal */
+        replace_output( old_signal, new_signals[i] );
+      }
+    }
+  }
+
+  void replace_output( signal_t const& old_signal,
+                       signal_t const& new_signal )
+  {
+    bool found = false;
+    for ( auto& output : outputs )
+    {
+      if ( output == old_signal )
+      {
+        found = true;
+        output = new_signal;
+        fanout_counts[new_signal.index]++;
+        fanout_counts[old_signal.index]--;
+        pin_types[pin( old_signal )] &= ~pin_type_t::PO;
+        pin_types[pin( new_signal )] |= pin_type_t::PO;
+      }
+    }
+    assert( found && "Output signal not found in the outputs list" );
+  }
+
+  void insert_fanout( signal_t const& f, node_index_t const& n )
+  {
+    auto const p = pin( f );
+    auto const begin = fanout_pool.begin() + pin_fanout_offset[p];
+    if ( std::find( begin, begin + pin_fanout_size[p], n ) != begin + pin_fanout_size[p] )
+    {
+      /* if the fanout already exists, we do not need to insert it again */
+      return;
+    }
+    fanout_counts[f.index]++;
+    pin_fanout_counts[p]++;
+    push_fanout( p, n );
+  }
+
+  void delete_fanout( signal_t const& f, node_index_t const& n )
+  {
+    auto const p = pin( f );
+    auto const begin = fanout_pool.begin() + pin_fanout_offset[p];
+    auto const end = begin + pin_fanout_size[p];
+    auto const it = std::remove( begin, end, n );
+    auto const occurrences = static_cast<uint32_t>( end - it );
+    fanout_counts[f.index] -= occurrences;
+    pin_fanout_counts[p] -= occurrences;
+    pin_fanout_size[p] -= occurrences;
+  }
+
+  /*! \brief Update the interconnections of a node.
+   *
+   * The node is re-hashed, so that the structural hashing table is consistent
+   * with the new children.
+   */
+  void update_nets( node_index_t const& root,
+                    signal_t const& old_signal,
+                    signal_t new_signal )
+  {
+    bool const hashed = hash_erase( root );
+    for ( auto i = fanin_offset[root]; i < fanin_offset[root] + fanin_count[root]; ++i )
+    {
+      if ( fanins[i] == old_signal )
+      {
+        insert_fanout( new_signal, root );
+        delete_fanout( fanins[i], root );
+        fanins[i] = new_signal;
+      }
+    }
+    if ( hashed )
+      hash_insert( root );
+  }
+
+  void delete_node( node_index_t const& n )
+  {
+    /* remove the node from the hash table if present */
+    hash_erase( n );
+
+    /* mark the node as dead */
+    for ( auto p = pin_offset[n]; p < pin_offset[n + 1]; ++p )
+    {
+      pin_types[p] |= pin_type_t::DEAD;
+      pin_fanout_size[p] = 0;
+      pin_fanout_counts[p] = 0;
+    }
+    fanout_counts[n] = 0;
+    fanin_count[n] = 0;
+  }
+
+  /*! \brief Remove the dead nodes stored after a given index.
+   *
+   * \param size The number of nodes to be kept in the storage.
+   */
+  void truncate( node_index_t const& size )
+  {
+    if ( size >= this->size() )
+      return;
+    for ( auto n = size; n < this->size(); ++n )
+    {
+      assert( is_dead( n ) && "Only dead nodes can be truncated" );
+    }
+    auto const first_pin = pin_offset[size];
+    for ( auto p = first_pin; p < pin_ids.size(); ++p )
+      fanout_garbage += pin_fanout_capacity[p];
+
+    fanins.resize( fanin_offset[size] );
+    pin_ids.resize( first_pin );
+    pin_types.resize( first_pin );
+    pin_fanout_counts.resize( first_pin );
+    pin_fanout_offset.resize( first_pin );
+    pin_fanout_size.resize( first_pin );
+    pin_fanout_capacity.resize( first_pin );
+
+    fanin_offset.resize( size + 1 );
+    pin_offset.resize( size + 1 );
+    fanin_count.resize( size );
+    traversal_ids.resize( size );
+    user_data.resize( size );
+    fanout_counts.resize( size );
+  }
+
+  /*! \brief Rebuild the storage keeping only the given nodes.
+   *
+   * The nodes are inserted again in the given order, which lists the primary
+   * inputs in their original order and each gate after its fanins. The nodes
+   * not in the order are dropped, while the outputs, the names and the library
+   * are preserved.
+   *
+   * \param order The primary inputs and the gates to be kept, in the new order.
+   * \return The new index of each old node, the maximum index for the dropped ones.
+   */
+  std::vector<node_index_t> compact( std::vector<node_index_t> const& order )
+  {
+    soa_storage_network old( std::move( *this ) );
+    fanin_offset.clear();
+    fanin_count.clear();
+    pin_offset.clear();
+    traversal_ids.clear();
+    user_data.clear();
+    fanout_counts.clear();
+    pin_ids.clear();
+    pin_fanout_counts.clear();
+    pin_fanout_offset.clear();
+    pin_fanout_size.clear();
+    pin_fanout_capacity.clear();
+    fanout_pool.clear();
+    fanins.clear();
+    pin_types.clear();
+    fanout_garbage = 0u;
+    inputs.clear();
+    outputs.clear();
+    names_map.clear();
+    hash.clear();
+    library = std::move( old.library );
+    module_name = std::move( old.module_name );
+    output_names = std::move( old.output_names );
+    trav_id = old.trav_id;
+    init();
+
+    std::vector<node_index_t> old_to_new( old.size(), std::numeric_limits<node_index_t>::max() );
+    old_to_new[0] = 0;
+    old_to_new[1] = 1;
+    std::vector<signal_t> children;
+    for ( auto const& n : order )
+    {
+      if ( old.is_ci( n ) )
+      {
+        old_to_new[n] = create_pi().index;
+        continue;
+      }
+      children.clear();
+      for ( auto const& f : old.get_children( n ) )
+      {
+        assert( old_to_new[f.index] != std::numeric_limits<node_index_t>::max() && "Fanins must precede their fanouts" );
+        children.emplace_back( old_to_new[f.index], f.output );
+      }
+      auto const ids = old.get_binding_ids( n );
+      old_to_new[n] = create_node( children, create_storage_node( children, ids ) ).index;
+    }
+
+    for ( auto const& f : old.outputs )
+    {
+      create_po( signal_t{ old_to_new[f.index], f.output } );
+    }
+    for ( auto const& [data, name] : old.names_map )
+    {
+      signal_t const f( data );
+      if ( old_to_new[f.index] != std::numeric_limits<node_index_t>::max() )
+        names_map[signal_t{ old_to_new[f.index], f.output }.data] = name;
+    }
+    return old_to_new;
+  }
+
+#pragma endregion
+
+#pragma region Structural properties
+
+  bool is_combinational() const
+  {
+    return true;
+  }
+
+  bool is_multioutput( node_index_t const& n ) const
+  {
+    return num_outputs( n ) > 1;
+  }
+
+  template<bool DoStrash = false,
+           network::design_type_t D = DesignType,
+           std::enable_if_t<D == network::design_type_t::CELL_BASED, int> = 0>
+  bool is_multioutput( std::string const& name ) const
+  {
+    return library.is_multioutput( name );
+  }
+
+  bool is_dead( node_index_t const& n ) const
+  {
+    bool all_dead{ true };
+    bool one_dead{ false };
+    for ( auto p = pin_offset[n]; p < pin_offset[n + 1]; ++p )
+    {
+      bool const dead = has_intersection( pin_types[p], pin_type_t::DEAD );
+      all_dead &= dead;
+      one_dead |= dead;
+    }
+    assert( !( all_dead ^ one_dead ) );
+    return all_dead;
+  }
+
+  inline bool is_constant( signal_t const& f ) const
+  {
+    return num_outputs( f.index ) > 0 && has_intersection( pin_types[pin( f )], pin_type_t::CONSTANT );
+  }
+
+  auto size() const
+  {
+    return static_cast<uint32_t>( fanin_count.size() );
+  }
+
+  auto num_cis() const
+  {
+    return static_cast<uint32_t>( inputs.size() );
+  }
+
+  auto num_cos() const
+  {
+    return static_cast<uint32_t>( outputs.size() );
+  }
+
+  auto num_pis() const
+  {
+    return static_cast<uint32_t>( inputs.size() );
+  }
+
+  auto num_pos() const
+  {
+    return static_cast<uint32_t>( outputs.size() );
+  }
+
+  auto num_gates() const
+  {
+    return static_cast<uint32_t>( size() - inputs.size() - 2 );
+  }
+
+  uint32_t num_outputs( node_index_t const& n ) const
+  {
+    return static_cast<uint32_t>( pin_offset[n + 1] - pin_offset[n] );
+  }
+
+  uint32_t fanin_size( node_index_t const& n ) const
+  {
+    return fanin_count[n];
+  }
+
+  uint32_t fanout_size( node_index_t const& n ) const
+  {
+    return fanout_counts[n];
+  }
+
+  uint32_t incr_fanout_size( node_index_t const& n )
+  {
+    return fanout_counts[n]++;
+  }
+
+  uint32_t decr_fanout_size( node_index_t const& n )
+  {
+    return --fanout_counts[n];
+  }
+
+  uint32_t incr_fanout_size_pin( node_index_t const& n, uint32_t pin_index )
+  {
+    return ++pin_fanout_counts[pin_offset[n] + pin_index];
+  }
+
+  uint32_t decr_fanout_size_pin( node_index_t const& n, uint32_t pin_index )
+  {
+    return --pin_fanout_counts[pin_offset[n] + pin_index];
+  }
+
+  uint32_t fanout_size_pin( node_index_t const& n, uint32_t pin_index ) const
+  {
+    return pin_fanout_counts[pin_offset[n] + pin_index];
+  }
+
+  bool is_function( node_index_t const& n ) const
+  {
+    auto const type = pin_types[pin_offset[n]];
+    return ( num_outputs( n ) > 0 ) && ( has_intersection( type, network::pin_type_t::INTERNAL ) ||
+                                         has_intersection( type, network::pin_type_t::PO ) );
+  }
+
+  /*! \brief Checks if a given node is already present in the storage. */
+  std::optional<node_index_t> find( node_t const& n ) const
+  {
+    return find( *n.children, *n.ids );
+  }
+
+  /*! \brief Checks if a node with the given fanins and binding IDs is in the storage. */
+  std::optional<node_index_t> find( std::vector<signal_t> const& children, std::vector<uint32_t> const& ids ) const
+  {
+    auto const res = hash.find( strash_table_t::fingerprint( children, ids ), [&]( auto const& m ) {
+      return equal( m, children, ids );
+    } );
+    assert( ( !res || !is_dead( *res ) ) && "The node should not be dead when looking for it" );
+    return res;
+  }
+
+  bool in_fanin( node_index_t parent, node_index_t other ) const
+  {
+    for ( auto i = fanin_offset[parent]; i < fanin_offset[parent] + fanin_count[parent]; ++i )
+    {
+      if ( fanins[i].index == other )
+        return true;
+    }
+    return false;
+  }
+
+#pragma endregion
+
+#pragma region Functional properties
+  kitty::dynamic_truth_table signal_function( const signal_t& f ) const
+  {
+    return library[pin_ids[pin( f )]].function;
+  }
+#pragma endregion
+
+#pragma region Nodes and signals
+
+  node_index_t ci_at( uint32_t index ) const
+  {
+    assert( index < inputs.size() );
+    return inputs[index];
+  }
+
+  signal_t co_at( uint32_t index ) const
+  {
+    assert( index < outputs.size() );
+    return outputs[index];
+  }
+
+  node_index_t pi_at( uint32_t index ) const
+  {
+    assert( index < inputs.size() );
+    return inputs[index];
+  }
+
+  signal_t po_at( uint32_t index ) const
+  {
+    assert( index < outputs.size() );
+    return outputs[index];
+  }
+
+  uint32_t pi_index( node_index_t const& n ) const
+  {
+    assert( has_intersection( pin_types[pin_offset[n]], network::pin_type_t::PI ) );
+    return static_cast<uint32_t>( fanins[fanin_offset[n]].data );
+  }
+
+  uint32_t po_index( signal_t const& f ) const
+  {
+    for ( uint32_t i = 0; i < outputs.size(); ++i )
+    {
+      if ( f == outputs[i] )
+        return i;
+    }
+    assert( false && "PO does not exist" );
+    return std::numeric_limits<uint32_t>::max();
+  }
+#pragma endregion
+
+#pragma region Node and signal iterators
+
+  template<typename Fn>
+  void foreach_node( Fn&& fn ) const
+  {
+    for ( node_index_t n = 2u; n < size(); ++n )
+    {
+      if ( !is_dead( n ) )
+      {
+        fn( n );
+      }
+    }
+  }
+
+  template<typename Fn>
+  void foreach_ci( Fn&& fn ) const
+  {
+    mockturtle::detail::foreach_element( inputs.begin(), inputs.end(), fn );
+  }
+
+  template<typename Fn>
+  void foreach_co( Fn&& fn ) const
+  {
+    mockturtle::detail::foreach_element( outputs.begin(), outputs.end(), fn );
+  }
+
+  template<typename Fn>
+  void foreach_pi( Fn&& fn ) const
+  {
+    mockturtle::detail::foreach_element( inputs.begin(), inputs.end(), fn );
+  }
+
+  template<typename Fn>
+  void foreach_po( Fn&& fn ) const
+  {
+    mockturtle::detail::foreach_element( outputs.begin(), outputs.end(), fn );
+  }
+
+  template<typename Fn>
+  void foreach_gate( Fn&& fn ) const
+  {
+    auto r = mockturtle::range<uint64_t>( 2u, size() ); /* start from 2 to avoid constants */
+    mockturtle::detail::foreach_element_if(
+        r.begin(), r.end(),
+        [this]( auto n ) { return !is_ci( n ) && !is_dead( n ); },
+        fn );
+  }
+
+  template<typename Fn>
+  void foreach_fanin( node_index_t const& n, Fn&& fn ) const
+  {
+    if ( n <= 1 || is_ci( n ) )
+      return;
+
+    auto const begin = fanins.begin() + fanin_offset[n];
+    mockturtle::detail::foreach_element( begin, begin + fanin_count[n], fn );
+  }
+
+  template<typename Fn>
+  void foreach_output_pin( node_index_t const& n, Fn&& fn ) const
+  {
+    for ( auto p = pin_offset[n]; p < pin_offset[n + 1]; ++p )
+    {
+      pin_t const view{ pin_ids[p], pin_types[p], p };
+      fn( view, p - pin_offset[n] );
+    }
+  }
+
+  template<typename Fn>
+  void foreach_output( node_index_t const& n, Fn&& fn ) const
+  {
+    for ( auto i = 0u; i < num_outputs( n ); ++i )
+    {
+      auto const f = signal_t{ n, i };
+      fn( f );
+    }
+  }
+
+  /*! \brief Iterate over the fanout of a pin.
+   *
+   * The size is read at each iteration, as in the node-based storage.
+   */
+  template<typename Fn>
+  void foreach_fanout( pin_t const& p, Fn&& fn ) const
+  {
+    for ( uint32_t i = 0; i < pin_fanout_size[p.index]; ++i )
+    {
+      node_index_t const n = fanout_pool[pin_fanout_offset[p.index] + i];
+      fn( n, i );
+    }
+  }
+
+  template<typename Fn>
+  void foreach_fanout( signal_t const& f, Fn&& fn ) const
+  {
+    auto const p = pin( f );
+    for ( uint32_t i = 0; i < pin_fanout_size[p]; ++i )
+    {
+      node_index_t const n = fanout_pool[pin_fanout_offset[p] + i];
+      fn( n );
+    }
+  }
+
+  template<typename Fn>
+  void foreach_fanout( node_index_t const& n, Fn&& fn ) const
+  {
+    foreach_output_pin( n, [&]( auto const& pin, auto i ) {
+      foreach_fanout( pin, [&]( auto const& fanout_node, auto j ) {
+        fn( fanout_node );
+      } );
+    } );
+  }
+
+#pragma endregion
+
+#pragma region Custom node values
+  void clear_values()
+  {
+    std::fill( user_data.begin(), user_data.end(), 0u );
+  }
+
+  uint32_t value( node_index_t const& n ) const
+  {
+    return user_data[n];
+  }
+
+  void set_value( node_index_t const& n, uint32_t v )
+  {
+    user_data[n] = v;
+  }
+
+  void set_name( signal_t const& f, std::string const& name )
+  {
+    names_map[f] = name;
+  }
+
+  uint32_t incr_value( node_index_t const& n )
+  {
+    return static_cast<uint32_t>( user_data[n]++ );
+  }
+
+  uint32_t decr_value( node_index_t const& n )
+  {
+    return static_cast<uint32_t>( --user_data[n] );
+  }
+
+  bool has_output_name( uint32_t po_index )
+  {
+    return output_names.size() > po_index;
+  }
+
+  std::string get_output_name( uint32_t po_index )
+  {
+    return output_names[po_index];
+  }
+
+  bool has_input_name( uint32_t pi_index )
+  {
+    return names_map.find( signal_t{ pi_at( pi_index ), 0 } ) != names_map.end();
+  }
+
+  std::string get_input_name( uint32_t pi_index )
+  {
+    signal_t const f{ pi_at( pi_index ), 0 };
+    return get_name( f );
+  }
+
+  void set_output_name( uint32_t po_index, std::string const& name )
+  {
+    output_names.resize( outputs.size() );
+    output_names[po_index] = name;
+  }
+
+  void set_input_name( uint32_t pi_index, std::string const& name )
+  {
+    signal_t const f{ pi_at( pi_index ), 0 };
+    names_map[f.data] = name;
+  }
+
+  bool has_name( signal_t const& f )
+  {
+    if ( names_map.find( f.data ) != names_map.end() )
+      return true;
+    if ( is_po( f ) )
+      return output_names.size() == num_pos();
+    return false;
+  }
+
+  std::string get_name( signal_t const& f )
+  {
+    return names_map[f];
+  }
+
+  std::string get_network_name() const
+  {
+    return module_name;
+  }
+
+  void set_network_name( std::string const& name )
+  {
+    module_name = name;
+  }
+
+#pragma endregion
+
+#pragma region Visited flags
+  void clear_visited()
+  {
+    std::fill( traversal_ids.begin(), traversal_ids.end(), 0u );
+  }
+
+  auto visited( node_index_t const& n ) const
+  {
+    return traversal_ids[n];
+  }
+
+  void set_visited( node_index_t const& n, uint32_t v )
+  {
+    traversal_ids[n] = v;
+  }
+
+  uint32_t get_trav_id() const
+  {
+    return trav_id;
+  }
+
+  unsigned int get_pin_id( std::string const& gate_name, std::string const& pin_name ) const
+  {
+    return library.get_pin_id( gate_name, pin_name );
+  }
+
+  void incr_trav_id()
+  {
+    if ( trav_id > ( std::numeric_limits<uint32_t>::max() - 10 ) )
+    {
+      std::cout << "[w] Traversal identifier exceeded safe treshold. Forced reset" << std::endl;
+      clear_values();
+      clear_visited();
+      trav_id = 0;
+    }
+    ++trav_id;
+  }
+#pragma endregion
+
+#pragma region Getters
+  /*! \brief Get the children of a node, without copying them. */
+  children_view get_children( node_index_t const& n ) const
+  {
+    signal_t const* begin = fanins.data() + fanin_offset[n];
+    return children_view( begin, begin + fanin_count[n] );
+  }
+
+  /*! \brief Get the indices of the fanin nodes of a node, without copying them. */
+  fanins_view get_fanins( node_index_t const& n ) const
+  {
+    signal_t const* begin = fanins.data() + fanin_offset[n];
+    return fanins_view( begin, begin + fanin_count[n] );
+  }
+
+  list_t const& get_chain( uint32_t id ) const
+  {
+    return library.get_chain( id );
+  }
+
+  libraries::gate_kernel const& get_kernel( uint32_t id ) const
+  {
+    return library.get_kernel( id );
+  }
+
+  double const& get_area( node_index_t const& n ) const
+  {
+    auto const& g = get_binding( signal_t{ n, 0 } );
+    return g.area;
+  }
+
+  std::vector<kitty::dynamic_truth_table> get_functions( node_index_t const& n ) const
+  {
+    std::vector<kitty::dynamic_truth_table> tts;
+    foreach_output( n, [&]( auto const& f ) {
+      auto const& g = get_binding( signal_t{ n, 0 } );
+      tts.push_back( g.function );
+    } );
+    return tts;
+  }
+
+  std::vector<uint32_t> get_binding_ids( node_index_t const& n ) const
+  {
+    return std::vector<uint32_t>( pin_ids.begin() + pin_offset[n], pin_ids.begin() + pin_offset[n + 1] );
+  }
+
+  std::vector<unsigned int> get_binding_ids( std::string const& name ) const
+  {
+    return library.get_binding_ids( name );
+  }
+
+  auto const& get_binding( signal_t const& f ) const
+  {
+    return library.get_gate( pin_ids[pin( f )] );
+  }
+
+  double get_max_pin_delay( signal_t const& f, uint32_t i ) const
+  {
+    return library.get_max_pin_delay( pin_ids[pin( f )], i );
+  }
+
+  double get_min_pin_delay( signal_t const& f, uint32_t i ) const
+  {
+    return library.get_min_pin_delay( pin_ids[pin( f )], i );
+  }
+
+  double get_input_load( signal_t const& f, uint32_t i ) const
+  {
+    return library.get_input_load( pin_ids[pin( f )], i );
+  }
+
+  std::vector<gate_t> const& get_library() const
+  {
+    return library.get_aug_gates();
+  }
+
+  /*! \brief Getter of the augmented library the gates are bound to. */
+  augmented_library_t const& get_augmented_library() const
+  {
+    return library;
+  }
+
+  node_index_t get_new_index()
+  {
+    return add_node( 1u, pin_type_t::NONE );
+  }
+
+  uint32_t get_fanin_number( unsigned int id, std::string const& pin_name ) const
+  {
+    return library.get_fanin_number( id, pin_name );
+  }
+#pragma endregion
+
+#pragma region Bindings
+
+  bool has_binding( signal_t const& f ) const
+  {
+    return has_binding( f.index );
+  }
+
+  bool has_binding( node_index_t const& n ) const
+  {
+    return !is_constant( n ) && !is_ci( n ) && !is_pi( n );
+  }
+
+  bool has_gate( std::string const& name ) const
+  {
+    return library.has_gate( name );
+  }
+
+  bool is_input_pin( std::string const& gate_name, std::string const& pin_name ) const
+  {
+    return library.is_input_pin( gate_name, pin_name );
+  }
+
+  bool is_output_pin( std::string const& gate_name, std::string const& pin_name ) const
+  {
+    return library.is_output_pin( gate_name, pin_name );
+  }
+#pragma endregion
+
+#pragma region Implementation details
+private:
+  /*! \brief Position of the pin of a signal in the pin arrays */
+  offset_t pin( signal_t const& f ) const
+  {
+    return pin_offset[f.index] + static_cast<offset_t>( f.output );
+  }
+
+  /*! \brief Append a node without fanins and with `num_pins` output pins */
+  node_index_t add_node( uint32_t num_pins, pin_type_t type )
+  {
+    if ( fanin_offset.empty() )
+    {
+      fanin_offset.push_back( 0u );
+      pin_offset.push_back( 0u );
+    }
+    auto const index = static_cast<node_index_t>( fanin_count.size() );
+    fanin_count.push_back( 0u );
+    traversal_ids.push_back( 0u );
+    user_data.push_back( 0u );
+    fanout_counts.push_back( 0u );
+    fanin_offset.push_back( static_cast<offset_t>( fanins.size() ) );
+
+    for ( auto i = 0u; i < num_pins; ++i )
+    {
+      pin_ids.push_back( std::numeric_limits<uint32_t>::max() );
+      pin_types.push_back( type );
+      pin_fanout_counts.push_back( 0u );
+      pin_fanout_offset.push_back( static_cast<offset_t>( fanout_pool.size() ) );
+      pin_fanout_size.push_back( 0u );
+      pin_fanout_capacity.push_back( 0u );
+    }
+    pin_offset.push_back( static_cast<offset_t>( pin_ids.size() ) );
+    return index;
+  }
+
+  /*! \brief Append a node to the fanout slice of a pin.
+   *
+   * When the slice is full, it is moved to the end of the pool with twice the
+   * capacity. The space left behind is reclaimed when it exceeds the live data.
+   */
+  void push_fanout( offset_t p, node_index_t n )
+  {
+    if ( pin_fanout_size[p] == pin_fanout_capacity[p] )
+    {
+      if ( fanout_garbage > fanout_pool.size() / 2 + 1024u )
+        compact_fanouts();
+
+      auto const capacity = std::max<uint32_t>( 2u, 2u * pin_fanout_capacity[p] );
+      auto const offset = static_cast<offset_t>( fanout_pool.size() );
+      fanout_pool.resize( fanout_pool.size() + capacity );
+      std::copy_n( fanout_pool.begin() + pin_fanout_offset[p], pin_fanout_size[p], fanout_pool.begin() + offset );
+      fanout_garbage += pin_fanout_capacity[p];
+      pin_fanout_offset[p] = offset;
+      pin_fanout_capacity[p] = capacity;
+    }
+    fanout_pool[pin_fanout_offset[p] + pin_fanout_size[p]++] = n;
+  }
+
+  /*! \brief Rebuild the fanout pool removing the unused slices. */
+  void compact_fanouts()
+  {
+    std::vector<node_index_t> pool;
+    pool.reserve( fanout_pool.size() - fanout_garbage );
+    for ( auto p = 0u; p < pin_ids.size(); ++p )
+    {
+      auto const offset = static_cast<offset_t>( pool.size() );
+      auto const begin = fanout_pool.begin() + pin_fanout_offset[p];
+      pool.insert( pool.end(), begin, begin + pin_fanout_size[p] );
+      pool.resize( offset + pin_fanout_capacity[p] );
+      pin_fanout_offset[p] = offset;
+    }
+    fanout_pool.swap( pool );
+    fanout_garbage = 0u;
+  }
+
+  /*! \brief Fingerprint of a stored node in the structural hashing table */
+  uint64_t hash_of( node_index_t const& n ) const
+  {
+    uint64_t seed = strash_table_t::fingerprint_seed;
+    for ( auto i = fanin_offset[n]; i < fanin_offset[n] + fanin_count[n]; ++i )
+      seed = strash_table_t::combine_signal( seed, fanins[i] );
+    for ( auto p = pin_offset[n]; p < pin_offset[n + 1]; ++p )
+      seed = strash_table_t::combine_id( seed, pin_ids[p] );
+    return seed;
+  }
+
+  bool equal( node_index_t const& m, std::vector<signal_t> const& children, std::vector<uint32_t> const& ids ) const
+  {
+    if ( fanin_count[m] != children.size() || num_outputs( m ) != ids.size() )
+      return false;
+    if ( !std::equal( children.begin(), children.end(), fanins.begin() + fanin_offset[m] ) )
+      return false;
+    return std::equal( ids.begin(), ids.end(), pin_ids.begin() + pin_offset[m] );
+  }
+
+  void hash_insert( node_index_t const& n )
+  {
+    hash.insert( hash_of( n ), n );
+  }
+
+  /*! \brief Remove a node from the hash table. Returns true if the node was found */
+  bool hash_erase( node_index_t const& n )
+  {
+    return hash.erase( hash_of( n ), n );
+  }
+#pragma endregion
+
+public:
+  uint32_t trav_id = 0u;
+
+  /* per-node arrays */
+  std::vector<offset_t> fanin_offset;
+  std::vector<uint32_t> fanin_count;
+  std::vector<offset_t> pin_offset;
+  std::vector<uint32_t> traversal_ids;
+  std::vector<uint32_t> user_data;
+  std::vector<uint32_t> fanout_counts;
+
+  /*! \brief Fanins of all the nodes, indexed by `fanin_offset` */
+  std::vector<signal_t> fanins;
+
+  /* per-pin arrays, indexed by `pin_offset` */
+  std::vector<uint32_t> pin_ids;
+  std::vector<pin_type_t> pin_types;
+  std::vector<uint32_t> pin_fanout_counts;
+  std::vector<offset_t> pin_fanout_offset;
+  std::vector<uint32_t> pin_fanout_size;
+  std::vector<uint32_t> pin_fanout_capacity;
+
+  /*! \brief Fanout slices of all the pins */
+  std::vector<node_index_t> fanout_pool;
+  /*! \brief Number of unused entries in the fanout pool */
+  size_t fanout_garbage = 0u;
+
+  std::vector<node_index_t> inputs;
+  std::vector<signal_t> outputs;
+  std::vector<std::string> output_names;
+  std::unordered_map<uint64_t, std::string> names_map;
+
+  augmented_library_t library;
+  std::string module_name;
+
+  /*! \brief Structural hashing table, storing the node indices */
+  strash_table_t hash;
+};
+
+} // namespace network
+
+} // namespace rinox
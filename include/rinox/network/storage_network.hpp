@@ -53,6 +53,7 @@
 #include "../libraries/augmented_library.hpp"
 #include "storage_node.hpp"
 #include "storage_signal.hpp"
+#include "strash_table.hpp"
 #include "utils.hpp"
 #include <mockturtle/io/genlib_reader.hpp>
 #include <mockturtle/networks/detail/foreach.hpp>
@@ -60,6 +61,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <limits>
 #include <queue>
 #include <vector>
 
@@ -96,6 +98,7 @@ public:
   using list_t = evaluation::chains::large_xag_chain;
   using node_t = storage_node<NumBitsOutputs>;
   using signal_t = storage_signal<NumBitsOutputs>;
+  using strash_table_t = strash_table<node_index_t>;
 
   /*! \brief The storage constructor.
    *
@@ -409,14 +412,7 @@ public:
       nodes[c.index].outputs[c.output].fanout.push_back( index );
     }
 
-    if ( hash.find( n ) != hash.end() )
-    {
-      hash[n].push_back( index );
-    }
-    else
-    {
-      hash[n] = { index };
-    }
+    hash.insert( hash_of( n ), index );
 
     return { index, 0 };
   }
@@ -566,6 +562,9 @@ public:
                     signal_t const& old_signal,
                     signal_t new_signal )
   {
+    /* re-hash the node, so that the hash table is consistent with the new children */
+    bool const hashed = hash.erase( hash_of( nodes[root] ), root );
+
     auto& nd_root = nodes[root];
     for ( auto& child : nd_root.children )
     {
@@ -581,6 +580,9 @@ public:
         child = new_signal;
       }
     }
+
+    if ( hashed )
+      hash.insert( hash_of( nd_root ), root );
   }
 
   /*! \brief Delete a node from the network.
@@ -594,16 +596,7 @@ public:
   void delete_node( node_index_t const& n )
   {
     /* remove the node from the hash table if present */
-    auto it = hash.find( nodes[n] );
-    if ( it != hash.end() )
-    {
-      auto& list = it->second;
-      list.erase( std::remove( list.begin(), list.end(), n ), list.end() );
-      if ( list.empty() ) // commented
-      {
-        hash.erase( it );
-      }
-    }
+    hash.erase( hash_of( nodes[n] ), n );
     /* mark the node as dead */
     for ( auto& pin : nodes[n].outputs )
     {
@@ -617,6 +610,81 @@ public:
     dead_nodes.push( n );
   }
 
+  /*! \brief Remove the dead nodes stored after a given index.
+   *
+   * \param size The number of nodes to be kept in the storage.
+   */
+  void truncate( node_index_t const& size )
+  {
+    while ( nodes.size() > size )
+    {
+      assert( is_dead( nodes.size() - 1 ) && "Only dead nodes can be truncated" );
+      nodes.pop_back();
+    }
+  }
+
+  /*! \brief Rebuild the storage keeping only the given nodes.
+   *
+   * The nodes are inserted again in the given order, which lists the primary
+   * inputs in their original order and each gate after its fanins. The nodes
+   * not in the order are dropped, while the outputs, the names and the library
+   * are preserved.
+   *
+   * \param order The primary inputs and the gates to be kept, in the new order.
+   * \return The new index of each old node, the maximum index for the dropped ones.
+   */
+  std::vector<node_index_t> compact( std::vector<node_index_t> const& order )
+  {
+    storage_network old( std::move( *this ) );
+    nodes.clear();
+    dead_nodes = {};
+    inputs.clear();
+    outputs.clear();
+    names_map.clear();
+    hash.clear();
+    library = std::move( old.library );
+    module_name = std::move( old.module_name );
+    output_names = std::move( old.output_names );
+    trav_id = old.trav_id;
+
+    nodes.reserve( order.size() + 2u );
+    nodes.emplace_back( pin_type_t::CONSTANT ); // 0
+    nodes.emplace_back( pin_type_t::CONSTANT ); // 1
+
+    std::vector<node_index_t> old_to_new( old.size(), std::numeric_limits<node_index_t>::max() );
+    old_to_new[0] = 0;
+    old_to_new[1] = 1;
+    std::vector<signal_t> children;
+    for ( auto const& n : order )
+    {
+      if ( old.is_ci( n ) )
+      {
+        old_to_new[n] = create_pi().index;
+        continue;
+      }
+      children.clear();
+      for ( auto const& f : old.get_children( n ) )
+      {
+        assert( old_to_new[f.index] != std::numeric_limits<node_index_t>::max() && "Fanins must precede their fanouts" );
+        children.emplace_back( old_to_new[f.index], f.output );
+      }
+      auto const ids = old.get_binding_ids( n );
+      old_to_new[n] = create_node( children, create_storage_node( children, ids ) ).index;
+    }
+
+    for ( auto const& f : old.outputs )
+    {
+      create_po( signal_t{ old_to_new[f.index], f.output } );
+    }
+    for ( auto const& [data, name] : old.names_map )
+    {
+      signal_t const f( data );
+      if ( old_to_new[f.index] != std::numeric_limits<node_index_t>::max() )
+        names_map[signal_t{ old_to_new[f.index], f.output }.data] = name;
+    }
+    return old_to_new;
+  }
+
 #pragma endregion
 
 #pragma region Structural properties
@@ -757,14 +825,28 @@ public:
    */
   std::optional<node_index_t> find( node_t const& n ) const
   {
-    auto it = hash.find( n );
-    if ( it != hash.end() )
-    {
-      assert( !is_dead( it->second[0] ) &&
-              "The node should not be dead when looking for it" );
-      return it->second[0];
-    }
-    return std::nullopt;
+    auto const res = hash.find( hash_of( n ), [&]( auto const& m ) {
+      return nodes[m].children == n.children &&
+             std::equal( n.outputs.begin(), n.outputs.end(), nodes[m].outputs.begin(), nodes[m].outputs.end(),
+                         []( auto const& a, auto const& b ) { return a.id == b.id; } );
+    } );
+    assert( ( !res || !is_dead( *res ) ) && "The node should not be dead when looking for it" );
+    return res;
+  }
+
+  /*! \brief Checks if a node with the given fanins and binding IDs is in the storage.
+   *
+   * Differently from `find( node_t const& )`, the node does not need to be built.
+   */
+  std::optional<node_index_t> find( std::vector<signal_t> const& children, std::vector<uint32_t> const& ids ) const
+  {
+    auto const res = hash.find( strash_table_t::fingerprint( children, ids ), [&]( auto const& m ) {
+      return nodes[m].children == children &&
+             std::equal( ids.begin(), ids.end(), nodes[m].outputs.begin(), nodes[m].outputs.end(),
+                         []( auto const& id, auto const& pin ) { return id == pin.id; } );
+    } );
+    assert( ( !res || !is_dead( *res ) ) && "The node should not be dead when looking for it" );
+    return res;
   }
 
   /*! \brief Checks if a node is in the fanin of another one.
@@ -1138,6 +1220,11 @@ public:
     return library.get_chain( id );
   }
 
+  libraries::gate_kernel const& get_kernel( uint32_t id ) const
+  {
+    return library.get_kernel( id );
+  }
+
   double const& get_area( node_index_t const& n ) const
   {
     auto const& g = get_binding( signal_t{ n, 0 } );
@@ -1200,6 +1287,12 @@ public:
     return library.get_aug_gates();
   }
 
+  /*! \brief Getter of the augmented library the gates are bound to. */
+  augmented_library_t const& get_augmented_library() const
+  {
+    return library;
+  }
+
   node_index_t get_new_index()
   {
     // if ( dead_nodes.empty() )
@@ -1248,6 +1341,21 @@ public:
   }
 #pragma endregion
 
+#pragma region Structural hashing
+private:
+  /*! \brief Fingerprint of a node in the structural hashing table */
+  static uint64_t hash_of( node_t const& n )
+  {
+    uint64_t seed = strash_table_t::fingerprint_seed;
+    for ( auto const& child : n.children )
+      seed = strash_table_t::combine_signal( seed, child );
+    for ( auto const& output : n.outputs )
+      seed = strash_table_t::combine_id( seed, output.id );
+    return seed;
+  }
+#pragma endregion
+
+public:
   /*! \brief Traversal ID for graph algorithms.
    *
    * This ID is used to mark nodes during traversal operations.
@@ -1293,13 +1401,12 @@ public:
   augmented_library_t library;
   std::string module_name;
 
-  /*! \brief Hash map for fast node lookups.
+  /*! \brief Structural hashing table for fast node lookups.
    *
-   * This hash map allows for quick access to nodes based on their indices.
-   * It uses a custom hash function to ensure efficient storage and retrieval
-   * of nodes in the network.
+   * The table stores the indices of the nodes, and compares the candidates
+   * against the node array, so that the nodes are never copied.
    */
-  phmap::flat_hash_map<node_t, std::vector<node_index_t>, network::node_hash<NumBitsOutputs>> hash;
+  strash_table<node_index_t> hash;
 };
 
 } // namespace network
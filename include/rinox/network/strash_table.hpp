@@ -0,0 +1,231 @@
+/* rinox: C++ logic network library
+ * Copyright (C) 2025 EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file strash_table.hpp
+  \brief Open-addressing structural hashing table for bound nodes
+
+  \author Andrea Costamagna
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace rinox
+{
+
+namespace network
+{
+
+/*! \brief Structural hashing table storing node indices.
+ *
+ * The table stores the fingerprint of each node together with its index, and
+ * never copies the nodes: the lookups compare the candidates against the node
+ * storage through a user-provided predicate. The fingerprint is computed from
+ * the fanin signals and the binding IDs with `fingerprint`, so that a node can
+ * be looked up before it is stored.
+ *
+ * Collisions are resolved by linear probing. Deleted entries leave a tombstone
+ * which is reclaimed when the table is rebuilt, and insertions always append
+ * at the end of the probing sequence. Hence, among structurally equivalent
+ * nodes, `find` returns the one inserted first.
+ */
+template<typename NodeIndex>
+class strash_table
+{
+public:
+  using node_index_t = NodeIndex;
+
+private:
+  static constexpr node_index_t empty_slot = std::numeric_limits<node_index_t>::max();
+  static constexpr node_index_t deleted_slot = std::numeric_limits<node_index_t>::max() - 1;
+  static constexpr std::size_t min_capacity = 16u;
+
+  struct slot_t
+  {
+    uint64_t hash;
+    node_index_t node;
+  };
+
+public:
+  /*! \brief Initial value of the fingerprints. */
+  static constexpr uint64_t fingerprint_seed = 0x9e3779b97f4a7c15ull;
+
+  /*! \brief Accumulate a fanin signal in a fingerprint. */
+  template<class Signal>
+  static uint64_t combine_signal( uint64_t seed, Signal const& f )
+  {
+    return mix( seed ^ static_cast<uint64_t>( f.data ) );
+  }
+
+  /*! \brief Accumulate a binding ID in a fingerprint. */
+  static uint64_t combine_id( uint64_t seed, uint32_t id )
+  {
+    return mix( seed ^ ( static_cast<uint64_t>( id ) | ( uint64_t( 1 ) << 63 ) ) );
+  }
+
+  /*! \brief Fingerprint of a node from its fanin signals and binding IDs. */
+  template<class Signals, class Ids>
+  static uint64_t fingerprint( Signals const& children, Ids const& ids )
+  {
+    uint64_t seed = fingerprint_seed;
+    for ( auto const& child : children )
+      seed = combine_signal( seed, child );
+    for ( auto const& id : ids )
+      seed = combine_id( seed, id );
+    return seed;
+  }
+
+  /*! \brief Returns the first node with the given fingerprint satisfying `equal`. */
+  template<typename Fn>
+  std::optional<node_index_t> find( uint64_t hash, Fn&& equal ) const
+  {
+    if ( slots_.empty() )
+      return std::nullopt;
+
+    for ( auto i = hash & mask_;; i = ( i + 1 ) & mask_ )
+    {
+      auto const& slot = slots_[i];
+      if ( slot.node == empty_slot )
+        return std::nullopt;
+      if ( slot.node != deleted_slot && slot.hash == hash && equal( slot.node ) )
+        return slot.node;
+    }
+  }
+
+  /*! \brief Insert a node, after the nodes with the same fingerprint. */
+  void insert( uint64_t hash, node_index_t const& n )
+  {
+    if ( ( num_used_ + 1 ) * 2 > slots_.size() )
+      rehash( num_entries_ + 1 );
+
+    auto i = hash & mask_;
+    while ( slots_[i].node != empty_slot )
+      i = ( i + 1 ) & mask_;
+    slots_[i] = { hash, n };
+    ++num_entries_;
+    ++num_used_;
+  }
+
+  /*! \brief Remove a node. Returns true if the node was found. */
+  bool erase( uint64_t hash, node_index_t const& n )
+  {
+    if ( slots_.empty() )
+      return false;
+
+    for ( auto i = hash & mask_;; i = ( i + 1 ) & mask_ )
+    {
+      auto& slot = slots_[i];
+      if ( slot.node == empty_slot )
+        return false;
+      if ( slot.node == n )
+      {
+        slot.node = deleted_slot;
+        --num_entries_;
+        return true;
+      }
+    }
+  }
+
+  /*! \brief Prepare the table for a number of nodes. */
+  void reserve( std::size_t num_nodes )
+  {
+    if ( num_nodes * 2 > slots_.size() )
+      rehash( num_nodes );
+  }
+
+  void clear()
+  {
+    slots_.clear();
+    mask_ = 0u;
+    num_entries_ = 0u;
+    num_used_ = 0u;
+  }
+
+  std::size_t size() const
+  {
+    return num_entries_;
+  }
+
+private:
+  static uint64_t mix( uint64_t x )
+  {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    return x ^ ( x >> 31 );
+  }
+
+  /*! \brief Rebuild the table dropping the tombstones.
+   *
+   * The slots are visited starting from an empty one, so that each probing
+   * sequence is re-inserted in order and the insertion order of equivalent
+   * nodes is preserved.
+   */
+  void rehash( std::size_t num_nodes )
+  {
+    std::size_t capacity = min_capacity;
+    while ( capacity < 4 * num_nodes )
+      capacity <<= 1;
+    if ( capacity < slots_.size() )
+      capacity = slots_.size();
+
+    std::vector<slot_t> old( capacity, slot_t{ 0u, empty_slot } );
+    old.swap( slots_ );
+    mask_ = capacity - 1;
+    num_used_ = num_entries_;
+
+    std::size_t start = 0u;
+    while ( start < old.size() && old[start].node != empty_slot )
+      ++start;
+    for ( std::size_t k = 0u; k < old.size(); ++k )
+    {
+      auto const& slot = old[( start + k ) & ( old.size() - 1 )];
+      if ( slot.node == empty_slot || slot.node == deleted_slot )
+        continue;
+      auto i = slot.hash & mask_;
+      while ( slots_[i].node != empty_slot )
+        i = ( i + 1 ) & mask_;
+      slots_[i] = slot;
+    }
+  }
+
+private:
+  std::vector<slot_t> slots_;
+  uint64_t mask_ = 0u;
+  /*! \brief Number of nodes in the table */
+  std::size_t num_entries_ = 0u;
+  /*! \brief Number of non-empty slots, including the tombstones */
+  std::size_t num_used_ = 0u;
+};
+
+} // namespace network
+
+} // namespace rinox
@@ -51,6 +51,16 @@ enum class design_type_t : uint8_t
   CELL_BASED,  //!< Standard cell-based design type
 };
 
+/*!
+ * \brief Memory layout of the storage of the Bound network
+ *
+ */
+enum class storage_layout_t : uint8_t
+{
+  ARRAY_OF_STRUCTS, //!< One object per node, owning its fanins and fanouts
+  STRUCT_OF_ARRAYS, //!< Flat arrays shared by all the nodes
+};
+
 /*!
  * \brief Computes the number of bits required to represent a given number.
  *
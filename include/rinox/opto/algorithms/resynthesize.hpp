@@ -32,9 +32,11 @@
 
 #pragma once
 
+#include "../../databases/database_synthesizer.hpp"
 #include "../../databases/mapped_database.hpp"
 #include "../../dependency/dependency_cut.hpp"
 #include "../../dependency/rewire_dependencies.hpp"
+#include "../../dependency/simula_dependencies.hpp"
 #include "../../dependency/struct_dependencies.hpp"
 #include "../../dependency/window_dependencies.hpp"
 #include "../../synthesis/lut_decomposer.hpp"
@@ -50,7 +52,17 @@
 #include <kitty/npn.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/static_truth_table.hpp>
+#include <mockturtle/traits.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <vector>
 
 #ifndef RINOX_NUM_VARS_SIGN
 #define RINOX_NUM_VARS_SIGN 6
@@ -85,6 +97,11 @@ namespace algorithms
 struct resynthesis_stats
 {
   windowing::window_manager_stats window_st;
+  windowing::window_simulator_stats simulator_st;
+  dependency::simula_dependencies_stats simula_st;
+  dependency::function_enumerator_stats enumerator_st;
+  databases::database_synthesizer_stats synthesizer_st;
+  databases::mapped_database_stats database_st;
   /*! \brief Total runtime. */
   mockturtle::stopwatch<>::duration time_total{ 0 };
 
@@ -99,6 +116,15 @@ struct resynthesis_stats
   uint32_t num_simula{ 0 };
   uint32_t num_rewire{ 0 };
 
+  /*! \brief Number of batches of windows optimized in parallel. */
+  uint32_t num_batches{ 0 };
+
+  /*! \brief Number of windows postponed because overlapping a window in the batch or its changes. */
+  uint32_t num_conflicts{ 0 };
+
+  /*! \brief Number of copies of the network replaced after differing from the network. */
+  uint32_t num_resyncs{ 0 };
+
   void report() const
   {
     std::cout << fmt::format( "[i] total time       = {:>5.2f} secs\n", mockturtle::to_seconds( time_total ) );
@@ -106,6 +132,24 @@ struct resynthesis_stats
     std::cout << fmt::format( "    num window       = {:5d}\n", num_window );
     std::cout << fmt::format( "    num simula       = {:5d}\n", num_simula );
     std::cout << fmt::format( "    num rewire       = {:5d}\n", num_rewire );
+    std::cout << fmt::format( "    num batches      = {:5d}\n", num_batches );
+    std::cout << fmt::format( "    num conflicts    = {:5d}\n", num_conflicts );
+    std::cout << fmt::format( "    num resyncs      = {:5d}\n", num_resyncs );
+    std::cout << fmt::format( "    num windows      = {:5d}\n", window_st.num_windows );
+    std::cout << fmt::format( "    simulation hits  = {:5d}\n", simulator_st.num_hits );
+    std::cout << fmt::format( "    partial hits     = {:5d}\n", simulator_st.num_partial_hits );
+    std::cout << fmt::format( "    simulation miss  = {:5d}\n", simulator_st.num_misses );
+    std::cout << fmt::format( "    simula validated = {:5d}\n", simula_st.num_validated );
+    std::cout << fmt::format( "    simula cex       = {:5d}\n", simula_st.num_counterexamples );
+    std::cout << fmt::format( "    dc completions   = {:5d}\n", enumerator_st.num_completions );
+    std::cout << fmt::format( "    dc capped        = {:5d}\n", enumerator_st.num_capped );
+    std::cout << fmt::format( "    db lookups       = {:5d}\n", database_st.num_lookups );
+    std::cout << fmt::format( "    db cache hits    = {:5d}\n", database_st.num_hits );
+    std::cout << fmt::format( "    db canonizations = {:5d}\n", database_st.num_canonizations );
+    std::cout << fmt::format( "    db dc lookups    = {:5d}\n", database_st.num_dc_lookups );
+    std::cout << fmt::format( "    db dc hits       = {:5d}\n", database_st.num_dc_hits );
+    std::cout << fmt::format( "    db misses        = {:5d}\n", synthesizer_st.num_misses );
+    std::cout << fmt::format( "    db synthesized   = {:5d}\n", synthesizer_st.num_synthesized );
   }
 };
 
@@ -144,9 +188,34 @@ struct default_resynthesis_params
   /*! \brief If true try simulation-guided rewriting with non-structural cuts */
   bool try_simula = false;
 
-  /*! \brief Activates lazy man's synthesis when set to true */
+  /*! \brief Activates lazy man's synthesis when set to true.
+   *
+   * The windows are evaluated in batches on copies of the database, hence the
+   * functions missing in the database are synthesized between the batches:
+   * they are available to the windows of the next batches, not to the window
+   * that missed them. With more than one thread, the result does not depend
+   * on the number of threads, unless the synthesis runs in background.
+   */
   bool dynamic_database = false;
 
+  /*! \brief Synthesis of the functions missing in the database ( lazy man's synthesis ) */
+  databases::database_synthesizer_params synthesizer_ps;
+
+  /*! \brief Match the functions with don't cares in the database instead of enumerating their completions.
+   *
+   * The matching expands the P-classes of all the rows in an index, which is
+   * large for the databases of 6-input functions, and checks the functions of
+   * the rows whose number of minterms is compatible with the function, whose
+   * range grows with the number of don't cares.
+   */
+  bool match_dont_cares = false;
+
+  /*! \brief Maximum number of don't cares of the functions matched in the database, the others are enumerated */
+  uint32_t max_matched_dont_cares = 4u;
+
+  /*! \brief Enumeration of the completions when the don't cares are not matched in the database */
+  dependency::function_enumerator_params enumerator_ps;
+
   /*! \brief Cube size for the signatures in simulation-guided resubstitution */
   static constexpr uint32_t num_vars_sign = RINOX_NUM_VARS_SIGN;
   /*! \brief Maximum number of leaves in the dependency cuts */
@@ -156,11 +225,142 @@ struct default_resynthesis_params
 
   /*! \brief Maximum fanout size for a node to be optimized*/
   uint32_t fanout_limit = 12u;
+
+  /*! \brief Number of threads evaluating windows concurrently ( 1 means sequential )
+   *
+   * With more than one thread, the windows are optimized in batches, and the
+   * result does not depend on the number of threads. It can differ from the
+   * sequential result: the windows of a batch are evaluated on the network as
+   * it was before the batch, while the sequential engine evaluates each window
+   * after committing the previous pivot, and the overlapping windows are
+   * postponed to the next batch, which changes the order of the pivots.
+   */
+  uint32_t num_threads = 1u;
+
+  /*! \brief Maximum number of non-overlapping windows evaluated in a parallel batch */
+  uint32_t max_batch_size = 256u;
+
+  /*! \brief Renumber the network in topological order and drop the dead nodes at the end
+   *
+   * The nodes and signals held by the caller, and the views and trackers built
+   * on the network, refer to the old indices and are invalidated.
+   */
+  bool compact = false;
 };
 
 namespace detail
 {
 
+/*! \brief Optimization found for a pivot node.
+ *
+ * The candidate stores what is needed to apply the optimization to any network
+ * with the same node indices of the one on which it was found. Rewiring
+ * candidates store the binding ids of the pivot, the other ones store a chain.
+ */
+template<class Ntk, typename Chain>
+struct resynthesis_candidate_t
+{
+  typename Ntk::node pivot;
+  dependency::dependency_t type;
+  std::vector<typename Ntk::signal> leaves;
+  std::vector<uint32_t> ids;
+  Chain chain;
+  /*! \brief Bit i is set if leaf i is connected through an inverter */
+  uint32_t inverted{ 0 };
+};
+
+/*! \brief Apply a candidate optimization to a network.
+ *
+ * \return The signal substituting the pivot, or nothing if the candidate is
+ * outdated, i.e., its pivot or leaves are dead.
+ */
+template<bool DoStrash, class Ntk, typename Chain>
+std::optional<typename Ntk::signal> commit_candidate( Ntk& ntk, resynthesis_candidate_t<Ntk, Chain> const& cand )
+{
+  if ( ntk.is_dead( cand.pivot ) )
+    return std::nullopt;
+  for ( auto const& f : cand.leaves )
+  {
+    if ( ntk.is_dead( ntk.get_node( f ) ) )
+      return std::nullopt;
+  }
+
+  std::vector<typename Ntk::signal> leaves;
+  if ( cand.inverted != 0u )
+  {
+    auto const inverter_id = ntk.get_augmented_library().get_inverter_id();
+    if ( !inverter_id )
+      return std::nullopt;
+    leaves = cand.leaves;
+    for ( auto i = 0u; i < leaves.size(); ++i )
+    {
+      if ( ( cand.inverted >> i ) & 1u )
+        leaves[i] = ntk.template create_node<DoStrash>( std::vector<typename Ntk::signal>{ leaves[i] }, static_cast<uint32_t>( *inverter_id ) );
+    }
+  }
+  auto const& children = ( cand.inverted != 0u ) ? leaves : cand.leaves;
+  auto const fnew = cand.ids.empty() ? insert( ntk, children, cand.chain ) : ntk.template create_node<DoStrash>( children, cand.ids );
+  std::vector<typename Ntk::signal> fs;
+  ntk.foreach_output( ntk.get_node( fnew ), [&]( auto f ) {
+    fs.push_back( f );
+  } );
+  ntk.substitute_node( cand.pivot, fs );
+  return fnew;
+}
+
+template<typename Candidate>
+void count_candidate( resynthesis_stats& st, Candidate const& cand )
+{
+  switch ( cand.type )
+  {
+  case dependency::REWIRE_DEP:
+    st.num_rewire++;
+    break;
+  case dependency::STRUCT_DEP:
+    st.num_struct++;
+    break;
+  case dependency::WINDOW_DEP:
+    st.num_window++;
+    break;
+  case dependency::SIMULA_DEP:
+    st.num_simula++;
+    break;
+  }
+}
+
+/*! \brief Checks if the node should be analyzed for optimization or skipped */
+template<class Ntk>
+bool skip_node( Ntk const& ntk, typename Ntk::node const& n, uint32_t fanout_limit )
+{
+  if ( ntk.fanout_size( n ) > fanout_limit )
+    return true;
+  if ( ntk.fanout_size( n ) <= 0 )
+    return true;
+  if ( ntk.is_pi( n ) || ntk.is_constant( n ) )
+    return true;
+  if ( ntk.is_dead( n ) )
+    return true;
+  return false;
+}
+
+/*! \brief Add the lookups performed on a database since `before` to the statistics. */
+inline void add_database_stats( resynthesis_stats& st, databases::mapped_database_stats const& after, databases::mapped_database_stats const& before = {} )
+{
+  st.database_st.num_lookups += after.num_lookups - before.num_lookups;
+  st.database_st.num_hits += after.num_hits - before.num_hits;
+  st.database_st.num_canonizations += after.num_canonizations - before.num_canonizations;
+  st.database_st.num_dc_lookups += after.num_dc_lookups - before.num_dc_lookups;
+  st.database_st.num_dc_hits += after.num_dc_hits - before.num_dc_hits;
+  st.database_st.num_dc_matches += after.num_dc_matches - before.num_dc_matches;
+}
+
+/*! \brief Resynthesis of the pivots one at a time.
+ *
+ * `run` optimizes the network in place, committing the best candidate of each
+ * pivot before analyzing the next one. The workers of
+ * `parallel_resynthesize_impl` only use `optimize`, on the network or on their
+ * own copy of the network and of the database.
+ */
 template<class Ntk, typename Database, typename Profiler, typename Params = default_resynthesis_params<RINOX_MAX_NUM_LEAVES>>
 class resynthesize_impl
 {
@@ -175,7 +375,27 @@ class resynthesize_impl
   using data_t = kitty::static_truth_table<Database::max_num_vars>;
   using decomposer_t = synthesis::lut_decomposer<Params::max_cuts_size, Database::max_num_vars>;
   using window_manager_t = windowing::window_manager<Ntk, typename Params::window_manager_params>;
-  // using validator_t = circuit_validator<Ntk, bill::solvers::bsat2, false, true, false>; // last is false
+  using synthesizer_t = databases::database_synthesizer<Database>;
+
+  /*! \brief Buffers of the evaluation of the candidates.
+   *
+   * The transient chains, leaves, arrival times and simulations are cleared
+   * and rebuilt for each candidate, reusing their memory. Hence, the inner loop
+   * does not allocate once the buffers have reached their maximum size.
+   */
+  struct scratch_t
+  {
+    std::vector<signal> signals;
+    std::vector<double> times;
+    std::vector<func_t const*> sim_ptrs;
+    std::vector<signal> loc_leaves;
+    std::vector<double> loc_times;
+    std::vector<typename decomposer_t::cut_func_t const*> loc_sims;
+    std::vector<signal> best_loc_leaves;
+    std::vector<typename decomposer_t::cut_func_t const*> best_loc_sims;
+    chain_t new_chain;
+    chain_t loc_chain;
+  };
 
   struct rewire_params : dependency::default_rewire_params
   {
@@ -195,110 +415,219 @@ class resynthesize_impl
     static constexpr uint32_t max_cube_spfd = Params::max_cube_spfd;
   };
 
+  struct simula_params : dependency::default_simula_params
+  {
+    static constexpr uint32_t num_vars_sign = Params::num_vars_sign;
+    static constexpr uint32_t max_cuts_size = Params::max_cuts_size;
+  };
+
   using rewire_dependencies_t = dependency::rewire_dependencies<Ntk, rewire_params>;
   using struct_dependencies_t = dependency::struct_dependencies<Ntk, struct_params>;
   using window_dependencies_t = dependency::window_dependencies<Ntk, window_params>;
-  // using simula_dependency_t = simula_dependency<Ntk, custom_simula_params>;
+  using simula_dependencies_t = dependency::simula_dependencies<Ntk, simula_params>;
 
 public:
+  using candidate_t = resynthesis_candidate_t<Ntk, chain_t>;
+  using pattern_t = typename simula_dependencies_t::pattern_t;
 
-  resynthesize_impl( Ntk& ntk, Database& database, Params ps, resynthesis_stats& st)
-    : ntk_( ntk ),
-      win_manager_( ntk, ps.window_manager_ps, st.window_st ),
-      profiler_( ntk, win_manager_, ps.profiler_ps ),
-      database_( database ),
-      win_simulator_( ntk ),
-      chain_simulator_( database.get_library() ),
-      ps_( ps ),
-      st_( st )
-  {}
 public:
-  void run()
+  resynthesize_impl( Ntk& ntk, Database& database, Params const& ps, resynthesis_stats& st )
+      : ntk_( ntk ),
+        ps_( ps ),
+        st_( st ),
+        enumerator_( ps_.enumerator_ps, st.enumerator_st ),
+        win_manager_( ntk, ps_.window_manager_ps, st.window_st ),
+        win_simulator_( ntk, st.simulator_st ),
+        profiler_( ntk, win_manager_, ps_.profiler_ps ),
+        database_( database ),
+        chain_simulator_( database.get_library() ),
+        rewire_dependencies_( ntk ),
+        struct_dependencies_( ntk ),
+        window_dependencies_( ntk )
   {
-    rewire_dependencies_t rewire_dependencies( ntk_ );
-    struct_dependencies_t struct_dependencies( ntk_ );
-    window_dependencies_t window_dependencies( ntk_ );
+    /* the simulation patterns of the engine are only allocated when used */
+    if ( ps_.try_simula )
+      simula_dependencies_.emplace( ntk, st.simula_st );
+  }
 
-    chain_t best_chain;
-    best_chain.add_inputs( Params::max_cuts_size );
+public:
+  /*! \brief Optimize the network in place, one pivot at a time. */
+  void run()
+  {
+    if ( ps_.dynamic_database )
+      synthesizer_ = std::make_unique<synthesizer_t>( database_.get_library().get_raw_gates(), ps_.synthesizer_ps, st_.synthesizer_st );
+    auto const database_st = database_.get_stats();
 
-    auto nmax = ntk_.size();
+    auto const nmax = ntk_.size();
     profiler_.foreach_gate( [&]( auto n ) {
       if ( n >= nmax )
-        return false;
+        return;
       /* Skip nodes which cannot result in optimization */
-      if ( skip_node( n ) )
-        return true;
+      if ( skip_node( ntk_, n, ps_.fanout_limit ) )
+        return;
+
+      /* the chains synthesized in background are available from the next pivot */
+      if ( synthesizer_ )
+        synthesizer_->flush( database_ );
+      auto const cand = optimize( n );
+      if ( cand && commit_candidate<Params::do_strashing>( ntk_, *cand ) )
+        count_candidate( st_, *cand );
+    } );
 
-      /* Build and run analysis on window */
-      window_analysis( n );
-      profiler_.init();
+    add_database_stats( st_, database_.get_stats(), database_st );
+    synthesizer_.reset();
+  }
 
-      if ( !win_manager_.is_valid() )
-        return true;
+  /*! \brief Search the best optimization for a pivot without modifying the network.
+   *
+   * Tentative insertions performed during the evaluation are left dangling and
+   * can be removed with `rollback`. Outside of `run`, when `dynamic_database`
+   * is set, the functions missing in the database are collected in `get_misses`.
+   */
+  std::optional<candidate_t> optimize( node const& n )
+  {
+    win_manager_.run( n );
+    return optimize_window( n );
+  }
 
-      if ( ps_.try_rewire )
-      {
-        rewire_dependencies.run( win_manager_, win_simulator_ );
-        std::optional<cut_t> best_cut;
-        double best_reward = 0;
-
-        rewire_dependencies.foreach_cut( [&]( auto& cut, auto i ) {
-          auto const& cut_leaves = cut.leaves;
-          auto const reward = profiler_.evaluate_rewiring( n, cut_leaves );
-          if ( reward > best_reward )
-          {
-            best_reward = reward;
-            best_cut = std::make_optional( cut );
-          }
-        } );
-        if ( best_cut )
-        {
-          auto const ids = ntk_.get_binding_ids( n );
-          auto const fnew = ntk_.template create_node<Params::do_strashing>( ( *best_cut ).leaves, ids );
-          substitute_node( n, fnew );
-          return true;
-        }
-      }
+  /*! \brief Search the best optimization for the pivot of a window built on a network with the same nodes. */
+  std::optional<candidate_t> optimize( windowing::window_t<Ntk> const& window )
+  {
+    win_manager_.load( window );
+    return optimize_window( window.pivot );
+  }
 
-      double best_reward = 0;
-      std::vector<signal_t> best_leaves;
+  /*! \brief Keep the counter-examples of the simulation-guided dependencies until `take_patterns`. */
+  void defer_patterns()
+  {
+    if ( simula_dependencies_ )
+      simula_dependencies_->defer_patterns( true );
+  }
 
-      if ( ps_.try_struct )
-      {
-        struct_dependencies.run( win_manager_, win_simulator_ );
+  /*! \brief Functions missing in the database found by the last call to `optimize`. */
+  std::vector<data_t> const& get_misses() const
+  {
+    return misses_;
+  }
 
-        struct_dependencies.foreach_cut( [&]( auto& cut, auto i ) {
-          best_reward = std::max( evaluate( cut, best_chain, best_leaves ), best_reward );
-        } );
+  /*! \brief Move out the counter-examples found by the simulation-guided dependencies. */
+  std::vector<pattern_t> take_patterns()
+  {
+    if ( !simula_dependencies_ )
+      return {};
+    return simula_dependencies_->take_patterns();
+  }
+
+  /*! \brief Add counter-examples to the patterns of the simulation-guided dependencies. */
+  void add_patterns( std::vector<pattern_t> const& patterns )
+  {
+    if ( simula_dependencies_ )
+      simula_dependencies_->add_patterns( patterns );
+  }
+
+  /*! \brief Remove the nodes created after the network had the given size. */
+  void rollback( node_index_t const& size )
+  {
+    for ( auto n = ntk_.size(); n > size; --n )
+    {
+      if ( !ntk_.is_dead( n - 1 ) )
+        ntk_.take_out_node( n - 1 );
+    }
+    ntk_.truncate( size );
+  }
+
+  /*! \brief Iterate over the candidate pivots in the order defined by the profiler. */
+  template<typename Fn>
+  void foreach_pivot( Fn&& fn )
+  {
+    profiler_.foreach_gate( fn );
+  }
+
+private:
+  /*! \brief Search the best optimization for the pivot of the current window. */
+  std::optional<candidate_t> optimize_window( node const& n )
+  {
+    misses_.clear();
+
+    win_simulator_.run( win_manager_ );
+    profiler_.init();
+
+    if ( !win_manager_.is_valid() )
+      return std::nullopt;
+
+    if ( ps_.try_rewire )
+    {
+      rewire_dependencies_.run( win_manager_, win_simulator_ );
+      std::optional<cut_t> best_cut;
+      double best_reward = 0;
 
-        if ( best_reward > 0 )
+      rewire_dependencies_.foreach_cut( [&]( auto& cut, auto i ) {
+        auto const& cut_leaves = cut.leaves;
+        auto const reward = profiler_.evaluate_rewiring( n, cut_leaves, cut.inverted );
+        if ( reward > best_reward )
         {
-          auto const fnew = insert( ntk_, best_leaves, best_chain );
-          substitute_node( n, fnew );
-          return true;
+          best_reward = reward;
+          best_cut = std::make_optional( cut );
         }
+      } );
+      if ( best_cut )
+      {
+        return candidate_t{ n, dependency::REWIRE_DEP, ( *best_cut ).leaves, ntk_.get_binding_ids( n ), {}, ( *best_cut ).inverted };
       }
-      if ( ps_.try_window )
+    }
+
+    double best_reward = 0;
+    std::vector<signal_t> best_leaves;
+    chain_t best_chain;
+    best_chain.add_inputs( Params::max_cuts_size );
+
+    if ( ps_.try_struct )
+    {
+      struct_dependencies_.run( win_manager_, win_simulator_ );
+
+      struct_dependencies_.foreach_cut( [&]( auto& cut, auto i ) {
+        best_reward = std::max( evaluate( cut, best_chain, best_leaves ), best_reward );
+      } );
+
+      if ( best_reward > 0 )
       {
-        window_dependencies.run( win_manager_, win_simulator_ );
-        window_dependencies.foreach_cut( [&]( auto& cut, auto i ) {
-          best_reward = std::max( evaluate( cut, best_chain, best_leaves ), best_reward );
-        } );
+        return candidate_t{ n, dependency::STRUCT_DEP, best_leaves, {}, best_chain };
+      }
+    }
+    if ( ps_.try_window )
+    {
+      window_dependencies_.run( win_manager_, win_simulator_ );
+      window_dependencies_.foreach_cut( [&]( auto& cut, auto i ) {
+        best_reward = std::max( evaluate( cut, best_chain, best_leaves ), best_reward );
+      } );
 
-        if ( best_reward > 0 )
+      if ( best_reward > 0 )
+      {
+        return candidate_t{ n, dependency::WINDOW_DEP, best_leaves, {}, best_chain };
+      }
+    }
+    if ( ps_.try_simula )
+    {
+      simula_dependencies_->run( win_manager_, win_simulator_ );
+      simula_dependencies_->foreach_cut( [&]( auto& cut, auto i ) {
+        /* profilers evaluating the window can only score leaves in the window */
+        if constexpr ( Profiler::pass_window )
         {
-          auto const fnew = insert( ntk_, best_leaves, best_chain );
-          substitute_node( n, fnew );
-          return true;
+          if ( !std::all_of( cut.begin(), cut.end(), [&]( auto const& f ) { return win_manager_.is_contained( ntk_.get_node( f ) ); } ) )
+            return;
         }
+        best_reward = std::max( evaluate( cut, best_chain, best_leaves ), best_reward );
+      } );
+
+      if ( best_reward > 0 )
+      {
+        return candidate_t{ n, dependency::SIMULA_DEP, best_leaves, {}, best_chain };
       }
+    }
 
-      return true;
-    } );
+    return std::nullopt;
   }
 
-private:
   double evaluate( cut_t const& cut, chain_t& best_chain, std::vector<signal_t>& best_leaves )
   {
     double best_reward = 0;
@@ -307,8 +636,10 @@ private:
     double const cost_curr = profiler_.evaluate( cut.root, cut.leaves, cut.root );
 
     auto const cut_func = cut.func[0];
-    auto signals = cut.leaves;
-    auto times = get_times( signals );
+    auto& signals = scratch_.signals;
+    auto& times = scratch_.times;
+    signals.assign( cut.leaves.begin(), cut.leaves.end() );
+    get_times( times, signals );
     signals.resize( Params::max_cuts_size, std::numeric_limits<uint64_t>::max() );
     times.resize( Params::max_cuts_size, std::numeric_limits<double>::max() );
     signal_t best_signal;
@@ -332,8 +663,8 @@ private:
     if ( !success )
       return 0;
 
-    chain_t new_chain;
-    new_chain.add_inputs( cut.leaves.size() );
+    auto& new_chain = scratch_.new_chain;
+    new_chain.reset( static_cast<uint32_t>( cut.leaves.size() ) );
     extract( new_chain, ntk_, cut.leaves, best_signal );
     double const cost_cand = profiler_.evaluate( new_chain, cut.leaves, cut.root );
     auto const reward = cost_curr - cost_cand;
@@ -348,47 +679,80 @@ private:
 
   std::optional<std::tuple<signal_t, double, func_t>> local_synthesis( cut_t const& cut, typename decomposer_t::specs_t const& specs, uint8_t lit, std::vector<signal_t>& signals, std::vector<double>& times )
   {
-    std::vector<func_t const*> sim_ptrs;
+    auto& sim_ptrs = scratch_.sim_ptrs;
     auto& spec = specs[lit];
+    sim_ptrs.clear();
     for ( auto i : spec.inputs )
       sim_ptrs.push_back( &specs[i].sim._bits );
 
     auto itt = dependency::extract_function<func_t, Database::max_num_vars>( sim_ptrs, specs[lit].sim._bits, specs[lit].sim._care );
     double best_loc_cost = std::numeric_limits<double>::max();
     std::optional<node> best_database_node;
-    std::vector<signal> best_loc_leaves;
-    std::vector<typename decomposer_t::cut_func_t const*> best_loc_sims;
+    auto& best_loc_leaves = scratch_.best_loc_leaves;
+    auto& best_loc_sims = scratch_.best_loc_sims;
     signal_t best_signal;
 
-    enumerator_.foreach_dont_care_assignment( itt, sim_ptrs.size(), [&]( auto const& ctt ) {
-      std::vector<signal> loc_leaves( spec.inputs.size() );
-      std::vector<double> loc_times( spec.inputs.size() );
-      std::vector<typename decomposer_t::cut_func_t const*> loc_sims = sim_ptrs;
+    auto const try_match = [&]( uint64_t row ) {
+      auto [index, cost_cand] = evaluate( row, scratch_.loc_leaves, scratch_.loc_times );
+      if ( cost_cand < best_loc_cost )
+      {
+        best_loc_cost = cost_cand;
+        best_database_node = std::make_optional( index );
+        best_loc_leaves = scratch_.loc_leaves;
+        best_loc_sims = scratch_.loc_sims;
+      }
+    };
+    auto const load_inputs = [&]() {
+      auto& loc_leaves = scratch_.loc_leaves;
+      auto& loc_times = scratch_.loc_times;
+      auto& loc_sims = scratch_.loc_sims;
+      loc_leaves.resize( spec.inputs.size() );
+      loc_times.resize( spec.inputs.size() );
+      loc_sims.assign( sim_ptrs.begin(), sim_ptrs.end() );
       std::transform( spec.inputs.begin(), spec.inputs.end(), loc_leaves.begin(), [&]( auto const& lit ) { return signals[lit]; } );
       std::transform( spec.inputs.begin(), spec.inputs.end(), loc_times.begin(), [&]( auto const& lit ) { return times[lit]; } );
-      // Perform boolean matching
-      auto row = database_.boolean_matching( ctt, loc_times, loc_leaves, loc_sims );
+    };
 
-      if ( row )
+    auto const match = [&]() {
+      if ( ps_.match_dont_cares && enumerator_.num_dont_cares( itt, sim_ptrs.size() ) <= ps_.max_matched_dont_cares )
       {
-        auto [index, cost_cand] = evaluate( *row, loc_leaves );
-        if ( cost_cand < best_loc_cost )
-        {
-          best_loc_cost = cost_cand;
-          best_database_node = std::make_optional( index );
-          best_loc_leaves = loc_leaves;
-          best_loc_sims = loc_sims;
-        }
+        database_.foreach_compatible_row( itt, sim_ptrs.size(), [&]( uint64_t row, auto const& perm ) {
+          load_inputs();
+          database_.match_inputs( row, perm, scratch_.loc_times, scratch_.loc_leaves, scratch_.loc_sims );
+          try_match( row );
+        } );
       }
-    } );
+      else
+      {
+        enumerator_.foreach_dont_care_assignment( itt, sim_ptrs.size(), [&]( auto const& ctt ) {
+          load_inputs();
+          // Perform boolean matching
+          auto row = database_.boolean_matching( ctt, scratch_.loc_times, scratch_.loc_leaves, scratch_.loc_sims );
+          if ( row )
+            try_match( *row );
+        } );
+      }
+    };
+
+    match();
+    /* lazy man's synthesis of the missing function, with the don't cares set to zero */
+    if ( !best_database_node && ps_.dynamic_database )
+    {
+      auto const func = boolean::binary_and( itt._bits, itt._care );
+      /* in batches, the function is added between the batches */
+      if ( !synthesizer_ )
+        misses_.push_back( func );
+      else if ( synthesizer_->synthesize( func, database_ ) )
+        match();
+    }
     if ( best_database_node )
     {
       auto nnew = database_.write( *best_database_node, ntk_, best_loc_leaves );
       best_signal = ntk_.make_signal( nnew );
       signals.push_back( best_signal );
       times.push_back( profiler_.get_arrival( best_signal ) );
-      chain_t loc_chain;
-      loc_chain.add_inputs( Database::max_num_vars );
+      auto& loc_chain = scratch_.loc_chain;
+      loc_chain.reset( Database::max_num_vars );
       extract( loc_chain, ntk_, best_loc_leaves, signals.back() );
       chain_simulator_( loc_chain, best_loc_sims );
       auto const sim = chain_simulator_.get_simulation( loc_chain, best_loc_sims, loc_chain.po_at( 0 ) );
@@ -397,78 +761,616 @@ private:
     return std::nullopt;
   }
 
-  std::tuple<node_index_t, double> evaluate( uint64_t const& row, std::vector<signal_t> const& loc_leaves )
+  /*! \brief Select the best entry of a database row.
+   *
+   * When the profiler can score the entries from the data stored in the
+   * database, the network is not modified. Otherwise, each entry is tentatively
+   * written in the network and taken out after evaluation.
+   */
+  std::tuple<node_index_t, double> evaluate( uint64_t const& row, std::vector<signal_t> const& loc_leaves, std::vector<double> const& loc_times )
   {
     node_index_t best_database_node = std::numeric_limits<node_index_t>::max();
     double best_cost = std::numeric_limits<double>::max();
 
     database_.foreach_entry( row, [&]( auto const& entry ) {
-      auto nnew = database_.write( entry, ntk_, loc_leaves );
-      auto cost_new = profiler_.evaluate( nnew, loc_leaves, win_manager_.get_pivot() );
+      double cost_new;
+      if constexpr ( Profiler::has_virtual_evaluation )
+      {
+        cost_new = profiler_.evaluate_entry( database_, entry, loc_leaves, loc_times );
+      }
+      else
+      {
+        auto nnew = database_.write( entry, ntk_, loc_leaves );
+        cost_new = profiler_.evaluate( nnew, loc_leaves, win_manager_.get_pivot() );
+        ntk_.take_out_node( nnew );
+      }
       if ( cost_new < best_cost )
       {
         best_cost = cost_new;
         best_database_node = entry.index;
       }
-      ntk_.take_out_node( nnew );
     } );
     return std::make_tuple( best_database_node, best_cost );
   }
 
-  void substitute_node( node_t const& n, signal_t const& fnew )
+private:
+  void get_times( std::vector<double>& times, std::vector<signal> const& leaves )
+  {
+    assert( Profiler::has_arrival && "[e] The profiler does not have the arrival tracker" );
+    times.resize( leaves.size() );
+    std::transform( leaves.begin(), leaves.end(), times.begin(),
+                    [&]( auto const& f ) { return profiler_.get_arrival( f ); } );
+  }
+
+private:
+  Ntk& ntk_;
+  Params ps_;
+  resynthesis_stats& st_;
+  dependency::function_enumerator<Database::max_num_vars> enumerator_;
+  window_manager_t win_manager_;
+  windowing::window_simulator<Ntk, Params::window_manager_params::max_num_leaves> win_simulator_;
+  Profiler profiler_;
+  Database& database_;
+  decomposer_t decomposer_;
+  evaluation::chain_simulator<chain_t, func_t> chain_simulator_;
+  rewire_dependencies_t rewire_dependencies_;
+  struct_dependencies_t struct_dependencies_;
+  window_dependencies_t window_dependencies_;
+  /*! \brief Simulation-guided dependencies, constructed only if `try_simula` is set */
+  std::optional<simula_dependencies_t> simula_dependencies_;
+  std::vector<data_t> misses_;
+  /*! \brief Synthesis of the functions missing in the database, owned by `run` */
+  std::unique_ptr<synthesizer_t> synthesizer_;
+  scratch_t scratch_;
+};
+
+/*! \brief Resynthesis evaluating non-overlapping windows in batches.
+ *
+ * The pivots are processed in rounds. Each round collects a batch of pivots
+ * whose windows ( MFFC, TFO, divisors, inputs, and outputs ) do not share any
+ * node, so that their optimizations are independent. Windows overlapping the
+ * ones already in the batch are postponed to the next round. When the profiler
+ * is timing-driven, the windows reaching the transitive fanout of a pivot in
+ * the batch are postponed too, since committing the pivot changes their
+ * arrival times.
+ *
+ * The windows are built once on the network, and evaluated by a pool of
+ * threads. The first thread works on the network and on the database, while
+ * each other thread owns a copy of both. The tentative insertions of each
+ * evaluation are rolled back. The best candidates are then committed to the
+ * network in the batch order. A commit can reach nodes outside its window, by
+ * structural hashing or by taking out the nodes left without fanout: the
+ * windows of the batch containing these nodes are re-evaluated in the next
+ * round. The committed candidates are replayed on the copies, which are
+ * compared with the network on the modified nodes and copied again if they
+ * differ. The functions missing in the database and the counter-examples of
+ * the simulation-guided dependencies are shared in the batch order too.
+ *
+ * Every evaluation starts from the same state of the network, of the database,
+ * and of the simulation patterns, whatever the thread evaluating it. Hence,
+ * the result does not depend on the number of threads. The only exception is
+ * the background synthesis of the missing functions, whose chains are inserted
+ * as soon as they are available. The result is not the one of the sequential
+ * engine, which sees the commits of all the previous pivots.
+ */
+template<class Ntk, typename Database, typename Profiler, typename Params = default_resynthesis_params<RINOX_MAX_NUM_LEAVES>>
+class parallel_resynthesize_impl
+{
+  using node_index_t = typename Ntk::node;
+  using signal_t = typename Ntk::signal;
+  using worker_t = resynthesize_impl<Ntk, Database, Profiler, Params>;
+  using candidate_t = typename worker_t::candidate_t;
+  using pattern_t = typename worker_t::pattern_t;
+  using function_t = typename Database::truth_table_t;
+  using window_manager_t = windowing::window_manager<Ntk, typename Params::window_manager_params>;
+  using synthesizer_t = databases::database_synthesizer<Database>;
+
+  static constexpr uint32_t no_owner = std::numeric_limits<uint32_t>::max();
+
+public:
+  parallel_resynthesize_impl( Ntk& ntk, Database& database, Params const& ps, resynthesis_stats& st )
+      : ntk_( ntk ),
+        database_( database ),
+        ps_( ps ),
+        st_( st ),
+        database_st_( database.get_stats() ),
+        win_manager_( ntk, ps_.window_manager_ps, st.window_st ),
+        workers_st_( std::max( 1u, ps.num_threads ) ),
+        ntks_( workers_st_.size() ),
+        databases_( workers_st_.size() ),
+        workers_( workers_st_.size() )
+  {
+    workers_[0] = std::make_unique<worker_t>( ntk_, database_, ps_, workers_st_[0] );
+    workers_[0]->defer_patterns();
+    for ( auto t = 1u; t < workers_.size(); ++t )
+      resync( t );
+    if ( ps_.dynamic_database )
+      synthesizer_ = std::make_unique<synthesizer_t>( database.get_library().get_raw_gates(), ps_.synthesizer_ps, st.synthesizer_st );
+    register_events();
+    start_threads();
+  }
+
+  parallel_resynthesize_impl( parallel_resynthesize_impl const& ) = delete;
+  parallel_resynthesize_impl& operator=( parallel_resynthesize_impl const& ) = delete;
+
+  ~parallel_resynthesize_impl()
   {
-    auto const nnew = ntk_.get_node( fnew );
-    std::vector<signal_t> fs;
-    ntk_.foreach_output( nnew, [&]( auto f ) {
-      fs.push_back( f );
+    stop_threads();
+    release_events();
+  }
+
+  void run()
+  {
+    std::vector<node_index_t> pending;
+    auto const nmax = ntk_.size();
+    workers_[0]->foreach_pivot( [&]( auto n ) {
+      if ( n < nmax )
+        pending.push_back( n );
     } );
-    ntk_.substitute_node( n, fs );
+
+    std::vector<node_index_t> batch;
+    std::vector<node_index_t> deferred;
+    std::vector<std::optional<candidate_t>> results;
+    std::vector<std::vector<function_t>> misses;
+    std::vector<std::vector<pattern_t>> patterns;
+    std::vector<pattern_t> batch_patterns;
+    std::vector<candidate_t const*> committed;
+    std::vector<uint8_t> invalid;
+    std::vector<uint8_t> in_sync( workers_.size() );
+    while ( !pending.empty() )
+    {
+      collect_batch( pending, batch, deferred );
+      pending.swap( deferred );
+      if ( batch.empty() )
+        continue;
+
+      st_.num_batches++;
+      if ( synthesizer_ )
+        synthesizer_->flush( get_databases() );
+
+      /* evaluation of the windows, on the network for the first thread and on the copies for the others */
+      results.assign( batch.size(), std::nullopt );
+      misses.resize( batch.size() );
+      patterns.resize( batch.size() );
+      foreach_thread( [&]( uint32_t t ) {
+        auto const size = get_network( t ).size();
+        for ( auto i = t; i < batch.size(); i += workers_.size() )
+        {
+          results[i] = workers_[t]->optimize( windows_[i] );
+          misses[i] = workers_[t]->get_misses();
+          patterns[i] = workers_[t]->take_patterns();
+          workers_[t]->rollback( size );
+        }
+      } );
+
+      /* commit in the batch order, postponing the windows reached by a previous commit */
+      auto const size = ntk_.size();
+      dirty_.clear();
+      committed.clear();
+      invalid.assign( batch.size(), 0u );
+      for ( auto i = 0u; i < batch.size(); ++i )
+      {
+        if ( invalid[i] )
+        {
+          st_.num_conflicts++;
+          pending.push_back( batch[i] );
+          continue;
+        }
+        if ( !results[i] )
+          continue;
+
+        auto const begin = dirty_.size();
+        auto const fnew = commit_candidate<Params::do_strashing>( ntk_, *results[i] );
+        if ( !fnew )
+          continue;
+        collect_reused( *fnew, size );
+        for ( auto j = begin; j < dirty_.size(); ++j )
+        {
+          auto const owner = get_owner( dirty_[j] );
+          if ( owner != no_owner && owner > i )
+            invalid[owner] = 1u;
+        }
+        count_candidate( st_, *results[i] );
+        committed.push_back( &*results[i] );
+      }
+
+      /* lazy man's synthesis of the functions missing in the database */
+      if ( synthesizer_ )
+      {
+        auto const dbs = get_databases();
+        for ( auto const& funcs : misses )
+        {
+          for ( auto const& func : funcs )
+            synthesizer_->synthesize( func, dbs );
+        }
+      }
+
+      batch_patterns.clear();
+      for ( auto& window_patterns : patterns )
+        std::move( window_patterns.begin(), window_patterns.end(), std::back_inserter( batch_patterns ) );
+      history_.insert( history_.end(), batch_patterns.begin(), batch_patterns.end() );
+
+      /* replay on the copies, while the network is only read */
+      in_sync[0] = 1u;
+      foreach_thread( [&]( uint32_t t ) {
+        if ( t == 0u )
+          return;
+        for ( auto const* cand : committed )
+          commit_candidate<Params::do_strashing>( *ntks_[t], *cand );
+        in_sync[t] = is_in_sync( *ntks_[t], size );
+        if ( in_sync[t] )
+          workers_[t]->add_patterns( batch_patterns );
+      } );
+      workers_[0]->add_patterns( batch_patterns );
+      for ( auto t = 1u; t < workers_.size(); ++t )
+      {
+        if ( in_sync[t] )
+          continue;
+        st_.num_resyncs++;
+        resync( t );
+      }
+    }
+
+    merge_stats();
   }
 
 private:
-  /*! \brief Checks if the node should be analyzed for optimization or skipped */
-  bool skip_node( node const& n )
+  /*! \brief Select the pivots of the next round among the pending ones.
+   *
+   * Pivots that cannot be optimized are dropped, while the ones whose window
+   * overlaps a window in the batch are moved to `deferred`. The windows of the
+   * batch are kept in `windows_`, in the batch order.
+   */
+  void collect_batch( std::vector<node_index_t> const& pending, std::vector<node_index_t>& batch, std::vector<node_index_t>& deferred )
+  {
+    batch.clear();
+    deferred.clear();
+    stamps_.resize( ntk_.size(), 0u );
+    owners_.resize( ntk_.size(), no_owner );
+    if constexpr ( Profiler::timing_driven )
+      tfo_stamps_.resize( ntk_.size(), 0u );
+    ++stamp_;
+
+    uint32_t const max_batch_size = std::max( 1u, ps_.max_batch_size );
+    for ( auto const& n : pending )
+    {
+      if ( batch.size() >= max_batch_size )
+      {
+        deferred.push_back( n );
+        continue;
+      }
+      if ( skip_node( ntk_, n, ps_.fanout_limit ) || !win_manager_.run( n ) )
+        continue;
+
+      collect_footprint( n );
+      bool const conflict = std::any_of( footprint_.begin(), footprint_.end(), [&]( auto const& m ) {
+        if constexpr ( Profiler::timing_driven )
+        {
+          if ( tfo_stamps_[m] == stamp_ )
+            return true;
+        }
+        return stamps_[m] == stamp_;
+      } );
+      if ( conflict )
+      {
+        st_.num_conflicts++;
+        deferred.push_back( n );
+        continue;
+      }
+      for ( auto const& m : footprint_ )
+      {
+        stamps_[m] = stamp_;
+        owners_[m] = static_cast<uint32_t>( batch.size() );
+      }
+      if constexpr ( Profiler::timing_driven )
+        mark_tfo( n );
+      if ( windows_.size() <= batch.size() )
+        windows_.emplace_back();
+      windows_[batch.size()] = win_manager_.get_window();
+      batch.push_back( n );
+    }
+  }
+
+  /*! \brief Collect the nodes read or modified when optimizing the current window. */
+  void collect_footprint( node_index_t const& n )
   {
-    if ( ntk_.fanout_size( n ) > ps_.fanout_limit )
-      return true;
-    if ( ntk_.fanout_size( n ) <= 0 )
-      return true;
-    if ( ntk_.is_pi( n ) || ntk_.is_constant( n ) )
-      return true;
-    if ( ntk_.is_dead( n ) )
-      return true;
-    return false;
+    footprint_.clear();
+    footprint_.push_back( n );
+    win_manager_.foreach_mffc( [&]( auto const& m, auto i ) { footprint_.push_back( m ); } );
+    win_manager_.foreach_tfo( [&]( auto const& m, auto i ) { footprint_.push_back( m ); } );
+    win_manager_.foreach_divisor( [&]( auto const& f, auto i ) { footprint_.push_back( ntk_.get_node( f ) ); } );
+    win_manager_.foreach_input( [&]( auto const& f, auto i ) { footprint_.push_back( ntk_.get_node( f ) ); } );
+    win_manager_.foreach_output( [&]( auto const& f, auto i ) { footprint_.push_back( ntk_.get_node( f ) ); } );
+    ntk_.foreach_output( n, [&]( auto const& f ) {
+      ntk_.foreach_fanout( f, [&]( node_index_t const& m ) {
+        footprint_.push_back( m );
+      } );
+    } );
   }
 
-  /*! \brief Perform window analysis if required by any heuristic. Return false if failure */
-  void window_analysis( node const& n )
+  /*! \brief Mark the transitive fanout of a pivot, whose arrival times change when committing it. */
+  void mark_tfo( node_index_t const& n )
   {
-    win_manager_.run( n );
-    win_simulator_.run( win_manager_ );
+    stack_.assign( 1u, n );
+    while ( !stack_.empty() )
+    {
+      auto const m = stack_.back();
+      stack_.pop_back();
+      ntk_.foreach_output( m, [&]( auto const& f ) {
+        ntk_.foreach_fanout( f, [&]( node_index_t const& o ) {
+          if ( tfo_stamps_[o] == stamp_ )
+            return;
+          tfo_stamps_[o] = stamp_;
+          stack_.push_back( o );
+        } );
+      } );
+    }
   }
 
-  std::vector<double> get_times( std::vector<signal> const& leaves )
+  /*! \brief Index in the batch of the window containing a node, if any. */
+  uint32_t get_owner( node_index_t const& n ) const
   {
-    assert( Profiler::has_arrival && "[e] The profiler does not have the arrival tracker" );
-    std::vector<double> times( leaves.size() );
-    std::transform( leaves.begin(), leaves.end(), times.begin(),
-                    [&]( auto const& f ) { return profiler_.get_arrival( f ); } );
-    return times;
+    if ( n >= stamps_.size() || stamps_[n] != stamp_ )
+      return no_owner;
+    return owners_[n];
+  }
+
+  /*! \brief Mark as dirty the nodes existing before the batch reached by a committed signal.
+   *
+   * Besides the leaves of the candidate, these are the nodes found by
+   * structural hashing, which gain a fanout.
+   */
+  void collect_reused( signal_t const& f, node_index_t const& size )
+  {
+    ntk_.incr_trav_id();
+    stack_.assign( 1u, ntk_.get_node( f ) );
+    while ( !stack_.empty() )
+    {
+      auto const n = stack_.back();
+      stack_.pop_back();
+      if ( ntk_.visited( n ) == ntk_.trav_id() )
+        continue;
+      ntk_.set_visited( n, ntk_.trav_id() );
+      if ( n < size )
+      {
+        dirty_.push_back( n );
+        continue;
+      }
+      ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+        stack_.push_back( ntk_.get_node( fi ) );
+      } );
+    }
+  }
+
+  /*! \brief Check that a copy equals the network on the nodes modified by the batch. */
+  bool is_in_sync( Ntk const& copy, node_index_t const& size ) const
+  {
+    if ( copy.size() != ntk_.size() )
+      return false;
+
+    auto const same_node = [&]( node_index_t const& n ) {
+      if ( ntk_.is_dead( n ) || copy.is_dead( n ) )
+        return ntk_.is_dead( n ) == copy.is_dead( n );
+      if ( ntk_.fanout_size( n ) != copy.fanout_size( n ) || ntk_.get_binding_ids( n ) != copy.get_binding_ids( n ) )
+        return false;
+      auto const& children = ntk_.get_children( n );
+      auto const& copy_children = copy.get_children( n );
+      return std::equal( children.begin(), children.end(), copy_children.begin(), copy_children.end() );
+    };
+    for ( auto n = size; n < ntk_.size(); ++n )
+    {
+      if ( !same_node( n ) )
+        return false;
+    }
+    return std::all_of( dirty_.begin(), dirty_.end(), same_node );
+  }
+
+  /*! \brief Network on which a worker evaluates the windows. */
+  Ntk& get_network( uint32_t t )
+  {
+    return t == 0u ? ntk_ : *ntks_[t];
+  }
+
+  /*! \brief Replace the copies of a worker with copies of the network and of the database. */
+  void resync( uint32_t t )
+  {
+    if ( databases_[t] )
+      add_database_stats( st_, databases_[t]->get_stats() );
+    workers_[t].reset();
+    ntks_[t] = std::make_unique<Ntk>( ntk_.clone() );
+    databases_[t] = std::make_unique<Database>( database_.clone() );
+    workers_[t] = std::make_unique<worker_t>( *ntks_[t], *databases_[t], ps_, workers_st_[t] );
+    workers_[t]->defer_patterns();
+    workers_[t]->add_patterns( history_ );
+  }
+
+  std::vector<Database*> get_databases() const
+  {
+    std::vector<Database*> dbs{ &database_ };
+    for ( auto t = 1u; t < databases_.size(); ++t )
+      dbs.push_back( databases_[t].get() );
+    return dbs;
+  }
+
+  /*! \brief Record the nodes modified or deleted while committing to the network. */
+  void register_events()
+  {
+    delete_event_ = ntk_.events().register_delete_event( [this]( node_index_t const& n ) {
+      dirty_.push_back( n );
+      ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+        dirty_.push_back( ntk_.get_node( fi ) );
+      } );
+    } );
+    modified_event_ = ntk_.events().register_modified_event( [this]( node_index_t const& n, auto const& old_children ) {
+      dirty_.push_back( n );
+      for ( auto const& fi : old_children )
+        dirty_.push_back( ntk_.get_node( fi ) );
+    } );
+  }
+
+  void release_events()
+  {
+    if ( delete_event_ )
+      ntk_.events().release_delete_event( delete_event_ );
+    if ( modified_event_ )
+      ntk_.events().release_modified_event( modified_event_ );
+  }
+
+  void merge_stats()
+  {
+    for ( auto const& wst : workers_st_ )
+    {
+      st_.simulator_st.num_hits += wst.simulator_st.num_hits;
+      st_.simulator_st.num_partial_hits += wst.simulator_st.num_partial_hits;
+      st_.simulator_st.num_misses += wst.simulator_st.num_misses;
+      st_.simula_st.num_proposed += wst.simula_st.num_proposed;
+      st_.simula_st.num_validated += wst.simula_st.num_validated;
+      st_.simula_st.num_counterexamples += wst.simula_st.num_counterexamples;
+      st_.simula_st.num_unknown += wst.simula_st.num_unknown;
+      st_.simula_st.num_skipped += wst.simula_st.num_skipped;
+      st_.enumerator_st.num_functions += wst.enumerator_st.num_functions;
+      st_.enumerator_st.num_completions += wst.enumerator_st.num_completions;
+      st_.enumerator_st.num_capped += wst.enumerator_st.num_capped;
+      st_.enumerator_st.num_cutoffs += wst.enumerator_st.num_cutoffs;
+    }
+    add_database_stats( st_, database_.get_stats(), database_st_ );
+    for ( auto t = 1u; t < databases_.size(); ++t )
+      add_database_stats( st_, databases_[t]->get_stats() );
+  }
+
+#pragma region Thread pool
+  /*! \brief Start one thread per worker but the first one, which runs on the calling thread. */
+  void start_threads()
+  {
+    for ( auto t = 1u; t < workers_.size(); ++t )
+      threads_.emplace_back( [this, t]() { work( t ); } );
+  }
+
+  void stop_threads()
+  {
+    {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      stop_ = true;
+    }
+    start_.notify_all();
+    for ( auto& thread : threads_ )
+      thread.join();
+    threads_.clear();
+  }
+
+  /*! \brief Loop of a thread of the pool, running the job of each generation. */
+  void work( uint32_t t )
+  {
+    uint64_t generation = 0u;
+    std::unique_lock<std::mutex> lock( mutex_ );
+    while ( true )
+    {
+      start_.wait( lock, [&]() { return stop_ || generation_ != generation; } );
+      if ( stop_ )
+        return;
+      generation = generation_;
+      lock.unlock();
+      job_( t );
+      lock.lock();
+      if ( ++num_done_ == workers_.size() - 1u )
+        done_.notify_one();
+    }
+  }
+
+  /*! \brief Run a job on each worker, and wait for all of them. */
+  template<typename Fn>
+  void foreach_thread( Fn&& fn )
+  {
+    if ( threads_.empty() )
+    {
+      fn( 0u );
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      job_ = [&fn]( uint32_t t ) { fn( t ); };
+      num_done_ = 0u;
+      ++generation_;
+    }
+    start_.notify_all();
+    fn( 0u );
+    std::unique_lock<std::mutex> lock( mutex_ );
+    done_.wait( lock, [&]() { return num_done_ == workers_.size() - 1u; } );
   }
+#pragma endregion
 
 private:
   Ntk& ntk_;
-  dependency::function_enumerator<Database::max_num_vars> enumerator_;
-  window_manager_t win_manager_;
-  windowing::window_simulator<Ntk, Params::window_manager_params::max_num_leaves> win_simulator_;
-  Profiler profiler_;
   Database& database_;
-  decomposer_t decomposer_;
-  evaluation::chain_simulator<chain_t, func_t> chain_simulator_;
   Params ps_;
   resynthesis_stats& st_;
+  /*! \brief Statistics of the database before the run, whose lookups are also done by the first worker */
+  databases::mapped_database_stats database_st_;
+  window_manager_t win_manager_;
+  std::vector<resynthesis_stats> workers_st_;
+  /*! \brief Copies of the network and of the database, for the workers but the first one */
+  std::vector<std::unique_ptr<Ntk>> ntks_;
+  std::vector<std::unique_ptr<Database>> databases_;
+  std::vector<std::unique_ptr<worker_t>> workers_;
+  std::unique_ptr<synthesizer_t> synthesizer_;
+
+  /*! \brief Windows of the current batch */
+  std::vector<windowing::window_t<Ntk>> windows_;
+  std::vector<uint32_t> stamps_;
+  std::vector<uint32_t> owners_;
+  /*! \brief Nodes in the transitive fanout of the pivots in the batch, for timing-driven profilers */
+  std::vector<uint32_t> tfo_stamps_;
+  uint32_t stamp_ = 0u;
+  std::vector<node_index_t> footprint_;
+  std::vector<node_index_t> stack_;
+
+  /*! \brief Nodes modified, deleted, or reused by the commits of the current batch */
+  std::vector<node_index_t> dirty_;
+  /*! \brief Counter-examples shared so far, replayed on the copies made again */
+  std::vector<pattern_t> history_;
+
+  /* thread pool */
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  std::function<void( uint32_t )> job_;
+  uint64_t generation_{ 0 };
+  uint32_t num_done_{ 0 };
+  bool stop_{ false };
+
+  std::shared_ptr<typename mockturtle::network_events<typename Ntk::base_type>::modified_event_type> modified_event_;
+  std::shared_ptr<typename mockturtle::network_events<typename Ntk::base_type>::delete_event_type> delete_event_;
 };
 
+/*! \brief Optimize the pivots one at a time with one thread, and in batches otherwise.
+ *
+ * The two engines can return different networks, see `num_threads`.
+ */
+template<class Ntk, typename Database, typename Profiler, typename Params>
+void run_resynthesis( Ntk& ntk, Database& database, Params const& ps, resynthesis_stats& st )
+{
+  if ( ps.num_threads > 1u )
+  {
+    parallel_resynthesize_impl<Ntk, Database, Profiler, Params> p( ntk, database, ps, st );
+    p.run();
+  }
+  else
+  {
+    resynthesize_impl<Ntk, Database, Profiler, Params> p( ntk, database, ps, st );
+    p.run();
+  }
+}
+
+/*! \brief Renumber the network in topological order, keeping the levels of depth views up-to-date. */
+template<class Ntk>
+void compact_network( Ntk& ntk )
+{
+  ntk.compact();
+  if constexpr ( mockturtle::has_update_levels_v<Ntk> )
+    ntk.update_levels();
+}
+
 } /* namespace detail */
 
 template<class Ntk, class Database, typename Params = default_resynthesis_params<RINOX_MAX_NUM_LEAVES>>
@@ -477,8 +1379,9 @@ void area_resynthesize( Ntk& ntk, Database& database, Params ps = {}, resynthesi
   using WinMngr = windowing::window_manager<Ntk, typename Params::window_manager_params>;
   using Profiler = profilers::area_profiler<Ntk, WinMngr>;
   resynthesis_stats st;
-  detail::resynthesize_impl<Ntk, Database, Profiler, Params> p( ntk, database, ps, st );
-  p.run();
+  detail::run_resynthesis<Ntk, Database, Profiler, Params>( ntk, database, ps, st );
+  if ( ps.compact )
+    detail::compact_network( ntk );
   if ( pst != nullptr )
     *pst = st;
 }
@@ -489,8 +1392,9 @@ void delay_resynthesize( Ntk& ntk, Database& database, Params ps = {}, resynthes
   using WinMngr = windowing::window_manager<Ntk, typename Params::window_manager_params>;
   using Profiler = profilers::delay_profiler<Ntk, WinMngr>;
   resynthesis_stats st;
-  detail::resynthesize_impl<Ntk, Database, Profiler, Params> p( ntk, database, ps, st );
-  p.run();
+  detail::run_resynthesis<Ntk, Database, Profiler, Params>( ntk, database, ps, st );
+  if ( ps.compact )
+    detail::compact_network( ntk );
   if ( pst != nullptr )
     *pst = st;
 }
@@ -501,8 +1405,9 @@ void power_resynthesize( Ntk& ntk, Database& database, Params ps = {}, resynthes
   using WinMngr = windowing::window_manager<Ntk, typename Params::window_manager_params>;
   using Profiler = profilers::power_profiler<Ntk, WinMngr, Params::window_manager_params::max_num_leaves>;
   resynthesis_stats st;
-  detail::resynthesize_impl<Ntk, Database, Profiler, Params> p( ntk, database, ps, st );
-  p.run();
+  detail::run_resynthesis<Ntk, Database, Profiler, Params>( ntk, database, ps, st );
+  if ( ps.compact )
+    detail::compact_network( ntk );
   if ( pst != nullptr )
     *pst = st;
 }
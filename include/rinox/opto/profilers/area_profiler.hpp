@@ -36,6 +36,11 @@
 #include "../../databases/mapped_database.hpp"
 #include "profilers_utils.hpp"
 
+#include <algorithm>
+#include <bitset>
+#include <optional>
+#include <vector>
+
 namespace rinox
 {
 
@@ -56,6 +61,8 @@ public:
   static cost_t constexpr max_cost = std::numeric_limits<cost_t>::max();
   static bool constexpr pass_window = false;
   static bool constexpr has_arrival = true;
+  static bool constexpr has_virtual_evaluation = true;
+  static bool constexpr timing_driven = false;
 
   struct node_with_cost_t
   {
@@ -74,7 +81,9 @@ public:
   }
 
   void init()
-  {}
+  {
+    mffc_pivot_.reset();
+  }
 
   double get_arrival( signal_t const& f ) const
   {
@@ -95,13 +104,35 @@ public:
     return cost_deref;
   }
 
-  cost_t evaluate_rewiring( node_index_t const& n, std::vector<signal_t> const& new_children )
+  /*! \brief Cost of a database entry without inserting it in the network.
+   *
+   * The cost is the area added by the entry once committed: its gates found
+   * in the network by structural hashing are shared and cost nothing, unless
+   * they belong to the MFFC of the pivot, which is freed by the substitution.
+   */
+  template<class Database, class Entry>
+  cost_t evaluate_entry( Database& database, Entry const& entry, std::vector<signal_t> const& leaves, std::vector<double> const& times )
+  {
+    (void)times;
+    update_mffc( win_manager_.get_pivot(), leaves );
+    return database.get_area_after_sharing( entry, ntk_, leaves, [&]( node_index_t const& n ) {
+      return n >= mffc_stamps_.size() || mffc_stamps_[n] != mffc_stamp_;
+    } );
+  }
+
+  /*! \brief Gain of rewiring a node, where bit i of `inverted` adds an inverter on child i. */
+  cost_t evaluate_rewiring( node_index_t const& n, std::vector<signal_t> const& new_children, uint32_t inverted = 0u )
   {
     for ( auto const& f : new_children )
       ntk_.incr_fanout_size( ntk_.get_node( f ) );
 
     auto const& win_inputs = win_manager_.get_inputs();
-    auto const cost = evaluate( n, win_inputs ) - ntk_.get_area( n );
+    auto cost = evaluate( n, win_inputs ) - ntk_.get_area( n );
+    if ( inverted != 0u )
+    {
+      auto const& library = ntk_.get_augmented_library();
+      cost -= library.get_area( *library.get_inverter_id() ) * std::bitset<32>( inverted ).count();
+    }
 
     for ( auto const& f : new_children )
       ntk_.decr_fanout_size( ntk_.get_node( f ) );
@@ -247,6 +278,65 @@ private:
     return mffc_cost;
   }
 
+  /*! \brief Mark the MFFC of `n` bounded by the leaves, unless already marked for the same pivot and leaves.
+   *
+   * The entries of a database row share the pivot and the leaves, and the
+   * network is not modified while they are evaluated. Inserting nodes changes
+   * the size of the network, and `init` resets the marks for the next pivot.
+   */
+  void update_mffc( node_index_t const& n, std::vector<signal_t> const& leaves )
+  {
+    if ( mffc_pivot_ && *mffc_pivot_ == n && mffc_size_ == ntk_.size() && mffc_leaves_ == leaves )
+      return;
+    mffc_pivot_ = n;
+    mffc_size_ = ntk_.size();
+    mffc_leaves_ = leaves;
+    collect_mffc( n, leaves );
+    ++mffc_stamp_;
+    mffc_stamps_.resize( ntk_.size(), 0u );
+    for ( auto const& m : mffc_ )
+      mffc_stamps_[m] = mffc_stamp_;
+  }
+
+  /*! \brief Collect in `mffc_` the nodes of the MFFC of `n` bounded by the leaves. */
+  void collect_mffc( node_index_t const& n, std::vector<signal_t> const& leaves )
+  {
+    mffc_.clear();
+    if ( n >= ntk_.size() || ntk_.is_dead( n ) )
+      return;
+
+    for ( auto const& f : leaves )
+    {
+      if ( ntk_.get_node( f ) < ntk_.size() )
+        ntk_.incr_fanout_size( ntk_.get_node( f ) );
+    }
+
+    recursive_collect( n );
+    recursive_ref( n );
+
+    for ( auto const& f : leaves )
+    {
+      if ( ntk_.get_node( f ) < ntk_.size() )
+        ntk_.decr_fanout_size( ntk_.get_node( f ) );
+    }
+  }
+
+  void recursive_collect( node_index_t const& n )
+  {
+    /* terminate? */
+    if ( ntk_.is_constant( n ) || ntk_.is_pi( n ) )
+      return;
+
+    mffc_.push_back( n );
+    ntk_.foreach_fanin( n, [&]( auto const& fi ) {
+      node_index_t const ni = ntk_.get_node( fi );
+      if ( ntk_.decr_fanout_size( ni ) == 0 )
+      {
+        recursive_collect( ni );
+      }
+    } );
+  }
+
   void sort_nodes()
   {
     nodes_.resize( ntk_.size() );
@@ -262,6 +352,15 @@ private:
   std::vector<node_with_cost_t> nodes_;
   analyzers::trackers::arrival_times_tracker<Ntk> arrival_;
   WinMngr & win_manager_;
+  /*! \brief Nodes of the MFFC of the pivot, freed when the pivot is substituted */
+  std::vector<node_index_t> mffc_;
+  /*! \brief Nodes of `mffc_` are marked with the current stamp */
+  std::vector<uint32_t> mffc_stamps_;
+  uint32_t mffc_stamp_{ 0 };
+  /*! \brief Pivot, leaves, and size of the network for which `mffc_` was collected */
+  std::optional<node_index_t> mffc_pivot_;
+  std::vector<signal_t> mffc_leaves_;
+  node_index_t mffc_size_{ 0 };
 };
 
 } /* namespace profilers */
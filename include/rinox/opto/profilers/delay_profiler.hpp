@@ -57,6 +57,9 @@ public:
   static cost_t constexpr max_cost = std::numeric_limits<cost_t>::max();
   static bool constexpr pass_window = false;
   static bool constexpr has_arrival = true;
+  static bool constexpr has_virtual_evaluation = true;
+  /* the cost of a candidate depends on the arrival times at its leaves */
+  static bool constexpr timing_driven = true;
 
   struct node_with_cost_t
   {
@@ -97,8 +100,35 @@ public:
     return time;
   }
 
-  cost_t evaluate_rewiring( node_index_t const& n, std::vector<signal_t> const& new_children )
+  /*! \brief Cost of a database entry without inserting it in the network.
+   *
+   * The arrival time at the output of the entry is obtained from the arrival
+   * times at its pins and from the longest paths stored in the entry. Pins
+   * with infinite arrival time are not connected.
+   */
+  template<class Database, class Entry>
+  cost_t evaluate_entry( Database& database, Entry const& entry, std::vector<signal_t> const& leaves, std::vector<double> const& times ) const
   {
+    (void)database;
+    (void)leaves;
+    cost_t time = 0.0;
+    for ( auto i = 0u; i < entry.delays.size() && i < times.size(); ++i )
+    {
+      if ( times[i] < std::numeric_limits<double>::max() )
+        time = std::max( time, times[i] + entry.delays[i] );
+    }
+    return time;
+  }
+
+  /*! \brief Gain of rewiring a node, where bit i of `inverted` adds an inverter on child i. */
+  cost_t evaluate_rewiring( node_index_t const& n, std::vector<signal_t> const& new_children, uint32_t inverted = 0u )
+  {
+    double inverter_delay = 0.0;
+    if ( inverted != 0u )
+    {
+      auto const& library = ntk_.get_augmented_library();
+      inverter_delay = library.get_max_pin_delay( *library.get_inverter_id(), 0u );
+    }
     cost_t curr_cost = 0.0;
     ntk_.foreach_output( n, [&]( auto const& f ) {
       curr_cost = std::max( curr_cost, arrival_.get_time( f ) );
@@ -107,7 +137,8 @@ public:
     ntk_.foreach_output( n, [&]( auto const& f ) {
       ntk_.foreach_fanin( n, [&]( auto const& fi, auto ii ) {
         (void)fi;
-        cand_cost = std::max( cand_cost, arrival_.get_time( new_children[ii] ) + ntk_.get_max_pin_delay( f, ii ) );
+        double const extra = ( ( inverted >> ii ) & 1u ) ? inverter_delay : 0.0;
+        cand_cost = std::max( cand_cost, arrival_.get_time( new_children[ii] ) + extra + ntk_.get_max_pin_delay( f, ii ) );
       } );
     } );
 
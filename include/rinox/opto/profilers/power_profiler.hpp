@@ -60,6 +60,10 @@ public:
   static cost_t constexpr max_cost = std::numeric_limits<cost_t>::max();
   static bool constexpr pass_window = true;
   static bool constexpr has_arrival = true;
+  /* the activity of an entry depends on the window, hence it must be simulated */
+  static bool constexpr has_virtual_evaluation = false;
+  /* the cost of a candidate depends on the arrival times at its leaves */
+  static bool constexpr timing_driven = true;
   static constexpr uint32_t max_num_steps = 10u;
 
   struct node_with_cost_t
@@ -126,7 +130,8 @@ public:
     simulate_signal( f, children );
   }
 
-  void simulate_signal( signal_t const& f, std::vector<signal_t> const& fanin )
+  template<class Fanin>
+  void simulate_signal( signal_t const& f, Fanin const& fanin )
   {
     double const norm = static_cast<double>( workload_.num_bits() );
 
@@ -245,7 +250,12 @@ public:
     return cost_deref;
   }
 
-  cost_t evaluate_rewiring( node_index_t const& n, std::vector<signal_t> const& new_children )
+  /*! \brief Gain of rewiring a node, where bit i of `inverted` adds an inverter on child i.
+   *
+   * The inverter has the switching activity of its input, hence only the load
+   * of its input pin is added.
+   */
+  cost_t evaluate_rewiring( node_index_t const& n, std::vector<signal_t> const& new_children, uint32_t inverted = 0u )
   {
     double cost_curr = 0.0;
     ntk_.foreach_output( n, [&]( auto const& f ) {
@@ -267,6 +277,11 @@ public:
       auto const switching = activity_[signal_to_activity_[fi]].get_switching();
       auto const load = ntk_.get_input_load( ntk_.make_signal( n ), i );
       cost_cand += switching * load;
+      if ( ( inverted >> i ) & 1u )
+      {
+        auto const& library = ntk_.get_augmented_library();
+        cost_cand += switching * library.get_input_load( *library.get_inverter_id(), 0u );
+      }
     }
 
     ntk_.foreach_output( n, [&]( auto const& f ) {
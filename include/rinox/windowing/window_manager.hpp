@@ -66,6 +66,12 @@ struct default_window_manager_params
 struct window_manager_stats
 {
   bool valid = false;
+
+  /*! \brief Number of windows built. */
+  uint32_t num_windows{ 0 };
+
+  /*! \brief Number of windows exceeding the limits on divisors or inputs. */
+  uint32_t num_invalid{ 0 };
 };
 
 template<class Ntk, typename Params = default_window_manager_params>
@@ -182,6 +188,9 @@ public:
     st_.valid = true;
     st_.valid &= window_.divs.size() <= ps_.max_num_divisors;
     st_.valid &= window_.inputs.size() <= ps_.max_num_leaves;
+    st_.num_windows++;
+    if ( !st_.valid )
+      st_.num_invalid++;
     return st_.valid;
   }
 
@@ -225,11 +234,24 @@ public:
     return window_.pivot;
   }
 
-  window_t<Ntk> get_window() const
+  window_t<Ntk> const& get_window() const
   {
     return window_;
   }
 
+  /*! \brief Load a valid window built on a network with the same node indices.
+   *
+   * The window is not counted in the statistics, since it has already been
+   * built by another manager.
+   */
+  void load( window_t<Ntk> const& window )
+  {
+    init( window.pivot );
+    window_ = window;
+    mark_contained();
+    st_.valid = true;
+  }
+
 #pragma region Miscellanea
 private:
   void init( node_index_t const& n )
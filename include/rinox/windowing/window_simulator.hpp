@@ -41,14 +41,52 @@
 
 #pragma once
 
+#include "../network/network_events.hpp"
 #include "../network/signal_map.hpp"
 
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <fmt/format.h>
+#include <parallel_hashmap/phmap.h>
+
 namespace rinox
 {
 
 namespace windowing
 {
 
+struct window_simulator_stats
+{
+  /*! \brief Number of nodes whose simulation was reused from the previous window. */
+  uint64_t num_hits{ 0 };
+
+  /*! \brief Number of reused nodes whose window has different leaves than the previous one. */
+  uint64_t num_partial_hits{ 0 };
+
+  /*! \brief Number of nodes simulated. */
+  uint64_t num_misses{ 0 };
+
+  void report() const
+  {
+    std::cout << fmt::format( "[i] simulation hits  = {:8d}\n", num_hits );
+    std::cout << fmt::format( "    partial hits     = {:8d}\n", num_partial_hits );
+    std::cout << fmt::format( "    simulation miss  = {:8d}\n", num_misses );
+  }
+};
+
+/*! \brief Simulator of the windows of a network.
+ *
+ * Neighbouring windows often share most of their inputs. An input that was
+ * also an input of the previous window keeps its projection, and the new
+ * inputs take the free ones. A node simulated in the previous window is
+ * reused when the network did not modify, delete, or create it since, and
+ * when the simulations of all its fanins are reused as well. Only the nodes
+ * whose transitive fanin in the window changed are simulated again.
+ */
 template<class Ntk, uint32_t CubeSizeLeaves = 12>
 class window_simulator
 {
@@ -60,21 +98,51 @@ public:
 
 public:
   window_simulator( Ntk& ntk )
+      : window_simulator( ntk, own_st_ )
+  {}
+
+  window_simulator( Ntk& ntk, window_simulator_stats& st )
       : ntk_( ntk ),
-        sig_to_sim_( ntk )
+        sig_to_sim_( ntk ),
+        st_( st )
   {
     sims_.reserve( 1000u );
     init();
+    register_events();
+  }
+
+  window_simulator( window_simulator const& ) = delete;
+  window_simulator& operator=( window_simulator const& ) = delete;
+
+  ~window_simulator()
+  {
+    release_events();
   }
 
   template<typename WinMngr>
   void run( WinMngr const& window )
   {
+    /* the last window becomes the source of reusable simulations */
+    std::swap( sims_, prev_sims_ );
+    std::swap( index_, prev_index_ );
+    std::swap( leaves_, prev_leaves_ );
+    std::swap( leaves_mask_, prev_leaves_mask_ );
+    index_.clear();
+    hits_.clear();
+    if ( !valid_ )
+    {
+      prev_index_.clear();
+      prev_leaves_mask_ = 0u;
+    }
+    valid_ = true;
+
     sims_.reserve( window.size() );
     sims_.resize( CubeSizeLeaves );
+    init();
     sig_to_sim_.reset();
 
     assign_inputs( window );
+    same_leaves_ = ( leaves_mask_ == prev_leaves_mask_ ) && ( kept_mask_ == leaves_mask_ );
 
     window.foreach_divisor( [&]( auto const& f, auto i ) {
       auto const n = ntk_.get_node( f );
@@ -93,6 +161,7 @@ public:
     } );
 
     care_ = compute_observability_careset( window );
+    dirty_.clear();
   }
 
   signature_t const& get( signal_t const& f ) const
@@ -105,75 +174,96 @@ public:
     return care_;
   }
 
+  /*! \brief Patterns for which a change of the pivot is observable at the window outputs.
+   *
+   * Each non-empty subset of the pivot outputs is complemented, and the TFO is
+   * simulated on a copy of the simulations, so that no pass is needed to
+   * restore them. The enumeration stops as soon as every pattern is in the
+   * careset.
+   */
   template<typename WinMngr>
   signature_t const compute_observability_careset( WinMngr const& window )
   {
-
     signature_t care;
     auto n = window.get_pivot();
     auto const& outputs = window.get_outputs();
-    if ( ntk_.num_outputs( n ) == outputs.size() )
+    bool pivot_is_output = false;
+    for ( auto i = 0u; i < outputs.size(); ++i )
     {
-      bool no_odcs = true;
-      for ( auto i = 0u; i < outputs.size(); ++i )
-      {
-        no_odcs &= ( ntk_.get_node( outputs[i] ) == window.get_pivot() );
-      }
-      if ( no_odcs )
-      {
-        return ~care;
-      }
+      pivot_is_output |= ( ntk_.get_node( outputs[i] ) == n );
+    }
+    /* complementing an output of the window is always observable */
+    if ( pivot_is_output )
+    {
+      return ~care;
     }
 
-    std::vector<signature_t> old_sims;
-    window.foreach_output( [&]( auto fo, auto io ) {
-      (void)io;
-      old_sims.push_back( sims_[sig_to_sim_[fo]] );
-    } );
-
-    for ( uint32_t m = 1u; m < ( 1u << ntk_.num_outputs( n ) ); ++m )
+    odc_sims_ = sims_;
+    auto const num_masks = 1u << ntk_.num_outputs( n );
+    for ( uint32_t m = 1u; m < num_masks; ++m )
     {
       int i = 0;
       ntk_.foreach_output( n, [&]( auto const& f ) {
-        if ( ( ( m >> i ) & 0x1 ) > 0 )
-          sims_[sig_to_sim_[f]] = ~sims_[sig_to_sim_[f]];
+        auto const index = sig_to_sim_[f];
+        odc_sims_[index] = ( ( ( m >> i ) & 0x1 ) > 0 ) ? ~sims_[index] : sims_[index];
         i++;
       } );
       window.foreach_tfo( [&]( auto no, auto io ) {
-        re_compute( window, no );
+        (void)io;
+        if ( !window.is_input( no ) )
+          simulate_node( odc_sims_, no );
       } );
 
       window.foreach_output( [&]( auto fo, auto io ) {
-        re_compute( window, fo );
-        care |= ( old_sims[io] ^ sims_[sig_to_sim_[fo]] );
+        (void)io;
+        auto const index = sig_to_sim_[fo];
+        care |= ( sims_[index] ^ odc_sims_[index] );
       } );
 
-      ntk_.foreach_output( n, [&]( auto const& f ) {
-        sims_[sig_to_sim_[f]] = ~sims_[sig_to_sim_[f]];
-      } );
-      window.foreach_tfo( [&]( auto no, auto io ) {
-        re_compute( window, no );
-      } );
+      if ( kitty::is_const0( ~care ) )
+        break;
     }
 
     return care;
   }
 
+  window_simulator_stats const& get_stats() const
+  {
+    return st_;
+  }
+
   template<typename WinMngr>
   void compute( WinMngr const& window, node_index_t const& n )
   {
     if ( window.is_input( n ) )
       return;
 
-    std::vector<signature_t const*> sim_ptrs;
+    index_[n] = static_cast<uint32_t>( sims_.size() );
+    auto const it = prev_index_.find( n );
+    if ( it != prev_index_.end() && dirty_.count( n ) == 0u && has_reused_fanins( window, n ) )
+    {
+      ++st_.num_hits;
+      if ( !same_leaves_ )
+        ++st_.num_partial_hits;
+      hits_.insert( n );
+      uint32_t i = it->second;
+      ntk_.foreach_output( n, [&]( auto const& fo ) {
+        sig_to_sim_[fo] = sims_.size();
+        sims_.push_back( prev_sims_[i++] );
+      } );
+      return;
+    }
+    ++st_.num_misses;
+
+    std::array<signature_t const*, Ntk::max_fanin_size> sim_ptrs;
     ntk_.foreach_fanin( n, [&]( auto const& fi, auto ii ) {
-      sim_ptrs.push_back( &sims_[sig_to_sim_[fi]] );
+      sim_ptrs[ii] = &sims_[sig_to_sim_[fi]];
     } );
-    auto const tts = ntk_.compute( n, sim_ptrs );
-    uint32_t io = 0;
     ntk_.foreach_output( n, [&]( auto const& fo ) {
+      /* simulate before growing the storage, which can move the fanin simulations */
+      ntk_.compute( tmp_, fo, sim_ptrs.data() );
       sig_to_sim_[fo] = sims_.size();
-      sims_.push_back( tts[io++] );
+      sims_.push_back( tmp_ );
     } );
     return;
   }
@@ -184,14 +274,12 @@ public:
     if ( window.is_input( n ) )
       return;
 
-    std::vector<signature_t const*> sim_ptrs;
+    std::array<signature_t const*, Ntk::max_fanin_size> sim_ptrs;
     ntk_.foreach_fanin( n, [&]( auto const& fi, auto ii ) {
-      sim_ptrs.push_back( &sims_[sig_to_sim_[fi]] );
+      sim_ptrs[ii] = &sims_[sig_to_sim_[fi]];
     } );
-    auto const tts = ntk_.compute( n, sim_ptrs );
-    uint32_t io = 0;
     ntk_.foreach_output( n, [&]( auto const& fo ) {
-      sims_[sig_to_sim_[fo]] = tts[io++];
+      ntk_.compute( sims_[sig_to_sim_[fo]], fo, sim_ptrs.data() );
     } );
     return;
   }
@@ -202,16 +290,27 @@ public:
     if ( window.is_input( ntk_.get_node( f ) ) )
       return;
 
-    std::vector<signature_t const*> sim_ptrs;
+    std::array<signature_t const*, Ntk::max_fanin_size> sim_ptrs;
     ntk_.foreach_fanin( f, [&]( auto const& fi, auto ii ) {
-      sim_ptrs.push_back( &sims_[sig_to_sim_[fi]] );
+      sim_ptrs[ii] = &sims_[sig_to_sim_[fi]];
     } );
-    auto const tt = ntk_.compute( f, sim_ptrs );
-    sims_[sig_to_sim_[f]] = tt;
+    ntk_.compute( sims_[sig_to_sim_[f]], f, sim_ptrs.data() );
     return;
   }
 
 private:
+  /*! \brief Simulate the outputs of a node reading and writing the given simulations */
+  void simulate_node( std::vector<signature_t>& sims, node_index_t const& n )
+  {
+    std::array<signature_t const*, Ntk::max_fanin_size> sim_ptrs;
+    ntk_.foreach_fanin( n, [&]( auto const& fi, auto ii ) {
+      sim_ptrs[ii] = &sims[sig_to_sim_[fi]];
+    } );
+    ntk_.foreach_output( n, [&]( auto const& fo ) {
+      ntk_.compute( sims[sig_to_sim_[fo]], fo, sim_ptrs.data() );
+    } );
+  }
+
   void init()
   {
     sims_.resize( CubeSizeLeaves );
@@ -219,20 +318,128 @@ private:
       kitty::create_nth_var( sims_[i], i );
   }
 
+  /*! \brief True if the fanins of a node have the same simulations as in the previous window */
+  template<typename WinMngr>
+  bool has_reused_fanins( WinMngr const& window, node_index_t const& n ) const
+  {
+    bool reused = true;
+    ntk_.foreach_fanin( n, [&]( auto const& fi, auto ii ) {
+      (void)ii;
+      if ( !reused )
+        return;
+      auto const ni = ntk_.get_node( fi );
+      if ( window.is_input( ni ) )
+        reused = ( ( kept_mask_ >> sig_to_sim_[fi] ) & 0x1 ) > 0;
+      else
+        reused = hits_.count( ni ) > 0u;
+    } );
+    return reused;
+  }
+
+  void register_events()
+  {
+    /* the nodes in the transitive fanout of a dirty node miss through their fanins */
+    auto const invalidate = [this]( node_index_t const& n ) {
+      if ( index_.find( n ) != index_.end() )
+        dirty_.insert( n );
+    };
+    add_event_ = ntk_.events().register_add_event( invalidate );
+    delete_event_ = ntk_.events().register_delete_event( invalidate );
+    modified_event_ = ntk_.events().register_modified_event( [invalidate]( auto const& n, auto const& old_children ) {
+      (void)old_children;
+      invalidate( n );
+    } );
+    /* the simulated nodes of the previous window have new indices */
+    remap_event_ = ntk_.events().register_remap_event( [this]( auto const& old_to_new ) {
+      (void)old_to_new;
+      valid_ = false;
+    } );
+  }
+
+  void release_events()
+  {
+    if ( add_event_ )
+      ntk_.events().release_add_event( add_event_ );
+    if ( delete_event_ )
+      ntk_.events().release_delete_event( delete_event_ );
+    if ( modified_event_ )
+      ntk_.events().release_modified_event( modified_event_ );
+    if ( remap_event_ )
+      ntk_.events().release_remap_event( remap_event_ );
+  }
+
+  /*! \brief Assign a projection to each input, keeping the ones of the inputs of the previous window */
   template<typename WinMngr>
   void assign_inputs( WinMngr const& window )
   {
     sims_.resize( CubeSizeLeaves );
+    leaves_.resize( CubeSizeLeaves );
+    leaves_mask_ = 0u;
+    new_leaves_.clear();
     window.foreach_input( [&]( auto const& f, auto i ) {
-      sig_to_sim_[f] = i;
+      (void)i;
+      for ( auto v = 0u; v < CubeSizeLeaves; ++v )
+      {
+        if ( ( ( prev_leaves_mask_ >> v ) & 0x1 ) && ( prev_leaves_[v] == f ) )
+        {
+          leaves_[v] = f;
+          leaves_mask_ |= 1u << v;
+          sig_to_sim_[f] = v;
+          return;
+        }
+      }
+      new_leaves_.push_back( f );
     } );
+    kept_mask_ = leaves_mask_;
+
+    uint32_t v = 0u;
+    for ( auto const& f : new_leaves_ )
+    {
+      while ( ( leaves_mask_ >> v ) & 0x1 )
+        ++v;
+      leaves_[v] = f;
+      leaves_mask_ |= 1u << v;
+      sig_to_sim_[f] = v;
+    }
   }
 
 private:
   Ntk& ntk_;
+  window_simulator_stats own_st_;
   std::vector<signature_t> sims_;
   signature_t care_;
+  /*! \brief Output of the node being simulated */
+  signature_t tmp_;
+  /*! \brief Simulations with complemented pivot outputs */
+  std::vector<signature_t> odc_sims_;
   network::incomplete_signal_map<uint32_t, Ntk> sig_to_sim_;
+  window_simulator_stats& st_;
+
+  /*! \brief Index of the first output simulation of the nodes simulated in the current window */
+  phmap::flat_hash_map<node_index_t, uint32_t> index_;
+  /*! \brief Nodes of the current window whose simulation was reused */
+  phmap::flat_hash_set<node_index_t> hits_;
+  /*! \brief Nodes of the last window modified, deleted, or created by the network */
+  phmap::flat_hash_set<node_index_t> dirty_;
+  /*! \brief Input assigned to each projection, for the projections set in the mask */
+  std::vector<signal_t> leaves_;
+  uint32_t leaves_mask_ = 0u;
+  /*! \brief Projections whose input was also an input of the previous window */
+  uint32_t kept_mask_ = 0u;
+  std::vector<signal_t> new_leaves_;
+  /*! \brief Simulations of the previous window */
+  std::vector<signature_t> prev_sims_;
+  phmap::flat_hash_map<node_index_t, uint32_t> prev_index_;
+  std::vector<signal_t> prev_leaves_;
+  uint32_t prev_leaves_mask_ = 0u;
+  /*! \brief False if the network renumbered the nodes since the last window */
+  bool valid_ = false;
+  bool same_leaves_ = false;
+
+  std::shared_ptr<typename mockturtle::network_events<typename Ntk::base_type>::add_event_type> add_event_;
+  std::shared_ptr<typename mockturtle::network_events<typename Ntk::base_type>::modified_event_type> modified_event_;
+  std::shared_ptr<typename mockturtle::network_events<typename Ntk::base_type>::delete_event_type> delete_event_;
+  std::shared_ptr<typename network::network_events<typename Ntk::base_type>::remap_event_type> remap_event_;
 };
 
 } // namespace windowing
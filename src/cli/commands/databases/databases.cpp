@@ -6,36 +6,46 @@
 #include <rinox/databases/database_generator.hpp>
 #include <lorina/genlib.hpp>
 
-// Minimal build hook—replace with your actual builder.
+// The current database is replaced only if the generation succeeds.
 static bool build_database(CLIContext& ctx,
                            rinox::databases::database_gen_params ps)
 {
+  static constexpr rinox::network::design_type_t design_t = rinox::network::design_type_t::CELL_BASED;
   if ( ps.num_vars == 4u )
   {
-    static constexpr rinox::network::design_type_t design_t = rinox::network::design_type_t::CELL_BASED;
     rinox::databases::database_generator<design_t, 4u, 2u> db_gen( ctx.gates );
-    db_gen.run( ps );
+    if ( !db_gen.run( ps ) )
+      return false;
+    ctx.db4.emplace( db_gen.extract_db() );
     std::cout << "Generated database" << std::endl;
-    auto tmp = db_gen.extract_db();
+    return true;
+  }
+  else if ( ps.num_vars == 6u )
+  {
+    rinox::databases::database_generator<design_t, 6u, 2u> db_gen( ctx.gates );
+    if ( !db_gen.run( ps ) )
+      return false;
+    ctx.db6.emplace( db_gen.extract_db() );
     std::cout << "Generated database" << std::endl;
-    ctx.db4.emplace(std::move(tmp));  
-    std::cout << "Assigned database" << std::endl;
     return true;
   }
   else
   {
-    std::cerr << "Only num-vars = 4 for now.\n";
+    std::cerr << "Only num-vars 4 or 6 for now.\n";
     return false;
   }
 }
 
 static void print_make_db_usage() {
   std::cerr <<
-    "Usage: make_db --method <string> --num-vars <N> --metric <area|delay|power>\n"
+    "Usage: make_db --method <string> --num-vars <4|6> --metric <area|delay|power>\n"
+    "               [--cuts <file.aig>] [--threads <T>] [--shards <S>] [--shard <s>] [--output <prefix>]\n"
     "Examples:\n"
     "  make_db --method mapp --num-vars 4 --metric area\n"
     "  make_db --method mapp --num-vars 4 --metric delay\n"
     "  make_db --method mapp --num-vars 4 --metric power\n"
+    "  make_db --num-vars 6 --cuts bench.aig --shards 16 --threads 8\n"
+    "  make_db --num-vars 6 --cuts bench.aig --shards 16 --shard 3 --output db6\n"
     "Default:\n"
     "  make_db = (make_db --method mapp --num-vars 4 --metric area)\n";
 
@@ -72,8 +82,8 @@ static void cmd_make_database(CLIContext& ctx, const std::vector<std::string>& a
       if (!need_val("--num-vars")) return;
       try {
         long long v = std::stoll(args[++i]);
-        if (v < 1 || v > 64) { // adjust bounds as you like
-          std::cerr << "Error: --num-vars must be in [1, 64].\n";
+        if (v != 4 && v != 6) {
+          std::cerr << "Error: --num-vars must be 4 or 6.\n";
           return;
         }
         dbps.num_vars = static_cast<uint32_t>(v);
@@ -84,6 +94,30 @@ static void cmd_make_database(CLIContext& ctx, const std::vector<std::string>& a
     } else if (a == "--metric") {
       if (!need_val("--metric")) return;
       dbps.metric = args[++i];
+    } else if (a == "--cuts") {
+      if (!need_val("--cuts")) return;
+      dbps.cuts_file = args[++i];
+    } else if (a == "--output") {
+      if (!need_val("--output")) return;
+      dbps.output_file = args[++i];
+    } else if (a == "--threads" || a == "--shards" || a == "--shard") {
+      if (!need_val(a.c_str())) return;
+      try {
+        long long v = std::stoll(args[++i]);
+        if (v < 0 || v > 1 << 16) {
+          std::cerr << "Error: " << a << " out of range.\n";
+          return;
+        }
+        if (a == "--threads")
+          dbps.num_threads = static_cast<uint32_t>(v);
+        else if (a == "--shards")
+          dbps.num_shards = static_cast<uint32_t>(v);
+        else
+          dbps.shard = static_cast<int32_t>(v);
+      } catch (...) {
+        std::cerr << "Error: " << a << " expects an integer.\n";
+        return;
+      }
     } else if (a.rfind("--", 0) == 0) {
       std::cerr << "Warning: unknown option '" << a << "' (ignored).\n";
     } else {
@@ -102,30 +136,84 @@ static void cmd_make_database(CLIContext& ctx, const std::vector<std::string>& a
             << " metric=" << dbps.metric << "\n";
 }
 
+static bool is_binary_database(const std::string& file) {
+  static const std::string ext = ".rdb";
+  return file.size() >= ext.size() &&
+         file.compare(file.size() - ext.size(), ext.size(), ext) == 0;
+}
+
 static void cmd_dump_database(CLIContext& ctx, const std::vector<std::string>& args) {
   if (args.size() < 2) {
-    std::cerr << "Usage: dump_db <filename>.v\n";
+    std::cerr << "Usage: dump_db <filename>.v|<filename>.rdb\n";
     return;
   }
-  if ( !ctx.db4 )
+  if ( ctx.db4 )
+  {
+    if ( is_binary_database( args[1] ) )
+      (*(ctx.db4)).commit_binary( args[1] );
+    else
+      (*(ctx.db4)).commit( args[1] );
+  }
+  else if ( ctx.db6 )
+  {
+    if ( is_binary_database( args[1] ) )
+      (*(ctx.db6)).commit_binary( args[1] );
+    else
+      (*(ctx.db6)).commit( args[1] );
+  }
+  else
   {
     std::cerr << "No database generated\n";
-    return;
   }
-  (*(ctx.db4)).commit( args[1] );
 }
 
 static void cmd_read_database(CLIContext& ctx, const std::vector<std::string>& args) {
+  if (args.size() < 2 || !is_binary_database(args[1])) {
+    std::cerr << "Usage: read_db <filename>.rdb\n";
+    return;
+  }
+  if (ctx.gates.empty()) {
+    std::cerr << "Error: load a library first with `read_genlib <file.genlib>`.\n";
+    return;
+  }
+  rinox::libraries::augmented_library<CLIContext::CellType> lib( ctx.gates );
+  rinox::databases::mapped_database<CLIContext::CellNtk, 4> db( lib );
+  if ( !db.load_binary( args[1] ) )
+  {
+    std::cerr << "Error: database not loaded.\n";
+    return;
+  }
+  ctx.db4.emplace( std::move( db ) );
+  std::cout << "Database loaded: rows=" << ctx.db4->num_rows()
+            << " entries=" << ctx.db4->size() << "\n";
+}
+
+static void cmd_merge_database(CLIContext& ctx, const std::vector<std::string>& args) {
   if (args.size() < 2) {
-    std::cerr << "Usage: read_db <filename>.v\n";
+    std::cerr << "Usage: merge_db <shard0>.rdb [<shard1>.rdb ...]\n";
+    return;
+  }
+  if (ctx.gates.empty()) {
+    std::cerr << "Error: load a library first with `read_genlib <file.genlib>`.\n";
+    return;
+  }
+  static constexpr rinox::network::design_type_t design_t = rinox::network::design_type_t::CELL_BASED;
+  rinox::databases::database_generator<design_t, 6u, 2u> db_gen( ctx.gates );
+  if ( !db_gen.merge_shards( std::vector<std::string>( args.begin() + 1, args.end() ) ) )
+  {
+    std::cerr << "Error: shards not merged.\n";
     return;
   }
+  ctx.db6.emplace( db_gen.extract_db() );
+  std::cout << "Database merged: rows=" << ctx.db6->num_rows()
+            << " entries=" << ctx.db6->size() << "\n";
 }
 
 std::map<std::string, CommandHandler> register_db_commands() {
   return {
     {"make_db", cmd_make_database},
     {"dump_db", cmd_dump_database},
-    {"read_db", cmd_read_database}
+    {"read_db", cmd_read_database},
+    {"merge_db", cmd_merge_database}
   };
 }
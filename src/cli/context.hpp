@@ -13,4 +13,5 @@ struct CLIContext
   std::vector<mockturtle::gate> gates;
   std::optional<CellNtk> ntk;
   std::optional<rinox::databases::mapped_database<CellNtk, 4>> db4;
+  std::optional<rinox::databases::mapped_database<CellNtk, 6>> db6;
 };
\ No newline at end of file
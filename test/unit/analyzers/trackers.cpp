@@ -2,6 +2,7 @@
 // Tests for rinox boolean/simd_operations.hpp
 
 #include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <cstdint>
@@ -34,9 +35,11 @@ std::string const test_library = "GATE   inv1    1 O=!a;            PIN * INV 1
                                  "GATE   fa      6 C=a*b+a*c+b*c;   PIN * INV 1 999 2.1 0.4 2.1 0.4\n"
                                  "GATE   fa      6 S=a^b^c;         PIN * INV 1 999 3.0 0.4 3.0 0.4";
 
-TEST_CASE( "Topological sorting in Bound networks", "[topo_sort_tracker]" )
+TEMPLATE_TEST_CASE( "Topological sorting in Bound networks", "[topo_sort_tracker]",
+                    ( bound_network<design_type_t::CELL_BASED, 2> ),
+                    ( bound_network<design_type_t::CELL_BASED, 2, storage_layout_t::STRUCT_OF_ARRAYS> ) )
 {
-  using bound_network = bound_network<design_type_t::CELL_BASED, 2>;
+  using bound_network = TestType;
   using node = typename bound_network::node;
   std::vector<gate> gates;
 
@@ -75,9 +78,11 @@ TEST_CASE( "Topological sorting in Bound networks", "[topo_sort_tracker]" )
   // ntk.substitute_node( ntk.get_node( f1 ), signal{ f5.index, 1 } );
 }
 
-TEST_CASE( "Arrival times in Bound networks", "[arrival_tracker]" )
+TEMPLATE_TEST_CASE( "Arrival times in Bound networks", "[arrival_tracker]",
+                    ( bound_network<design_type_t::CELL_BASED, 2> ),
+                    ( bound_network<design_type_t::CELL_BASED, 2, storage_layout_t::STRUCT_OF_ARRAYS> ) )
 {
-  using bound_network = bound_network<design_type_t::CELL_BASED, 2>;
+  using bound_network = TestType;
   using signal = typename bound_network::signal;
   std::vector<gate> gates;
 
@@ -174,3 +179,117 @@ TEST_CASE( "Sensing times in Bound networks", "[sensing_tracker]" )
   CHECK( sensing.get_time( f2 ) == 3.9 );
   CHECK( sensing.get_time( f3 ) == 4.8 );
 }
+
+TEMPLATE_TEST_CASE( "Global simulation in Bound networks", "[simulation_tracker]",
+                    ( bound_network<design_type_t::CELL_BASED, 2> ),
+                    ( bound_network<design_type_t::CELL_BASED, 2, storage_layout_t::STRUCT_OF_ARRAYS> ) )
+{
+  using bound_network = TestType;
+  using signal = typename bound_network::signal;
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  bound_network ntk( gates );
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const f1 = ntk.create_node( { a }, 0 );
+  auto const f2 = ntk.create_node( { f1, b }, 2 );
+  auto const f3 = ntk.create_node( { f2, c }, 3 );
+  ntk.create_po( f3 );
+
+  simulation_tracker_params ps;
+  ps.num_bits = 100u;
+  simulation_tracker sim( ntk, ps );
+  CHECK( sim.num_blocks() == 2u );
+
+  auto const check = [&]( auto const& f, auto&& fn ) {
+    for ( auto i = 0u; i < ps.num_bits; ++i )
+      CHECK( sim.get_bit( f, i ) == fn( sim.get_bit( a, i ), sim.get_bit( b, i ), sim.get_bit( c, i ) ) );
+    /* the unused bits are zero */
+    CHECK( ( sim.blocks( f )[1] >> 36u ) == 0u );
+  };
+  check( f3, []( bool x, bool y, bool z ) { return !( !x && y ) && z; } );
+
+  /* check correctness of on_add update */
+  auto const f5 = ntk.create_node( { a, b, c }, { 12, 13 } );
+  check( signal{ f5.index, 0 }, []( bool x, bool y, bool z ) { return ( x && y ) || ( x && z ) || ( y && z ); } );
+  check( signal{ f5.index, 1 }, []( bool x, bool y, bool z ) { return x ^ y ^ z; } );
+
+  /* check correctness of on_modified update */
+  ntk.substitute_node( ntk.get_node( f1 ), signal{ f5.index, 1 } );
+  check( f3, []( bool x, bool y, bool z ) { return !( ( x ^ y ^ z ) && y ) && z; } );
+
+  /* check propagation of the input patterns */
+  for ( auto i = 0u; i < ps.num_bits; ++i )
+    sim.set_input_bit( ntk.get_node( c ), i, i % 3u == 0u );
+  sim.update();
+  check( f3, []( bool x, bool y, bool z ) { return !( ( x ^ y ^ z ) && y ) && z; } );
+
+  /* the parallel simulation matches the sequential one */
+  simulation_tracker_params pps = ps;
+  pps.num_threads = 4u;
+  pps.min_parallel_size = 0u;
+  simulation_tracker psim( ntk, pps );
+  for ( auto i = 0u; i < ps.num_bits; ++i )
+    psim.set_input_bit( ntk.get_node( c ), i, i % 3u == 0u );
+  psim.run();
+  ntk.foreach_node( [&]( auto const& n ) {
+    ntk.foreach_output( n, [&]( auto const& f ) {
+      CHECK( psim.get( f ) == sim.get( f ) );
+    } );
+  } );
+}
+
+TEMPLATE_TEST_CASE( "Global simulation after truncating the network", "[simulation_tracker]",
+                    ( bound_network<design_type_t::CELL_BASED, 2> ),
+                    ( bound_network<design_type_t::CELL_BASED, 2, storage_layout_t::STRUCT_OF_ARRAYS> ) )
+{
+  using bound_network = TestType;
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  bound_network ntk( gates );
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const f1 = ntk.create_node( { a, b }, 3 );
+  ntk.create_po( f1 );
+
+  simulation_tracker_params ps;
+  ps.num_bits = 100u;
+  simulation_tracker sim( ntk, ps );
+
+  auto const check = [&]( auto const& f, auto&& fn ) {
+    for ( auto i = 0u; i < ps.num_bits; ++i )
+      CHECK( sim.get_bit( f, i ) == fn( sim.get_bit( a, i ), sim.get_bit( b, i ), sim.get_bit( c, i ) ) );
+  };
+
+  /* tentative insertion, as in the evaluation of a candidate */
+  auto const size = ntk.size();
+  auto const g1 = ntk.create_node( { a, c }, 4 );
+  auto const g2 = ntk.create_node( { g1, b }, 3 );
+  check( g2, []( bool x, bool y, bool z ) { return ( x ^ z ) && y; } );
+
+  /* the deleted nodes are cleared */
+  ntk.take_out_node( ntk.get_node( g2 ) );
+  CHECK( ntk.is_dead( ntk.get_node( g1 ) ) );
+  CHECK( sim.blocks( g1 )[0] == 0u );
+  CHECK( sim.blocks( g1 )[1] == 0u );
+
+  /* rollback: the reused indices are simulated again */
+  ntk.truncate( size );
+  auto const h1 = ntk.create_node( { b, c }, 2 );
+  auto const h2 = ntk.create_node( { h1, a }, 4 );
+  CHECK( h1.index == g1.index );
+  CHECK( h2.index == g2.index );
+  check( h1, []( bool x, bool y, bool z ) { (void)x; return !( y && z ); } );
+  check( h2, []( bool x, bool y, bool z ) { return !( y && z ) ^ x; } );
+  check( f1, []( bool x, bool y, bool z ) { (void)z; return x && y; } );
+}
@@ -0,0 +1,209 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <kitty/kitty.hpp>
+#include <lorina/genlib.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <rinox/databases/database_generator.hpp>
+
+std::string const generator_library = "GATE   zero    0 O=CONST0;\n"
+                                      "GATE   one     0 O=CONST1;\n"
+                                      "GATE   inv1    1 O=!a;                      PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                                      "GATE   nand2   2 O=!(a*b);                  PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                                      "GATE   nor2    2 O=!(a+b);                  PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                                      "GATE   xor2    4 O=a^b;                     PIN * UNKNOWN 2 999 1.9 0.5 1.9 0.5\n";
+
+TEST_CASE( "Generating databases in shards", "[database_generator]" )
+{
+  using generator_t = rinox::databases::database_generator<rinox::network::design_type_t::CELL_BASED, 4u, 2u>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( generator_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::databases::database_gen_params ps;
+  ps.num_vars = 4u;
+  ps.metric = "area";
+  ps.num_threads = 2u;
+
+  ps.num_shards = 1u;
+  generator_t gen1( gates );
+  CHECK( gen1.run( ps ) );
+  auto const db1 = gen1.extract_db();
+
+  ps.num_shards = 2u;
+  generator_t gen2( gates );
+  CHECK( gen2.run( ps ) );
+  auto const db2 = gen2.extract_db();
+
+  /* the shards built one at a time, as on different machines */
+  ps.num_threads = 1u;
+  ps.shard = 0;
+  generator_t gen_s0( gates );
+  CHECK( gen_s0.run( ps ) );
+  auto db_s = gen_s0.extract_db();
+  ps.shard = 1;
+  generator_t gen_s1( gates );
+  CHECK( gen_s1.run( ps ) );
+  auto db_s1 = gen_s1.extract_db();
+  db_s.merge( db_s1 );
+
+  CHECK( db1.num_rows() > 0u );
+  CHECK( db2.num_rows() == db1.num_rows() );
+  CHECK( db2.size() == db1.size() );
+  CHECK( db_s.num_rows() == db1.num_rows() );
+  CHECK( db_s.size() == db1.size() );
+}
+
+TEST_CASE( "Rejecting invalid database generation parameters", "[database_generator]" )
+{
+  using generator_t = rinox::databases::database_generator<rinox::network::design_type_t::CELL_BASED, 6u, 2u>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( generator_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::databases::database_gen_params ps;
+  ps.num_vars = 4u;
+  ps.method = "exact";
+  generator_t gen1( gates );
+  CHECK( !gen1.run( ps ) );
+  CHECK( gen1.extract_db().size() == 0u );
+
+  ps.method = "mapp";
+  ps.metric = "speed";
+  generator_t gen2( gates );
+  CHECK( !gen2.run( ps ) );
+
+  ps.metric = "area";
+  ps.num_shards = 2u;
+  ps.shard = 2;
+  generator_t gen3( gates );
+  CHECK( !gen3.run( ps ) );
+
+  /* the 6-input classes are harvested from a benchmark */
+  ps.num_vars = 6u;
+  ps.num_shards = 1u;
+  ps.shard = -1;
+  generator_t gen4( gates );
+  CHECK( !gen4.run( ps ) );
+  CHECK( gen4.extract_db().size() == 0u );
+}
+
+TEST_CASE( "Generating 5-input databases from the cuts of a benchmark", "[database_generator]" )
+{
+  using generator_t = rinox::databases::database_generator<rinox::network::design_type_t::CELL_BASED, 6u, 2u>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( generator_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  mockturtle::aig_network aig;
+  auto const a = aig.create_pi();
+  auto const b = aig.create_pi();
+  auto const c = aig.create_pi();
+  auto const d = aig.create_pi();
+  auto const e = aig.create_pi();
+  auto const x = aig.create_xor( aig.create_xor( a, b ), aig.create_and( c, d ) );
+  aig.create_po( aig.create_or( x, e ) );
+  aig.create_po( aig.create_maj( a, aig.create_and( b, e ), aig.create_xor( c, d ) ) );
+
+  rinox::databases::database_gen_params ps;
+  ps.num_vars = 5u;
+  ps.num_shards = 2u;
+  ps.num_threads = 2u;
+  ps.output_file = "rinox_database_generator_test";
+
+  generator_t gen( gates );
+  auto const classes = gen.load_classes( aig, ps );
+  REQUIRE( classes );
+  REQUIRE( !classes->empty() );
+  for ( auto const& tt : *classes )
+  {
+    REQUIRE( tt.num_vars() == 5u );
+    for ( auto i = 0u; i < 5u; ++i )
+      CHECK( kitty::has_var( tt, i ) );
+    CHECK( kitty::equal( std::get<0>( kitty::exact_p_canonization( tt ) ), tt ) );
+  }
+
+  gen.sharded_generation( *classes, ps );
+  auto const db = gen.extract_db();
+  CHECK( db.num_rows() > 0u );
+
+  /* the shards saved on disk merge back into the same database */
+  std::vector<std::string> const files{ generator_t::shard_file( ps.output_file, 0u ), generator_t::shard_file( ps.output_file, 1u ) };
+  generator_t merged_gen( gates );
+  CHECK( merged_gen.merge_shards( files ) );
+  auto const merged = merged_gen.extract_db();
+  CHECK( merged.num_rows() == db.num_rows() );
+  CHECK( merged.size() == db.size() );
+
+  for ( auto const& file : files )
+    std::remove( file.c_str() );
+}
+
+std::string const tradeoff_library = "GATE   zero    0 O=CONST0;\n"
+                                     "GATE   one     0 O=CONST1;\n"
+                                     "GATE   inv1    1 O=!a;                      PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
+                                     "GATE   nand2   2 O=!(a*b);                  PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                                     "GATE   nor2    2 O=!(a+b);                  PIN * INV 1 999 1.0 0.2 1.0 0.2\n"
+                                     "GATE   xor2    3 O=a^b;                     PIN * UNKNOWN 2 999 4.0 0.5 4.0 0.5\n"
+                                     "GATE   maj3    3 O=(a*b)+(a*c)+(b*c);       PIN * NONINV 1 999 5.0 0.5 5.0 0.5\n";
+
+TEST_CASE( "Generating delay-oriented databases", "[database_generator]" )
+{
+  using generator_t = rinox::databases::database_generator<rinox::network::design_type_t::CELL_BASED, 4u, 2u>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( tradeoff_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::databases::database_gen_params ps;
+  ps.num_vars = 4u;
+  ps.num_shards = 2u;
+
+  ps.metric = "area";
+  generator_t area_gen( gates );
+  CHECK( area_gen.run( ps ) );
+  auto area_db = area_gen.extract_db();
+
+  ps.metric = "delay";
+  generator_t delay_gen( gates );
+  CHECK( delay_gen.run( ps ) );
+  auto delay_db = delay_gen.extract_db();
+
+  /* the classes are processed in the same order, hence the rows match */
+  CHECK( delay_db.num_rows() == area_db.num_rows() );
+
+  auto const best_delay = []( auto& db, uint64_t row ) {
+    double best = std::numeric_limits<double>::max();
+    db.foreach_entry( row, [&]( auto const& entry ) {
+      double const delay = entry.delays.empty() ? 0.0 : *std::max_element( entry.delays.begin(), entry.delays.end() );
+      best = std::min( best, delay );
+    } );
+    return best;
+  };
+
+  /* the delay-oriented mappings add entries that are strictly faster */
+  uint32_t num_faster = 0u;
+  for ( auto r = 0u; r < area_db.num_rows(); ++r )
+  {
+    double const area_delay = best_delay( area_db, r );
+    double const delay_delay = best_delay( delay_db, r );
+    CHECK( delay_delay <= area_delay );
+    num_faster += delay_delay < area_delay ? 1u : 0u;
+  }
+  CHECK( num_faster > 0u );
+}
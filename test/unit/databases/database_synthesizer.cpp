@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <kitty/kitty.hpp>
+#include <lorina/genlib.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <rinox/databases/database_synthesizer.hpp>
+#include <rinox/databases/mapped_database.hpp>
+#include <rinox/network/network.hpp>
+
+std::string const synthesizer_library = "GATE   zero    0 O=CONST0;\n"
+                                        "GATE   one     0 O=CONST1;\n"
+                                        "GATE   inv1    1 O=!a;                      PIN * INV 1 999 1.0 0.0 1.0 0.0\n"
+                                        "GATE   nand2   2 O=!(a*b);                  PIN * INV 1 999 1.0 0.0 1.0 0.0\n"
+                                        "GATE   and2    3 O=a*b;                     PIN * NONINV 1 999 1.0 0.0 1.0 0.0\n"
+                                        "GATE   xor2    4 O=a^b;                     PIN * UNKNOWN 1 999 1.0 0.0 1.0 0.0\n";
+
+TEST_CASE( "Synthesize the functions missing in a mapped database", "[database_synthesizer]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  static constexpr uint32_t MaxNumVars = 3u;
+  using database_t = rinox::databases::mapped_database<bound_network, MaxNumVars>;
+  using TT = kitty::static_truth_table<MaxNumVars>;
+
+  std::vector<mockturtle::gate> gates;
+  std::istringstream in( synthesizer_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+  database_t db( lib );
+
+  std::vector<TT> xs( MaxNumVars );
+  for ( auto i = 0u; i < MaxNumVars; ++i )
+    kitty::create_nth_var( xs[i], i );
+  TT const func = ( xs[0] & xs[1] ) ^ xs[2];
+
+  std::vector<double> times{ 0, 0, 0 };
+  CHECK( !db.boolean_matching( func, times ) );
+
+  rinox::databases::database_synthesizer_stats st;
+  rinox::databases::database_synthesizer<database_t> synthesizer( gates, {}, st );
+  CHECK( synthesizer.synthesize( func, db ) );
+  CHECK( db.boolean_matching( func, times ) );
+
+  /* the P-class is memoized: permuting the inputs does not trigger a new synthesis */
+  TT const perm_func = ( xs[2] & xs[1] ) ^ xs[0];
+  CHECK( !synthesizer.synthesize( perm_func, db ) );
+  CHECK( st.num_misses == 2u );
+  CHECK( st.num_repeated == 1u );
+  CHECK( st.num_synthesized == 1u );
+}
+
+TEST_CASE( "Synthesize the functions missing in a mapped database in background", "[database_synthesizer]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  static constexpr uint32_t MaxNumVars = 3u;
+  using database_t = rinox::databases::mapped_database<bound_network, MaxNumVars>;
+  using TT = kitty::static_truth_table<MaxNumVars>;
+
+  std::vector<mockturtle::gate> gates;
+  std::istringstream in( synthesizer_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+  database_t db( lib );
+
+  std::vector<TT> xs( MaxNumVars );
+  for ( auto i = 0u; i < MaxNumVars; ++i )
+    kitty::create_nth_var( xs[i], i );
+  TT const func = ( xs[0] | xs[1] ) & xs[2];
+
+  rinox::databases::database_synthesizer_params ps;
+  ps.background = true;
+  rinox::databases::database_synthesizer_stats st;
+  {
+    rinox::databases::database_synthesizer<database_t> synthesizer( gates, ps, st );
+    CHECK( !synthesizer.synthesize( func, db ) );
+
+    /* the counts of the background thread are only visible after a flush */
+    bool flushed = false;
+    for ( auto i = 0u; i < 1000u && !flushed; ++i )
+    {
+      flushed = synthesizer.flush( db );
+      if ( !flushed )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+    REQUIRE( flushed );
+    CHECK( st.num_synthesized == 1u );
+    CHECK( st.num_failed == 0u );
+
+    std::vector<double> times{ 0, 0, 0 };
+    CHECK( db.boolean_matching( func, times ) );
+  }
+  CHECK( st.num_misses == 1u );
+  CHECK( st.num_synthesized == 1u );
+}
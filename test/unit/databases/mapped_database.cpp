@@ -1,6 +1,8 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <sstream>
 #include <vector>
@@ -377,6 +379,39 @@ TEST_CASE( "Inserting two nodes chain in database", "[mapped_database]" )
   }
 }
 
+TEST_CASE( "Canonizations of the functions inserted in mapped databases", "[mapped_database]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<gate> gates;
+
+  std::istringstream in( symmetric_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+
+  static constexpr uint32_t MaxNumVars = 4u;
+  rinox::databases::mapped_database<bound_network, MaxNumVars> db( lib );
+  rinox::evaluation::chains::bound_chain<rinox::network::design_type_t::CELL_BASED> chain1, chain2;
+  chain1.add_inputs( MaxNumVars );
+  chain1.add_output( chain1.add_gate( { 0, 1 }, 1 ) );
+  chain2.add_inputs( MaxNumVars );
+  chain2.add_output( chain2.add_gate( { 1, 0 }, 1 ) );
+
+  /* a new function is canonized once, and the following insertions hit the cache */
+  CHECK( db.add( chain1 ) );
+  CHECK( db.get_stats().num_lookups == 1u );
+  CHECK( db.get_stats().num_canonizations == 1u );
+  CHECK( !db.add( chain2 ) );
+  CHECK( db.get_stats().num_lookups == 2u );
+  CHECK( db.get_stats().num_hits == 1u );
+  CHECK( db.get_stats().num_canonizations == 1u );
+
+  /* the copies of the database count their own lookups */
+  auto copy = db.clone();
+  CHECK( copy.get_stats().num_lookups == 0u );
+}
+
 TEST_CASE( "Dominant and dominated chains in mapped database", "[mapped_database]" )
 {
   using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
@@ -419,6 +454,48 @@ TEST_CASE( "Dominant and dominated chains in mapped database", "[mapped_database
   CHECK( db.size() == 1 );
 }
 
+TEST_CASE( "Merging mapped databases", "[mapped_database]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  using chain_t = rinox::evaluation::chains::bound_chain<rinox::network::design_type_t::CELL_BASED>;
+  std::vector<gate> gates;
+
+  std::istringstream in( symmetric_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+
+  static constexpr uint32_t MaxNumVars = 6u;
+  rinox::databases::mapped_database<bound_network, MaxNumVars> db1( lib );
+  rinox::databases::mapped_database<bound_network, MaxNumVars> db2( lib );
+
+  /* majority of inputs 0, 1, 5, and a dominating implementation of it */
+  chain_t chain1, chain2, chain3;
+  chain1.add_inputs( MaxNumVars );
+  chain2.add_inputs( MaxNumVars );
+  chain3.add_inputs( MaxNumVars );
+  auto const l1_1 = chain1.add_gate( { 1 }, 0 );
+  auto const l1_2 = chain1.add_gate( { 5 }, 0 );
+  auto const l1_3 = chain1.add_gate( { l1_1, 5 }, 1 );
+  auto const l1_4 = chain1.add_gate( { l1_2, 1 }, 1 );
+  auto const l1_5 = chain1.add_gate( { l1_3, l1_4 }, 6 );
+  chain1.add_output( l1_5 );
+  chain2.add_output( chain2.add_gate( { 4, 0 }, 6 ) );
+  chain3.add_output( chain3.add_gate( { 2, 3 }, 1 ) );
+
+  CHECK( db1.add( chain1 ) );
+  CHECK( db2.add( chain2 ) );
+  CHECK( db2.add( chain3 ) );
+
+  /* the entry of db1 is dominated by the one of db2 */
+  CHECK( db1.merge( db2 ) == 2u );
+  CHECK( db1.num_rows() == 2u );
+  CHECK( db1.size() == 2u );
+  CHECK( db1.merge( db2 ) == 0u );
+  CHECK( db1.size() == 2u );
+}
+
 TEST_CASE( "Saving a mapped database", "[mapped_database]" )
 {
   using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
@@ -615,4 +692,185 @@ TEST_CASE( "Database look-up with 3-input completely specified function", "[mapp
   } );
 
   CHECK( arrival.worst_delay() == 70 );
-}
\ No newline at end of file
+}
+TEST_CASE( "Saving and loading mapped databases in binary format", "[mapped_database]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<gate> gates;
+
+  std::istringstream in( symmetric_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+
+  static constexpr uint32_t MaxNumVars = 4u;
+  rinox::databases::mapped_database<bound_network, MaxNumVars> db( lib );
+
+  rinox::evaluation::chains::bound_chain<rinox::network::design_type_t::CELL_BASED> chain1, chain2;
+  chain1.add_inputs( MaxNumVars );
+  auto const l0 = chain1.add_gate( { 0, 1 }, 1 );
+  chain1.add_output( chain1.add_gate( { l0, 2, 3 }, 3 ) );
+  chain2.add_inputs( MaxNumVars );
+  chain2.add_output( chain2.add_gate( { 2, 3 }, 6 ) );
+  CHECK( db.add( chain1 ) );
+  CHECK( db.add( chain2 ) );
+
+  std::ostringstream os;
+  db.commit_binary( os );
+  std::string const data = os.str();
+
+  rinox::databases::mapped_database<bound_network, MaxNumVars> loaded( lib );
+  CHECK( loaded.load_binary( data.data(), data.size() ) );
+  CHECK( loaded.num_rows() == db.num_rows() );
+  CHECK( loaded.size() == db.size() );
+
+  /* the loaded database matches the same functions with the same entries */
+  rinox::evaluation::chains::bound_chain<rinox::network::design_type_t::CELL_BASED> chain3;
+  chain3.add_inputs( MaxNumVars );
+  chain3.add_output( chain3.add_gate( { 1, 0 }, 6 ) );
+  rinox::evaluation::chain_simulator<decltype( chain3 ), kitty::static_truth_table<MaxNumVars>> sim( lib );
+  std::array<kitty::static_truth_table<MaxNumVars>, MaxNumVars> projs;
+  std::vector<kitty::static_truth_table<MaxNumVars> const*> ptrs;
+  for ( auto i = 0u; i < MaxNumVars; ++i )
+  {
+    kitty::create_nth_var( projs[i], i );
+    ptrs.push_back( &projs[i] );
+  }
+  sim( chain3, ptrs );
+  auto const tt = sim.get_simulation( chain3, ptrs, chain3.po_at( 0 ) );
+  std::vector<double> times0( MaxNumVars, 0.0 ), times1( MaxNumVars, 0.0 );
+  auto const row0 = db.boolean_matching( tt, times0 );
+  auto const row1 = loaded.boolean_matching( tt, times1 );
+  CHECK( row0 );
+  CHECK( row1 );
+  CHECK( *row0 == *row1 );
+  std::vector<double> areas0, areas1;
+  db.foreach_entry( *row0, [&]( auto const& entry ) { areas0.push_back( entry.area ); } );
+  loaded.foreach_entry( *row1, [&]( auto const& entry ) { areas1.push_back( entry.area ); } );
+  CHECK( areas0 == areas1 );
+
+  /* adding a dominated implementation is still rejected after loading */
+  CHECK( !loaded.add( chain3 ) );
+
+  /* databases built with a different library are rejected */
+  std::vector<gate> other_gates;
+  std::istringstream in_other( test_library );
+  CHECK( lorina::read_genlib( in_other, genlib_reader( other_gates ) ) == lorina::return_code::success );
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> other_lib( other_gates );
+  rinox::databases::mapped_database<bound_network, MaxNumVars> other( other_lib );
+  CHECK( !other.load_binary( data.data(), data.size() ) );
+  CHECK( !loaded.load_binary( data.data(), data.size() / 2 ) );
+  CHECK( loaded.num_rows() == db.num_rows() );
+
+  /* the buffer does not need to be aligned */
+  std::vector<char> misaligned( data.size() + 1u );
+  std::copy( data.begin(), data.end(), misaligned.begin() + 1 );
+  rinox::databases::mapped_database<bound_network, MaxNumVars> unaligned( lib );
+  CHECK( unaligned.load_binary( misaligned.data() + 1, data.size() ) );
+  CHECK( unaligned.num_rows() == db.num_rows() );
+  CHECK( unaligned.size() == db.size() );
+
+  /* out-of-range codes are rejected */
+  std::string corrupted = data;
+  std::fill( corrupted.begin() + corrupted.size() / 2, corrupted.end(), static_cast<char>( 0xff ) );
+  rinox::databases::mapped_database<bound_network, MaxNumVars> broken( lib );
+  CHECK( !broken.load_binary( corrupted.data(), corrupted.size() ) );
+  CHECK( broken.num_rows() == 0u );
+}
+
+TEST_CASE( "Database look-up with incompletely specified functions", "[mapped_database]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  using signal = typename bound_network::signal;
+  using chain_t = rinox::evaluation::chains::bound_chain<rinox::network::design_type_t::CELL_BASED>;
+  std::vector<gate> gates;
+
+  std::istringstream in( symmetric_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+
+  static constexpr uint32_t MaxNumVars = 3u;
+  rinox::databases::mapped_database<bound_network, MaxNumVars> db( lib );
+
+  chain_t and_inv;
+  and_inv.add_inputs( MaxNumVars );
+  and_inv.add_output( and_inv.add_gate( { and_inv.add_gate( { 0 }, 0 ), 1 }, 1 ) );
+  CHECK( db.add( and_inv ) );
+  chain_t and2;
+  and2.add_inputs( MaxNumVars );
+  and2.add_output( and2.add_gate( { 0, 1 }, 1 ) );
+  CHECK( db.add( and2 ) );
+  chain_t maj3;
+  maj3.add_inputs( MaxNumVars );
+  maj3.add_output( maj3.add_gate( { 0, 1, 2 }, 2 ) );
+  CHECK( db.add( maj3 ) );
+
+  using TT = kitty::static_truth_table<MaxNumVars>;
+
+  bound_network ntk( gates );
+  std::array<TT, MaxNumVars> xs;
+  std::vector<signal> fs;
+  std::vector<TT const*> sim_ptrs;
+  for ( auto i = 0u; i < MaxNumVars; ++i )
+  {
+    kitty::create_nth_var( xs[i], i );
+    sim_ptrs.push_back( &xs[i] );
+    fs.push_back( ntk.create_pi() );
+  }
+  rinox::evaluation::chain_simulator<chain_t, TT> sim( lib );
+
+  /* functions of the first two variables, independent of the third one */
+  auto const expand = []( uint32_t bits ) {
+    TT tt;
+    for ( auto m = 0u; m < ( 1u << MaxNumVars ); ++m )
+    {
+      if ( ( bits >> ( m & 3u ) ) & 1u )
+        kitty::set_bit( tt, m );
+    }
+    return tt;
+  };
+
+  for ( auto care = 0u; care < 16u; ++care )
+  {
+    for ( auto on = 0u; on < 16u; ++on )
+    {
+      if ( ( on & ~care ) != 0u )
+        continue;
+      kitty::ternary_truth_table<TT> itt( expand( on ), expand( care ) );
+
+      /* expected: the completions with a row in the database */
+      uint32_t num_expected = 0u;
+      for ( auto dc = 0u; dc < 16u; ++dc )
+      {
+        if ( ( dc & care ) != 0u )
+          continue;
+        std::vector<double> times{ 0, 0 };
+        if ( db.boolean_matching( expand( on | dc ), times ) )
+          ++num_expected;
+      }
+
+      uint32_t num_matches = 0u;
+      db.foreach_compatible_row( itt, 2u, [&]( uint64_t row, auto const& perm ) {
+        ++num_matches;
+        auto fs_c = fs;
+        std::vector<double> times{ 0, 0, 0 };
+        fs_c.resize( 2u );
+        times.resize( 2u );
+        db.match_inputs( row, perm, times, fs_c );
+        db.foreach_entry( row, [&]( auto const& entry ) {
+          auto const n = db.write( entry, ntk, fs_c );
+          chain_t chain_res( MaxNumVars );
+          rinox::evaluation::chains::extract( chain_res, ntk, fs, ntk.make_signal( n ) );
+          sim( chain_res, sim_ptrs );
+          auto const res = sim.get_simulation( chain_res, sim_ptrs, chain_res.po_at( 0 ) );
+          CHECK( kitty::is_const0( ( res ^ itt._bits ) & itt._care ) );
+        } );
+      } );
+      CHECK( num_matches == num_expected );
+    }
+  }
+  CHECK( db.get_stats().num_dc_lookups > 0 );
+}
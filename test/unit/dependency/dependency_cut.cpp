@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <kitty/kitty.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#include <rinox/dependency/dependency_cut.hpp>
+
+#include <vector>
+
+TEST_CASE( "Enumerate the completions of an incompletely specified function", "[dependency_cut]" )
+{
+  static constexpr uint32_t NumVars = 4u;
+  using TT = kitty::static_truth_table<NumVars>;
+
+  /* function of the first 3 variables, with 3 don't care minterms */
+  std::vector<TT> xs( NumVars );
+  for ( auto i = 0u; i < NumVars; ++i )
+    kitty::create_nth_var( xs[i], i );
+  TT const onset = xs[0] & xs[1];
+  TT const dcset = ( ~xs[0] & ~xs[1] & ~xs[2] ) | ( xs[0] & ~xs[1] & xs[2] ) | ( ~xs[0] & xs[1] & xs[2] );
+  kitty::ternary_truth_table<TT> const itt( onset, ~dcset );
+
+  rinox::dependency::function_enumerator_stats st;
+  rinox::dependency::function_enumerator<NumVars> enumerator( {}, st );
+
+  std::vector<TT> completions;
+  auto const num_completions = enumerator.foreach_dont_care_assignment( itt, 3u, [&]( TT const& tt ) {
+    completions.push_back( tt );
+  } );
+  CHECK( num_completions == 8u );
+  CHECK( completions.size() == 8u );
+  CHECK( kitty::equal( completions[0], onset ) );
+  for ( auto i = 0u; i < completions.size(); ++i )
+  {
+    CHECK( kitty::is_const0( ( completions[i] ^ onset ) & ~dcset ) );
+    for ( auto j = 0u; j < i; ++j )
+      CHECK( !kitty::equal( completions[i], completions[j] ) );
+    /* consecutive completions differ in one minterm of the first 3 variables */
+    if ( i > 0u )
+      CHECK( kitty::count_ones( completions[i] ^ completions[i - 1] ) == 2u );
+  }
+  CHECK( st.num_functions == 1u );
+  CHECK( st.num_completions == 8u );
+
+  /* stop at the first completion containing the whole don't care set */
+  uint32_t num_calls = 0u;
+  auto const num_visited = enumerator.foreach_dont_care_assignment( itt, 3u, [&]( TT const& tt ) {
+    ++num_calls;
+    return !kitty::equal( tt, onset | dcset );
+  } );
+  CHECK( num_visited == num_calls );
+  CHECK( num_calls < 8u );
+  CHECK( st.num_cutoffs == 1u );
+
+  /* cap the number of don't cares enumerated */
+  rinox::dependency::function_enumerator<NumVars> capped( { 2u } );
+  completions.clear();
+  capped.foreach_dont_care_assignment( itt, 3u, [&]( TT const& tt ) {
+    completions.push_back( tt );
+  } );
+  CHECK( completions.size() == 4u );
+  CHECK( capped.get_stats().num_capped == 1u );
+}
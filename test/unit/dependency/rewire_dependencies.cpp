@@ -94,3 +94,55 @@ TEST_CASE( "Rewiring analysis for reconvergent network", "[rewire_dependencies]"
     std::cout << std::endl;
   } );
 }
+
+TEST_CASE( "Rewiring to a complemented divisor", "[rewire_dependencies]" )
+{
+  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::string const library = "GATE   inv1    1.0 O=!a;                  PIN * INV 1   999 1.0 0.0 1.0 0.0\n"
+                              "GATE   and2    1.0 O=a*b;                 PIN * INV 1   999 1.0 0.0 1.0 0.0\n"
+                              "GATE   or2     1.0 O=a+b;                 PIN * INV 1   999 1.0 0.0 1.0 0.0\n"
+                              "GATE   nand2   1.0 O=!(a*b);              PIN * INV 1   999 1.0 0.0 1.0 0.0";
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  Ntk ntk( gates );
+  REQUIRE( ntk.get_augmented_library().get_inverter_id() );
+
+  using signal = typename Ntk::signal;
+  signal const a = ntk.create_pi();
+  signal const b = ntk.create_pi();
+  signal const c = ntk.create_pi();
+  signal const x = ntk.create_node( std::vector<signal>{ a, b }, 1 );
+  signal const y = ntk.create_node( std::vector<signal>{ a, b }, 3 );
+  signal const p = ntk.create_node( std::vector<signal>{ x, c }, 2 );
+  ntk.create_po( p );
+  ntk.create_po( y );
+
+  using DNtk = mockturtle::depth_view<Ntk>;
+  rinox::windowing::window_manager_stats st;
+  DNtk dntk( ntk );
+
+  window_manager_params ps;
+  rinox::windowing::window_manager<DNtk, window_manager_params> window( dntk, ps, st );
+  CHECK( window.run( dntk.get_node( p ) ) );
+  rinox::windowing::window_simulator sim( dntk );
+  sim.run( window );
+
+  rinox::dependency::rewire_dependencies dep( ntk );
+  dep.run( window, sim );
+
+  bool found = false;
+  dep.foreach_cut( [&]( auto const& cut, auto i ) {
+    if ( cut.inverted != 0u )
+    {
+      CHECK( cut.inverted == 1u );
+      CHECK( cut.leaves[0] == y );
+      CHECK( cut.leaves[1] == c );
+      found = true;
+    }
+  } );
+  CHECK( found );
+}
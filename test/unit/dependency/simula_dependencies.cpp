@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <kitty/kitty.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#include <rinox/dependency/simula_dependencies.hpp>
+#include <rinox/network/network.hpp>
+#include <rinox/windowing/window_manager.hpp>
+#include <rinox/windowing/window_simulator.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+std::string const test_library = "GATE   and2    1.0 O=a*b;                 PIN * INV 1   999 1.0 0.0 1.0 0.0\n"
+                                 "GATE   or2     1.0 O=a+b;                 PIN * INV 1   999 1.0 0.0 1.0 0.0\n"
+                                 "GATE   xor2    1.0 O=a^b;                 PIN * INV 1   999 1.0 0.0 1.0 0.0\n"
+                                 "GATE   inv1    1.0 O=!(a);                PIN * INV 1   999 1.0 0.0 1.0 0.0";
+
+struct custom_simula_params : rinox::dependency::default_simula_params
+{
+  static constexpr uint32_t max_cuts_size = 4u;
+};
+
+struct window_manager_params : rinox::windowing::default_window_manager_params
+{
+  static constexpr uint32_t max_num_leaves = 6u;
+};
+
+/*! \brief Exhaustively check that the functions of the cuts implement the pivot */
+template<class Ntk, class Dep>
+void check_cuts( Ntk const& ntk, Dep& dep, typename Ntk::node const& pivot )
+{
+  std::vector<kitty::dynamic_truth_table> tts( ntk.size(), kitty::dynamic_truth_table( ntk.num_pis() ) );
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    kitty::create_nth_var( tts[n], i );
+  } );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    std::vector<kitty::dynamic_truth_table const*> sim_ptrs;
+    ntk.foreach_fanin( n, [&]( auto const& fi ) {
+      sim_ptrs.push_back( &tts[ntk.get_node( fi )] );
+    } );
+    ntk.compute( tts[n], ntk.make_signal( n ), sim_ptrs );
+  } );
+
+  dep.foreach_cut( [&]( auto const& cut, auto i ) {
+    CHECK( cut.type == rinox::dependency::SIMULA_DEP );
+    CHECK( cut.root == pivot );
+    REQUIRE( cut.func.size() == 1u );
+    for ( auto x = 0u; x < tts[pivot].num_bits(); ++x )
+    {
+      uint32_t m = 0u;
+      for ( auto v = 0u; v < cut.leaves.size(); ++v )
+        m |= kitty::get_bit( tts[ntk.get_node( cut.leaves[v] )], x ) << v;
+      CHECK( kitty::get_bit( cut.func[0]._care, m ) );
+      CHECK( kitty::get_bit( cut.func[0]._bits, m ) == kitty::get_bit( tts[pivot], x ) );
+    }
+  } );
+}
+
+TEST_CASE( "Simulation-guided dependencies validated with SAT", "[simula_dependencies]" )
+{
+  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  Ntk ntk( gates );
+
+  using signal = typename Ntk::signal;
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const g1 = ntk.create_node( std::vector<signal>{ b, c }, 1 );
+  auto const g = ntk.create_node( std::vector<signal>{ a, g1 }, 0 );
+  auto const h1 = ntk.create_node( std::vector<signal>{ a, b }, 0 );
+  auto const h2 = ntk.create_node( std::vector<signal>{ a, c }, 0 );
+  auto const p = ntk.create_node( std::vector<signal>{ h1, h2 }, 1 );
+  ntk.create_po( g );
+  ntk.create_po( p );
+
+  using DNtk = mockturtle::depth_view<Ntk>;
+  rinox::windowing::window_manager_stats st;
+  DNtk dntk( ntk );
+
+  window_manager_params ps;
+  ps.odc_levels = 0;
+  rinox::windowing::window_manager<DNtk> window( dntk, ps, st );
+  CHECK( window.run( dntk.get_node( p ) ) );
+  rinox::windowing::window_simulator<DNtk, window_manager_params::max_num_leaves> sim( dntk );
+  sim.run( window );
+
+  rinox::dependency::simula_dependencies_stats dst;
+  rinox::dependency::simula_dependencies<DNtk, custom_simula_params> dep( dntk, dst );
+  /* the patterns are seeded, and g is proposed and validated in the first run */
+  dep.run( window, sim );
+  check_cuts( dntk, dep, dntk.get_node( p ) );
+  CHECK( dst.num_validated > 0u );
+}
+
+TEST_CASE( "Simulation-guided dependencies refined with counter-examples", "[simula_dependencies]" )
+{
+  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  Ntk ntk( gates );
+
+  using signal = typename Ntk::signal;
+  /* the conjunction of 12 inputs is almost never true on 64 random patterns */
+  std::vector<signal> pis;
+  for ( auto i = 0u; i < 12u; ++i )
+    pis.push_back( ntk.create_pi() );
+  auto h = pis[0];
+  auto k = pis[6];
+  for ( auto i = 1u; i < 6u; ++i )
+  {
+    h = ntk.create_node( std::vector<signal>{ h, pis[i] }, 0 );
+    k = ntk.create_node( std::vector<signal>{ k, pis[6 + i] }, 0 );
+  }
+  auto const p = ntk.create_node( std::vector<signal>{ h, k }, 0 );
+  ntk.create_po( p );
+
+  using DNtk = mockturtle::depth_view<Ntk>;
+  rinox::windowing::window_manager_stats st;
+  DNtk dntk( ntk );
+
+  window_manager_params ps;
+  ps.odc_levels = 0;
+  rinox::windowing::window_manager<DNtk> window( dntk, ps, st );
+  CHECK( window.run( dntk.get_node( p ) ) );
+  rinox::windowing::window_simulator<DNtk, window_manager_params::max_num_leaves> sim( dntk );
+  sim.run( window );
+
+  rinox::dependency::simula_dependencies_stats dst;
+  rinox::dependency::simula_dependencies<DNtk, custom_simula_params> dep( dntk, dst );
+  dep.run( window, sim );
+  check_cuts( dntk, dep, dntk.get_node( p ) );
+  CHECK( dst.num_counterexamples > 0u );
+
+  /* the counter-examples distinguish the pivot from the constant in the next run */
+  dep.run( window, sim );
+  check_cuts( dntk, dep, dntk.get_node( p ) );
+  CHECK( dst.num_validated > 0u );
+}
@@ -253,3 +253,35 @@ TEST_CASE( "simulation of bound_chain with static truth tables", "[evaluation]"
     CHECK( kitty::equal( xs[i], sim.get_simulation( chain, xs_r, i ) ) );
   }
 }
+
+TEST_CASE( "fanins and reuse of bound_chain", "[evaluation]" )
+{
+  bound_chain<rinox::network::design_type_t::CELL_BASED> chain( 3u );
+  auto const lit3 = chain.add_gate( { 0, 1, 2 }, 6 );
+  auto const lit4 = chain.add_gate( { lit3, 2 }, 5 );
+  chain.add_output( lit4 );
+
+  std::vector<std::vector<uint32_t>> fanins;
+  std::vector<uint32_t> ids;
+  chain.foreach_gate( [&]( auto const& fanin, auto id, auto i ) {
+    fanins.emplace_back( fanin.begin(), fanin.end() );
+    ids.push_back( id );
+  } );
+  CHECK( fanins == std::vector<std::vector<uint32_t>>{ { 0, 1, 2 }, { 3, 2 } } );
+  CHECK( ids == std::vector<uint32_t>{ 6, 5 } );
+
+  chain.replace_in_node( 1, 1, 0 );
+  CHECK( chain.get_fanins( 1 )[1] == 0u );
+  CHECK( chain.get_fanins( 0 ).size() == 3u );
+
+  /* rebuild the same chain after a reset */
+  auto const copy = chain;
+  chain.reset( 3u );
+  CHECK( chain.num_gates() == 0u );
+  CHECK( chain.num_pos() == 0u );
+  CHECK( !( chain == copy ) );
+  chain.add_gate( { 0, 1, 2 }, 6 );
+  chain.add_gate( { lit3, 0 }, 5 );
+  chain.add_output( lit4 );
+  CHECK( chain == copy );
+}
@@ -679,6 +679,88 @@ TEST_CASE( "Read json without port direction", "[json_parsing]" )
   CHECK( ntk.num_gates() == 3 );
 }
 
+TEST_CASE( "Stream json with sections in arbitrary order", "[json_parsing]" )
+{
+
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in_lib( test_library );
+  auto result_lib = lorina::read_genlib( in_lib, genlib_reader( gates ) );
+  CHECK( result_lib == lorina::return_code::success );
+
+  std::string file = R"({
+  "creator": "Rinox",
+  "modules": {
+    "top": {
+      "attributes": { "top": "00000000000000000000000000000001" },
+      "memories": {
+        "mem": { "width": 8, "size": [ 16, 32 ], "attributes": { "nested": [ 1, [ 2, 3 ] ] } }
+      },
+      "cells": {
+        "nand0": {
+          "type": "nand2",
+          "parameters": { "WIDTH": 1 },
+          "attributes": { "src": "top.v:3" },
+          "connections": { "a": [ 2 ], "b": [ 3 ], "O": [ 4 ] }
+        },
+        "inv0": {
+          "type": "inv1",
+          "connections": { "a": [ 4 ], "O": [ 5 ] }
+        }
+      },
+      "ports": {
+        "a": { "direction": "input",  "bits": [ 2 ] },
+        "b": { "direction": "input",  "bits": [ 3 ] },
+        "y": { "direction": "output", "bits": [ 5 ] }
+      },
+      "netnames": {
+        "n1": { "hide_name": 1, "bits": [ 4 ] }
+      }
+    }
+  },
+  "trailer": [ { "key": null }, true, 1.5 ]
+})";
+
+  std::istringstream in_ntk( file );
+  rinox::io::json::json_stream jstream( in_ntk );
+  CHECK( jstream.module_names() == std::vector<std::string>{ "top" } );
+  CHECK( jstream.module_name() == "top" );
+
+  rinox::io::json::instance_t inst;
+  CHECK( jstream.get_instance( inst ) == rinox::io::json::instance_return_code::valid );
+  auto const* c = std::get_if<rinox::io::json::cell_instance_t>( &inst );
+  REQUIRE( c != nullptr );
+  CHECK( c->name == "nand0" );
+  CHECK( c->parameters == std::vector<std::pair<std::string, std::string>>{ { "WIDTH", "1" } } );
+  CHECK( c->attributes == std::vector<std::pair<std::string, std::string>>{ { "src", "\"top.v:3\"" } } );
+
+  CHECK( jstream.get_instance( inst ) == rinox::io::json::instance_return_code::valid );
+  CHECK( std::holds_alternative<rinox::io::json::cell_instance_t>( inst ) );
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    CHECK( jstream.get_instance( inst ) == rinox::io::json::instance_return_code::valid );
+    CHECK( std::holds_alternative<rinox::io::json::port_instance_t>( inst ) );
+  }
+  CHECK( jstream.get_instance( inst ) == rinox::io::json::instance_return_code::valid );
+  CHECK( std::holds_alternative<rinox::io::json::net_name_instance_t>( inst ) );
+  CHECK( jstream.get_instance( inst ) == rinox::io::json::instance_return_code::end );
+
+  /* selecting the module again restarts from its first instance */
+  CHECK( jstream.set_module( "top" ) );
+  CHECK( jstream.get_instance( inst ) == rinox::io::json::instance_return_code::valid );
+  CHECK( std::holds_alternative<rinox::io::json::cell_instance_t>( inst ) );
+  CHECK( !jstream.set_module( "missing" ) );
+
+  bound_network ntk( gates );
+  std::istringstream in_ntk2( file );
+  const auto result_ntk = rinox::io::json::read_json( in_ntk2, rinox::io::reader( ntk ) );
+  CHECK( result_ntk == lorina::return_code::success );
+  CHECK( ntk.num_pis() == 2 );
+  CHECK( ntk.num_pos() == 1 );
+  CHECK( ntk.num_gates() == 2 );
+}
+
 TEST_CASE( "Ripple carry Adder", "[json_parsing]" )
 {
 
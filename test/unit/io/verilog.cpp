@@ -531,4 +531,182 @@ endmodule)";
       "endmodule\n";
 
   CHECK( out.str() == expected );
-}
\ No newline at end of file
+}
+TEST_CASE( "Read structural verilog from a buffer in memory", "[verilog_reader]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in_lib( test_library );
+  auto result_lib = lorina::read_genlib( in_lib, genlib_reader( gates ) );
+  CHECK( result_lib == lorina::return_code::success );
+
+  std::string file =
+      R"(module top( \bus.a[0] , \bus.a [1] , c , y , z );
+  // comment with  spaces
+  input \bus.a[0] , \bus.a [1] , c ;
+  output y , z ;
+  wire n1 , n2 ;
+  nand2 g0 ( .a(\bus.a[0] ), .b(\bus.a [1]), .O(n1) );
+  fa    g1 ( .a(n1), .b(c), .c(\bus.a [1]), .S(n2), .C(z) );
+  inv1  g2 ( .a(n2), .O(y) );
+endmodule)";
+
+  bound_network ntk_stream( gates );
+  std::istringstream in_ntk( file );
+  auto const result_stream = rinox::io::verilog::read_verilog( in_ntk, rinox::io::reader( ntk_stream ) );
+  CHECK( result_stream == lorina::return_code::success );
+
+  bound_network ntk_buffer( gates );
+  auto const result_buffer = rinox::io::verilog::read_verilog_buffer( std::string_view( file ), rinox::io::reader( ntk_buffer ) );
+  CHECK( result_buffer == lorina::return_code::success );
+
+  CHECK( ntk_buffer.num_pis() == 3 );
+  CHECK( ntk_buffer.num_pos() == 2 );
+  CHECK( ntk_buffer.num_gates() == 3 );
+
+  std::ostringstream out_stream, out_buffer;
+  rinox::io::verilog::write_verilog( ntk_stream, out_stream );
+  rinox::io::verilog::write_verilog( ntk_buffer, out_buffer );
+  CHECK( out_stream.str() == out_buffer.str() );
+
+  /* the views keep the spaces of escaped names, which are removed by the parser */
+  rinox::io::verilog::mapped_tokenizer tok( "\\bus.a [1] , x" );
+  std::string_view token;
+  CHECK( tok.get_token_view( token ) == lorina::detail::tokenizer_return_code::valid );
+  CHECK( token == "\\bus.a [1] " );
+  CHECK( tok.get_token_view( token ) == lorina::detail::tokenizer_return_code::valid );
+  CHECK( token == "," );
+  CHECK( tok.get_token_view( token ) == lorina::detail::tokenizer_return_code::valid );
+  CHECK( token == "x" );
+}
+
+TEST_CASE( "Read multi-module verilog in parallel", "[verilog_reader]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in_lib( test_library );
+  auto result_lib = lorina::read_genlib( in_lib, genlib_reader( gates ) );
+  CHECK( result_lib == lorina::return_code::success );
+
+  std::string file =
+      R"(// the keywords in comments and escaped names are not module boundaries: module endmodule
+module first( a , b , y );
+  input a , b ;
+  output y ;
+  wire \n.endmodule ;
+  nand2 g0 ( .a(a), .b(b), .O(\n.endmodule ) );
+  inv1  g1 ( .a(\n.endmodule ), .O(y) );
+endmodule
+module second( c , d , e , z );
+  input c , d , e ;
+  output z ;
+  wire n0 ;
+  // gates listed in reverse topological order
+  xor2 g1 ( .a(n0), .b(e), .O(z) );
+  and2 g0 ( .a(c), .b(d), .O(n0) );
+endmodule
+)";
+
+  auto const chunks = rinox::io::verilog::detail::split_modules( file );
+  REQUIRE( chunks.size() == 2u );
+  CHECK( chunks[0].substr( 0, 12 ) == "module first" );
+  CHECK( chunks[1].substr( 0, 13 ) == "module second" );
+  CHECK( chunks[1].substr( chunks[1].size() - 9 ) == "endmodule" );
+
+  bound_network ntk_seq( gates );
+  auto const result_seq = rinox::io::verilog::read_verilog_buffer( std::string_view( file ), rinox::io::reader( ntk_seq ) );
+  CHECK( result_seq == lorina::return_code::success );
+
+  bound_network ntk_par( gates );
+  auto const result_par = rinox::io::verilog::read_verilog_buffer_parallel( std::string_view( file ), rinox::io::reader( ntk_par ), 2u );
+  CHECK( result_par == lorina::return_code::success );
+
+  CHECK( ntk_par.num_pis() == 5 );
+  CHECK( ntk_par.num_gates() == 4 );
+  CHECK( ntk_par.num_pis() == ntk_seq.num_pis() );
+  CHECK( ntk_par.num_pos() == ntk_seq.num_pos() );
+  CHECK( ntk_par.size() == ntk_seq.size() );
+
+  std::ostringstream out_seq, out_par;
+  rinox::io::verilog::write_verilog( ntk_seq, out_seq );
+  rinox::io::verilog::write_verilog( ntk_par, out_par );
+  CHECK( out_seq.str() == out_par.str() );
+}
+
+TEST_CASE( "Read hierarchical verilog in parallel", "[verilog_reader]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  using parser_t = rinox::io::verilog::verilog_parser<rinox::io::verilog::module_recorder<bound_network>, rinox::io::verilog::mapped_tokenizer>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in_lib( test_library );
+  auto result_lib = lorina::read_genlib( in_lib, genlib_reader( gates ) );
+  CHECK( result_lib == lorina::return_code::success );
+
+  std::string file =
+      R"(module child( a , b , y );
+  input a , b ;
+  output y ;
+  nand2 g0 ( .a(a), .b(b), .O(y) );
+endmodule
+module top( x0 , x1 , x2 , z , w );
+  input x0 , x1 , x2 ;
+  output z , w ;
+  child u0 ( .a(x0), .b(x1), .y(w) );
+  and2 g0 ( .a(x1), .b(x2), .O(z) );
+endmodule
+)";
+
+  auto const chunks = rinox::io::verilog::detail::split_modules( file );
+  REQUIRE( chunks.size() == 2u );
+
+  bound_network ntk_rec( gates );
+  rinox::io::reader const target( ntk_rec );
+
+  /* the interfaces are parsed without the bodies */
+  rinox::io::verilog::module_recorder<bound_network> discarded( target );
+  parser_t interface_parser( chunks[0], discarded );
+  auto const child = interface_parser.parse_module_interface();
+  REQUIRE( child );
+  CHECK( child->first == "child" );
+  CHECK( child->second.inputs == std::vector<std::string>{ "a", "b" } );
+  CHECK( child->second.outputs == std::vector<std::string>{ "y" } );
+
+  /* the body of the top module instantiates the declared module */
+  typename parser_t::declared_modules_t declared;
+  declared.emplace( child->first, std::make_pair( 0u, child->second ) );
+
+  rinox::io::verilog::module_recorder<bound_network> undeclared_recorder( target );
+  parser_t undeclared_parser( chunks[1], undeclared_recorder );
+  CHECK( !undeclared_parser.parse_modules() );
+
+  rinox::io::verilog::module_recorder<bound_network> declared_recorder( target );
+  parser_t declared_parser( chunks[1], declared_recorder );
+  declared_parser.declare_modules( &declared, 1u );
+  CHECK( declared_parser.parse_modules() );
+
+  /* a module cannot instantiate the modules defined after it */
+  rinox::io::verilog::module_recorder<bound_network> later_recorder( target );
+  parser_t later_parser( chunks[1], later_recorder );
+  later_parser.declare_modules( &declared, 0u );
+  CHECK( !later_parser.parse_modules() );
+
+  bound_network ntk_seq( gates );
+  auto const result_seq = rinox::io::verilog::read_verilog_buffer( std::string_view( file ), rinox::io::reader( ntk_seq ) );
+  CHECK( result_seq == lorina::return_code::success );
+
+  bound_network ntk_par( gates );
+  auto const result_par = rinox::io::verilog::read_verilog_buffer_parallel( std::string_view( file ), rinox::io::reader( ntk_par ), 2u );
+  CHECK( result_par == lorina::return_code::success );
+
+  CHECK( ntk_par.num_pis() == ntk_seq.num_pis() );
+  CHECK( ntk_par.num_pos() == ntk_seq.num_pos() );
+  CHECK( ntk_par.num_gates() == ntk_seq.num_gates() );
+
+  std::ostringstream out_seq, out_par;
+  rinox::io::verilog::write_verilog( ntk_seq, out_seq );
+  rinox::io::verilog::write_verilog( ntk_par, out_par );
+  CHECK( out_seq.str() == out_par.str() );
+}
@@ -2,8 +2,10 @@
 // Tests for rinox boolean/simd_operations.hpp
 
 #include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
 #include <cstdint>
 #include <vector>
 
@@ -221,10 +223,12 @@ TEST_CASE( "Array-based Bound network: Cloning nodes and networks", "[network]"
   CHECK( ntk2.num_gates() == ntk.num_gates() );
 }
 
-TEST_CASE( "Cell-based Bound network: Substitute multiple-output node with single-output nodes", "[network]" )
+TEMPLATE_TEST_CASE( "Cell-based Bound network: Substitute multiple-output node with single-output nodes", "[network]",
+                    ( bound_network<design_type_t::CELL_BASED, 2> ),
+                    ( bound_network<design_type_t::CELL_BASED, 2, storage_layout_t::STRUCT_OF_ARRAYS> ) )
 {
-  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
-  using signal = bound_network::signal;
+  using bound_network = TestType;
+  using signal = typename bound_network::signal;
 
   std::vector<gate> gates;
 
@@ -252,6 +256,9 @@ TEST_CASE( "Cell-based Bound network: Substitute multiple-output node with singl
   CHECK( ntk.is_po( signal{ f1.index, 0 } ) );
   CHECK( ntk.is_po( signal{ f1.index, 1 } ) );
   CHECK( ntk.is_po( f2 ) );
+  CHECK( ntk.pi_index( c.index ) == 2 );
+  CHECK( ntk.num_outputs( f1.index ) == 2 );
+  CHECK( ntk.fanin_size( f2.index ) == 2 );
   CHECK( ntk.fanout_size( carry.index ) == 0 );
   CHECK( ntk.fanout_size( sum.index ) == 0 );
   CHECK( ntk.fanout_size( f1.index ) == 5 );
@@ -270,6 +277,14 @@ TEST_CASE( "Cell-based Bound network: Substitute multiple-output node with singl
   CHECK( ntk.fanout_size( f1.index ) == 0 );
   CHECK( ntk.fanout_size( f2.index ) == 1 );
   CHECK( ntk.is_dead( f1.index ) );
+  CHECK( ntk.get_children( f2.index ) == std::vector<signal>{ carry, sum } );
+
+  uint32_t num_fanouts = 0;
+  ntk.foreach_fanout( carry, [&]( auto const& n ) {
+    CHECK( n == f2.index );
+    num_fanouts++;
+  } );
+  CHECK( num_fanouts == 1 );
 }
 
 TEST_CASE( "Array-based Bound network: Substitute multiple-output node with single-output nodes", "[network]" )
@@ -351,9 +366,11 @@ TEST_CASE( "Array-based Bound network: Strashing", "[network]" )
   CHECK( f6 != f5 );
 }
 
-TEST_CASE( "Cell-based Bound network: Strashing", "[network]" )
+TEMPLATE_TEST_CASE( "Cell-based Bound network: Strashing", "[network]",
+                    ( bound_network<design_type_t::CELL_BASED, 2> ),
+                    ( bound_network<design_type_t::CELL_BASED, 2, storage_layout_t::STRUCT_OF_ARRAYS> ) )
 {
-  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  using bound_network = TestType;
 
   std::vector<gate> gates;
 
@@ -371,6 +388,7 @@ TEST_CASE( "Cell-based Bound network: Strashing", "[network]" )
   auto const f4 = ntk.create_node( { a, b }, 2 );                   // nand2
   auto const f5 = ntk.create_node( { a, b }, 2 );                   // nand2
   auto const f6 = ntk.create_node<true>( { a, b }, 2 );             // nand2
+  auto const f7 = ntk.create_node<true>( { a, b }, 3 );             // and2
 
   CHECK( f2 != f1 );
   CHECK( f3 == f1 );
@@ -378,6 +396,11 @@ TEST_CASE( "Cell-based Bound network: Strashing", "[network]" )
   CHECK( f5 != f4 );
   CHECK( f6 == f4 );
   CHECK( f6 != f5 );
+  CHECK( f7 != f4 );
+
+  ntk.take_out_node( f4.index );
+  auto const f8 = ntk.create_node<true>( { a, b }, 2 ); // nand2
+  CHECK( f8 == f5 );
 }
 
 TEST_CASE( "Cell-based Bound network: Simulation", "[network]" )
@@ -420,6 +443,50 @@ TEST_CASE( "Cell-based Bound network: Simulation", "[network]" )
   CHECK( kitty::equal( res[0], tts[5] ) );
 }
 
+TEST_CASE( "Cell-based Bound network: Compiled gate kernels", "[network]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+  for ( auto const& g : lib.get_aug_gates() )
+  {
+    if ( g.num_vars == 0 )
+      continue;
+    auto const& kernel = lib.get_kernel( g.id );
+    CHECK( kernel.num_inputs() == g.num_vars );
+
+    /* dynamic truth tables with as many variables as the gate */
+    std::vector<kitty::dynamic_truth_table> dyn_vars;
+    std::vector<kitty::dynamic_truth_table const*> dyn_ptrs;
+    for ( auto i = 0u; i < g.num_vars; ++i )
+    {
+      dyn_vars.emplace_back( g.num_vars );
+      kitty::create_nth_var( dyn_vars.back(), i );
+    }
+    for ( auto const& tt : dyn_vars )
+      dyn_ptrs.push_back( &tt );
+    kitty::dynamic_truth_table dyn_res;
+    kernel( dyn_res, dyn_ptrs.data() );
+    CHECK( kitty::equal( dyn_res, g.function ) );
+
+    /* static truth tables with more variables than the gate */
+    std::array<kitty::static_truth_table<6u>, 6u> sta_vars;
+    std::array<kitty::static_truth_table<6u> const*, 6u> sta_ptrs;
+    for ( auto i = 0u; i < 6u; ++i )
+    {
+      kitty::create_nth_var( sta_vars[i], i );
+      sta_ptrs[i] = &sta_vars[i];
+    }
+    kitty::static_truth_table<6u> sta_res;
+    kernel( sta_res, sta_ptrs.data() );
+    CHECK( kitty::equal( sta_res, kitty::extend_to<6u>( g.function ) ) );
+  }
+}
+
 TEST_CASE( "Array-based Bound network: Simulation", "[network]" )
 {
   using bound_network = rinox::network::bound_network<rinox::network::design_type_t::ARRAY_BASED, 2>;
@@ -490,4 +557,155 @@ TEST_CASE( "Cell-based Bound network wrapped in a depth view", "[network]" )
   CHECK( dntk.level( f1.index ) == 1u );
   CHECK( dntk.level( f2.index ) == 2u );
   CHECK( dntk.level( f3.index ) == 3u );
-}
\ No newline at end of file
+}
+
+template<class Ntk>
+std::vector<kitty::dynamic_truth_table> simulate_outputs( Ntk const& ntk )
+{
+  std::vector<kitty::dynamic_truth_table> tts( ntk.signal_size(), kitty::dynamic_truth_table( ntk.num_pis() ) );
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    kitty::create_nth_var( tts[ntk.signal_to_index( ntk.make_signal( n ) )], i );
+  } );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    std::vector<kitty::dynamic_truth_table const*> sim_ptrs;
+    ntk.foreach_fanin( n, [&]( auto const& fi ) {
+      sim_ptrs.push_back( &tts[ntk.signal_to_index( fi )] );
+    } );
+    ntk.foreach_output( n, [&]( auto const& f ) {
+      ntk.compute( tts[ntk.signal_to_index( f )], f, sim_ptrs );
+    } );
+  } );
+
+  std::vector<kitty::dynamic_truth_table> res;
+  ntk.foreach_po( [&]( auto const& f ) {
+    res.push_back( tts[ntk.signal_to_index( f )] );
+  } );
+  return res;
+}
+
+TEMPLATE_TEST_CASE( "Cell-based Bound network: Compaction", "[network]",
+                    ( bound_network<design_type_t::CELL_BASED, 2> ),
+                    ( bound_network<design_type_t::CELL_BASED, 2, storage_layout_t::STRUCT_OF_ARRAYS> ) )
+{
+  using Ntk = TestType;
+  using signal = typename Ntk::signal;
+
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  Ntk ntk( gates );
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const f1 = ntk.create_node( { a, b, c }, { 12, 13 } );  // fa
+  auto const f2 = ntk.create_node( std::vector<signal>{ signal{ f1.index, 0 },
+                                                        signal{ f1.index, 1 } },
+                                   2u );                       // nand2
+  auto const dangling = ntk.create_node( { a, b }, 4 );        // xor2
+  auto const carry = ntk.create_node( { a, b, c }, 5 );        // maj3
+  auto const sum = ntk.create_node( { a, b, c }, 6 );          // xor3
+  ntk.create_po( f2 );
+  ntk.create_po( signal{ f1.index, 1 } );
+  ntk.set_name( b, "b" );
+  ntk.set_name( f2, "y" );
+
+  ntk.substitute_node( f1.index, std::vector<signal>{ carry, sum } );
+  CHECK( ntk.is_dead( f1.index ) );
+  CHECK( ntk.size() == 10u );
+
+  auto const tts = simulate_outputs( ntk );
+
+  uint32_t num_remaps = 0u;
+  auto remap = ntk.events().register_remap_event( [&]( auto const& old_to_new ) {
+    ++num_remaps;
+    CHECK( old_to_new.size() == 10u );
+  } );
+  auto const old_to_new = ntk.compact();
+  ntk.events().release_remap_event( remap );
+
+  CHECK( num_remaps == 1u );
+  CHECK( ntk.size() == 9u );
+  CHECK( old_to_new[f1.index] == Ntk::null_node );
+  CHECK( old_to_new[a.index] == 2u );
+  CHECK( old_to_new[b.index] == 3u );
+  CHECK( old_to_new[c.index] == 4u );
+
+  /* the gates reachable from the outputs follow their fanins */
+  CHECK( old_to_new[carry.index] == 5u );
+  CHECK( old_to_new[sum.index] == 6u );
+  CHECK( old_to_new[f2.index] == 7u );
+  CHECK( old_to_new[dangling.index] == 8u );
+
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    CHECK( n == 2u + i );
+  } );
+  ntk.foreach_node( [&]( auto const& n ) {
+    CHECK( !ntk.is_dead( n ) );
+    ntk.foreach_fanin( n, [&]( auto const& fi ) {
+      CHECK( fi.index < n );
+    } );
+  } );
+
+  CHECK( ntk.has_name( ntk.make_signal( 3u ) ) );
+  CHECK( ntk.get_name( ntk.make_signal( 3u ) ) == "b" );
+  CHECK( ntk.has_name( ntk.make_signal( 7u ) ) );
+  CHECK( ntk.get_name( ntk.make_signal( 7u ) ) == "y" );
+
+  auto const new_tts = simulate_outputs( ntk );
+  REQUIRE( new_tts.size() == tts.size() );
+  for ( auto i = 0u; i < tts.size(); ++i )
+    CHECK( kitty::equal( new_tts[i], tts[i] ) );
+}
+
+TEMPLATE_TEST_CASE( "Cell-based Bound network: Strashing after updates", "[network]",
+                    ( bound_network<design_type_t::CELL_BASED, 2> ),
+                    ( bound_network<design_type_t::CELL_BASED, 2, storage_layout_t::STRUCT_OF_ARRAYS> ) )
+{
+  using Ntk = TestType;
+  using signal = typename Ntk::signal;
+
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  Ntk ntk( gates );
+  std::vector<signal> pis;
+  for ( auto i = 0u; i < 8u; ++i )
+    pis.push_back( ntk.create_pi() );
+
+  /* enough nodes to grow the table and leave tombstones behind */
+  std::vector<signal> ands;
+  for ( auto i = 0u; i < pis.size(); ++i )
+  {
+    for ( auto j = i + 1; j < pis.size(); ++j )
+      ands.push_back( ntk.create_node( { pis[i], pis[j] }, 3 ) ); // and2
+  }
+  for ( auto k = 0u; k < ands.size(); k += 2 )
+    ntk.take_out_node( ands[k].index );
+
+  auto idx = 0u;
+  for ( auto i = 0u; i < pis.size(); ++i )
+  {
+    for ( auto j = i + 1; j < pis.size(); ++j, ++idx )
+    {
+      auto const f = ntk.create_node<true>( { pis[i], pis[j] }, 3 ); // and2
+      if ( idx % 2 == 1 )
+        CHECK( f == ands[idx] );
+      CHECK( !ntk.is_dead( f.index ) );
+      CHECK( ntk.create_node<true>( { pis[i], pis[j] }, 3 ) == f );
+    }
+  }
+
+  /* the substituted fanins are visible to the structural hashing */
+  auto const g = ntk.create_node( { pis[0], pis[1] }, 2 ); // nand2
+  auto const h = ntk.create_node( { g, pis[2] }, 4 );      // xor2
+  auto const x = ntk.create_node( { pis[0], pis[1] }, 4 ); // xor2
+  ntk.create_po( h );
+  ntk.substitute_node( g.index, x );
+  CHECK( ntk.create_node<true>( { x, pis[2] }, 4 ) == h );
+}
@@ -6,10 +6,18 @@
 
 #include <rinox/network/network.hpp>
 #include <rinox/opto/algorithms/resynthesize.hpp>
+#include <mockturtle/algorithms/equivalence_checking.hpp>
+#include <mockturtle/algorithms/miter.hpp>
 #include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/utils/tech_library.hpp>
 #include <mockturtle/views/depth_view.hpp>
 
+#include <array>
+#include <functional>
+#include <map>
+#include <random>
+
 std::string const test_library = "GATE   and2    1.0 O=a*b;                 PIN * INV 1   999 1.0 0.0 1.0 0.0\n"
                                  "GATE   or2     1.0 O=a+b;                 PIN * INV 1   999 1.0 0.0 1.0 0.0\n"
                                  "GATE   xor2    0.5 O=a^b;                 PIN * INV 1   999 1.0 0.0 1.0 0.0\n"
@@ -111,6 +119,49 @@ TEST_CASE( "Area resynthesis via rewiring - single-output gate with don't cares"
   CHECK( ntk.area() == 5.5 );
 }
 
+TEST_CASE( "Parallel area resynthesis via rewiring - single-output gate with don't cares", "[area_resynthesis]" )
+{
+  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  using signal = typename Ntk::signal;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+
+  static constexpr uint32_t MaxNumVars = 6u;
+  using Db = rinox::databases::mapped_database<Ntk, MaxNumVars>;
+  Db db( lib );
+
+  Ntk ntk( gates );
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+  auto const d = ntk.create_pi();
+  auto const f1 = ntk.create_node( { a, b }, 0u );
+  auto const f2 = ntk.create_node( { c, d }, 1u );
+  auto const f3 = ntk.create_node( { c, d }, 0u );
+  auto const f4 = ntk.create_node( { c, d }, 2u );
+  auto const f5 = ntk.create_node( { f1, f2 }, 0u );
+  auto const f6 = ntk.create_node( { f3, f5 }, 1u );
+  auto const f7 = ntk.create_node( { f3, f4 }, 0u );
+
+  ntk.create_po( f6 );
+  ntk.create_po( f7 );
+
+  using DNtk = mockturtle::depth_view<Ntk>;
+  DNtk dntk( ntk );
+  custom_area_rewire_params ps;
+  ps.window_manager_ps.odc_levels = 3;
+  ps.num_threads = 4u;
+  rinox::opto::algorithms::resynthesis_stats st;
+  rinox::opto::algorithms::area_resynthesize<DNtk, Db, custom_area_rewire_params>( dntk, db, ps, &st );
+  CHECK( ntk.area() == 5.5 );
+  CHECK( st.num_batches > 0 );
+}
+
 TEST_CASE( "Area resynthesis via rewiring - multiple-output gate without don't cares", "[area_resynthesis]" )
 {
   using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
@@ -407,4 +458,297 @@ TEST_CASE( "Area resynthesis via window rewriting - single-output gate with don'
   ps.window_manager_ps.odc_levels = 3;
   rinox::opto::algorithms::area_resynthesize<DNtk, Db, custom_area_window_params1>( dntk, db, ps );
   CHECK( ntk.area() == 5.5 );
-}
\ No newline at end of file
+}
+/*! \brief Convert a bound network to a k-LUT network for equivalence checking */
+template<class Ntk>
+mockturtle::klut_network bound_to_klut( Ntk const& ntk )
+{
+  using klut_signal = mockturtle::klut_network::signal;
+  mockturtle::klut_network klut;
+  std::map<std::pair<uint64_t, uint32_t>, klut_signal> old_to_new;
+  ntk.foreach_pi( [&]( auto const& n ) {
+    old_to_new[{ n, 0u }] = klut.create_pi();
+  } );
+
+  std::function<klut_signal( typename Ntk::signal const& )> convert = [&]( auto const& f ) {
+    auto const n = ntk.get_node( f );
+    if ( ntk.is_constant( n ) )
+      return klut.get_constant( ntk.constant_value( n ) );
+    auto const it = old_to_new.find( { n, f.output } );
+    if ( it != old_to_new.end() )
+      return it->second;
+    std::vector<klut_signal> children;
+    ntk.foreach_fanin( n, [&]( auto const& fi ) {
+      children.push_back( convert( fi ) );
+    } );
+    auto const g = klut.create_node( children, ntk.node_function( n, f.output ) );
+    old_to_new[{ n, f.output }] = g;
+    return g;
+  };
+  ntk.foreach_po( [&]( auto const& f ) {
+    klut.create_po( convert( f ) );
+  } );
+  return klut;
+}
+
+/*! \brief Database of the single gates of the test library with at most three inputs */
+template<class Db>
+void fill_random_area_database( Db& db )
+{
+  for ( uint32_t const id : { 0u, 1u, 2u, 8u } )
+  {
+    rinox::evaluation::chains::bound_chain<rinox::network::design_type_t::CELL_BASED> list;
+    list.add_inputs( 3u );
+    list.add_output( list.add_gate( { 0, 1 }, id ) );
+    db.add( list );
+  }
+  for ( uint32_t const id : { 3u, 4u, 5u } )
+  {
+    rinox::evaluation::chains::bound_chain<rinox::network::design_type_t::CELL_BASED> list;
+    list.add_inputs( 3u );
+    list.add_output( list.add_gate( { 0, 1, 2 }, id ) );
+    db.add( list );
+  }
+}
+
+/*! \brief Pseudo-random network of two- and three-input gates */
+template<class Ntk>
+void build_random_area_network( Ntk& ntk )
+{
+  std::vector<typename Ntk::signal> signals;
+  for ( auto i = 0u; i < 8u; ++i )
+    signals.push_back( ntk.create_pi() );
+  std::mt19937 rng( 17u );
+  for ( auto i = 0u; i < 120u; ++i )
+  {
+    auto const pick = [&]() { return signals[signals.size() - 1u - rng() % std::min<size_t>( signals.size(), 12u )]; };
+    if ( rng() % 3u == 0u )
+    {
+      static constexpr std::array<uint32_t, 3> ids3{ 3u, 4u, 5u };
+      auto const id = ids3[rng() % ids3.size()];
+      signals.push_back( ntk.create_node( { pick(), pick(), pick() }, id ) );
+    }
+    else
+    {
+      static constexpr std::array<uint32_t, 4> ids2{ 0u, 1u, 2u, 8u };
+      auto const id = ids2[rng() % ids2.size()];
+      signals.push_back( ntk.create_node( { pick(), pick() }, id ) );
+    }
+  }
+  for ( auto i = 0u; i < 8u; ++i )
+    ntk.create_po( signals[signals.size() - 1u - 5u * i] );
+}
+
+/*! \brief Check that two networks have the same nodes, bindings, and outputs */
+template<class Ntk>
+void check_identical_networks( Ntk const& lhs, Ntk const& rhs )
+{
+  auto const children = []( Ntk const& ntk, auto const& n ) {
+    std::vector<typename Ntk::signal> fanins;
+    ntk.foreach_fanin( n, [&]( auto const& fi ) {
+      fanins.push_back( fi );
+    } );
+    return fanins;
+  };
+  REQUIRE( lhs.size() == rhs.size() );
+  CHECK( lhs.area() == rhs.area() );
+  lhs.foreach_node( [&]( auto const& n ) {
+    REQUIRE( lhs.is_dead( n ) == rhs.is_dead( n ) );
+    if ( lhs.is_dead( n ) || lhs.is_constant( n ) || lhs.is_pi( n ) )
+      return;
+    CHECK( lhs.get_binding_ids( n ) == rhs.get_binding_ids( n ) );
+    CHECK( children( lhs, n ) == children( rhs, n ) );
+  } );
+  lhs.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( f == rhs.po_at( i ) );
+  } );
+}
+
+struct custom_area_threads_params : rinox::opto::algorithms::default_resynthesis_params<6u>
+{
+  bool try_rewire = true;
+  bool try_struct = true;
+  bool try_window = true;
+  bool try_simula = false;
+  bool dynamic_database = false;
+  static constexpr uint32_t max_cuts_size = 3u;
+};
+
+TEST_CASE( "Batch area resynthesis does not depend on the number of threads", "[area_resynthesis]" )
+{
+  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+
+  using Db = rinox::databases::mapped_database<Ntk, 3u>;
+  Db db( lib );
+  fill_random_area_database( db );
+
+  Ntk ntk( gates );
+  build_random_area_network( ntk );
+  auto const reference = bound_to_klut( ntk );
+
+  /* the batch engine is called directly with one thread, which otherwise runs the sequential engine */
+  using DNtk = mockturtle::depth_view<Ntk>;
+  using WinMngr = rinox::windowing::window_manager<DNtk, typename custom_area_threads_params::window_manager_params>;
+  using Profiler = rinox::opto::profilers::area_profiler<DNtk, WinMngr>;
+  std::vector<Ntk> results;
+  for ( uint32_t const num_threads : { 1u, 2u, 4u } )
+  {
+    Ntk copy = ntk.clone();
+    DNtk dntk( copy );
+    custom_area_threads_params ps;
+    ps.window_manager_ps.odc_levels = 2;
+    ps.num_threads = num_threads;
+    ps.max_batch_size = 8u;
+    ps.compact = false;
+    rinox::opto::algorithms::resynthesis_stats st;
+    {
+      rinox::opto::algorithms::detail::parallel_resynthesize_impl<DNtk, Db, Profiler, custom_area_threads_params> p( dntk, db, ps, st );
+      p.run();
+    }
+    CHECK( st.num_batches > 0u );
+    CHECK( copy.area() <= ntk.area() );
+
+    auto const optimized = bound_to_klut( copy );
+    auto const miter = mockturtle::miter<mockturtle::klut_network>( reference, optimized );
+    REQUIRE( miter );
+    auto const equivalent = mockturtle::equivalence_checking( *miter );
+    REQUIRE( equivalent );
+    CHECK( *equivalent );
+    results.push_back( copy );
+  }
+
+  /* the optimized networks are identical */
+  for ( auto r = 1u; r < results.size(); ++r )
+    check_identical_networks( results[0], results[r] );
+}
+
+TEST_CASE( "Area resynthesis with one and four threads", "[area_resynthesis]" )
+{
+  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+
+  using Db = rinox::databases::mapped_database<Ntk, 3u>;
+  Db db( lib );
+  fill_random_area_database( db );
+
+  Ntk ntk( gates );
+  build_random_area_network( ntk );
+  auto const reference = bound_to_klut( ntk );
+
+  using DNtk = mockturtle::depth_view<Ntk>;
+  using WinMngr = rinox::windowing::window_manager<DNtk, typename custom_area_threads_params::window_manager_params>;
+  using Profiler = rinox::opto::profilers::area_profiler<DNtk, WinMngr>;
+  std::vector<Ntk> results;
+  for ( uint32_t const num_threads : { 1u, 4u } )
+  {
+    Ntk copy = ntk.clone();
+    DNtk dntk( copy );
+    custom_area_threads_params ps;
+    ps.window_manager_ps.odc_levels = 2;
+    ps.num_threads = num_threads;
+    ps.max_batch_size = 8u;
+    rinox::opto::algorithms::resynthesis_stats st;
+    rinox::opto::algorithms::area_resynthesize<DNtk, Db, custom_area_threads_params>( dntk, db, ps, &st );
+    CHECK( ( st.num_batches > 0u ) == ( num_threads > 1u ) );
+    CHECK( copy.area() <= ntk.area() );
+
+    auto const optimized = bound_to_klut( copy );
+    auto const miter = mockturtle::miter<mockturtle::klut_network>( reference, optimized );
+    REQUIRE( miter );
+    auto const equivalent = mockturtle::equivalence_checking( *miter );
+    REQUIRE( equivalent );
+    CHECK( *equivalent );
+    results.push_back( copy );
+  }
+
+  /* one thread runs the sequential engine */
+  Ntk serial = ntk.clone();
+  {
+    DNtk dntk( serial );
+    custom_area_threads_params ps;
+    ps.window_manager_ps.odc_levels = 2;
+    rinox::opto::algorithms::resynthesis_stats st;
+    rinox::opto::algorithms::detail::resynthesize_impl<DNtk, Db, Profiler, custom_area_threads_params> p( dntk, db, ps, st );
+    p.run();
+  }
+  check_identical_networks( serial, results[0] );
+
+  /* four threads run the batch engine, whose result does not depend on the number of threads */
+  Ntk batch = ntk.clone();
+  {
+    DNtk dntk( batch );
+    custom_area_threads_params ps;
+    ps.window_manager_ps.odc_levels = 2;
+    ps.num_threads = 2u;
+    ps.max_batch_size = 8u;
+    rinox::opto::algorithms::area_resynthesize<DNtk, Db, custom_area_threads_params>( dntk, db, ps );
+  }
+  check_identical_networks( batch, results[1] );
+}
+
+struct custom_area_simula_params : rinox::opto::algorithms::default_resynthesis_params<6u>
+{
+  bool try_rewire = false;
+  bool try_struct = false;
+  bool try_window = false;
+  bool try_simula = true;
+  bool dynamic_database = false;
+  static constexpr uint32_t max_cuts_size = 3u;
+};
+
+TEST_CASE( "Area resynthesis via simulation-guided dependencies after rollbacks", "[area_resynthesis]" )
+{
+  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+
+  using Db = rinox::databases::mapped_database<Ntk, 3u>;
+  Db db( lib );
+  fill_random_area_database( db );
+
+  Ntk ntk( gates );
+  build_random_area_network( ntk );
+  auto const reference = bound_to_klut( ntk );
+
+  /* every evaluation of the batch engine rolls back its tentative nodes, whose
+   * indices are reused by the next evaluation: stale simulations would accept
+   * wrong divisors */
+  using DNtk = mockturtle::depth_view<Ntk>;
+  for ( uint32_t const num_threads : { 2u, 4u } )
+  {
+    Ntk copy = ntk.clone();
+    DNtk dntk( copy );
+    custom_area_simula_params ps;
+    ps.num_threads = num_threads;
+    ps.max_batch_size = 4u;
+    rinox::opto::algorithms::resynthesis_stats st;
+    rinox::opto::algorithms::area_resynthesize<DNtk, Db, custom_area_simula_params>( dntk, db, ps, &st );
+    CHECK( st.num_batches > 0u );
+    CHECK( copy.area() <= ntk.area() );
+
+    auto const optimized = bound_to_klut( copy );
+    auto const miter = mockturtle::miter<mockturtle::klut_network>( reference, optimized );
+    REQUIRE( miter );
+    auto const equivalent = mockturtle::equivalence_checking( *miter );
+    REQUIRE( equivalent );
+    CHECK( *equivalent );
+  }
+}
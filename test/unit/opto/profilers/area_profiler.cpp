@@ -2,9 +2,13 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <cstdint>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include <lorina/genlib.hpp>
+#include <rinox/databases/mapped_database.hpp>
+#include <rinox/evaluation/chains/bound_chain.hpp>
 #include <rinox/network/network.hpp>
 #include <rinox/opto/profilers/area_profiler.hpp>
 #include <rinox/windowing/window_manager.hpp>
@@ -89,4 +93,79 @@ TEST_CASE( "Area profiler for resynthesis of mapped networks", "[area_resyn_prof
   auto cost = profiler.evaluate( list, std::vector<signal>( { a, b, c } ) );
   CHECK( cost == 4 );
   CHECK( ntk.area() == 14 );
-}
\ No newline at end of file
+}
+std::string const sharing_library = "GATE   zero    0 O=CONST0;\n"
+                                    "GATE   one     0 O=CONST1;\n"
+                                    "GATE   inv     1 O=!a;            PIN * INV 1 999 1.0 0.0 1.0 0.0\n"
+                                    "GATE   nand2   2 O=!(a*b);        PIN * INV 1 999 1.0 0.0 1.0 0.0\n"
+                                    "GATE   and2  2.5 O=a*b;           PIN * NONINV 1 999 5.0 0.0 5.0 0.0";
+
+TEST_CASE( "Area profiler ranks database entries after structural hashing", "[area_resyn_profiler]" )
+{
+  using bound_network = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  using signal = bound_network::signal;
+  using chain_t = rinox::evaluation::chains::bound_chain<rinox::network::design_type_t::CELL_BASED>;
+  static constexpr uint32_t MaxNumVars = 3u;
+
+  std::vector<mockturtle::gate> gates;
+  std::istringstream in( sharing_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  /* two non-dominated implementations of the AND: and2, and inv( nand2 ) with smaller delay */
+  rinox::libraries::augmented_library<rinox::network::design_type_t::CELL_BASED> lib( gates );
+  rinox::databases::mapped_database<bound_network, MaxNumVars> db( lib );
+  chain_t and_chain, nand_chain;
+  and_chain.add_inputs( MaxNumVars );
+  and_chain.add_output( and_chain.add_gate( { 0, 1 }, 4 ) );
+  nand_chain.add_inputs( MaxNumVars );
+  nand_chain.add_output( nand_chain.add_gate( { nand_chain.add_gate( { 0, 1 }, 3 ) }, 2 ) );
+  CHECK( db.add( and_chain ) );
+  CHECK( db.add( nand_chain ) );
+
+  bound_network ntk( gates );
+  auto const a = ntk.create_pi();
+  auto const b = ntk.create_pi();
+  auto const c = ntk.create_pi();
+
+  kitty::static_truth_table<MaxNumVars> x0, x1;
+  kitty::create_nth_var( x0, 0 );
+  kitty::create_nth_var( x1, 1 );
+  std::vector<signal> leaves{ a, b, c };
+  std::vector<double> times{ 0.0, 0.0, 0.0 };
+  auto const row = db.boolean_matching( x0 & x1, times, leaves );
+  REQUIRE( row );
+
+  /* the network already implements the AND with the gates of the second entry */
+  uint64_t shared = 0u;
+  db.foreach_entry( *row, [&]( auto const& entry ) {
+    if ( entry.area == 3.0 )
+      shared = db.write( entry, ntk, leaves );
+  } );
+  REQUIRE( shared > 0u );
+  ntk.create_po( ntk.make_signal( shared ) );
+  auto const pivot = ntk.create_node( { a, c }, 4 );
+  ntk.create_po( pivot );
+
+  rinox::opto::profilers::profiler_params ps;
+  rinox::windowing::default_window_manager_params wps;
+  rinox::windowing::window_manager_stats wst;
+  rinox::windowing::window_manager<bound_network> win_manager( ntk, wps, wst );
+  rinox::opto::profilers::area_profiler profiler( ntk, win_manager, ps );
+
+  /* the shared entry is free, hence it is preferred to the one with smaller area */
+  win_manager.run( pivot.index );
+  auto const size = ntk.size();
+  db.foreach_entry( *row, [&]( auto const& entry ) {
+    auto const cost = profiler.evaluate_entry( db, entry, leaves, times );
+    CHECK( cost == ( entry.area == 3.0 ? 0.0 : 2.5 ) );
+  } );
+  CHECK( ntk.size() == size );
+
+  /* the logic in the MFFC of the pivot is freed by the substitution, hence it is not shared */
+  win_manager.run( shared );
+  db.foreach_entry( *row, [&]( auto const& entry ) {
+    CHECK( profiler.evaluate_entry( db, entry, leaves, times ) == entry.area );
+  } );
+  CHECK( ntk.fanout_size( shared ) == 1u );
+}
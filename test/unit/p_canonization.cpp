@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+// Tests for rinox boolean/p_canonization.hpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include <kitty/kitty.hpp>
+#include <rinox/boolean/p_canonization.hpp>
+
+namespace nspace = rinox::boolean;
+
+template<uint32_t NumVars>
+kitty::static_truth_table<NumVars> from_repr( kitty::static_truth_table<NumVars> const& repr, nspace::permutation_t const& perm )
+{
+  std::vector<uint8_t> vec( NumVars );
+  for ( auto i = 0u; i < NumVars; ++i )
+    vec[i] = perm.forward( i );
+  return kitty::create_from_npn_config( std::make_tuple( repr, 0u, vec ) );
+}
+
+TEST_CASE( "P-canonization of all 4-input functions", "[p_canonization]" )
+{
+  static constexpr uint32_t NumVars = 4u;
+  nspace::p_canonizer<NumVars> with_table( true );
+  nspace::p_canonizer<NumVars> without_table( false );
+
+  std::set<uint64_t> classes;
+  kitty::static_truth_table<NumVars> tt;
+  do
+  {
+    auto const [repr, perm] = with_table( tt );
+    auto const [repr2, perm2] = without_table( tt );
+    CHECK( kitty::equal( repr, repr2 ) );
+    CHECK( perm == perm2 );
+    CHECK( kitty::equal( from_repr( repr, perm ), tt ) );
+    classes.insert( *repr.cbegin() );
+    kitty::next_inplace( tt );
+  } while ( !kitty::is_const0( tt ) );
+
+  /* number of P-classes of 4-input functions (222 are the NPN-classes) */
+  CHECK( classes.size() == 3984u );
+}
+
+TEST_CASE( "P-canonization of permuted 6-input functions", "[p_canonization]" )
+{
+  static constexpr uint32_t NumVars = 6u;
+  nspace::p_canonizer<NumVars> canonizer;
+
+  for ( auto seed = 0u; seed < 50u; ++seed )
+  {
+    kitty::static_truth_table<NumVars> tt;
+    kitty::create_random( tt, seed );
+    auto const [repr, perm] = canonizer( tt );
+    CHECK( kitty::equal( from_repr( repr, perm ), tt ) );
+
+    /* P-equivalent functions have the same representative */
+    auto permuted = tt;
+    kitty::swap_inplace( permuted, seed % NumVars, ( seed + 1 + seed / NumVars ) % NumVars );
+    kitty::swap_inplace( permuted, 0u, 5u );
+    auto const [repr_p, perm_p] = canonizer( permuted );
+    CHECK( kitty::equal( repr, repr_p ) );
+    CHECK( kitty::equal( from_repr( repr_p, perm_p ), permuted ) );
+  }
+
+  /* symmetric functions */
+  kitty::static_truth_table<NumVars> a, b, c, d;
+  kitty::create_nth_var( a, 0 );
+  kitty::create_nth_var( b, 3 );
+  kitty::create_nth_var( c, 5 );
+  kitty::create_nth_var( d, 1 );
+  auto const f = kitty::ternary_majority( a, b, c ) ^ d;
+  auto const [repr, perm] = canonizer( f );
+  CHECK( kitty::equal( from_repr( repr, perm ), f ) );
+}
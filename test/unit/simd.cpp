@@ -136,3 +136,86 @@ TEST_CASE( "SIMD nspace::binary LT large", "[simd]" )
   auto simd_resd = nspace::binary_lt( ttda, ttdb );
   REQUIRE( simd_resd == refd );
 }
+
+TEST_CASE( "SIMD kernels of each instruction set", "[simd]" )
+{
+  using TTD = kitty::dynamic_truth_table;
+
+  /* 11 variables: 32 blocks, plus a table with a tail not multiple of the vector width */
+  for ( auto num_vars : { 11u, 7u } )
+  {
+    TTD tta( num_vars ), ttb( num_vars );
+    kitty::create_random( tta, num_vars );
+    kitty::create_random( ttb, num_vars + 1 );
+
+    auto const initial = nspace::get_simd_isa();
+    for ( auto isa : { nspace::simd_isa::SCALAR, nspace::simd_isa::SSE42, nspace::simd_isa::AVX2, nspace::simd_isa::AVX512 } )
+    {
+      auto const selected = nspace::set_simd_isa( isa );
+      CHECK( static_cast<uint32_t>( selected ) <= static_cast<uint32_t>( isa ) );
+
+      CHECK( nspace::binary_and<TTD, false>( tta, ttb ) == ( tta & ttb ) );
+      CHECK( nspace::binary_or<TTD, false>( tta, ttb ) == ( tta | ttb ) );
+      CHECK( nspace::binary_xor<TTD, false>( tta, ttb ) == ( tta ^ ttb ) );
+      CHECK( nspace::binary_lt<TTD, false>( tta, ttb ) == ( ~tta & ttb ) );
+      CHECK( nspace::unary_not<TTD, false>( tta ) == ~tta );
+      CHECK( nspace::count_ones( tta ) == kitty::count_ones( tta ) );
+
+      TTD ttc( num_vars );
+      nspace::set_ones<TTD, false>( ttc );
+      CHECK( kitty::is_const0( ~ttc ) );
+      nspace::set_zero<TTD, false>( ttc );
+      CHECK( kitty::is_const0( ttc ) );
+    }
+    nspace::set_simd_isa( initial );
+  }
+}
+
+TEST_CASE( "SIMD advantage cached per instruction set", "[simd]" )
+{
+  using TTD = kitty::dynamic_truth_table;
+
+  TTD tt( 12u );
+  auto const initial = nspace::get_simd_isa();
+  nspace::test_avx2_advantage( tt, 12u );
+
+  /* a decision taken with the vectorized kernels is not reused with the scalar ones */
+  nspace::set_simd_isa( nspace::simd_isa::SCALAR );
+  CHECK( !nspace::use_avx2_cached<nspace::Operation::AND, TTD>( tt, 12u ) );
+  CHECK( !nspace::use_avx2_cached<nspace::Operation::NOT, TTD>( tt, 12u ) );
+  nspace::set_simd_isa( initial );
+}
+
+TEST_CASE( "SIMD fused split and count", "[simd]" )
+{
+  using TTS = kitty::static_truth_table<12u>;
+
+  TTS mask, tt, onset;
+  kitty::create_random( mask, 4 );
+  kitty::create_random( tt, 5 );
+  kitty::create_random( onset, 6 );
+  TTS const offset = mask & ~onset;
+
+  auto const initial = nspace::get_simd_isa();
+  for ( auto isa : { nspace::simd_isa::SCALAR, nspace::simd_isa::SSE42, nspace::simd_isa::AVX2, nspace::simd_isa::AVX512 } )
+  {
+    nspace::set_simd_isa( isa );
+    TTS const mask0 = mask & ~tt;
+    TTS const mask1 = mask & tt;
+
+    auto const counts = nspace::count_split( mask, tt, onset, offset );
+    CHECK( counts.on0 == kitty::count_ones( mask0 & onset ) );
+    CHECK( counts.off0 == kitty::count_ones( mask0 & offset ) );
+    CHECK( counts.on1 == kitty::count_ones( mask1 & onset ) );
+    CHECK( counts.off1 == kitty::count_ones( mask1 & offset ) );
+
+    TTS split0 = mask;
+    TTS split1;
+    auto const split_counts = nspace::split_and_count( split0, split1, tt, onset, offset );
+    CHECK( split0 == mask0 );
+    CHECK( split1 == mask1 );
+    CHECK( split_counts.on0 == counts.on0 );
+    CHECK( split_counts.off1 == counts.off1 );
+  }
+  nspace::set_simd_isa( initial );
+}
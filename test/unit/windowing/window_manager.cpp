@@ -1,4 +1,5 @@
 #include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <kitty/kitty.hpp>
@@ -25,10 +26,11 @@ struct window_manager_params2 : rinox::windowing::default_window_manager_params
   static constexpr uint32_t max_num_leaves = 8u;
 };
 
-TEST_CASE( "Window construction with reconvergent structure", "[window_manager]" )
+TEMPLATE_TEST_CASE( "Window construction with reconvergent structure", "[window_manager]",
+                    ( rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2> ),
+                    ( rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2, rinox::network::storage_layout_t::STRUCT_OF_ARRAYS> ) )
 {
-
-  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  using Ntk = TestType;
   std::vector<mockturtle::gate> gates;
 
   std::istringstream in( test_library );
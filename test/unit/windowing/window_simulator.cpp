@@ -1,4 +1,5 @@
 #include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <kitty/kitty.hpp>
@@ -21,9 +22,11 @@ struct window_manager_params : rinox::windowing::default_window_manager_params
   static constexpr uint32_t max_num_leaves = 8u;
 };
 
-TEST_CASE( "Simulate a small window", "[window_simulator]" )
+TEMPLATE_TEST_CASE( "Simulate a small window", "[window_simulator]",
+                    ( rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2> ),
+                    ( rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2, rinox::network::storage_layout_t::STRUCT_OF_ARRAYS> ) )
 {
-  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  using Ntk = TestType;
   std::vector<mockturtle::gate> gates;
 
   std::istringstream in( test_library );
@@ -72,3 +75,138 @@ TEST_CASE( "Simulate a small window", "[window_simulator]" )
   auto care = sim.compute_observability_careset( window );
   CHECK( kitty::equal( care, ~ttc & ( tta & ttd ) ) );
 }
+
+TEST_CASE( "Reuse the simulations of the previous window", "[window_simulator]" )
+{
+  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  Ntk ntk( gates );
+
+  using signal = typename Ntk::signal;
+  std::vector<signal> fs;
+  signal const a = ntk.create_pi();
+  signal const b = ntk.create_pi();
+  signal const c = ntk.create_pi();
+  signal const d = ntk.create_pi();
+
+  fs.push_back( ntk.create_node( { a, b }, 1 ) );         // 0
+  fs.push_back( ntk.create_node( { c, d }, 1 ) );         // 1
+  fs.push_back( ntk.create_node( { fs[0], fs[1] }, 1 ) ); // 2
+  fs.push_back( ntk.create_node( { d }, 0 ) );            // 3
+  fs.push_back( ntk.create_node( { a }, 0 ) );            // 4
+  fs.push_back( ntk.create_node( { fs[4], fs[2] }, 2 ) ); // 5
+  fs.push_back( ntk.create_node( { fs[3], fs[5] }, 2 ) ); // 6
+  fs.push_back( ntk.create_node( { c }, 0 ) );            // 7
+  fs.push_back( ntk.create_node( { fs[7], fs[6] }, 1 ) ); // 8
+  fs.push_back( ntk.create_node( { fs[8] }, 0 ) );        // 9
+
+  ntk.create_po( fs[9] );
+
+  using DNtk = mockturtle::depth_view<Ntk>;
+  rinox::windowing::window_manager_stats st;
+  DNtk dntk( ntk );
+
+  window_manager_params ps;
+  ps.odc_levels = 4u;
+
+  rinox::windowing::window_manager<DNtk> window( dntk, ps, st );
+  rinox::windowing::window_simulator_stats sim_st;
+  rinox::windowing::window_simulator sim( dntk, sim_st );
+
+  CHECK( window.run( dntk.get_node( fs[2] ) ) );
+  sim.run( window );
+  auto const tt9 = sim.get( fs[9] );
+  CHECK( sim_st.num_hits == 0u );
+  auto const num_misses = sim_st.num_misses;
+  CHECK( num_misses > 0u );
+
+  /* same window: every node is reused */
+  CHECK( window.run( dntk.get_node( fs[2] ) ) );
+  sim.run( window );
+  CHECK( sim_st.num_hits == num_misses );
+  CHECK( sim_st.num_misses == num_misses );
+  CHECK( kitty::equal( sim.get( fs[9] ), tt9 ) );
+
+  /* modifying a node of the window resimulates only its transitive fanout */
+  auto const n7 = ntk.get_node( fs[7] );
+  signal const f7 = ntk.create_node( { c }, 0 );
+  ntk.substitute_node( n7, f7 );
+  CHECK( window.run( dntk.get_node( fs[2] ) ) );
+  sim.run( window );
+  CHECK( sim_st.num_hits > num_misses );
+  CHECK( sim_st.num_misses > num_misses );
+  CHECK( sim_st.num_partial_hits == 0u );
+  CHECK( kitty::equal( sim.get( fs[9] ), tt9 ) );
+}
+
+TEST_CASE( "Reuse the simulations of a window with different leaves", "[window_simulator]" )
+{
+  using Ntk = rinox::network::bound_network<rinox::network::design_type_t::CELL_BASED, 2>;
+  std::vector<mockturtle::gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, mockturtle::genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  Ntk ntk( gates );
+
+  using signal = typename Ntk::signal;
+  signal const a = ntk.create_pi();
+  signal const b = ntk.create_pi();
+  signal const c = ntk.create_pi();
+  signal const d = ntk.create_pi();
+  signal const e = ntk.create_pi();
+
+  signal const g0 = ntk.create_node( { a, b }, 1 );
+  signal const g1 = ntk.create_node( { g0, c }, 1 );
+  signal const g2 = ntk.create_node( { g1, d }, 1 );
+  signal const g3 = ntk.create_node( { g2, e }, 1 );
+  ntk.create_po( g3 );
+
+  using DNtk = mockturtle::depth_view<Ntk>;
+  rinox::windowing::window_manager_stats st;
+  DNtk dntk( ntk );
+
+  window_manager_params ps;
+  rinox::windowing::window_manager<DNtk> window( dntk, ps, st );
+  rinox::windowing::window_simulator_stats sim_st;
+  rinox::windowing::window_simulator sim( dntk, sim_st );
+
+  rinox::windowing::window_t<DNtk> win;
+  win.pivot = ntk.get_node( g2 );
+  win.inputs = { a, b, c, d };
+  win.divs = { a, b, c, d, g0, g1 };
+  win.mffc = { ntk.get_node( g2 ) };
+  win.outputs = { g2 };
+  window.load( win );
+  sim.run( window );
+  CHECK( sim_st.num_hits == 0u );
+  CHECK( sim_st.num_misses == 3u );
+
+  /* the neighbouring pivot adds a leaf: the nodes in the fanin of the old pivot are reused */
+  win.pivot = ntk.get_node( g3 );
+  win.inputs = { a, b, c, d, e };
+  win.divs = { a, b, c, d, e, g0, g1, g2 };
+  win.mffc = { ntk.get_node( g3 ) };
+  win.outputs = { g3 };
+  window.load( win );
+  sim.run( window );
+  CHECK( sim_st.num_hits == 3u );
+  CHECK( sim_st.num_partial_hits == 3u );
+  CHECK( sim_st.num_misses == 4u );
+  CHECK( kitty::equal( sim.get( g3 ), sim.get( a ) & sim.get( b ) & sim.get( c ) & sim.get( d ) & sim.get( e ) ) );
+
+  /* a node turning into a leaf changes the transitive fanin of its fanout */
+  win.inputs = { g0, c, d, e };
+  win.divs = { g0, c, d, e, g1, g2 };
+  window.load( win );
+  sim.run( window );
+  CHECK( sim_st.num_hits == 3u );
+  CHECK( sim_st.num_misses == 7u );
+  CHECK( kitty::equal( sim.get( g3 ), sim.get( g0 ) & sim.get( c ) & sim.get( d ) & sim.get( e ) ) );
+}